@@ -27,9 +27,27 @@ public class DriverProxy {
 		LIMIT_LEN_IMPLICATIONS(10),
 		ENABLE_SORTING_HEURISTICS(11), 		// default option
 		DISABLE_SORTING_HEURISTICS(12), 
-		REGEX_FLAG(13),
-		OUTPUT_PATH(14), 					// not actively used through Java
-		SCRIPT_PATH(15);					// not actively used
+		FORCE_DNF_FORMULA(13),
+		COUNT_BOUND_EXACT(14),
+		REGEX_FLAG(15),
+		OUTPUT_PATH(16), 					// not actively used through Java
+		SCRIPT_PATH(17),					// not actively used
+		REGEX_CACHE_FILE(18),				// compiled regex automata are loaded from and saved into this file
+		ENABLE_DEFERRED_MINIMIZATION(19),	// default option
+		DISABLE_DEFERRED_MINIMIZATION(20),
+		ENABLE_NATIVE_MINIMIZATION(21),
+		DISABLE_NATIVE_MINIMIZATION(22),	// default option
+		INT_BIT_WIDTH(23),					// integers are fixed width two's complement numbers, 0 (default) for unbounded
+		ENABLE_DIRECT_INDEX_CONSTRUCTIONS(24),	// default option
+		DISABLE_DIRECT_INDEX_CONSTRUCTIONS(25),
+		NUM_OF_THREADS(26),					// number of threads used to solve independent components, 1 (default) is sequential
+		SAT_ONLY_MODE(27),					// stops solving a disjunction at its first satisfiable disjunct, do not use with model counting
+		RESULT_CACHE_SIZE(28),			// number of query results kept in memory and shared by all drivers, 0 (default) disables the result cache
+		RESULT_CACHE_FILE(29),			// file to load query results from and save them back when the driver is disposed, enables the result cache
+		TIMEOUT(30),						// milliseconds each call of a query (solve, count, examples) may run before the query is cancelled, 0 (default) for no limit
+		MEMORY_LIMIT(31),					// megabytes of automata a call of a query may keep before the query is cancelled, 0 (default) for no limit
+		ENABLE_TIMING_REFINEMENT(32),		// sorting heuristics scale their estimates with the solving times of earlier queries, the order is not reproducible
+		DISABLE_TIMING_REFINEMENT(33);		// default option
 
 		private final int value;
 
@@ -118,6 +136,37 @@ public class DriverProxy {
 
 	public native boolean isSatisfiable(final String constraint);
 
+	/**
+	 * @return true if the last query is cancelled by the TIMEOUT or MEMORY_LIMIT option, results are
+	 * unsatisfiable, 0 counts and no examples until the next isSatisfiable or reset
+	 */
+	public native boolean isUnknown();
+
+	public void push() {
+		push(1);
+	}
+
+	public boolean pop() {
+		return pop(1);
+	}
+
+	/**
+	 * Saves the current assertions, pop restores them
+	 */
+	public native void push(final int levels);
+
+	/**
+	 * @return false, keeping the assertions as they are, if there are not that many pushed levels
+	 */
+	public native boolean pop(final int levels);
+
+	/**
+	 * Adds assertions (and declarations, push and pop commands) on top of the current ones and solves
+	 * only the new assertions when possible; isSatisfiable discards the incremental assertions
+	 * @return satisfiability of all current assertions
+	 */
+	public native boolean assertIncremental(final String constraint);
+
 	public native BigInteger countVariable(final String varName, final long bound);
 	
 	public native BigInteger countInts(final long bound);
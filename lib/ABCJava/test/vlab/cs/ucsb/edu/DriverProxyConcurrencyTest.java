@@ -0,0 +1,129 @@
+package vlab.cs.ucsb.edu;
+
+import java.math.BigInteger;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+/**
+ * Solves the same constraints with one DriverProxy per thread without any Java side locking and
+ * compares the results with the ones computed by a single driver. Drivers in different threads use
+ * different options to check that options of one driver are not seen by the others.
+ * 
+ * Run with 'make check-java' from the build directory, or after installing abc with
+ * java -Djava.library.path=/usr/local/lib vlab.cs.ucsb.edu.DriverProxyConcurrencyTest [threads] [rounds]
+ * 
+ * @author agent
+ *
+ */
+public class DriverProxyConcurrencyTest {
+
+	private static final String[] CONSTRAINTS = {
+		"(declare-fun x () String)\n(assert (in x /(ab)*c/))\n(assert (< (len x) 6))\n(check-sat)",
+		"(declare-fun x () String)\n(declare-fun y () String)\n(assert (= (str.++ x y) \"abcd\"))\n(check-sat)",
+		"(declare-fun x () String)\n(assert (str.contains x \"ab\"))\n(assert (str.prefixof \"ba\" x))\n(check-sat)",
+		"(declare-fun x () String)\n(assert (= (str.indexof x \"c\") 2))\n(assert (< (len x) 5))\n(check-sat)",
+		"(declare-fun x () String)\n(assert (in x /a+/))\n(assert (in x /b+/))\n(check-sat)"
+	};
+
+	private static final long BOUND = 5;
+
+	private static class Result {
+		final boolean isSatisfiable;
+		final BigInteger count;
+
+		Result(final boolean isSatisfiable, final BigInteger count) {
+			this.isSatisfiable = isSatisfiable;
+			this.count = count;
+		}
+
+		@Override
+		public boolean equals(final Object other) {
+			if (!(other instanceof Result)) {
+				return false;
+			}
+			final Result result = (Result) other;
+			return isSatisfiable == result.isSatisfiable
+					&& (count == null ? result.count == null : count.equals(result.count));
+		}
+
+		@Override
+		public int hashCode() {
+			return Boolean.hashCode(isSatisfiable);
+		}
+
+		@Override
+		public String toString() {
+			return isSatisfiable ? "sat " + count : "unsat";
+		}
+	}
+
+	private static Result solve(final DriverProxy driver, final String constraint) {
+		final boolean isSatisfiable = driver.isSatisfiable(constraint);
+		return new Result(isSatisfiable, isSatisfiable ? driver.countVariable("x", BOUND) : null);
+	}
+
+	private static List<Result> solveAll(final DriverProxy driver, final int rounds) {
+		final List<Result> results = new ArrayList<Result>();
+		for (int round = 0; round < rounds; round++) {
+			for (final String constraint : CONSTRAINTS) {
+				results.add(solve(driver, constraint));
+			}
+		}
+		return results;
+	}
+
+	public static void main(final String[] args) throws Exception {
+		final int threads = args.length > 0 ? Integer.parseInt(args[0]) : 8;
+		final int rounds = args.length > 1 ? Integer.parseInt(args[1]) : 10;
+
+		final DriverProxy sequentialDriver = new DriverProxy();
+		final List<Result> expected = solveAll(sequentialDriver, 1);
+		sequentialDriver.dispose();
+
+		final ExecutorService executor = Executors.newFixedThreadPool(threads);
+		final List<Future<List<Result>>> futures = new ArrayList<Future<List<Result>>>();
+		final long start = System.nanoTime();
+		for (int t = 0; t < threads; t++) {
+			final int thread = t;
+			futures.add(executor.submit(new Callable<List<Result>>() {
+				@Override
+				public List<Result> call() {
+					final DriverProxy driver = new DriverProxy();
+					// options that do not change the results, they must stay private to this driver
+					if (thread % 2 == 1) {
+						driver.setOption(DriverProxy.Option.DISABLE_EQUIVALENCE_CLASSES);
+						driver.setOption(DriverProxy.Option.DISABLE_DIRECT_INDEX_CONSTRUCTIONS);
+						driver.setOption(DriverProxy.Option.NUM_OF_THREADS, 2);
+					}
+					try {
+						return solveAll(driver, rounds);
+					} finally {
+						driver.dispose();
+					}
+				}
+			}));
+		}
+
+		int failures = 0;
+		for (int t = 0; t < threads; t++) {
+			final List<Result> results = futures.get(t).get();
+			for (int i = 0; i < results.size(); i++) {
+				final Result expectedResult = expected.get(i % CONSTRAINTS.length);
+				if (!expectedResult.equals(results.get(i))) {
+					System.err.println("thread " + t + ", constraint " + (i % CONSTRAINTS.length) + ": expected "
+							+ expectedResult + ", got " + results.get(i));
+					failures++;
+				}
+			}
+		}
+		executor.shutdown();
+
+		final long elapsed = (System.nanoTime() - start) / 1000000;
+		System.out.println(threads + " threads x " + rounds + " rounds in " + elapsed + " ms, " + failures + " failures");
+		System.exit(failures == 0 ? 0 : 1);
+	}
+}
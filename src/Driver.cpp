@@ -10,29 +10,48 @@
 namespace Vlab {
 
 //const Log::Level Driver::TAG = Log::DRIVER;
-bool Driver::IS_LOGGING_INITIALIZED = false;
+const int Driver::VLOG_LEVEL = 10;
+std::once_flag Driver::LOGGING_INITIALIZED;
+std::atomic<int> Driver::NUMBER_OF_INSTANCES {0};
 
 Driver::Driver()
     : script_(nullptr),
       symbol_table_(nullptr),
       constraint_information_(nullptr),
-      is_model_counter_cached_ { false } {
+      is_model_counter_cached_ { false },
+      is_incremental_state_loaded_ { false },
+      is_incremental_state_relational_ { false },
+      is_result_cached_ { false },
+      cached_is_satisfiable_ { false },
+      is_unknown_ { false },
+      is_running_query_ { false },
+      cost_model_timings_ { std::make_shared<Solver::ConstraintCostModel::Timings>() } {
+  ++NUMBER_OF_INSTANCES;
 }
 
 Driver::~Driver() {
+  Option::Options::Scope option_scope(options_);
+  ClearIncrementalLevels();
   delete symbol_table_;
   delete script_;
   delete constraint_information_;
-  Theory::Automaton::CleanUp();
+  if (not Option::Theory::REGEX_CACHE_FILE.empty()) {
+    Theory::StringAutomaton::SaveRegexCache(Option::Theory::REGEX_CACHE_FILE);
+  }
+  if (not Option::Solver::RESULT_CACHE_FILE.empty()) {
+    Solver::ResultCache::Save(Option::Solver::RESULT_CACHE_FILE);
+  }
+  if (--NUMBER_OF_INSTANCES == 0) {
+    Theory::Automaton::CleanUp();
+  }
 }
 
 void Driver::InitializeLogger(int log_level) {
-  if (!IS_LOGGING_INITIALIZED) {
+  std::call_once(LOGGING_INITIALIZED, [log_level]() {
     FLAGS_v = log_level;
     FLAGS_logtostderr = 1;
     google::InitGoogleLogging("ABC.Java.Driver");
-    IS_LOGGING_INITIALIZED = true;
-  }
+  });
 }
 
 void Driver::error(const std::string& m) {
@@ -40,6 +59,8 @@ void Driver::error(const std::string& m) {
 }
 
 int Driver::Parse(std::istream* in) {
+  Option::Options::Scope option_scope(options_);
+  ClearIncrementalLevels();
   SMT::Scanner scanner(in);
   //  scanner.set_debug(trace_scanning);
   SMT::Parser parser(script_, scanner);
@@ -67,29 +88,59 @@ void Driver::ast2dot(std::string file_name) {
 }
 
 void Driver::InitializeSolver() {
+  Option::Options::Scope option_scope(options_);
+  RunWithinBudget([this]() {
+    symbol_table_ = new Solver::SymbolTable();
+    constraint_information_ = new Solver::ConstraintInformation();
+
+    Solver::Initializer initializer(script_, symbol_table_);
+    initializer.start();
+
+    std::string output_root {"./output"};
+    //ast2dot(output_root + "/post_initializer.dot");
+    //std::cin.get();
+
+    Solver::SyntacticProcessor syntactic_processor(script_);
+    syntactic_processor.start();
+
+    //ast2dot(output_root + "/post_syntactic_processor.dot");
+    //std::cin.get();
+
+    Solver::SyntacticOptimizer syntactic_optimizer(script_, symbol_table_);
+    syntactic_optimizer.start();
+
+    //ast2dot(output_root + "/post_syntactic_optimizer.dot");
+    //std::cin.get();
+
+    result_cache_key_.clear();
+    is_result_cached_ = false;
+    // incremental solving needs the variable values of each level
+    if (Option::Solver::RESULT_CACHE_SIZE > 0 and incremental_levels_.empty()) {
+      Solver::ConstraintFingerprint constraint_fingerprint(script_, symbol_table_);
+      constraint_fingerprint.start();
+      if (not constraint_fingerprint.get_fingerprint().empty()) {
+        result_cache_key_ = Solver::ResultCache::GetKey(constraint_fingerprint.get_fingerprint());
+        Solver::ResultCache::Entry entry;
+        if (Solver::ResultCache::Get(result_cache_key_, entry)) {
+          is_result_cached_ = true;
+          cached_is_satisfiable_ = entry.is_satisfiable;
+          if (not entry.model_counter.empty()) {
+            std::stringstream is(entry.model_counter);
+            cereal::BinaryInputArchive ar(is);
+            model_counter_ = Solver::ModelCounter();
+            model_counter_.load(ar);
+            is_model_counter_cached_ = true;
+          }
+          return;
+        }
+      }
+    }
 
-  symbol_table_ = new Solver::SymbolTable();
-  constraint_information_ = new Solver::ConstraintInformation();
-
-  Solver::Initializer initializer(script_, symbol_table_);
-  initializer.start();
-
-  std::string output_root {"./output"};
-  //ast2dot(output_root + "/post_initializer.dot");
-  //std::cin.get();
-
-  Solver::SyntacticProcessor syntactic_processor(script_);
-  syntactic_processor.start();
-
-  //ast2dot(output_root + "/post_syntactic_processor.dot");
-  //std::cin.get();
-
-  Solver::SyntacticOptimizer syntactic_optimizer(script_, symbol_table_);
-  syntactic_optimizer.start();
-
-  //ast2dot(output_root + "/post_syntactic_optimizer.dot");
-  //std::cin.get();
+    RunSolverPasses();
+  });
+}
 
+void Driver::RunSolverPasses() {
   //int count = 0;
   if (Option::Solver::ENABLE_EQUIVALENCE_CLASSES) {
     Solver::EquivalenceGenerator equivalence_generator(script_, symbol_table_);
@@ -115,6 +166,16 @@ void Driver::InitializeSolver() {
     //ast2dot(output_root + "/post_implication_runner.dot");
   }
 
+  // fixed width integers wrap around, lengths cannot be reasoned about as unbounded integers
+  if (Option::Theory::INT_BIT_WIDTH == 0) {
+    Solver::LengthAbstractionChecker length_abstraction_checker(script_, symbol_table_);
+    length_abstraction_checker.start();
+    if (not length_abstraction_checker.is_feasible()) {
+      symbol_table_->update_satisfiability_result(false);
+      return;
+    }
+  }
+
   Solver::FormulaOptimizer formula_optimizer(script_, symbol_table_);
   formula_optimizer.start();
 
@@ -122,26 +183,353 @@ void Driver::InitializeSolver() {
 	//std::cin.get();
 
   if (Option::Solver::ENABLE_SORTING_HEURISTICS) {
-    Solver::ConstraintSorter constraint_sorter(script_, symbol_table_);
+    Solver::ConstraintSorter constraint_sorter(script_, symbol_table_, cost_model_timings_);
     constraint_sorter.start();
   }
 }
 
 void Driver::Solve() {
-//  TODO move arithmetic formula generation and string relation generation here to guide constraint solving better
-//
-//  Solver::ArithmeticFormulaGenerator arithmetic_formula_generator(script_, symbol_table_, constraint_information_);
-//  arithmetic_formula_generator.start();
+  Option::Options::Scope option_scope(options_);
+  RunWithinBudget([this]() {
+    //  TODO move arithmetic formula generation and string relation generation here to guide constraint solving better
+    //
+    //  Solver::ArithmeticFormulaGenerator arithmetic_formula_generator(script_, symbol_table_, constraint_information_);
+    //  arithmetic_formula_generator.start();
+
+    if (is_result_cached_) {
+      return;
+    }
 
-  Solver::ConstraintSolver constraint_solver(script_, symbol_table_, constraint_information_);
-  constraint_solver.start();
+    // solver passes may already find the script unsatisfiable
+    if (symbol_table_->isSatisfiable()) {
+      Solver::ConstraintSolver constraint_solver(script_, symbol_table_, constraint_information_,
+                                                 cost_model_timings_);
+      constraint_solver.start();
+    }
+
+    if (not result_cache_key_.empty()) {
+      Solver::ResultCache::Put(result_cache_key_, symbol_table_->isSatisfiable());
+    }
+  });
 }
 
 bool Driver::is_sat() {
-  return symbol_table_->isSatisfiable();
+  Option::Options::Scope option_scope(options_);
+  bool is_satisfiable = false;
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(false);
+    is_satisfiable = is_result_cached_ ? cached_is_satisfiable_ : symbol_table_->isSatisfiable();
+  });
+  return is_satisfiable;
+}
+
+bool Driver::is_unknown() const {
+  return is_unknown_;
+}
+
+void Driver::SolveCachedQuery() {
+  if (not is_result_cached_) {
+    return;
+  }
+  Option::Options::Scope option_scope(options_);
+  DVLOG(VLOG_LEVEL) << "solving the cached query for variable values";
+  is_result_cached_ = false;
+  RunSolverPasses();
+  Solve();
+}
+
+void Driver::Push(const unsigned long levels) {
+  if (incremental_levels_.empty()) {
+    incremental_levels_.push_back(IncrementalLevel());
+    incremental_levels_.back().is_satisfiable = true;
+  }
+  for (unsigned long i = 0; i < levels; ++i) {
+    IncrementalLevel level;
+    level.values = incremental_levels_.back().values;
+    level.constrained_variables = incremental_levels_.back().constrained_variables;
+    level.linked_variables = incremental_levels_.back().linked_variables;
+    level.is_satisfiable = incremental_levels_.back().is_satisfiable;
+    incremental_levels_.push_back(level);
+  }
+}
+
+bool Driver::Pop(const unsigned long levels) {
+  if (levels == 0) {
+    return true;
+  }
+  if (levels >= incremental_levels_.size()) {
+    const std::size_t pushed_levels = incremental_levels_.empty() ? 0 : incremental_levels_.size() - 1;
+    LOG(ERROR) << "cannot pop " << levels << " levels, " << pushed_levels << " levels are pushed";
+    return false;
+  }
+  for (unsigned long i = 0; i < levels; ++i) {
+    for (auto declaration : incremental_levels_.back().declarations) {
+      delete declaration;
+    }
+    for (auto assertion : incremental_levels_.back().assertions) {
+      delete assertion;
+    }
+    incremental_levels_.pop_back();
+  }
+  is_incremental_state_loaded_ = false;
+  return true;
+}
+
+bool Driver::AssertIncremental(std::istream* in) {
+  Option::Options::Scope option_scope(options_);
+  bool is_satisfiable = false;
+  RunWithinBudget([&]() {
+    if (incremental_levels_.empty()) {
+      incremental_levels_.push_back(IncrementalLevel());
+      incremental_levels_.back().is_satisfiable = true;
+    }
+
+    SMT::Script_ptr script = nullptr;
+    SMT::Scanner scanner(in);
+    SMT::Parser parser(script, scanner);
+    CHECK_EQ(0, parser.parse())<< "Syntax error";
+
+    std::vector<SMT::Assert_ptr> assertions;
+    for (auto command : *(script->command_list)) {
+      switch (command->getType()) {
+        case SMT::Command::Type::DECLARE_FUN:
+          incremental_levels_.back().declarations.push_back(dynamic_cast<SMT::DeclareFun_ptr>(command)->clone());
+          break;
+        case SMT::Command::Type::ASSERT:
+          assertions.push_back(dynamic_cast<SMT::Assert_ptr>(command)->clone());
+          break;
+        case SMT::Command::Type::PUSH:
+          SolveIncremental(assertions);
+          Push(dynamic_cast<SMT::Push_ptr>(command)->getNumberOfLevels());
+          break;
+        case SMT::Command::Type::POP:
+          SolveIncremental(assertions);
+          Pop(dynamic_cast<SMT::Pop_ptr>(command)->getNumberOfLevels());
+          break;
+        case SMT::Command::Type::CHECK_SAT:
+          SolveIncremental(assertions);
+          break;
+        default:
+          DVLOG(VLOG_LEVEL) << "'" << *command << "' is ignored in incremental mode";
+          break;
+      }
+    }
+    SolveIncremental(assertions);
+    delete script;
+    is_satisfiable = incremental_levels_.back().is_satisfiable;
+  });
+  return is_satisfiable;
+}
+
+bool Driver::AssertIncremental(const std::string constraint) {
+  std::istringstream in(constraint);
+  return AssertIncremental(&in);
+}
+
+/**
+ * Takes the ownership of the assertions and clears the given list.
+ * New assertions are grouped by shared variables. Their solutions can be combined with the saved values
+ * when each group either mentions only variables that were not constrained before, or mentions a single
+ * variable that was constrained only by single-variable assertions; the solution of such a variable is the
+ * intersection of its saved value and its value for the group.
+ */
+void Driver::SolveIncremental(std::vector<SMT::Assert_ptr>& assertions) {
+  if (assertions.empty()) {
+    return;
+  }
+  auto& level = incremental_levels_.back();
+  std::set<std::string> declared_names;
+  for (auto& incremental_level : incremental_levels_) {
+    for (auto declaration : incremental_level.declarations) {
+      declared_names.insert(declaration->symbol->getData());
+    }
+  }
+
+  // group the new assertions by shared variables
+  std::vector<std::set<std::string>> groups;
+  for (auto assertion : assertions) {
+    auto group = GetIncrementalVariableNames(assertion->term, declared_names);
+    for (auto it = groups.begin(); it != groups.end();) {
+      if (std::any_of(it->begin(), it->end(), [&group](const std::string& name) { return group.count(name) > 0; })) {
+        group.insert(it->begin(), it->end());
+        it = groups.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    groups.push_back(group);
+  }
+
+  bool is_combinable = true;
+  std::set<std::string> single_variables;
+  std::set<std::string> linked_variables;
+  for (auto& group : groups) {
+    if (group.size() == 1) {
+      is_combinable = is_combinable and level.linked_variables.count(*group.begin()) == 0;
+      single_variables.insert(*group.begin());
+    } else {
+      for (auto& name : group) {
+        is_combinable = is_combinable and level.constrained_variables.count(name) == 0;
+      }
+      linked_variables.insert(group.begin(), group.end());
+    }
+  }
+  // relations between the variables of earlier assertions are lost when their saved values are loaded
+  const bool is_relational = level.linked_variables.empty();
+  std::set<std::string> new_variables(single_variables);
+  new_variables.insert(linked_variables.begin(), linked_variables.end());
+  level.constrained_variables.insert(new_variables.begin(), new_variables.end());
+  level.linked_variables.insert(linked_variables.begin(), linked_variables.end());
+
+  std::vector<SMT::Assert_ptr> new_assertions (assertions);
+  level.assertions.insert(level.assertions.end(), assertions.begin(), assertions.end());
+  assertions.clear();
+
+  if (not level.is_satisfiable) {
+    // more assertions do not make it satisfiable
+    return;
+  } else if (not is_combinable) {
+    SolveAllIncrementalLevels();
+    return;
+  }
+
+  InitializeIncrementalSolver(new_assertions);
+  Solve();
+  bool is_satisfiable = symbol_table_->isSatisfiable();
+  if (is_satisfiable) {
+    symbol_table_->push_scope(script_);
+    for (auto& entry : level.values) {
+      auto variable = symbol_table_->get_variable_unsafe(entry.first);
+      if (variable == nullptr) {
+        continue;
+      }
+      std::unique_ptr<Solver::Value> value;
+      if (single_variables.count(entry.first) > 0) {
+        auto new_value = symbol_table_->get_projected_value_at_scope(script_, variable);
+        if (new_value == nullptr) {
+          value.reset(entry.second->clone());
+        } else if (new_value->getType() == entry.second->getType()) {
+          value.reset(new_value->intersect(entry.second.get()));
+        } else {
+          // values are not comparable, fall back to solving everything
+          symbol_table_->pop_scope();
+          SolveAllIncrementalLevels();
+          return;
+        }
+      } else {
+        value.reset(entry.second->clone());
+      }
+      is_satisfiable = symbol_table_->set_value(variable, value.get()) and is_satisfiable;
+    }
+    symbol_table_->pop_scope();
+    symbol_table_->update_satisfiability_result(is_satisfiable);
+  }
+
+  level.is_satisfiable = is_satisfiable;
+  if (is_satisfiable) {
+    SaveIncrementalValues(new_variables);
+  }
+  is_incremental_state_loaded_ = true;
+  is_incremental_state_relational_ = is_relational;
+}
+
+void Driver::SolveAllIncrementalLevels() {
+  std::vector<SMT::Assert_ptr> assertions;
+  for (auto& level : incremental_levels_) {
+    assertions.insert(assertions.end(), level.assertions.begin(), level.assertions.end());
+  }
+  InitializeIncrementalSolver(assertions);
+  Solve();
+
+  auto& level = incremental_levels_.back();
+  level.is_satisfiable = symbol_table_->isSatisfiable();
+  level.values.clear();
+  if (level.is_satisfiable) {
+    SaveIncrementalValues(level.constrained_variables);
+  }
+  is_incremental_state_loaded_ = true;
+  is_incremental_state_relational_ = true;
+}
+
+/**
+ * Solver passes rewrite the script, it is built from copies of the declarations and the given assertions
+ */
+void Driver::InitializeIncrementalSolver(const std::vector<SMT::Assert_ptr>& assertions) {
+  ClearSolverState();
+  auto command_list = new SMT::CommandList();
+  for (auto& level : incremental_levels_) {
+    for (auto declaration : level.declarations) {
+      command_list->push_back(declaration->clone());
+    }
+  }
+  for (auto assertion : assertions) {
+    command_list->push_back(assertion->clone());
+  }
+  script_ = new SMT::Script(command_list);
+  InitializeSolver();
+}
+
+void Driver::SaveIncrementalValues(const std::set<std::string>& variable_names) {
+  auto& level = incremental_levels_.back();
+  for (auto& name : variable_names) {
+    auto variable = symbol_table_->get_variable_unsafe(name);
+    if (variable == nullptr) {
+      continue;
+    }
+    auto value = symbol_table_->get_projected_value_at_scope(script_, variable);
+    if (value == nullptr) {
+      level.values.erase(name);
+    } else {
+      level.values[name] = std::shared_ptr<Solver::Value>(value->clone());
+    }
+  }
+}
+
+void Driver::UpdateIncrementalState(const bool needs_relations) {
+  if (incremental_levels_.empty()) {
+    return;
+  }
+  Option::Options::Scope option_scope(options_);
+  auto& level = incremental_levels_.back();
+  if (needs_relations and level.is_satisfiable and not level.linked_variables.empty()
+      and not (is_incremental_state_loaded_ and is_incremental_state_relational_)) {
+    SolveAllIncrementalLevels();
+    return;
+  } else if (is_incremental_state_loaded_) {
+    return;
+  }
+
+  InitializeIncrementalSolver(std::vector<SMT::Assert_ptr>());
+  symbol_table_->push_scope(script_);
+  for (auto& entry : level.values) {
+    auto variable = symbol_table_->get_variable_unsafe(entry.first);
+    if (variable != nullptr) {
+      symbol_table_->set_value(variable, entry.second.get());
+    }
+  }
+  symbol_table_->pop_scope();
+  symbol_table_->update_satisfiability_result(level.is_satisfiable);
+  is_incremental_state_loaded_ = true;
+  is_incremental_state_relational_ = level.linked_variables.empty();
+}
+
+std::set<std::string> Driver::GetIncrementalVariableNames(SMT::Term_ptr term, const std::set<std::string>& declared_names) {
+  std::set<std::string> names;
+  Solver::AstTraverser variable_collector(script_);
+  variable_collector.setTermPreCallback([&names, &declared_names](SMT::Term_ptr term) -> bool {
+    if (SMT::QualIdentifier_ptr qi_term = dynamic_cast<SMT::QualIdentifier_ptr>(term)) {
+      if (declared_names.count(qi_term->getVarName()) > 0) {
+        names.insert(qi_term->getVarName());
+      }
+    }
+    return true;
+  });
+  variable_collector.visit(term);
+  return names;
 }
 
 void Driver::GetModels(const unsigned long bound,const unsigned long num_models) {
+  Option::Options::Scope option_scope(options_);
 
 	LOG(FATAL) << "IMPLEMENT ME";
 
@@ -387,40 +775,84 @@ void Driver::GetModels(const unsigned long bound,const unsigned long num_models)
 }
 
 Theory::BigInteger Driver::CountVariable(const std::string var_name, const unsigned long bound) {
-  Theory::BigInteger projected_count, tuple_count;
-  tuple_count = GetModelCounterForVariable(var_name,false).Count(bound, bound);
-  projected_count = GetModelCounterForVariable(var_name,true).Count(bound, bound);
-
-	return (projected_count < tuple_count) ? projected_count : tuple_count;
+  Option::Options::Scope option_scope(options_);
+  Theory::BigInteger count = 0;
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(false);
+    Theory::BigInteger projected_count, tuple_count;
+    tuple_count = GetModelCounterForVariable(var_name,false).Count(bound, bound);
+    projected_count = GetModelCounterForVariable(var_name,true).Count(bound, bound);
+    count = (projected_count < tuple_count) ? projected_count : tuple_count;
+  });
+  return count;
 }
 
 Theory::BigInteger Driver::CountInts(const unsigned long bound) {
-  return GetModelCounter().CountInts(bound);
+  Option::Options::Scope option_scope(options_);
+  Theory::BigInteger count = 0;
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(true);
+    count = GetModelCounter().CountInts(bound);
+  });
+  return count;
 }
 
 Theory::BigInteger Driver::CountStrs(const unsigned long bound) {
-  return GetModelCounter().CountStrs(bound);
+  Option::Options::Scope option_scope(options_);
+  Theory::BigInteger count = 0;
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(true);
+    count = GetModelCounter().CountStrs(bound);
+  });
+  return count;
 }
 
 Theory::BigInteger Driver::Count(const unsigned long int_bound, const unsigned long str_bound) {
-  return CountInts(int_bound) * CountStrs(str_bound);
+  Option::Options::Scope option_scope(options_);
+  Theory::BigInteger count = 0;
+  RunWithinBudget([&]() {
+    count = CountInts(int_bound) * CountStrs(str_bound);
+  });
+  return count;
 }
 
 Solver::ModelCounter& Driver::GetModelCounterForVariable(const std::string var_name, bool project) {
-  auto variable = symbol_table_->get_variable(var_name);
-  auto representative_variable = symbol_table_->get_representative_variable_of_at_scope(script_, variable);
-
-//  auto it = variable_model_counter_.find(representative_variable);
-//  if (it == variable_model_counter_.end()) {
-    SetModelCounterForVariable(var_name,project);
-    auto it = variable_model_counter_.find(representative_variable);
-  //}
-  return it->second;
+  Option::Options::Scope option_scope(options_);
+  Solver::ModelCounter* model_counter = nullptr;
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(false);
+    SolveCachedQuery();
+    auto variable = symbol_table_->get_variable(var_name);
+    auto representative_variable = symbol_table_->get_representative_variable_of_at_scope(script_, variable);
+
+    //  auto it = variable_model_counter_.find(representative_variable);
+    //  if (it == variable_model_counter_.end()) {
+      SetModelCounterForVariable(var_name,project);
+      auto it = variable_model_counter_.find(representative_variable);
+    //}
+    model_counter = &it->second;
+  });
+  if (model_counter == nullptr) {
+    model_counter_ = Solver::ModelCounter();
+    return model_counter_;
+  }
+  return *model_counter;
 }
 
 Solver::ModelCounter& Driver::GetModelCounter() {
-  if (not is_model_counter_cached_) {
-    SetModelCounter();
+  Option::Options::Scope option_scope(options_);
+  bool is_done = RunWithinBudget([this]() {
+    UpdateIncrementalState(true);
+    if (not is_model_counter_cached_) {
+      SolveCachedQuery();
+      SetModelCounter();
+      if (not result_cache_key_.empty()) {
+        Solver::ResultCache::PutModelCounter(result_cache_key_, symbol_table_->isSatisfiable(), model_counter_);
+      }
+    }
+  });
+  if (not is_done) {
+    model_counter_ = Solver::ModelCounter();
   }
   return model_counter_;
 }
@@ -444,7 +876,9 @@ void Driver::SetModelCounterForVariable(const std::string var_name, bool project
   }
 
   auto& mc = variable_model_counter_[representative_variable];
+  mc.set_satisfiable(symbol_table_->isSatisfiable());
   mc.set_use_sign_integers(Option::Solver::USE_SIGNED_INTEGERS);
+  mc.set_int_bit_width(Option::Theory::INT_BIT_WIDTH);
   mc.set_count_bound_exact(Option::Solver::COUNT_BOUND_EXACT);
   if (var_value == nullptr) {
     if (SMT::Variable::Type::INT == representative_variable->getType()) {
@@ -477,7 +911,9 @@ void Driver::SetModelCounterForVariable(const std::string var_name, bool project
    * TODO add string part as well
    */
 void Driver::SetModelCounter() {
+  model_counter_.set_satisfiable(symbol_table_->isSatisfiable());
   model_counter_.set_use_sign_integers(Option::Solver::USE_SIGNED_INTEGERS);
+  model_counter_.set_int_bit_width(Option::Theory::INT_BIT_WIDTH);
   int num_bin_var = 0;
   for (const auto &variable_entry : getSatisfyingVariables()) {
     if (variable_entry.second == nullptr) {
@@ -523,6 +959,7 @@ void Driver::SetModelCounter() {
 }
 
 void Driver::inspectResult(Solver::Value_ptr value, std::string file_name) {
+  Option::Options::Scope option_scope(options_);
   std::ofstream outfile(file_name.c_str());
 
   if (!outfile.good()) {
@@ -540,6 +977,7 @@ void Driver::inspectResult(Solver::Value_ptr value, std::string file_name) {
 }
 
 void Driver::printResult(Solver::Value_ptr value, std::ostream& out) {
+  Option::Options::Scope option_scope(options_);
   switch (value->getType()) {
     case Solver::Value::Type::STRING_AUTOMATON:
       value->getStringAutomaton()->toDotAscii(false, out);
@@ -555,98 +993,152 @@ void Driver::printResult(Solver::Value_ptr value, std::ostream& out) {
   }
 }
 
-std::map<SMT::Variable_ptr, Solver::Value_ptr> Driver::getSatisfyingVariables() const {
+std::map<SMT::Variable_ptr, Solver::Value_ptr> Driver::getSatisfyingVariables() {
+  SolveCachedQuery();
   return symbol_table_->get_values_at_scope(script_);
 }
 
 std::map<std::string, std::string> Driver::getSatisfyingExamples() {
+  Option::Options::Scope option_scope(options_);
   std::map<std::string, std::string> results;
-  for (auto& variable_entry : getSatisfyingVariables()) {
-    if (Solver::Value::Type::BINARYINT_AUTOMATON == variable_entry.second->getType()) {
-      std::map<std::string, int> values = variable_entry.second->getBinaryIntAutomaton()->GetAnAcceptingIntForEachVar();
-      for (auto& entry : values) {
-        results[entry.first] = std::to_string(entry.second);
-      }
-    } else if(Solver::Value::Type::STRING_AUTOMATON == variable_entry.second->getType()) {
-    	auto string_auto = variable_entry.second->getStringAutomaton();
-    	auto string_formula = string_auto->GetFormula();
-    	for(auto it : string_formula->GetVariableCoefficientMap()) {
-    		auto single_string_auto = string_auto->GetAutomatonForVariable(it.first);
-    		results[it.first] = single_string_auto->GetAnAcceptingString();
-    		delete single_string_auto;
-    	}
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(true);
+    SolveCachedQuery();
+    for (auto& variable_entry : getSatisfyingVariables()) {
+      if (Solver::Value::Type::BINARYINT_AUTOMATON == variable_entry.second->getType()) {
+        std::map<std::string, int> values = variable_entry.second->getBinaryIntAutomaton()->GetAnAcceptingIntForEachVar();
+        for (auto& entry : values) {
+          results[entry.first] = std::to_string(entry.second);
+        }
+      } else if(Solver::Value::Type::STRING_AUTOMATON == variable_entry.second->getType()) {
+      	auto string_auto = variable_entry.second->getStringAutomaton();
+      	for(auto it : string_auto->GetAutomataForAllVariables()) {
+      		results[it.first] = it.second->GetAnAcceptingString();
+      		delete it.second;
+      	}
 
     	
-    } else {
-      results[variable_entry.first->getName()] = variable_entry.second->getASatisfyingExample();
+      } else {
+        results[variable_entry.first->getName()] = variable_entry.second->getASatisfyingExample();
+      }
     }
+  });
+  if (is_unknown_) {
+    results.clear();
   }
   return results;
 }
 
 std::map<std::string, std::string> Driver::getSatisfyingExamplesRandom() {
+  Option::Options::Scope option_scope(options_);
   std::map<std::string, std::string> results;
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(true);
+    SolveCachedQuery();
 
 
-  // check to see if we've cached automata/projected-automata for variables first
-  // otherwise get from symbol table
-  // SHOULD ONLY BE EMPTY RIGHT AFTER SOLVING, ONLY STRING AUTOMATA
-  if(not cached_values_.empty()) {
-  	for(auto it : cached_values_) {
-  		results[it.first] = cached_values_[it.first]->getStringAutomaton()->GetAnAcceptingStringRandom();
-  	}
-  } else {
-		for (auto& variable_entry : getSatisfyingVariables()) {
-			if(Solver::Value::Type::STRING_AUTOMATON == variable_entry.second->getType()) {
-				auto string_auto = variable_entry.second->getStringAutomaton();
-				auto string_formula = string_auto->GetFormula();
-				for(auto it : string_formula->GetVariableCoefficientMap()) {
-					auto single_string_auto = string_auto->GetAutomatonForVariable(it.first);
-					results[it.first] = single_string_auto->GetAnAcceptingStringRandom();
-					cached_values_[it.first] = new Solver::Value(single_string_auto);
-				}
-			}
-		}
+    // check to see if we've cached automata/projected-automata for variables first
+    // otherwise get from symbol table
+    // SHOULD ONLY BE EMPTY RIGHT AFTER SOLVING, ONLY STRING AUTOMATA
+    if(not cached_values_.empty()) {
+    	for(auto it : cached_values_) {
+    		results[it.first] = cached_values_[it.first]->getStringAutomaton()->GetAnAcceptingStringRandom();
+    	}
+    } else {
+  		for (auto& variable_entry : getSatisfyingVariables()) {
+  			if(Solver::Value::Type::STRING_AUTOMATON == variable_entry.second->getType()) {
+  				auto string_auto = variable_entry.second->getStringAutomaton();
+  				for(auto it : string_auto->GetAutomataForAllVariables()) {
+  					auto single_string_auto = it.second;
+  					results[it.first] = single_string_auto->GetAnAcceptingStringRandom();
+  					cached_values_[it.first] = new Solver::Value(single_string_auto);
+  				}
+  			}
+  		}
+    }
+  });
+  if (is_unknown_) {
+    results.clear();
   }
   return results;
 }
 
 std::map<std::string, std::string> Driver::getSatisfyingExamplesRandomBounded(const int bound) {
+  Option::Options::Scope option_scope(options_);
   std::map<std::string, std::string> results;
-
-  // check to see if we've cached automata/projected-automata for variables first
-  // otherwise get from symbol table
-  // SHOULD ONLY BE EMPTY RIGHT AFTER SOLVING, ONLY STRING AUTOMATA
-  if(not cached_bounded_values_.empty()) {
-  	for(auto it : cached_bounded_values_) {
-  		results[it.first] = cached_bounded_values_[it.first]->getStringAutomaton()->GetAnAcceptingStringRandom();
-  	}
-  } else {
-		for (auto& variable_entry : getSatisfyingVariables()) {
-			if(Solver::Value::Type::STRING_AUTOMATON == variable_entry.second->getType()) {
-				auto string_auto = variable_entry.second->getStringAutomaton();
-				auto string_formula = string_auto->GetFormula();
-				for(auto it : string_formula->GetVariableCoefficientMap()) {
-					auto single_string_auto = string_auto->GetAutomatonForVariable(it.first);
-          auto length_auto = Theory::StringAutomaton::MakeAnyStringLengthLessThanOrEqualTo(bound);
-					auto single_string_auto_bounded = single_string_auto->Intersect(length_auto);
-          delete length_auto;
-					delete single_string_auto;
-          if(single_string_auto_bounded->IsEmptyLanguage()) {
-            delete single_string_auto_bounded;
-            single_string_auto_bounded = nullptr;
-            continue;
-          }
-					results[it.first] = single_string_auto_bounded->GetAnAcceptingStringRandom();
-					cached_bounded_values_[it.first] = new Solver::Value(single_string_auto_bounded);
-				}
-			}
-		}
+  RunWithinBudget([&]() {
+    UpdateIncrementalState(true);
+    SolveCachedQuery();
+
+    // check to see if we've cached automata/projected-automata for variables first
+    // otherwise get from symbol table
+    // SHOULD ONLY BE EMPTY RIGHT AFTER SOLVING, ONLY STRING AUTOMATA
+    if(not cached_bounded_values_.empty()) {
+    	for(auto it : cached_bounded_values_) {
+    		results[it.first] = cached_bounded_values_[it.first]->getStringAutomaton()->GetAnAcceptingStringRandom();
+    	}
+    } else {
+  		for (auto& variable_entry : getSatisfyingVariables()) {
+  			if(Solver::Value::Type::STRING_AUTOMATON == variable_entry.second->getType()) {
+  				auto string_auto = variable_entry.second->getStringAutomaton();
+  				for(auto it : string_auto->GetAutomataForAllVariables()) {
+  					auto single_string_auto = it.second;
+            auto length_auto = Theory::StringAutomaton::MakeAnyStringLengthLessThanOrEqualTo(bound);
+  					auto single_string_auto_bounded = single_string_auto->Intersect(length_auto);
+            delete length_auto;
+  					delete single_string_auto;
+            if(single_string_auto_bounded->IsEmptyLanguage()) {
+              delete single_string_auto_bounded;
+              single_string_auto_bounded = nullptr;
+              continue;
+            }
+  					results[it.first] = single_string_auto_bounded->GetAnAcceptingStringRandom();
+  					cached_bounded_values_[it.first] = new Solver::Value(single_string_auto_bounded);
+  				}
+  			}
+  		}
+    }
+  });
+  if (is_unknown_) {
+    results.clear();
   }
   return results;
 }
 
 void Driver::reset() {
+  Option::Options::Scope option_scope(options_);
+  ClearIncrementalLevels();
+  ClearSolverState();
+  is_unknown_ = false;
+}
+
+bool Driver::RunWithinBudget(const std::function<void()>& query) {
+  if (is_unknown_) {
+    return false;
+  }
+  // joins the budget of an enclosing call or of the caller
+  Util::Cancellation::Scope cancellation_scope(Option::Solver::TIMEOUT, Option::Solver::MEMORY_LIMIT);
+  const bool is_nested = is_running_query_;
+  is_running_query_ = true;
+  try {
+    // the enclosing budget may already be exhausted
+    Util::Cancellation::Check();
+    query();
+  } catch (const Util::Cancelled& e) {
+    is_running_query_ = is_nested;
+    // nested calls leave it to the outermost call of the driver
+    if (is_nested) {
+      throw;
+    }
+    LOG(WARNING) << "query is cancelled: " << e.what() << ", the result is unknown until the driver is reset";
+    is_unknown_ = true;
+    return false;
+  }
+  is_running_query_ = is_nested;
+  return true;
+}
+
+void Driver::ClearSolverState() {
 	for(auto &iter : cached_values_) {
 		delete iter.second;
 		iter.second = nullptr;
@@ -659,14 +1151,38 @@ void Driver::reset() {
 	}
 	cached_bounded_values_.clear();
 
+  is_model_counter_cached_ = false;
+  model_counter_ = Solver::ModelCounter();
+  variable_model_counter_.clear();
+
+  result_cache_key_.clear();
+  is_result_cached_ = false;
+
   delete symbol_table_;
   delete script_;
+  delete constraint_information_;
   script_ = nullptr;
   symbol_table_ = nullptr;
+  constraint_information_ = nullptr;
 //  LOG(INFO) << "Driver reseted.";
 }
 
+void Driver::ClearIncrementalLevels() {
+  for (auto& level : incremental_levels_) {
+    for (auto declaration : level.declarations) {
+      delete declaration;
+    }
+    for (auto assertion : level.assertions) {
+      delete assertion;
+    }
+  }
+  incremental_levels_.clear();
+  is_incremental_state_loaded_ = false;
+  is_incremental_state_relational_ = false;
+}
+
 void Driver::set_option(const Option::Name option) {
+  Option::Options::Scope option_scope(options_);
   switch (option) {
     case Option::Name::USE_SIGNED_INTEGERS:
       Option::Solver::USE_SIGNED_INTEGERS = true;
@@ -707,30 +1223,85 @@ void Driver::set_option(const Option::Name option) {
     case Option::Name::DISABLE_SORTING_HEURISTICS:
       Option::Solver::ENABLE_SORTING_HEURISTICS = false;
       break;
+    case Option::Name::ENABLE_TIMING_REFINEMENT:
+      Option::Solver::ENABLE_TIMING_REFINEMENT = true;
+      break;
+    case Option::Name::DISABLE_TIMING_REFINEMENT:
+      Option::Solver::ENABLE_TIMING_REFINEMENT = false;
+      break;
     case Option::Name::FORCE_DNF_FORMULA:
     	Option::Solver::FORCE_DNF_FORMULA = true;
     	break;
     case Option::Name::COUNT_BOUND_EXACT:
     	Option::Solver::COUNT_BOUND_EXACT = true;
+    	Option::Theory::COUNT_BOUND_EXACT = true;
     	break;
+    case Option::Name::SAT_ONLY_MODE:
+      Option::Solver::SAT_ONLY_MODE = true;
+      break;
+    case Option::Name::ENABLE_DEFERRED_MINIMIZATION:
+      Option::Theory::DEFER_MINIMIZATION = true;
+      break;
+    case Option::Name::DISABLE_DEFERRED_MINIMIZATION:
+      Option::Theory::DEFER_MINIMIZATION = false;
+      break;
+    case Option::Name::ENABLE_NATIVE_MINIMIZATION:
+      Option::Theory::USE_NATIVE_MINIMIZATION = true;
+      break;
+    case Option::Name::DISABLE_NATIVE_MINIMIZATION:
+      Option::Theory::USE_NATIVE_MINIMIZATION = false;
+      break;
+    case Option::Name::ENABLE_DIRECT_INDEX_CONSTRUCTIONS:
+      Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = true;
+      break;
+    case Option::Name::DISABLE_DIRECT_INDEX_CONSTRUCTIONS:
+      Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = false;
+      break;
     default:
       LOG(ERROR)<< "option is not recognized: " << static_cast<int>(option);
       break;
     }
-  }
+  options_ = Option::Options();
+}
 
 void Driver::set_option(const Option::Name option, const int value) {
+  Option::Options::Scope option_scope(options_);
   switch (option) {
     case Option::Name::REGEX_FLAG:
       Util::RegularExpression::DEFAULT = value;
       break;
+    case Option::Name::INT_BIT_WIDTH:
+      CHECK_GE(value, 0) << "integer width cannot be negative";
+      Option::Theory::INT_BIT_WIDTH = value;
+      break;
+    case Option::Name::NUM_OF_THREADS:
+      CHECK_GE(value, 1) << "number of threads must be positive";
+      Option::Solver::NUM_OF_THREADS = value;
+      break;
+    case Option::Name::RESULT_CACHE_SIZE:
+      CHECK_GE(value, 0) << "result cache size cannot be negative";
+      Option::Solver::RESULT_CACHE_SIZE = value;
+      if (value > 0) {
+        Solver::ResultCache::SetSize(value);
+      }
+      break;
+    case Option::Name::TIMEOUT:
+      CHECK_GE(value, 0) << "timeout cannot be negative";
+      Option::Solver::TIMEOUT = value;
+      break;
+    case Option::Name::MEMORY_LIMIT:
+      CHECK_GE(value, 0) << "memory limit cannot be negative";
+      Option::Solver::MEMORY_LIMIT = value;
+      break;
     default:
       LOG(ERROR)<< "option is not recognized: " << static_cast<int>(option) << " -> " << value;
       break;
     }
+  options_ = Option::Options();
 }
 
 void Driver::set_option(const Option::Name option, const std::string value) {
+  Option::Options::Scope option_scope(options_);
   switch (option) {
     case Option::Name::OUTPUT_PATH:
       Option::Solver::OUTPUT_PATH = value;
@@ -740,10 +1311,22 @@ void Driver::set_option(const Option::Name option, const std::string value) {
       Option::Solver::SCRIPT_PATH = value;
       Option::Theory::SCRIPT_PATH = value;
       break;
+    case Option::Name::REGEX_CACHE_FILE:
+      Option::Theory::REGEX_CACHE_FILE = value;
+      Theory::StringAutomaton::LoadRegexCache(value);
+      break;
+    case Option::Name::RESULT_CACHE_FILE:
+      Option::Solver::RESULT_CACHE_FILE = value;
+      if (Option::Solver::RESULT_CACHE_SIZE == 0) {
+        Option::Solver::RESULT_CACHE_SIZE = Solver::ResultCache::DEFAULT_SIZE;
+      }
+      Solver::ResultCache::Load(value);
+      break;
     default:
       LOG(ERROR)<< "option is not recognized: " << static_cast<int>(option) << " -> " << value;
       break;
     }
+  options_ = Option::Options();
 }
 
 void Driver::test() {
@@ -8,14 +8,20 @@
 #ifndef SRC_DRIVER_H_
 #define SRC_DRIVER_H_
 
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -28,6 +34,8 @@
 #include "smt/ast.h"
 #include "smt/typedefs.h"
 #include "solver/Ast2Dot.h"
+#include "solver/AstTraverser.h"
+#include "solver/ConstraintFingerprint.h"
 #include "solver/ConstraintInformation.h"
 #include "solver/ConstraintSolver.h"
 #include "solver/ConstraintSorter.h"
@@ -36,8 +44,11 @@
 #include "solver/FormulaOptimizer.h"
 #include "solver/ImplicationRunner.h"
 #include "solver/Initializer.h"
+#include "solver/LengthAbstractionChecker.h"
 #include "solver/ModelCounter.h"
+#include "solver/options/Options.h"
 #include "solver/options/Solver.h"
+#include "solver/ResultCache.h"
 #include "solver/SymbolTable.h"
 #include "solver/SyntacticOptimizer.h"
 #include "solver/SyntacticProcessor.h"
@@ -50,6 +61,7 @@
 #include "theory/StringFormula.h"
 #include "theory/Formula.h"
 #include "theory/SymbolicCounter.h"
+#include "utils/Cancellation.h"
 #include "utils/Serialize.h"
 
 namespace Vlab {
@@ -73,10 +85,50 @@ public:
   void ast2dot(std::string file_name);
   void ast2dot(std::ostream* out);
 //	void collectStatistics();
+  /**
+   * Runs the solver passes on the parsed script; when the result cache is enabled and has the result of
+   * an equivalent query, stops after the syntactic passes and later calls use the cached result
+   */
   void InitializeSolver();
   void Solve();
   bool is_sat();
 
+  /**
+   * Queries are cancelled when they run out of the budget set with the TIMEOUT and MEMORY_LIMIT options;
+   * afterwards the result is unknown, is_sat is false, counts are 0 and there are no examples until reset.
+   * A query is everything from Parse, or from the first call after reset, until reset; its deadline starts
+   * with its first call and all later calls (solving, counting, examples, incremental assertions) share it.
+   * Its memory is the total size of the automata it builds. Setting either option starts a new budget.
+   */
+  bool is_unknown() const;
+
+  /**
+   * Incremental solving, assertions are kept in a stack of levels as in SMT-LIB push/pop.
+   * New assertions are solved on their own and their solutions are intersected with the per-variable
+   * solutions of the assertions below them. When that would lose a relation between variables (a group of
+   * new assertions shares a variable with earlier assertions and mentions more than one variable, or the
+   * shared variable appears in an earlier assertion with other variables) all assertions on the stack are
+   * solved again. In particular, any new assertion that mentions more than one already constrained variable
+   * costs as much as solving the whole stack from scratch; incremental solving only pays off when new
+   * assertions add single-variable constraints or constrain new variables.
+   * Queries (is_sat, Count*, GetModelCounter*, getSatisfyingExamples*) answer for all assertions on the stack.
+   */
+  void Push(const unsigned long levels = 1);
+
+  /**
+   * @param levels
+   * @return false, leaving the stack as it is, if there are not that many pushed levels
+   */
+  bool Pop(const unsigned long levels = 1);
+
+  /**
+   * Processes declarations, assertions, push, pop and check-sat commands in order
+   * @param in
+   * @return satisfiability of all assertions on the stack
+   */
+  bool AssertIncremental(std::istream* in);
+  bool AssertIncremental(const std::string constraint);
+
   void GetModels(const unsigned long bound,const unsigned long num_models);
 
   Theory::BigInteger CountVariable(const std::string var_name, const unsigned long bound);
@@ -89,7 +141,7 @@ public:
 
   void printResult(Solver::Value_ptr value, std::ostream& out);
   void inspectResult(Solver::Value_ptr value, std::string file_name);
-  std::map<SMT::Variable_ptr, Solver::Value_ptr> getSatisfyingVariables() const;
+  std::map<SMT::Variable_ptr, Solver::Value_ptr> getSatisfyingVariables();
   std::map<std::string, std::string> getSatisfyingExamples();
   std::map<std::string, std::string> getSatisfyingExamplesRandom();
   std::map<std::string, std::string> getSatisfyingExamplesRandomBounded(const int bound);
@@ -112,9 +164,56 @@ public:
   std::string file_;
 
 protected:
+  /**
+   * Assertions added at one incremental level and the solutions of all assertions up to that level
+   */
+  struct IncrementalLevel {
+    std::vector<SMT::DeclareFun_ptr> declarations;
+    std::vector<SMT::Assert_ptr> assertions;
+    /**
+     * Projected values of the constrained variables, shared with the levels above
+     */
+    std::map<std::string, std::shared_ptr<Solver::Value>> values;
+    std::set<std::string> constrained_variables;
+    /**
+     * Variables that appear in an assertion together with another variable
+     */
+    std::set<std::string> linked_variables;
+    bool is_satisfiable;
+  };
+
   void SetModelCounterForVariable(const std::string var_name, bool project = true);
   void SetModelCounter();
 
+  /**
+   * Passes that run after the constraint fingerprint is taken
+   */
+  void RunSolverPasses();
+
+  /**
+   * Solves a query whose result is taken from the result cache, for the calls that need variable values
+   */
+  void SolveCachedQuery();
+
+  void ClearSolverState();
+  void ClearIncrementalLevels();
+  void SolveIncremental(std::vector<SMT::Assert_ptr>& assertions);
+  void SolveAllIncrementalLevels();
+  void InitializeIncrementalSolver(const std::vector<SMT::Assert_ptr>& assertions);
+  void SaveIncrementalValues(const std::set<std::string>& variable_names);
+
+  /**
+   * Brings the solver state up to date with the top incremental level, after a pop it only loads the saved values
+   * @param needs_relations solves all levels again if the loaded values lose relations between variables
+   */
+  void UpdateIncrementalState(const bool needs_relations);
+
+  std::set<std::string> GetIncrementalVariableNames(SMT::Term_ptr term, const std::set<std::string>& declared_names);
+
+  std::vector<IncrementalLevel> incremental_levels_;
+  bool is_incremental_state_loaded_;
+  bool is_incremental_state_relational_;
+
   bool is_model_counter_cached_;
   Solver::ModelCounter model_counter_;
   /**
@@ -132,8 +231,45 @@ protected:
    */
   std::map<std::string, Solver::Value_ptr> cached_bounded_values_;
 
+  /**
+   * Result cache key of the query, empty when the result cache is not used
+   */
+  std::string result_cache_key_;
+  bool is_result_cached_;
+  bool cached_is_satisfiable_;
+
+  /**
+   * Runs a call of the query within the timeout and memory limit, each call gets its own budget unless it
+   * runs in the budget of an enclosing call or of the caller
+   * @param query
+   * @return false if the query is cancelled or the result is already unknown
+   */
+  bool RunWithinBudget(const std::function<void()>& query);
+  bool is_unknown_;
+
+  /**
+   * Set while a call of the query runs, cancellation is handled by the outermost call
+   */
+  bool is_running_query_;
+
+  /**
+   * Options of this driver, they are activated on the calling thread in each call
+   */
+  Option::Options options_;
+
+  /**
+   * Time spent per conjunct in the queries of this driver, orders the conjuncts of the following queries
+   */
+  Solver::ConstraintCostModel::Timings_ptr cost_model_timings_;
+
 private:
-  static bool IS_LOGGING_INITIALIZED;
+  static const int VLOG_LEVEL;
+  static std::once_flag LOGGING_INITIALIZED;
+
+  /**
+   * Automaton caches shared by all drivers are cleaned up when the last driver is deleted
+   */
+  static std::atomic<int> NUMBER_OF_INSTANCES;
 
 };
 
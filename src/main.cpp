@@ -93,10 +93,40 @@ int main(const int argc, const char **argv) {
       driver.set_option(Vlab::Option::Name::ENABLE_SORTING_HEURISTICS);
     } else if (argv[i] == std::string("--disable-sorting")) {
       driver.set_option(Vlab::Option::Name::DISABLE_SORTING_HEURISTICS);
+    } else if (argv[i] == std::string("--enable-timing-refinement")) {
+      driver.set_option(Vlab::Option::Name::ENABLE_TIMING_REFINEMENT);
+    } else if (argv[i] == std::string("--disable-timing-refinement")) {
+      driver.set_option(Vlab::Option::Name::DISABLE_TIMING_REFINEMENT);
     } else if (argv[i] == std::string("--force-dnf-formula")) {
     	driver.set_option(Vlab::Option::Name::FORCE_DNF_FORMULA);
     } else if (argv[i] == std::string("--count-bound-exact")) {
     	driver.set_option(Vlab::Option::Name::COUNT_BOUND_EXACT);
+    } else if (argv[i] == std::string("--sat-only")) {
+      driver.set_option(Vlab::Option::Name::SAT_ONLY_MODE);
+    } else if (argv[i] == std::string("--enable-deferred-minimization")) {
+      driver.set_option(Vlab::Option::Name::ENABLE_DEFERRED_MINIMIZATION);
+    } else if (argv[i] == std::string("--disable-deferred-minimization")) {
+      driver.set_option(Vlab::Option::Name::DISABLE_DEFERRED_MINIMIZATION);
+    } else if (argv[i] == std::string("--enable-native-minimization")) {
+      driver.set_option(Vlab::Option::Name::ENABLE_NATIVE_MINIMIZATION);
+    } else if (argv[i] == std::string("--disable-native-minimization")) {
+      driver.set_option(Vlab::Option::Name::DISABLE_NATIVE_MINIMIZATION);
+    } else if (argv[i] == std::string("--enable-direct-index-constructions")) {
+      driver.set_option(Vlab::Option::Name::ENABLE_DIRECT_INDEX_CONSTRUCTIONS);
+    } else if (argv[i] == std::string("--disable-direct-index-constructions")) {
+      driver.set_option(Vlab::Option::Name::DISABLE_DIRECT_INDEX_CONSTRUCTIONS);
+    } else if (argv[i] == std::string("--int-width")) {
+      driver.set_option(Vlab::Option::Name::INT_BIT_WIDTH, std::stoi(argv[i + 1]));
+      ++i;
+    } else if (argv[i] == std::string("--threads")) {
+      driver.set_option(Vlab::Option::Name::NUM_OF_THREADS, std::stoi(argv[i + 1]));
+      ++i;
+    } else if (argv[i] == std::string("--timeout")) {
+      driver.set_option(Vlab::Option::Name::TIMEOUT, std::stoi(argv[i + 1]));
+      ++i;
+    } else if (argv[i] == std::string("--memory-limit")) {
+      driver.set_option(Vlab::Option::Name::MEMORY_LIMIT, std::stoi(argv[i + 1]));
+      ++i;
     } else if (argv[i] == std::string("-bs") or argv[i] == std::string("--bound-str")) {
       std::string bounds_str {argv[i + 1]};
       str_bounds = parse_count_bounds(bounds_str);
@@ -116,6 +146,15 @@ int main(const int argc, const char **argv) {
     } else if (argv[i] == std::string("--count-variable")) {
       count_variable = argv[i + 1];
       ++i;
+    } else if (argv[i] == std::string("--regex-cache")) {
+      driver.set_option(Vlab::Option::Name::REGEX_CACHE_FILE, std::string(argv[i + 1]));
+      ++i;
+    } else if (argv[i] == std::string("--result-cache-size")) {
+      driver.set_option(Vlab::Option::Name::RESULT_CACHE_SIZE, std::stoi(argv[i + 1]));
+      ++i;
+    } else if (argv[i] == std::string("--result-cache")) {
+      driver.set_option(Vlab::Option::Name::RESULT_CACHE_FILE, std::string(argv[i + 1]));
+      ++i;
     } else if (argv[i] == std::string("--output-dir")) {
       output_root = argv[i + 1];
       ++i;
@@ -138,6 +177,7 @@ int main(const int argc, const char **argv) {
       std::cout << std::setw(col) << "-bv or --bound-var <values>" << ": model count integer bit length bound e.g., -b 10 or a set of bounds e.g., -b \"4,8,16\"" << std::endl;
       std::cout << std::setw(col) << "--count-variable <name>" << ": model counts projected variable instead of tuples e.g., --count-variable x" << std::endl;
       std::cout << std::setw(col) << "--count-bound-exact" << ": model counts solutions of length exactly equal to given bound" << std::endl;
+      std::cout << std::setw(col) << "--sat-only" << ": stops solving a disjunction at its first satisfiable disjunct, do not use with model counting" << std::endl;
       std::cout << std::setw(col) << "--use-unsigned" << ": allows only positive integers" << std::endl;
       std::cout << std::setw(col) << "--use-signed" << ": allows positive and negative integers" << std::endl;
       std::cout << std::setw(col) << "--use-multitrack" << ": uses multitrack automata for strings" << std::endl;
@@ -149,8 +189,23 @@ int main(const int argc, const char **argv) {
       std::cout << std::setw(col) << "--enable-implications" << ": enables adding implications for string constraints" << std::endl;
       std::cout << std::setw(col) << "--disable-implications" << ": disables adding implications for string constraints" << std::endl;
       std::cout << std::setw(col) << "--limit-len-implications" << ": disables length implications for word equations" << std::endl;
-      std::cout << std::setw(col) << "--enable-sorting" << ": enables sorting heuristics for string constraints" << std::endl;
+      std::cout << std::setw(col) << "--enable-sorting" << ": orders constraints by their estimated automata costs" << std::endl;
       std::cout << std::setw(col) << "--disable-sorting" << ": disables sorting heuristics for string constraints" << std::endl;
+      std::cout << std::setw(col) << "--enable-timing-refinement" << ": scales the sorting estimates with the solving times of earlier queries, the order is not reproducible" << std::endl;
+      std::cout << std::setw(col) << "--disable-timing-refinement" << ": sorts by the estimates only (default)" << std::endl;
+      std::cout << std::setw(col) << "--enable-deferred-minimization" << ": minimizes once at the end of chains of automata operations" << std::endl;
+      std::cout << std::setw(col) << "--disable-deferred-minimization" << ": minimizes after every automata operation" << std::endl;
+      std::cout << std::setw(col) << "--enable-native-minimization" << ": uses partition refinement minimizer instead of MONA's" << std::endl;
+      std::cout << std::setw(col) << "--disable-native-minimization" << ": uses MONA's minimizer" << std::endl;
+      std::cout << std::setw(col) << "--enable-direct-index-constructions" << ": builds charAt, substring and indexOf automata directly for constant arguments" << std::endl;
+      std::cout << std::setw(col) << "--disable-direct-index-constructions" << ": builds charAt, substring and indexOf automata with suffix and prefix operations" << std::endl;
+      std::cout << std::setw(col) << "--int-width <w>" << ": integers are w bit two's complement numbers, 0 (default) for unbounded" << std::endl;
+      std::cout << std::setw(col) << "--threads <n>" << ": solves independent components on n threads, 1 (default) is sequential" << std::endl;
+      std::cout << std::setw(col) << "--timeout <ms>" << ": gives up on a query once solving or counting runs for more than ms milliseconds and reports unknown, 0 (default) for no limit" << std::endl;
+      std::cout << std::setw(col) << "--memory-limit <MB>" << ": gives up on a query once the automata it keeps take more than MB megabytes and reports unknown, 0 (default) for no limit" << std::endl;
+      std::cout << std::setw(col) << "--regex-cache <path>" << ": loads compiled regex automata from the file and saves new ones back on exit" << std::endl;
+      std::cout << std::setw(col) << "--result-cache-size <n>" << ": keeps results of the last n queries, 0 (default) disables the result cache" << std::endl;
+      std::cout << std::setw(col) << "--result-cache <path>" << ": loads query results from the file and saves them back on exit, enables the result cache" << std::endl;
       std::cout << std::setw(col) << "--output-dir <dir>" << ": used for debugging outputs" << std::endl;
       std::cout << std::setw(col) << "--log-dir <dir>" << ": redirect logs from stderr to files and saves in the directory specified." << std::endl;
       std::cout << std::setw(col) << "--v <value>" << ": sets verbose logging level, unless you build ABC with configure --disable-debug" << std::endl;
@@ -203,7 +258,11 @@ int main(const int argc, const char **argv) {
   auto solving_time = end - start;
   LOG(INFO) << "Done solving";
 
-  std::cout << (driver.is_sat() ? "sat" : "unsat") << std::endl;
+  if (driver.is_unknown()) {
+    std::cout << "unknown" << std::endl;
+  } else {
+    std::cout << (driver.is_sat() ? "sat" : "unsat") << std::endl;
+  }
 
 
 
@@ -306,7 +365,7 @@ int main(const int argc, const char **argv) {
         auto count_result = driver.CountVariable(count_variable, b);
         end = std::chrono::steady_clock::now();
         auto count_time = end - start;
-        LOG(INFO) << "report bound: " << b << " count: " << count_result << " time: "
+        LOG(INFO) << "report bound: " << b << " count: " << (driver.is_unknown() ? "unknown" : count_result.str()) << " time: "
                   << std::chrono::duration<long double, std::milli>(count_time).count() << " ms";
       }
       for (auto b : str_bounds) {
@@ -314,7 +373,7 @@ int main(const int argc, const char **argv) {
         auto count_result = driver.CountVariable(count_variable, b);
         end = std::chrono::steady_clock::now();
         auto count_time = end - start;
-        LOG(INFO) << "report bound: " << b << " count: " << count_result << " time: "
+        LOG(INFO) << "report bound: " << b << " count: " << (driver.is_unknown() ? "unknown" : count_result.str()) << " time: "
                   << std::chrono::duration<long double, std::milli>(count_time).count() << " ms";
         
       }
@@ -324,7 +383,7 @@ int main(const int argc, const char **argv) {
         auto count = driver.CountInts(b);
         end = std::chrono::steady_clock::now();
         auto count_time = end - start;
-        LOG(INFO) << "report bound: " << b << " count: " << count << " time: "
+        LOG(INFO) << "report bound: " << b << " count: " << (driver.is_unknown() ? "unknown" : count.str()) << " time: "
                   << std::chrono::duration<long double, std::milli>(count_time).count() << " ms";
       }
       for (auto b : str_bounds) {
@@ -332,10 +391,12 @@ int main(const int argc, const char **argv) {
         auto count = driver.CountStrs(b);
         end = std::chrono::steady_clock::now();
         auto count_time = end - start;
-        LOG(INFO) << "report bound: " << b << " count: " << count << " time: "
+        LOG(INFO) << "report bound: " << b << " count: " << (driver.is_unknown() ? "unknown" : count.str()) << " time: "
                   << std::chrono::duration<long double, std::milli>(count_time).count() << " ms";
       }
     }
+  } else if (driver.is_unknown()) {
+    LOG(INFO) << "report is_sat: UNKNOWN time: " << std::chrono::duration <long double, std::milli> (solving_time).count() << " ms";
   } else {
     LOG(INFO) << "report is_sat: UNSAT time: " << std::chrono::duration <long double, std::milli> (solving_time).count() << " ms";
     LOG(INFO) << "report count: 0 time: 0";
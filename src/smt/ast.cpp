@@ -240,6 +240,66 @@ void CheckSatAndCount::visit_children(Visitor_ptr v) {
   v->visit(symbol);
 }
 
+Push::Push(Primitive_ptr numeral)
+    : Command(Command::Type::PUSH),
+      numeral(numeral) {
+}
+
+Push::Push(const Push& other)
+    : Command(other.type) {
+  numeral = other.numeral->clone();
+}
+
+Push_ptr Push::clone() const {
+  return new Push(*this);
+}
+
+Push::~Push() {
+  delete numeral;
+}
+
+std::string Push::str() const {
+  return "push " + numeral->getData();
+}
+
+void Push::visit_children(Visitor_ptr v) {
+  v->visit(numeral);
+}
+
+unsigned long Push::getNumberOfLevels() const {
+  return std::stoul(numeral->getData());
+}
+
+Pop::Pop(Primitive_ptr numeral)
+    : Command(Command::Type::POP),
+      numeral(numeral) {
+}
+
+Pop::Pop(const Pop& other)
+    : Command(other.type) {
+  numeral = other.numeral->clone();
+}
+
+Pop_ptr Pop::clone() const {
+  return new Pop(*this);
+}
+
+Pop::~Pop() {
+  delete numeral;
+}
+
+std::string Pop::str() const {
+  return "pop " + numeral->getData();
+}
+
+void Pop::visit_children(Visitor_ptr v) {
+  v->visit(numeral);
+}
+
+unsigned long Pop::getNumberOfLevels() const {
+  return std::stoul(numeral->getData());
+}
+
 /* ends commands */
 
 /* Terms */
@@ -164,6 +164,38 @@ class CheckSatAndCount : public Command {
   Primitive_ptr symbol;
 
 };
+
+/**
+ * ( push <numeral> )
+ */
+class Push : public Command {
+ public:
+  Push(Primitive_ptr);
+  Push(const Push&);
+  virtual Push_ptr clone() const override;
+  virtual ~Push();
+  virtual std::string str() const override;
+  virtual void visit_children(Visitor_ptr) override;
+  unsigned long getNumberOfLevels() const;
+
+  Primitive_ptr numeral;
+};
+
+/**
+ * ( pop <numeral> )
+ */
+class Pop : public Command {
+ public:
+  Pop(Primitive_ptr);
+  Pop(const Pop&);
+  virtual Pop_ptr clone() const override;
+  virtual ~Pop();
+  virtual std::string str() const override;
+  virtual void visit_children(Visitor_ptr) override;
+  unsigned long getNumberOfLevels() const;
+
+  Primitive_ptr numeral;
+};
 /* ends commands */
 
 /* start terms */
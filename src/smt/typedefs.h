@@ -23,6 +23,8 @@ class DeclareFun;
 class Assert;
 class CheckSat;
 class CheckSatAndCount;
+class Push;
+class Pop;
 class Term;
 class Exclamation;
 class Exists;
@@ -101,6 +103,8 @@ using SetLogic_ptr = SetLogic*;
 using DeclareFun_ptr = DeclareFun*;
 using Assert_ptr = Assert*;
 using CheckSat_ptr = CheckSat*;
+using Push_ptr = Push*;
+using Pop_ptr = Pop*;
 using Term_ptr = Term*;
 using TermList = std::vector<Term_ptr>;
 using TermList_ptr = TermList*;
@@ -159,15 +159,28 @@ void ArithmeticConstraintSolver::visitAnd(And_ptr and_term) {
 		}
 	}
 
+	// Do not visit child or terms here, handle them in POSTVISIT AND
+	TermList arithmetic_terms;
 	for (auto term : *(and_term->term_list)) {
-		auto formula = arithmetic_formula_generator_.get_term_formula(term);
-		// Do not visit child or terms here, handle them in POSTVISIT AND
-		if (formula != nullptr and (dynamic_cast<Or_ptr>(term) == nullptr)) {
-			has_arithmetic_formula = true;
-			visit(term);
-			auto param = get_term_value(term);
-			is_satisfiable = param->is_satisfiable();
-			if (is_satisfiable) {
+		if (arithmetic_formula_generator_.get_term_formula(term) != nullptr and (dynamic_cast<Or_ptr>(term) == nullptr)) {
+			arithmetic_terms.push_back(term);
+		}
+	}
+
+	const bool collect_statistics = VLOG_IS_ON(VLOG_LEVEL);
+	std::map<std::string, GroupStatistics> group_statistics;
+	for (auto term : order_conjuncts(arithmetic_terms)) {
+		has_arithmetic_formula = true;
+		visit(term);
+		auto param = get_term_value(term);
+		is_satisfiable = param->is_satisfiable();
+		if (collect_statistics and Value::Type::BINARYINT_AUTOMATON == param->getType()) {
+			auto& statistics = group_statistics[arithmetic_formula_generator_.get_term_group_name(term)];
+			++statistics.conjuncts;
+			statistics.conjunct_states += param->getBinaryIntAutomaton()->GetNumberOfStates();
+			statistics.conjunct_bdd_nodes += param->getBinaryIntAutomaton()->GetNumberOfBddNodes();
+		}
+		if (is_satisfiable) {
 //        if (and_value == nullptr) {
 //          and_value = param->clone();
 //        } else {
@@ -176,19 +189,33 @@ void ArithmeticConstraintSolver::visitAnd(And_ptr and_term) {
 //          delete old_value;
 //          is_satisfiable = and_value->is_satisfiable();
 //        }
-				auto term_group_name = arithmetic_formula_generator_.get_term_group_name(term);
-				if(term_group_name.empty()) {
-					LOG(FATAL) << "Term has no group!";
-				}
-				//LOG(INFO) << "------------ " << *term << " has group name " << term_group_name;
-				symbol_table_->IntersectValue(term_group_name,param);
-				is_satisfiable = symbol_table_->get_value(term_group_name)->is_satisfiable();
+			auto term_group_name = arithmetic_formula_generator_.get_term_group_name(term);
+			if(term_group_name.empty()) {
+				LOG(FATAL) << "Term has no group!";
 			}
-			clear_term_value(term);
-			if (not is_satisfiable) {
-				break;
+			//LOG(INFO) << "------------ " << *term << " has group name " << term_group_name;
+			symbol_table_->IntersectValue(term_group_name,param);
+			auto group_value = symbol_table_->get_value(term_group_name);
+			is_satisfiable = group_value->is_satisfiable();
+			if (collect_statistics and Value::Type::BINARYINT_AUTOMATON == group_value->getType()) {
+				auto& statistics = group_statistics[term_group_name];
+				statistics.result_states = group_value->getBinaryIntAutomaton()->GetNumberOfStates();
+				statistics.result_bdd_nodes = group_value->getBinaryIntAutomaton()->GetNumberOfBddNodes();
+				statistics.peak_states = std::max(statistics.peak_states, statistics.result_states);
+				statistics.peak_bdd_nodes = std::max(statistics.peak_bdd_nodes, statistics.result_bdd_nodes);
 			}
 		}
+		clear_term_value(term);
+		if (not is_satisfiable) {
+			break;
+		}
+	}
+
+	for (auto& el : group_statistics) {
+		DVLOG(VLOG_LEVEL) << "group " << el.first << ": " << el.second.conjuncts << " conjuncts with "
+				<< el.second.conjunct_states << " states, " << el.second.conjunct_bdd_nodes << " bdd nodes; peak "
+				<< el.second.peak_states << " states, " << el.second.peak_bdd_nodes << " bdd nodes; result "
+				<< el.second.result_states << " states, " << el.second.result_bdd_nodes << " bdd nodes";
 	}
 
   DVLOG(VLOG_LEVEL) << "visit children of component end: " << *and_term << "@" << and_term;
@@ -227,6 +254,74 @@ void ArithmeticConstraintSolver::visitAnd(And_ptr and_term) {
   DVLOG(VLOG_LEVEL) << "post visit component end: " << *and_term << "@" << and_term;
 }
 
+TermList ArithmeticConstraintSolver::order_conjuncts(const TermList& terms) {
+  // conjuncts of different groups are independent, bucket them by group in order of appearance
+  std::vector<std::string> group_names;
+  std::map<std::string, TermList> group_terms;
+  for (auto term : terms) {
+    auto group_name = arithmetic_formula_generator_.get_term_group_name(term);
+    if (group_terms.find(group_name) == group_terms.end()) {
+      group_names.push_back(group_name);
+    }
+    group_terms[group_name].push_back(term);
+  }
+
+  TermList ordered_terms;
+  for (auto& group_name : group_names) {
+    auto& candidates = group_terms[group_name];
+    std::vector<int> costs;
+    std::vector<std::set<std::string>> variables;
+    for (auto term : candidates) {
+      auto formula = arithmetic_formula_generator_.get_term_formula(term);
+      costs.push_back(get_formula_cost(formula));
+      std::set<std::string> term_variables;
+      for (auto& el : formula->GetVariableCoefficientMap()) {
+        if (el.second != 0) {
+          term_variables.insert(el.first);
+        }
+      }
+      variables.push_back(term_variables);
+    }
+
+    std::vector<bool> is_selected(candidates.size(), false);
+    std::set<std::string> constrained_variables;
+    for (std::size_t n = 0; n < candidates.size(); ++n) {
+      int best = -1, best_shared = -1;
+      for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (is_selected[i]) {
+          continue;
+        }
+        int shared = 0;
+        for (auto& var_name : variables[i]) {
+          shared += constrained_variables.count(var_name);
+        }
+        if (best == -1 or shared > best_shared or (shared == best_shared and costs[i] < costs[best])) {
+          best = i;
+          best_shared = shared;
+        }
+      }
+      is_selected[best] = true;
+      constrained_variables.insert(variables[best].begin(), variables[best].end());
+      ordered_terms.push_back(candidates[best]);
+    }
+  }
+  return ordered_terms;
+}
+
+int ArithmeticConstraintSolver::get_formula_cost(ArithmeticFormula_ptr formula) {
+  int cost = std::abs(formula->GetConstant());
+  for (int coeff : formula->GetCoefficients()) {
+    cost += std::abs(coeff);
+  }
+  // equalities reject on the first mismatching bit and have half of the carry states of inequalities
+  switch (formula->GetType()) {
+    case ArithmeticFormula::Type::EQ:
+      return cost;
+    default:
+      return 2 * cost;
+  }
+}
+
 /**
  * 1) Update group value at each scope
  * 2) Update result (union of scopes) after all
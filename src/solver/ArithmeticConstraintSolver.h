@@ -8,10 +8,14 @@
 #ifndef SOLVER_ARITHMETICCONSTRAINTSOLVER_H_
 #define SOLVER_ARITHMETICCONSTRAINTSOLVER_H_
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -60,8 +64,34 @@ class ArithmeticConstraintSolver : public AstTraverser {
   std::map<SMT::Term_ptr, SMT::TermList>& get_string_terms_map();
 
  protected:
+  /**
+   * Sizes of the automata seen while intersecting the conjuncts of a variable group
+   */
+  struct GroupStatistics {
+    int conjuncts = 0;
+    int conjunct_states = 0, conjunct_bdd_nodes = 0;
+    int peak_states = 0, peak_bdd_nodes = 0;
+    int result_states = 0, result_bdd_nodes = 0;
+  };
+
   void visitOr(SMT::Or_ptr);
 
+  /**
+   * Orders the arithmetic conjuncts of a component for intersection.
+   * Conjuncts of the same variable group are kept together, each group starts with its cheapest formula and
+   * continues with the conjunct that shares most variables with the ones already intersected.
+   * @param terms conjuncts that have arithmetic formulas
+   * @return
+   */
+  SMT::TermList order_conjuncts(const SMT::TermList& terms);
+
+  /**
+   * Estimates the size of the automaton of a formula from its carry range
+   * @param formula
+   * @return
+   */
+  static int get_formula_cost(Theory::ArithmeticFormula_ptr formula);
+
   bool use_unsigned_integers_;
   SymbolTable_ptr symbol_table_;
   ConstraintInformation_ptr constraint_information_;
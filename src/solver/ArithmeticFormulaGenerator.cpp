@@ -843,6 +843,7 @@ void ArithmeticFormulaGenerator::set_group_mappings() {
 		}
 		//LOG(INFO) << "";
 	}
+	order_group_variables();
 
 	for (auto& el: subgroups_) {
 		symbol_table_->add_variable(new Variable(el.first, Variable::Type::NONE));
@@ -867,5 +868,35 @@ void ArithmeticFormulaGenerator::set_group_mappings() {
   DVLOG(VLOG_LEVEL)<< "end setting int group for components";
 }
 
+/**
+ * Searches a bdd variable order for each group from the atomic formulas of the group, all formulas of a group
+ * must have the same order since their automata are intersected.
+ */
+void ArithmeticFormulaGenerator::order_group_variables() {
+  std::map<std::string, std::vector<ArithmeticFormula_ptr>> group_term_formulas;
+  for (auto& el : term_group_map_) {
+    auto formula = get_term_formula(el.first);
+    if (formula != nullptr and group_formula_.find(el.second) != group_formula_.end()) {
+      group_term_formulas[el.second].push_back(formula);
+    }
+  }
+
+  for (auto& el : group_formula_) {
+    auto& formulas = group_term_formulas[el.first];
+    auto variables = el.second->GetVariableOrder();
+    auto variable_order = VariableOrder::Find(formulas, variables);
+    if (variable_order == variables) {
+      continue;
+    }
+    DVLOG(VLOG_LEVEL) << "group " << el.first << ": estimated bdd width "
+        << VariableOrder::EstimateBddWidth(formulas, variables) << " in name order, "
+        << VariableOrder::EstimateBddWidth(formulas, variable_order) << " in searched order";
+    el.second->SetVariableOrder(variable_order);
+    for (auto formula : formulas) {
+      formula->SetVariableOrder(variable_order);
+    }
+  }
+}
+
 } /* namespace Solver */
 } /* namespace Vlab */
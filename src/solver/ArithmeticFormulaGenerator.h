@@ -23,6 +23,7 @@
 #include "../smt/typedefs.h"
 #include "../smt/Visitor.h"
 #include "../theory/ArithmeticFormula.h"
+#include "../theory/VariableOrder.h"
 #include "ConstraintInformation.h"
 #include "options/Solver.h"
 #include "SymbolTable.h"
@@ -125,6 +126,7 @@ protected:
   bool set_term_formula(SMT::Term_ptr term, Theory::ArithmeticFormula_ptr formula);
   void delete_term_formula(SMT::Term_ptr);
   void set_group_mappings();
+  void order_group_variables();
 
   SMT::Script_ptr root_;
   SymbolTable_ptr symbol_table_;
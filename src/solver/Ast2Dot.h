@@ -8,6 +8,7 @@
 #ifndef SOLVER_AST2DOT_H_
 #define SOLVER_AST2DOT_H_
 
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -111,7 +112,7 @@ private:
   std::ostream* m_out; //file for writting output
   u_int64_t count; //used to give each node a uniq id
   std::stack<u_int64_t> s; //stack for tracking parent/child pairs
-  static int name_counter;
+  static std::atomic<int> name_counter;
 
 };
 
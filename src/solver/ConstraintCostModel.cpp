@@ -0,0 +1,415 @@
+/*
+ * ConstraintCostModel.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ConstraintCostModel.h"
+
+namespace Vlab {
+namespace Solver {
+
+using namespace SMT;
+
+const int ConstraintCostModel::VLOG_LEVEL = 20;
+const double ConstraintCostModel::MAX_COST = 1e15;
+const double ConstraintCostModel::TRACK_FACTOR = 4;
+
+ConstraintCostModel::ConstraintCostModel(Script_ptr script, SymbolTable_ptr symbol_table, Timings_ptr timings)
+    : AstTraverser(script),
+      symbol_table_(symbol_table),
+      use_timings_ { timings != nullptr and Option::Solver::ENABLE_TIMING_REFINEMENT },
+      timings_(timings) {
+  setCallbacks();
+}
+
+ConstraintCostModel::~ConstraintCostModel() {
+}
+
+void ConstraintCostModel::start() {
+  DVLOG(VLOG_LEVEL) << "Starting the Constraint Cost Model";
+  for (auto command : *(root_->command_list)) {
+    if (Command::Type::ASSERT == command->getType()) {
+      Estimate(dynamic_cast<Assert_ptr>(command)->term);
+    }
+  }
+  end();
+}
+
+void ConstraintCostModel::end() {
+}
+
+void ConstraintCostModel::setCallbacks() {
+  auto term_pre_callback = [this](Term_ptr term) -> bool {
+    switch (term->type()) {
+      case Term::Type::QUALIDENTIFIER:
+      case Term::Type::TERMCONSTANT:
+        return false;
+      default:
+        children_stack_.push_back(std::vector<Cost>());
+        return true;
+    }
+  };
+
+  auto term_post_callback = [this](Term_ptr term) -> bool {
+    Cost cost { 1, 0, 1, { }, { } };
+    switch (term->type()) {
+      case Term::Type::QUALIDENTIFIER: {
+        auto name = dynamic_cast<QualIdentifier_ptr>(term)->getVarName();
+        auto variable = symbol_table_->get_variable_unsafe(name);
+        auto it = variable_states_.find(name);
+        if (it != variable_states_.end()) {
+          cost.states = it->second;
+        }
+        if (variable != nullptr and Variable::Type::STRING == variable->getType()) {
+          cost.string_variables.insert(name);
+        } else if (variable != nullptr and Variable::Type::INT == variable->getType()) {
+          cost.int_variables.insert(name);
+        }
+        break;
+      }
+      case Term::Type::TERMCONSTANT: {
+        auto term_constant = dynamic_cast<TermConstant_ptr>(term);
+        auto value = term_constant->getValue();
+        switch (term_constant->getValueType()) {
+          case Primitive::Type::STRING:
+            cost.states = value.length() + 2;
+            cost.selectivity = 0;
+            break;
+          case Primitive::Type::REGEX: {
+            Util::RegularExpression regular_expression(value);
+            cost.states = GetRegexSize(&regular_expression);
+            if (Util::RegularExpression::Type::ANYSTRING == regular_expression.type()) {
+              cost.selectivity = 1;
+            } else {
+              cost.selectivity = IsFinite(&regular_expression) ? 0.1 : 0.5;
+            }
+            break;
+          }
+          case Primitive::Type::NUMERAL:
+            cost.states = value.length() * std::log2(10) + 2;
+            cost.selectivity = 0;
+            break;
+          case Primitive::Type::BOOL:
+            cost.selectivity = ("false" == value) ? 0 : 1;
+            break;
+          default:
+            break;
+        }
+        break;
+      }
+      default: {
+        auto children = children_stack_.back();
+        children_stack_.pop_back();
+        cost = MakeCost(term, children);
+        break;
+      }
+    }
+    children_stack_.back().push_back(cost);
+    return false;
+  };
+
+  setTermPreCallback(term_pre_callback);
+  setTermPostCallback(term_post_callback);
+}
+
+ConstraintCostModel::Cost ConstraintCostModel::Estimate(Term_ptr term) {
+  children_stack_.clear();
+  children_stack_.push_back(std::vector<Cost>());
+  visit(term);
+  Cost cost = children_stack_.back().empty() ? Cost { 1, 1, 1, { }, { } } : children_stack_.back().front();
+  children_stack_.clear();
+  DVLOG(VLOG_LEVEL) << "cost of " << *term << "@" << term << ": states " << cost.states << ", construction "
+                    << cost.construction << ", selectivity " << cost.selectivity;
+  return cost;
+}
+
+/**
+ * Construction cost weighted by selectivity; restrictive constraints shrink the automata of the following ones,
+ * a constant is added to still prefer cheaper ones among unrestrictive constraints
+ */
+double ConstraintCostModel::GetScore(Term_ptr term) {
+  return GetScore(Estimate(term));
+}
+
+double ConstraintCostModel::GetScore(const Cost& cost) {
+  return Cap(cost.construction * (0.1 + cost.selectivity) + cost.states * cost.selectivity);
+}
+
+std::set<std::string> ConstraintCostModel::Restrict(Term_ptr term) {
+  return Restrict(Estimate(term));
+}
+
+std::set<std::string> ConstraintCostModel::Restrict(const Cost& cost) {
+  std::set<std::string> restricted_variables;
+  for (auto& names : { cost.string_variables, cost.int_variables }) {
+    for (auto& name : names) {
+      auto it = variable_states_.find(name);
+      if (it == variable_states_.end() or it->second > cost.states) {
+        variable_states_[name] = cost.states;
+        restricted_variables.insert(name);
+      }
+    }
+  }
+  return restricted_variables;
+}
+
+void ConstraintCostModel::RecordTiming(Term_ptr term, const double milliseconds) {
+  if (not use_timings_) {
+    return;
+  }
+  auto it = recorded_costs_.find(term);
+  if (it == recorded_costs_.end()) {
+    // recorded timings are compared with the estimates they have not scaled yet
+    use_timings_ = false;
+    it = recorded_costs_.insert(std::make_pair(term, Estimate(term).construction)).first;
+    use_timings_ = true;
+  }
+  const double construction = it->second;
+  if (construction <= 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(timings_->mutex);
+  auto& timing = timings_->by_type[term->type()];
+  timing.first += milliseconds;
+  timing.second += construction;
+  timings_->total.first += milliseconds;
+  timings_->total.second += construction;
+}
+
+ConstraintCostModel::Timings_ptr ConstraintCostModel::get_timings() const {
+  return timings_;
+}
+
+/**
+ * Number of states of a Thompson style automaton, repetitions are unrolled and complements are determinized
+ */
+double ConstraintCostModel::GetRegexSize(Util::RegularExpression_ptr regular_expression) {
+  switch (regular_expression->type()) {
+    case Util::RegularExpression::Type::UNION:
+    case Util::RegularExpression::Type::CONCATENATION:
+      return Cap(GetRegexSize(regular_expression->get_expr1()) + GetRegexSize(regular_expression->get_expr2()));
+    case Util::RegularExpression::Type::INTERSECTION:
+      return Cap(GetRegexSize(regular_expression->get_expr1()) * GetRegexSize(regular_expression->get_expr2()));
+    case Util::RegularExpression::Type::OPTIONAL:
+    case Util::RegularExpression::Type::REPEAT_STAR:
+    case Util::RegularExpression::Type::REPEAT_PLUS:
+      return Cap(GetRegexSize(regular_expression->get_expr1()) + 1);
+    case Util::RegularExpression::Type::REPEAT_MIN:
+      return Cap(GetRegexSize(regular_expression->get_expr1()) * (regular_expression->get_min() + 1));
+    case Util::RegularExpression::Type::REPEAT_MINMAX:
+      return Cap(GetRegexSize(regular_expression->get_expr1()) * (regular_expression->get_max() + 1));
+    case Util::RegularExpression::Type::COMPLEMENT:
+      return Cap(std::pow(2, std::min(GetRegexSize(regular_expression->get_expr1()), 50.0)));
+    case Util::RegularExpression::Type::STRING:
+      return regular_expression->get_string().length() + 1;
+    case Util::RegularExpression::Type::INTERVAL:
+      return Cap(10 * std::to_string(regular_expression->get_max()).length());
+    default:
+      return 2;
+  }
+}
+
+bool ConstraintCostModel::IsFinite(Util::RegularExpression_ptr regular_expression) {
+  switch (regular_expression->type()) {
+    case Util::RegularExpression::Type::UNION:
+    case Util::RegularExpression::Type::CONCATENATION:
+      return IsFinite(regular_expression->get_expr1()) and IsFinite(regular_expression->get_expr2());
+    case Util::RegularExpression::Type::INTERSECTION:
+      return IsFinite(regular_expression->get_expr1()) or IsFinite(regular_expression->get_expr2());
+    case Util::RegularExpression::Type::OPTIONAL:
+    case Util::RegularExpression::Type::REPEAT_MINMAX:
+      return IsFinite(regular_expression->get_expr1());
+    case Util::RegularExpression::Type::REPEAT_STAR:
+    case Util::RegularExpression::Type::REPEAT_PLUS:
+    case Util::RegularExpression::Type::REPEAT_MIN:
+    case Util::RegularExpression::Type::COMPLEMENT:
+    case Util::RegularExpression::Type::ANYSTRING:
+    case Util::RegularExpression::Type::AUTOMATON:
+      return false;
+    default:
+      return true;
+  }
+}
+
+/**
+ * Ratio of the time spent per estimated unit for the operation to the time spent per estimated unit overall
+ */
+double ConstraintCostModel::GetTimingFactor(Term::Type type) {
+  std::lock_guard<std::mutex> lock(timings_->mutex);
+  auto it = timings_->by_type.find(type);
+  if (it == timings_->by_type.end() or it->second.second <= 0 or timings_->total.first <= 0) {
+    return 1;
+  }
+  double factor = (it->second.first / it->second.second) / (timings_->total.first / timings_->total.second);
+  return std::max(0.01, std::min(factor, 100.0));
+}
+
+double ConstraintCostModel::Cap(const double value) {
+  return std::min(value, MAX_COST);
+}
+
+/**
+ * Combines the estimates of the operands; 'operation' is the cost of the operation itself.
+ * Relational string constraints get one track per string variable with multi-track automata,
+ * each track multiplies the alphabet and roughly the number of states.
+ */
+ConstraintCostModel::Cost ConstraintCostModel::MakeCost(Term_ptr term, std::vector<Cost>& children) {
+  Cost cost { 1, 0, 1, { }, { } };
+  double sum_states = 0, product_states = 1, min_states = children.empty() ? 1 : MAX_COST;
+  double min_selectivity = 1, max_selectivity = children.empty() ? 1 : 0, product_selectivity = 1, sum_selectivity = 0;
+  double children_construction = 0;
+  for (auto& child : children) {
+    cost.string_variables.insert(child.string_variables.begin(), child.string_variables.end());
+    cost.int_variables.insert(child.int_variables.begin(), child.int_variables.end());
+    sum_states += child.states;
+    product_states = Cap(product_states * child.states);
+    min_states = std::min(min_states, child.states);
+    min_selectivity = std::min(min_selectivity, child.selectivity);
+    max_selectivity = std::max(max_selectivity, child.selectivity);
+    product_selectivity *= child.selectivity;
+    sum_selectivity += child.selectivity;
+    children_construction += child.construction;
+  }
+
+  double operation = 0;
+  bool is_relational = false;
+  switch (term->type()) {
+    case Term::Type::AND:
+      cost.states = min_states;
+      cost.selectivity = product_selectivity;
+      operation = sum_states;
+      break;
+    case Term::Type::OR:
+      cost.states = sum_states;
+      cost.selectivity = std::min(1.0, sum_selectivity);
+      operation = sum_states;
+      break;
+    case Term::Type::NOT:
+      cost.states = sum_states;
+      cost.selectivity = 1 - min_selectivity * 0.9;
+      operation = sum_states * 4;
+      break;
+    case Term::Type::EQ:
+    case Term::Type::IN:
+      cost.states = min_states;
+      cost.selectivity = std::min(min_selectivity, 0.5);
+      operation = product_states;
+      is_relational = true;
+      break;
+    case Term::Type::NOTEQ:
+    case Term::Type::NOTIN:
+      cost.states = product_states;
+      cost.selectivity = 0.9;
+      operation = product_states * 2;
+      is_relational = true;
+      break;
+    case Term::Type::BEGINS:
+    case Term::Type::ENDS:
+      cost.states = sum_states;
+      cost.selectivity = 0.3;
+      operation = product_states * 2;
+      is_relational = true;
+      break;
+    case Term::Type::CONTAINS:
+      cost.states = sum_states;
+      cost.selectivity = 0.5;
+      operation = product_states * 4;
+      is_relational = true;
+      break;
+    case Term::Type::NOTBEGINS:
+    case Term::Type::NOTENDS:
+      cost.states = product_states;
+      cost.selectivity = 0.9;
+      operation = product_states * 4;
+      is_relational = true;
+      break;
+    case Term::Type::NOTCONTAINS:
+      cost.states = product_states;
+      cost.selectivity = 0.9;
+      operation = product_states * 8;
+      is_relational = true;
+      break;
+    case Term::Type::GT:
+    case Term::Type::GE:
+    case Term::Type::LT:
+    case Term::Type::LE:
+      cost.states = sum_states;
+      cost.selectivity = 0.5;
+      operation = sum_states;
+      is_relational = true;
+      break;
+    case Term::Type::UMINUS:
+    case Term::Type::MINUS:
+    case Term::Type::PLUS:
+    case Term::Type::TIMES:
+    case Term::Type::DIV:
+    case Term::Type::CONCAT:
+      cost.states = sum_states;
+      cost.selectivity = max_selectivity;
+      operation = sum_states;
+      break;
+    case Term::Type::LEN:
+    case Term::Type::CHARAT:
+      cost.states = sum_states;
+      cost.selectivity = max_selectivity;
+      operation = sum_states * 4;
+      break;
+    case Term::Type::TOUPPER:
+    case Term::Type::TOLOWER:
+    case Term::Type::TRIM:
+      cost.states = sum_states;
+      cost.selectivity = max_selectivity;
+      operation = sum_states * 2;
+      break;
+    case Term::Type::INDEXOF:
+    case Term::Type::LASTINDEXOF:
+    case Term::Type::SUBSTRING:
+    case Term::Type::COUNT:
+      cost.states = product_states;
+      cost.selectivity = max_selectivity;
+      operation = product_states * 8;
+      break;
+    case Term::Type::REPLACE:
+      cost.states = product_states;
+      cost.selectivity = max_selectivity;
+      operation = product_states * 16;
+      break;
+    case Term::Type::TOSTRING:
+    case Term::Type::TOINT:
+      cost.states = sum_states;
+      cost.selectivity = max_selectivity;
+      operation = sum_states * 32;
+      break;
+    default:
+      cost.states = product_states;
+      cost.selectivity = max_selectivity;
+      operation = product_states * 8;
+      break;
+  }
+
+  if (is_relational and Option::Solver::USE_MULTITRACK_AUTO and cost.string_variables.size() > 1) {
+    const double track_factor = std::pow(TRACK_FACTOR, cost.string_variables.size() - 1);
+    cost.states = Cap(cost.states * track_factor);
+    operation *= track_factor;
+  }
+  if (is_relational and cost.int_variables.size() > 1) {
+    operation *= cost.int_variables.size();
+  }
+
+  if (use_timings_) {
+    operation *= GetTimingFactor(term->type());
+  }
+  cost.states = Cap(cost.states);
+  cost.construction = Cap(children_construction + operation);
+  cost.selectivity = std::max(0.0, std::min(cost.selectivity, 1.0));
+  return cost;
+}
+
+} /* namespace Solver */
+} /* namespace Vlab */
@@ -0,0 +1,139 @@
+/*
+ * ConstraintCostModel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_CONSTRAINTCOSTMODEL_H_
+#define SOLVER_CONSTRAINTCOSTMODEL_H_
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "../smt/ast.h"
+#include "../smt/typedefs.h"
+#include "../utils/RegularExpression.h"
+#include "AstTraverser.h"
+#include "options/Solver.h"
+#include "SymbolTable.h"
+
+namespace Vlab {
+namespace Solver {
+
+/**
+ * Estimates the size of the automaton of a term and the cost of constructing it, from the sizes of
+ * regular expressions and constants, the number of tracks of relational constraints and the operations.
+ * Estimates are relative; with timing refinement on, construction costs of each operation are scaled with
+ * the timings recorded while solving, see RecordTiming. Timings are kept by the driver and shared by the
+ * models of its passes.
+ */
+class ConstraintCostModel : public AstTraverser {
+public:
+  struct Cost {
+    /**
+     * Estimated number of states of the resulting automaton
+     */
+    double states;
+    /**
+     * Estimated construction cost, relative units
+     */
+    double construction;
+    /**
+     * Estimated fraction of the values of the variables that satisfy the term, lower is more restrictive
+     */
+    double selectivity;
+    std::set<std::string> string_variables;
+    std::set<std::string> int_variables;
+  };
+
+  /**
+   * Sums of the recorded milliseconds and of the estimated construction costs, per operation and overall;
+   * solvers of parallel components record into the same timings
+   */
+  struct Timings {
+    std::map<SMT::Term::Type, std::pair<double, double>> by_type;
+    std::pair<double, double> total { 0, 0 };
+    std::mutex mutex;
+  };
+  using Timings_ptr = std::shared_ptr<Timings>;
+
+  /**
+   * @param timings scale the construction costs and collect the recorded ones when timing refinement is on,
+   * nullptr to use the estimates only
+   */
+  ConstraintCostModel(SMT::Script_ptr, SymbolTable_ptr, Timings_ptr timings = nullptr);
+  virtual ~ConstraintCostModel();
+
+  void start() override;
+  void end() override;
+  void setCallbacks();
+
+  Cost Estimate(SMT::Term_ptr term);
+
+  /**
+   * Ranks a term, the ones with lower scores should be solved first
+   */
+  double GetScore(SMT::Term_ptr term);
+
+  /**
+   * Bounds the sizes of the variables of a term by its estimated automaton size for the following estimates;
+   * called for a conjunct once it is ordered, the remaining conjuncts are intersected with smaller automata
+   * @return variables whose bounds are lowered, only the estimates of terms with them change
+   */
+  std::set<std::string> Restrict(SMT::Term_ptr term);
+  std::set<std::string> Restrict(const Cost& cost);
+
+  /**
+   * Score of an estimate, see GetScore
+   */
+  static double GetScore(const Cost& cost);
+
+  /**
+   * Refines the construction cost of the operation of the term with the time spent to solve it, including the
+   * time spent for its subterms; does nothing without timings or if timing refinement is off
+   */
+  void RecordTiming(SMT::Term_ptr term, const double milliseconds);
+
+  Timings_ptr get_timings() const;
+
+protected:
+  static double GetRegexSize(Util::RegularExpression_ptr regular_expression);
+  static bool IsFinite(Util::RegularExpression_ptr regular_expression);
+  double GetTimingFactor(SMT::Term::Type type);
+  static double Cap(const double value);
+
+  Cost MakeCost(SMT::Term_ptr term, std::vector<Cost>& children);
+
+  SymbolTable_ptr symbol_table_;
+  std::vector<std::vector<Cost>> children_stack_;
+  std::map<std::string, double> variable_states_;
+  bool use_timings_;
+  Timings_ptr timings_;
+
+  /**
+   * Construction costs of the recorded terms without the timings, a conjunct solved again is not estimated again
+   */
+  std::map<SMT::Term_ptr, double> recorded_costs_;
+
+private:
+  static const double MAX_COST;
+  static const double TRACK_FACTOR;
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_CONSTRAINTCOSTMODEL_H_ */
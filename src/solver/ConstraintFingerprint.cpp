@@ -0,0 +1,203 @@
+/*
+ * ConstraintFingerprint.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ConstraintFingerprint.h"
+
+namespace Vlab {
+namespace Solver {
+
+using namespace SMT;
+
+const int ConstraintFingerprint::VLOG_LEVEL = 20;
+
+ConstraintFingerprint::ConstraintFingerprint(Script_ptr script, SymbolTable_ptr symbol_table)
+    : AstTraverser(script),
+      symbol_table_(symbol_table),
+      is_normalizable_ { true } {
+  setCallbacks();
+}
+
+ConstraintFingerprint::~ConstraintFingerprint() {
+}
+
+void ConstraintFingerprint::start() {
+  DVLOG(VLOG_LEVEL) << "Starting the Constraint Fingerprint";
+  is_normalizable_ = true;
+  fingerprint_.clear();
+  children_stack_.clear();
+  children_stack_.push_back(std::vector<Node>());
+  visitScript(root_);
+  end();
+}
+
+/**
+ * Assertions are a conjunction, they are sorted as the operands of an 'and'.
+ * Each variable is replaced with the position of its first appearance; numbers of declared variables are
+ * appended since unconstrained variables change the model count.
+ */
+void ConstraintFingerprint::end() {
+  if (not is_normalizable_) {
+    DVLOG(VLOG_LEVEL) << "script cannot be normalized";
+    children_stack_.clear();
+    return;
+  }
+
+  auto root = MakeNode("assert", children_stack_.back(), true);
+  children_stack_.clear();
+
+  std::map<std::string, int> variable_indices;
+  std::stringstream ss;
+  ss << root.shape << "|";
+  for (auto& name : root.variables) {
+    auto it = variable_indices.find(name);
+    if (it == variable_indices.end()) {
+      it = variable_indices.insert(std::make_pair(name, variable_indices.size())).first;
+    }
+    ss << it->second << ",";
+  }
+  ss << "|" << symbol_table_->get_num_of_variables(Variable::Type::BOOL)
+     << "," << symbol_table_->get_num_of_variables(Variable::Type::INT)
+     << "," << symbol_table_->get_num_of_variables(Variable::Type::STRING);
+  fingerprint_ = ss.str();
+  DVLOG(VLOG_LEVEL) << "fingerprint: " << fingerprint_;
+}
+
+void ConstraintFingerprint::setCallbacks() {
+  auto command_callback = [](Command_ptr command) -> bool {
+    return Command::Type::ASSERT == command->getType();
+  };
+
+  auto term_pre_callback = [this](Term_ptr term) -> bool {
+    switch (term->type()) {
+      case Term::Type::EXCLAMATION:
+      case Term::Type::EXISTS:
+      case Term::Type::FORALL:
+      case Term::Type::LET:
+      case Term::Type::UNKNOWN:
+      case Term::Type::ASQUALIDENTIFIER:
+        is_normalizable_ = false;
+        return false;
+      case Term::Type::QUALIDENTIFIER:
+      case Term::Type::TERMCONSTANT:
+        return false;
+      default:
+        children_stack_.push_back(std::vector<Node>());
+        return is_normalizable_;
+    }
+  };
+
+  auto term_post_callback = [this](Term_ptr term) -> bool {
+    Node node;
+    switch (term->type()) {
+      case Term::Type::EXCLAMATION:
+      case Term::Type::EXISTS:
+      case Term::Type::FORALL:
+      case Term::Type::LET:
+      case Term::Type::UNKNOWN:
+      case Term::Type::ASQUALIDENTIFIER:
+        return false;
+      case Term::Type::QUALIDENTIFIER: {
+        auto name = dynamic_cast<QualIdentifier_ptr>(term)->getVarName();
+        auto variable = symbol_table_->get_variable_unsafe(name);
+        if (variable == nullptr) {
+          node.shape = "id" + std::to_string(name.size()) + ":" + name;
+        } else {
+          node.shape = "?" + std::to_string(static_cast<int>(variable->getType()));
+          node.variables.push_back(name);
+        }
+        break;
+      }
+      case Term::Type::TERMCONSTANT: {
+        auto term_constant = dynamic_cast<TermConstant_ptr>(term);
+        auto value = term_constant->getValue();
+        node.shape = "c" + std::to_string(static_cast<int>(term_constant->getValueType())) + ":"
+            + std::to_string(value.size()) + ":" + value;
+        break;
+      }
+      default: {
+        auto children = children_stack_.back();
+        children_stack_.pop_back();
+        node = MakeNode(GetLabel(term), children, IsCommutative(term));
+        break;
+      }
+    }
+    children_stack_.back().push_back(node);
+    return false;
+  };
+
+  setCommandPreCallback(command_callback);
+  setTermPreCallback(term_pre_callback);
+  setTermPostCallback(term_post_callback);
+}
+
+std::string ConstraintFingerprint::get_fingerprint() const {
+  return fingerprint_;
+}
+
+bool ConstraintFingerprint::IsCommutative(Term_ptr term) {
+  switch (term->type()) {
+    case Term::Type::AND:
+    case Term::Type::OR:
+    case Term::Type::PLUS:
+    case Term::Type::TIMES:
+    case Term::Type::EQ:
+    case Term::Type::NOTEQ:
+    case Term::Type::REUNION:
+    case Term::Type::REINTER:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * Term type and, for the terms that have one, the mode that tells how their operands are read
+ */
+std::string ConstraintFingerprint::GetLabel(Term_ptr term) {
+  std::string label = std::to_string(static_cast<int>(term->type()));
+  switch (term->type()) {
+    case Term::Type::INDEXOF:
+      label += "." + std::to_string(static_cast<int>(dynamic_cast<IndexOf_ptr>(term)->getMode()));
+      break;
+    case Term::Type::LASTINDEXOF:
+      label += "." + std::to_string(static_cast<int>(dynamic_cast<LastIndexOf_ptr>(term)->getMode()));
+      break;
+    case Term::Type::SUBSTRING:
+      label += "." + std::to_string(static_cast<int>(dynamic_cast<SubString_ptr>(term)->getMode()));
+      break;
+    default:
+      break;
+  }
+  return label;
+}
+
+/**
+ * Operands are ordered by their shapes; operands with the same shape keep their order, which may give
+ * different fingerprints to equivalent scripts but never the same fingerprint to different ones
+ */
+ConstraintFingerprint::Node ConstraintFingerprint::MakeNode(const std::string label, std::vector<Node>& children,
+                                                            const bool sort_children) {
+  if (sort_children) {
+    std::stable_sort(children.begin(), children.end(), [](const Node& left, const Node& right) {
+      return left.shape < right.shape;
+    });
+  }
+  Node node;
+  node.shape = "(" + label;
+  for (auto& child : children) {
+    node.shape += " " + child.shape;
+    node.variables.insert(node.variables.end(), child.variables.begin(), child.variables.end());
+  }
+  node.shape += ")";
+  return node;
+}
+
+} /* namespace Solver */
+} /* namespace Vlab */
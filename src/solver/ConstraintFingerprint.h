@@ -0,0 +1,75 @@
+/*
+ * ConstraintFingerprint.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_CONSTRAINTFINGERPRINT_H_
+#define SOLVER_CONSTRAINTFINGERPRINT_H_
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "../smt/ast.h"
+#include "../smt/typedefs.h"
+#include "AstTraverser.h"
+#include "SymbolTable.h"
+
+namespace Vlab {
+namespace Solver {
+
+/**
+ * Generates a normalized text for the assertions of a script; scripts that are the same up to
+ * variable names and the order of the operands of commutative terms get the same fingerprint.
+ * Variables are renamed in the order they appear after the operands of commutative terms are sorted.
+ * The fingerprint is empty for scripts with quantifiers, let bindings or unknown terms.
+ */
+class ConstraintFingerprint : public AstTraverser {
+public:
+  ConstraintFingerprint(SMT::Script_ptr, SymbolTable_ptr);
+  virtual ~ConstraintFingerprint();
+
+  void start() override;
+  void end() override;
+  void setCallbacks();
+
+  /**
+   * @return normalized text of the script, empty if it cannot be normalized
+   */
+  std::string get_fingerprint() const;
+
+protected:
+  /**
+   * Normalized term; variables are written as their sort, their names are kept in the order they are written
+   */
+  struct Node {
+    std::string shape;
+    std::vector<std::string> variables;
+  };
+
+  static bool IsCommutative(SMT::Term_ptr term);
+  static std::string GetLabel(SMT::Term_ptr term);
+  static Node MakeNode(const std::string label, std::vector<Node>& children, const bool sort_children);
+
+  SymbolTable_ptr symbol_table_;
+  bool is_normalizable_;
+  std::vector<std::vector<Node>> children_stack_;
+  std::string fingerprint_;
+
+private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_CONSTRAINTFINGERPRINT_H_ */
@@ -13,18 +13,22 @@ namespace Solver {
 using namespace SMT;
 using namespace Theory;
 
+const int ConstraintSolver::MAX_PROPAGATION_ROUNDS = 2;
 const int ConstraintSolver::VLOG_LEVEL = 11;
 
 ConstraintSolver::ConstraintSolver(Script_ptr script, SymbolTable_ptr symbol_table,
-                                   ConstraintInformation_ptr constraint_information)
+                                   ConstraintInformation_ptr constraint_information,
+                                   ConstraintCostModel::Timings_ptr timings)
     : iteration_count_ { 0 },
+      solves_in_parallel_ { true },
       root_(script),
       symbol_table_(symbol_table),
       constraint_information_(constraint_information),
       arithmetic_constraint_solver_(script, symbol_table, constraint_information,
                                     Option::Solver::USE_SIGNED_INTEGERS),
-      string_constraint_solver_(script, symbol_table, constraint_information) {
-	Automaton::SetCountBoundExact(Option::Solver::COUNT_BOUND_EXACT);
+      string_constraint_solver_(script, symbol_table, constraint_information),
+      cost_model_(script, symbol_table, timings),
+      is_timing_ { false } {
 }
 
 ConstraintSolver::~ConstraintSolver() {
@@ -162,8 +166,29 @@ void ConstraintSolver::visitAnd(And_ptr and_term) {
   DVLOG(VLOG_LEVEL) << "visit children start: " << *and_term << "@" << and_term;
 
   //if (is_satisfiable and (constraint_information_->has_mixed_constraint(and_term) or (not is_component))) {
-  if (is_satisfiable) {
+  if (is_satisfiable and (not is_component) and can_solve_in_parallel(and_term->term_list)
+      and std::all_of(and_term->term_list->begin(), and_term->term_list->end(),
+                      [this](Term_ptr term) { return constraint_information_->is_component(term); })) {
+    is_satisfiable = solve_components_in_parallel(and_term);
+  } else if (is_satisfiable) {
+    merge_constant_pattern_constraints(and_term);
+    // a conjunct relating more than one variable is solved once more when another conjunct refines one of them
+    std::deque<Term_ptr> worklist;
+    std::set<Term_ptr> queued_terms;
+    std::map<std::string, std::vector<Term_ptr>> dependent_terms;
+    std::map<Term_ptr, int> number_of_rounds;
     for (auto& term : *(and_term->term_list)) {
+      if (merged_terms_.find(term) != merged_terms_.end()) {
+        DVLOG(VLOG_LEVEL) << "skip merged constraint: " << *term << "@" << term;
+        continue;
+      }
+      worklist.push_back(term);
+      queued_terms.insert(term);
+    }
+    while (not worklist.empty()) {
+      Term_ptr term = worklist.front();
+      worklist.pop_front();
+      queued_terms.erase(term);
       is_satisfiable = check_and_visit(term) and is_satisfiable;
       if (not is_satisfiable) {
       	clearTermValuesAndLocalLetVars();
@@ -176,6 +201,21 @@ void ConstraintSolver::visitAnd(And_ptr and_term) {
           if(not is_satisfiable) {
           	break;
           }
+          if (++number_of_rounds[term] == 1 and path_variables_.size() > 1
+              and not constraint_information_->has_arithmetic_constraint(term)) {
+            for (auto& name : path_variables_) {
+              dependent_terms[name].push_back(term);
+            }
+          }
+          for (auto& name : changed_variables_) {
+            for (auto dependent_term : dependent_terms[name]) {
+              if (dependent_term not_eq term and number_of_rounds[dependent_term] < MAX_PROPAGATION_ROUNDS
+                  and queued_terms.insert(dependent_term).second) {
+                DVLOG(VLOG_LEVEL) << "propagate again: " << *dependent_term << "@" << dependent_term;
+                worklist.push_back(dependent_term);
+              }
+            }
+          }
         }
         clearTermValuesAndLocalLetVars();
       }
@@ -228,21 +268,16 @@ void ConstraintSolver::visitOr(Or_ptr or_term) {
   DVLOG(VLOG_LEVEL) << "visit children start: " << *or_term << "@" << or_term;
 
   //if (constraint_information_->has_mixed_constraint(or_term)) {
-  if(true) {
+  if (can_solve_in_parallel(or_term->term_list)) {
+    is_satisfiable = solve_disjuncts_in_parallel(or_term) or is_satisfiable;
+  } else {
     for (auto& term : *(or_term->term_list)) {
-      symbol_table_->push_scope(term);
-      bool is_scope_satisfiable = check_and_visit(term);
-
-      if (dynamic_cast<And_ptr>(term) == nullptr) {
-        if (is_scope_satisfiable) {
-          update_variables();
-        } else {
-        	variable_path_table_.clear();
-        }
-        clearTermValuesAndLocalLetVars();
-      }
+      bool is_scope_satisfiable = solve_disjunct(term);
       is_satisfiable = is_satisfiable or is_scope_satisfiable;
-      symbol_table_->pop_scope();
+      if (is_scope_satisfiable and Option::Solver::SAT_ONLY_MODE) {
+        DVLOG(VLOG_LEVEL) << "skip remaining disjuncts: " << *or_term << "@" << or_term;
+        break;
+      }
     }
   }
 
@@ -675,7 +710,15 @@ void ConstraintSolver::visitContains(Contains_ptr contains_term) {
 
   Value_ptr result = nullptr, param_subject = getTermValue(contains_term->subject_term), param_search = getTermValue(
       contains_term->search_term);
-  result = new Value(param_subject->getStringAutomaton()->Contains(param_search->getStringAutomaton()));
+  auto merged_it = merged_patterns_.find(contains_term);
+  if (merged_it != merged_patterns_.end()) {
+    Theory::StringAutomaton_ptr contains_all_auto = Theory::StringAutomaton::MakeContainsAllOf(merged_it->second);
+    result = new Value(param_subject->getStringAutomaton()->Intersect(contains_all_auto));
+    delete contains_all_auto;
+    contains_all_auto = nullptr;
+  } else {
+    result = new Value(param_subject->getStringAutomaton()->Contains(param_search->getStringAutomaton()));
+  }
   setTermValue(contains_term, result);
 }
 
@@ -687,8 +730,14 @@ void ConstraintSolver::visitNotContains(NotContains_ptr not_contains_term) {
       getTermValue(not_contains_term->search_term);
 
 
+  auto merged_it = merged_patterns_.find(not_contains_term);
   if (not (param_subject->is_satisfiable() and param_search->is_satisfiable())) {
     result = new Value(false);
+  } else if (merged_it != merged_patterns_.end()) {
+    Theory::StringAutomaton_ptr not_contains_any_auto = Theory::StringAutomaton::MakeNotContainsAnyOf(merged_it->second);
+    result = new Value(param_subject->getStringAutomaton()->Intersect(not_contains_any_auto));
+    delete not_contains_any_auto;
+    not_contains_any_auto = nullptr;
   } else if (param_search->isSingleValue()) {
     Theory::StringAutomaton_ptr contains_auto = param_subject->getStringAutomaton()->Contains(
         param_search->getStringAutomaton());
@@ -1225,18 +1274,294 @@ void ConstraintSolver::setVariablePath(QualIdentifier_ptr qi_term) {
 }
 
 bool ConstraintSolver::update_variables() {
+  path_variables_.clear();
+  changed_variables_.clear();
   if (variable_path_table_.size() == 0) {
     return true;
   }
+  // paths start with the variable
+  for (auto& path : variable_path_table_) {
+    if (auto qi_term = dynamic_cast<QualIdentifier_ptr>(path.front())) {
+      path_variables_.insert(qi_term->getVarName());
+    }
+  }
   VariableValueComputer value_updater(symbol_table_, variable_path_table_, term_values_);
   value_updater.start();
   auto is_satisfiable = value_updater.is_satisfiable();
+  changed_variables_ = value_updater.get_changed_variables();
   variable_path_table_.clear();
   // TODO should we delete term_values ???
   // TODO refactor relation - single interaction
   return is_satisfiable;
 }
 
+/**
+ * Groups contains and not contains constraints of the 'and' term that search a constant string in the same variable.
+ * Not contains constraints are merged into one, contains constraints are merged in chunks since the
+ * contains-all automaton pairs each Aho-Corasick state with the set of patterns seen so far.
+ */
+void ConstraintSolver::merge_constant_pattern_constraints(And_ptr and_term) {
+  const std::size_t max_merged_contains = 8;
+  std::map<std::pair<std::string, bool>, std::vector<std::pair<Term_ptr, std::string>>> groups;
+  for (auto term : *(and_term->term_list)) {
+    merged_patterns_.erase(term);
+    merged_terms_.erase(term);
+    if (constraint_information_->has_arithmetic_constraint(term) or constraint_information_->has_string_constraint(term)) {
+      continue;
+    }
+
+    Term_ptr subject_term = nullptr, search_term = nullptr;
+    bool is_not_contains = false;
+    if (Contains_ptr contains_term = dynamic_cast<Contains_ptr>(term)) {
+      subject_term = contains_term->subject_term;
+      search_term = contains_term->search_term;
+    } else if (NotContains_ptr not_contains_term = dynamic_cast<NotContains_ptr>(term)) {
+      subject_term = not_contains_term->subject_term;
+      search_term = not_contains_term->search_term;
+      is_not_contains = true;
+    } else {
+      continue;
+    }
+
+    QualIdentifier_ptr variable_term = dynamic_cast<QualIdentifier_ptr>(subject_term);
+    TermConstant_ptr constant_term = dynamic_cast<TermConstant_ptr>(search_term);
+    if (variable_term and constant_term and Primitive::Type::STRING == constant_term->getValueType()) {
+      groups[std::make_pair(variable_term->getVarName(), is_not_contains)].push_back(
+          std::make_pair(term, constant_term->getValue()));
+    }
+  }
+
+  for (auto& group : groups) {
+    auto& terms = group.second;
+    const std::size_t chunk_size = group.first.second ? terms.size() : max_merged_contains;
+    for (std::size_t begin = 0; begin + 1 < terms.size(); begin += chunk_size) {
+      const std::size_t end = std::min(terms.size(), begin + chunk_size);
+      auto& patterns = merged_patterns_[terms[begin].first];
+      for (std::size_t i = begin; i < end; ++i) {
+        patterns.push_back(terms[i].second);
+        if (i != begin) {
+          merged_terms_.insert(terms[i].first);
+        }
+      }
+      DVLOG(VLOG_LEVEL) << "merged " << patterns.size() << (group.first.second ? " not contains" : " contains")
+          << " constraints on " << group.first.first;
+    }
+  }
+}
+
+bool ConstraintSolver::solve_component(Term_ptr term) {
+  bool is_satisfiable = check_and_visit(term);
+  if (is_satisfiable and dynamic_cast<Or_ptr>(term) == nullptr) {
+    is_satisfiable = update_variables();
+  }
+  end();
+  return is_satisfiable;
+}
+
+bool ConstraintSolver::solve_disjunct(Term_ptr term) {
+  symbol_table_->push_scope(term);
+  bool is_scope_satisfiable = check_and_visit(term);
+
+  if (dynamic_cast<And_ptr>(term) == nullptr) {
+    if (is_scope_satisfiable) {
+      update_variables();
+    } else {
+      variable_path_table_.clear();
+    }
+    clearTermValuesAndLocalLetVars();
+  }
+  symbol_table_->pop_scope();
+  return is_scope_satisfiable;
+}
+
+bool ConstraintSolver::can_solve_in_parallel(SMT::TermList_ptr term_list) {
+  return solves_in_parallel_ and Option::Solver::NUM_OF_THREADS > 1 and iteration_count_ == 0 and term_list->size() > 1;
+}
+
+/**
+ * Workers run with the options and the cancellation budget of the calling thread, a cancelled
+ * component is rethrown on the calling thread once all workers are done.
+ * Each component gets its own solver on a forked symbol table. Results are joined in component order
+ * and joining stops at the first unsatisfiable component, so the symbol table ends up the same as
+ * after solving the components one by one.
+ */
+bool ConstraintSolver::solve_components_in_parallel(And_ptr and_term) {
+  const auto& components = *(and_term->term_list);
+  const int number_of_components = components.size();
+  std::vector<ConstraintSolver*> component_solvers;
+  for (auto component : components) {
+    component_solvers.push_back(make_forked_solver(component));
+  }
+
+  // components after an unsatisfiable one are not needed
+  std::atomic<int> first_unsat_component {number_of_components};
+  std::vector<char> results(number_of_components, false);
+  const Option::Options options;
+  const auto budget = Util::Cancellation::GetBudget();
+  std::vector<Util::ThreadPool::Task> tasks;
+  for (int i = 0; i < number_of_components; ++i) {
+    tasks.push_back([i, &options, &budget, &components, &component_solvers, &results, &first_unsat_component]() {
+      Option::Options::Scope option_scope(options);
+      Util::Cancellation::Scope cancellation_scope(budget);
+      if (i > first_unsat_component.load()) {
+        return;
+      }
+      DVLOG(VLOG_LEVEL) << "solve component: " << *components[i] << "@" << components[i];
+      try {
+        results[i] = component_solvers[i]->solve_component(components[i]);
+      } catch (const Util::Cancelled&) {
+        // the budget is marked as cancelled, the calling thread rethrows
+        return;
+      }
+      if (not results[i]) {
+        lower_to(first_unsat_component, i);
+      }
+    });
+  }
+  get_thread_pool()->RunAll(tasks);
+  if (budget != nullptr and budget->is_cancelled) {
+    delete_forked_solvers(component_solvers);
+    Util::Cancellation::Check();
+  }
+
+  bool is_satisfiable = true;
+  for (int i = 0; i < number_of_components; ++i) {
+    is_satisfiable = is_satisfiable and results[i];
+    auto forked_table = component_solvers[i]->symbol_table_;
+    if (is_satisfiable) {
+      symbol_table_->join(forked_table);
+    }
+    delete component_solvers[i];
+    delete forked_table;
+  }
+
+  if (not is_satisfiable) {
+    clearTermValuesAndLocalLetVars();
+    variable_path_table_.clear();
+  }
+  return is_satisfiable;
+}
+
+/**
+ * Each disjunct gets its own solver on a forked symbol table and updates only its own scope there,
+ * the scopes are joined back in disjunct order. In satisfiability-only mode disjuncts after a
+ * satisfiable one are not started and the running ones are abandoned through their own budgets,
+ * and only the disjuncts up to the first satisfiable one are joined, which is what the sequential
+ * solver computes in that mode.
+ */
+bool ConstraintSolver::solve_disjuncts_in_parallel(Or_ptr or_term) {
+  const auto& disjuncts = *(or_term->term_list);
+  const int number_of_disjuncts = disjuncts.size();
+  std::vector<ConstraintSolver*> disjunct_solvers;
+  for (auto disjunct : disjuncts) {
+    disjunct_solvers.push_back(make_forked_solver(disjunct));
+  }
+
+  std::atomic<int> first_sat_disjunct {number_of_disjuncts};
+  std::vector<char> results(number_of_disjuncts, false);
+  const Option::Options options;
+  const auto budget = Util::Cancellation::GetBudget();
+  std::vector<Util::Cancellation::Budget_ptr> disjunct_budgets;
+  for (int i = 0; i < number_of_disjuncts; ++i) {
+    disjunct_budgets.push_back(Util::Cancellation::MakeChildBudget(budget));
+  }
+  std::vector<Util::ThreadPool::Task> tasks;
+  for (int i = 0; i < number_of_disjuncts; ++i) {
+    tasks.push_back([i, number_of_disjuncts, &options, &disjunct_budgets, &disjuncts, &disjunct_solvers, &results,
+                     &first_sat_disjunct]() {
+      Option::Options::Scope option_scope(options);
+      Util::Cancellation::Scope cancellation_scope(disjunct_budgets[i]);
+      if (Option::Solver::SAT_ONLY_MODE and i > first_sat_disjunct.load()) {
+        return;
+      }
+      DVLOG(VLOG_LEVEL) << "solve disjunct: " << *disjuncts[i] << "@" << disjuncts[i];
+      try {
+        results[i] = disjunct_solvers[i]->solve_disjunct(disjuncts[i]);
+        disjunct_solvers[i]->end();
+      } catch (const Util::Cancelled&) {
+        results[i] = false;
+        return;
+      }
+      if (results[i]) {
+        lower_to(first_sat_disjunct, i);
+        if (Option::Solver::SAT_ONLY_MODE) {
+          for (int j = i + 1; j < number_of_disjuncts; ++j) {
+            Util::Cancellation::Abandon(disjunct_budgets[j]);
+          }
+        }
+      }
+    });
+  }
+  get_thread_pool()->RunAll(tasks);
+  if (budget != nullptr and budget->is_cancelled) {
+    delete_forked_solvers(disjunct_solvers);
+    Util::Cancellation::Check();
+  }
+
+  bool is_satisfiable = false;
+  for (int i = 0; i < number_of_disjuncts; ++i) {
+    auto forked_table = disjunct_solvers[i]->symbol_table_;
+    if (not Option::Solver::SAT_ONLY_MODE or i <= first_sat_disjunct.load()) {
+      symbol_table_->join(forked_table, disjuncts[i]);
+      is_satisfiable = is_satisfiable or results[i];
+    }
+    delete disjunct_solvers[i];
+    delete forked_table;
+  }
+  return is_satisfiable;
+}
+
+void ConstraintSolver::delete_forked_solvers(std::vector<ConstraintSolver*>& forked_solvers) {
+  for (auto forked_solver : forked_solvers) {
+    auto forked_table = forked_solver->symbol_table_;
+    delete forked_solver;
+    delete forked_table;
+  }
+  forked_solvers.clear();
+}
+
+/**
+ * The solver is created and its formulae are collected on the calling thread since formula generation
+ * updates the shared constraint information.
+ */
+ConstraintSolver* ConstraintSolver::make_forked_solver(Term_ptr term) {
+  std::set<Variable_ptr> variables;
+  AstTraverser variable_collector(root_);
+  variable_collector.setTermPreCallback([this, &variables](Term_ptr term) -> bool {
+    if (QualIdentifier_ptr qi_term = dynamic_cast<QualIdentifier_ptr>(term)) {
+      auto variable = symbol_table_->get_variable_unsafe(qi_term->getVarName());
+      if (variable not_eq nullptr) {
+        variables.insert(variable);
+      }
+    }
+    return true;
+  });
+  variable_collector.visit(term);
+
+  auto forked_solver = new ConstraintSolver(root_, symbol_table_->fork(variables), constraint_information_,
+                                            cost_model_.get_timings());
+  forked_solver->arithmetic_constraint_solver_.collect_arithmetic_constraint_info();
+  forked_solver->string_constraint_solver_.collect_string_constraint_info();
+  forked_solver->iteration_count_ = iteration_count_;
+  forked_solver->is_timing_ = is_timing_;
+  // siblings of the term already keep the pool busy, nested terms are solved sequentially
+  forked_solver->solves_in_parallel_ = false;
+  return forked_solver;
+}
+
+Util::ThreadPool* ConstraintSolver::get_thread_pool() {
+  if (thread_pool_ == nullptr or thread_pool_->GetNumberOfThreads() != static_cast<unsigned>(Option::Solver::NUM_OF_THREADS)) {
+    thread_pool_.reset(new Util::ThreadPool(Option::Solver::NUM_OF_THREADS));
+  }
+  return thread_pool_.get();
+}
+
+void ConstraintSolver::lower_to(std::atomic<int>& index, const int value) {
+  int current = index.load();
+  while (value < current and not index.compare_exchange_weak(current, value)) {
+  }
+}
+
 void ConstraintSolver::visit_children_of(Term_ptr term) {
   path_trace_.push_back(term);
   Visitor::visit_children_of(term);
@@ -1259,7 +1584,18 @@ bool ConstraintSolver::check_and_visit(Term_ptr term) {
       return true;  // should be checked already
     }
   }
-  visit(term);
+  if (Option::Solver::ENABLE_SORTING_HEURISTICS and Option::Solver::ENABLE_TIMING_REFINEMENT and not is_timing_
+      and Term::Type::AND not_eq term->type()) {
+    // timings refine the cost model that orders the constraints
+    is_timing_ = true;
+    auto start_time = std::chrono::steady_clock::now();
+    visit(term);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+    is_timing_ = false;
+    cost_model_.RecordTiming(term, elapsed.count());
+  } else {
+    visit(term);
+  }
   auto param = getTermValue(term);
   return param->is_satisfiable();
 }
@@ -8,7 +8,13 @@
 #ifndef SOLVER_CONSTRAINTSOLVER_H_
 #define SOLVER_CONSTRAINTSOLVER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <map>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -26,9 +32,14 @@
 #include "../theory/StringFormula.h"
 #include "../theory/UnaryAutomaton.h"
 #include "../theory/Formula.h"
+#include "../utils/Cancellation.h"
+#include "../utils/ThreadPool.h"
 #include "optimization/ConstraintQuerier.h"
 #include "ArithmeticConstraintSolver.h"
+#include "AstTraverser.h"
+#include "ConstraintCostModel.h"
 #include "ConstraintInformation.h"
+#include "options/Options.h"
 #include "options/Solver.h"
 #include "StringConstraintSolver.h"
 #include "StringFormulaGenerator.h"
@@ -43,7 +54,12 @@ class ConstraintSolver: public SMT::Visitor {
   typedef std::map<SMT::Term_ptr, Value_ptr> TermValueMap;
   typedef std::vector<std::vector<SMT::Term_ptr>> VariablePathTable;
  public:
-  ConstraintSolver(SMT::Script_ptr, SymbolTable_ptr, ConstraintInformation_ptr);
+  /**
+   * @param timings of the cost model, the time spent for each conjunct is recorded when sorting heuristics and
+   * timing refinement are on
+   */
+  ConstraintSolver(SMT::Script_ptr, SymbolTable_ptr, ConstraintInformation_ptr,
+                   ConstraintCostModel::Timings_ptr timings = nullptr);
   virtual ~ConstraintSolver();
 
   void start() override;
@@ -127,8 +143,52 @@ class ConstraintSolver: public SMT::Visitor {
   void visit_children_of(SMT::Term_ptr term);
   bool check_and_visit(SMT::Term_ptr term);
   bool process_mixed_integer_string_constraints_in(SMT::Term_ptr term);
+  void merge_constant_pattern_constraints(SMT::And_ptr and_term);
+
+  /**
+   * Solves a single component and updates the variables it constrains
+   * @param term
+   * @return
+   */
+  bool solve_component(SMT::Term_ptr term);
+
+  /**
+   * Solves a disjunct in its own scope
+   * @param term
+   * @return
+   */
+  bool solve_disjunct(SMT::Term_ptr term);
+
+  bool can_solve_in_parallel(SMT::TermList_ptr term_list);
+
+  /**
+   * Solves the components of the given conjunction concurrently, each one on its own solver and forked
+   * symbol table, and joins the results back in component order
+   * @param and_term
+   * @return
+   */
+  bool solve_components_in_parallel(SMT::And_ptr and_term);
+
+  /**
+   * Solves the disjuncts of the given disjunction concurrently, each one on its own solver and forked
+   * symbol table, and joins their scopes back in disjunct order
+   * @param or_term
+   * @return
+   */
+  bool solve_disjuncts_in_parallel(SMT::Or_ptr or_term);
+
+  /**
+   * Creates a solver on a symbol table forked for the variables of the given term
+   * @param term
+   * @return
+   */
+  ConstraintSolver* make_forked_solver(SMT::Term_ptr term);
+  static void delete_forked_solvers(std::vector<ConstraintSolver*>& forked_solvers);
+  Util::ThreadPool* get_thread_pool();
+  static void lower_to(std::atomic<int>& index, const int value);
 
   int iteration_count_;
+  bool solves_in_parallel_;
   SMT::Script_ptr root_;
   SymbolTable_ptr symbol_table_;
   ConstraintInformation_ptr constraint_information_;
@@ -143,7 +203,35 @@ class ConstraintSolver: public SMT::Visitor {
 
   // for relational variables that need to be updated
   std::vector<SMT::Variable_ptr> tagged_variables;
+
+  /**
+   * Constant patterns of contains/not contains constraints on the same variable; a group is solved
+   * at its first constraint with one multi-pattern automaton and the rest of the group is skipped
+   */
+  std::map<SMT::Term_ptr, std::vector<std::string>> merged_patterns_;
+  std::set<SMT::Term_ptr> merged_terms_;
+
+  /**
+   * Variables on the paths of the last updated conjunct and the ones whose values are refined by it
+   */
+  std::set<std::string> path_variables_;
+  std::set<std::string> changed_variables_;
+
+  /**
+   * Created on first use when more than one thread is requested
+   */
+  std::unique_ptr<Util::ThreadPool> thread_pool_;
+
+  /**
+   * Records the time spent for the outermost conjuncts, terms solved within a timed one are not timed again
+   */
+  ConstraintCostModel cost_model_;
+  bool is_timing_;
  private:
+  /**
+   * Times a conjunct is solved at most, each propagation round repeats all its automata constructions
+   */
+  static const int MAX_PROPAGATION_ROUNDS;
   static const int VLOG_LEVEL;
 };
 
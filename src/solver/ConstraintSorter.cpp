@@ -13,10 +13,11 @@ namespace Solver {
 using namespace SMT;
 
 const int ConstraintSorter::VLOG_LEVEL = 13;
-std::string ConstraintSorter::TermNode::count_var;
+thread_local std::string ConstraintSorter::TermNode::count_var;
 
-ConstraintSorter::ConstraintSorter(Script_ptr script, SymbolTable_ptr symbol_table)
-        : root(script), symbol_table(symbol_table), term_node(nullptr) {
+ConstraintSorter::ConstraintSorter(Script_ptr script, SymbolTable_ptr symbol_table,
+                                   ConstraintCostModel::Timings_ptr timings)
+        : root(script), symbol_table(symbol_table), timings(timings), term_node(nullptr) {
 
 	if(symbol_table->has_count_variable()) {
 		auto var = symbol_table->get_count_variable();
@@ -647,50 +648,76 @@ ConstraintSorter::TermNode_ptr ConstraintSorter::process_child_nodes(TermNode_pt
   return result_node;
 }
 
+/**
+ * Orders terms by their estimated costs, terms with the count variable are solved last
+ */
 void ConstraintSorter::sort_terms(std::vector<TermNode_ptr>& term_node_list) {
-	// if no count variable, just sort based on number of total variables in each term
+  ConstraintCostModel cost_model(root, symbol_table, timings);
+	// if no count variable, just sort based on the cost of each term
 	if(ConstraintSorter::TermNode::count_var.empty()) {
-		std::stable_sort(term_node_list.begin(), term_node_list.end(),
-							[](TermNode_ptr left_node, TermNode_ptr right_node) -> bool {
-								return (left_node->numOfTotalVars() < right_node->numOfTotalVars());
-							});
+		order_by_cost(term_node_list, cost_model);
 		return;
 	}
 
 	// otherwise, sort based on count variable
-  std::vector<TermNode_ptr> sorted_term_node_list;
+  auto it = std::stable_partition(term_node_list.begin(), term_node_list.end(),
+          [](TermNode_ptr node) -> bool {
+            return (node->numOfTotalVars() == 0) or (not node->hasSymbolicVar());
+          });
+  std::vector<TermNode_ptr> symbolic_term_node_list(it, term_node_list.end());
+  term_node_list.erase(it, term_node_list.end());
 
-  for (auto it = term_node_list.begin(); it != term_node_list.end(); ) {
-    if ((*it)->numOfTotalVars() == 0) {
-      sorted_term_node_list.push_back((*it));
-      it = term_node_list.erase(it);
-    }
-    else if(not (*it)->hasSymbolicVar()) {
-      sorted_term_node_list.push_back((*it));
-      it = term_node_list.erase(it);
-    }
-    else {
-      it++;
-    }
-  }
+  order_by_cost(term_node_list, cost_model);
+  order_by_cost(symbolic_term_node_list, cost_model);
+  term_node_list.insert(term_node_list.end(), symbolic_term_node_list.begin(), symbolic_term_node_list.end());
 
-  std::sort(term_node_list.begin(), term_node_list.end(),
-          [](TermNode_ptr left_node, TermNode_ptr right_node) -> bool {
-            return (left_node->numOfTotalVars() < right_node->numOfTotalVars());
-          });
+  DVLOG(VLOG_LEVEL) << "node list sorted";
+}
 
-  for (auto it = term_node_list.begin(); it != term_node_list.end(); ) {
-    if (not (*it)->hasSymbolicVar()) {
-      sorted_term_node_list.push_back((*it));
-      it = term_node_list.erase(it);
-    } else {
-      it++;
-    }
+/**
+ * Greedily picks the term with the lowest score; once a term is picked, its variables are bounded by its
+ * estimated automaton size and the remaining terms with those variables are scored again.
+ * Ties keep the original order.
+ */
+void ConstraintSorter::order_by_cost(std::vector<TermNode_ptr>& term_node_list, ConstraintCostModel& cost_model) {
+  std::vector<ConstraintCostModel::Cost> costs;
+  std::vector<double> scores;
+  for (auto term_node : term_node_list) {
+    costs.push_back(cost_model.Estimate(term_node->getNode()));
+    scores.push_back(ConstraintCostModel::GetScore(costs.back()));
   }
 
-  term_node_list.insert(term_node_list.begin(), sorted_term_node_list.begin(), sorted_term_node_list.end());
-
-  DVLOG(VLOG_LEVEL) << "node list sorted";
+  std::vector<TermNode_ptr> sorted_term_node_list;
+  while (not term_node_list.empty()) {
+    std::size_t min_index = 0;
+    for (std::size_t i = 1; i < term_node_list.size(); ++i) {
+      if (scores[i] < scores[min_index]) {
+        min_index = i;
+      }
+    }
+    DVLOG(VLOG_LEVEL) << "next term: " << *term_node_list[min_index]->getNode() << " score: " << scores[min_index];
+    auto restricted_variables = cost_model.Restrict(costs[min_index]);
+    sorted_term_node_list.push_back(term_node_list[min_index]);
+    term_node_list.erase(term_node_list.begin() + min_index);
+    costs.erase(costs.begin() + min_index);
+    scores.erase(scores.begin() + min_index);
+
+    for (std::size_t i = 0; i < term_node_list.size() and not restricted_variables.empty(); ++i) {
+      auto& cost = costs[i];
+      bool is_restricted = false;
+      for (auto& name : restricted_variables) {
+        if (cost.string_variables.count(name) > 0 or cost.int_variables.count(name) > 0) {
+          is_restricted = true;
+          break;
+        }
+      }
+      if (is_restricted) {
+        cost = cost_model.Estimate(term_node_list[i]->getNode());
+        scores[i] = ConstraintCostModel::GetScore(cost);
+      }
+    }
+  }
+  term_node_list = sorted_term_node_list;
 }
 
 ConstraintSorter::TermNode::TermNode()
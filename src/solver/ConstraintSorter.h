@@ -193,6 +193,7 @@
 #include <glog/logging.h>
 #include "smt/ast.h"
 #include "SymbolTable.h"
+#include "ConstraintCostModel.h"
 #include "Counter.h"
 
 namespace Vlab {
@@ -200,7 +201,10 @@ namespace Solver {
 // TODO fix sorting algorithm based on latest updates
 class ConstraintSorter: public SMT::Visitor {
 public:
-  ConstraintSorter(SMT::Script_ptr, SymbolTable_ptr);
+  /**
+   * @param timings recorded while solving, scale the estimated construction costs
+   */
+  ConstraintSorter(SMT::Script_ptr, SymbolTable_ptr, ConstraintCostModel::Timings_ptr timings = nullptr);
   virtual ~ConstraintSorter();
   void start() override;
   void end() override;
@@ -280,9 +284,11 @@ protected:
   VariableNode_ptr get_variable_node(SMT::Variable_ptr);
   TermNode_ptr process_child_nodes(TermNode_ptr, TermNode_ptr);
   void sort_terms(std::vector<TermNode_ptr>& term_list);
+  void order_by_cost(std::vector<TermNode_ptr>& term_list, ConstraintCostModel& cost_model);
 
   SMT::Script_ptr root;
   SymbolTable_ptr symbol_table;
+  ConstraintCostModel::Timings_ptr timings;
   TermNode_ptr term_node;
 
   std::vector<TermNode_ptr> dependency_node_list;
@@ -313,7 +319,7 @@ protected:
     bool hasSymbolicVarOnRight();
     bool hasSymbolicVar();
 
-    static std::string count_var;
+    static thread_local std::string count_var;
   protected:
     SMT::Term_ptr _node;
     bool _has_symbolic_var_on_left;
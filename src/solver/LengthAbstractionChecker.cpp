@@ -0,0 +1,507 @@
+/*
+ * LengthAbstractionChecker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "LengthAbstractionChecker.h"
+
+namespace Vlab {
+namespace Solver {
+
+using namespace SMT;
+
+const int LengthAbstractionChecker::MAX_ROUNDS = 64;
+const int LengthAbstractionChecker::VLOG_LEVEL = 20;
+
+LengthAbstractionChecker::LengthAbstractionChecker(Script_ptr script, SymbolTable_ptr symbol_table)
+    : AstTraverser(script),
+      symbol_table_(symbol_table),
+      is_feasible_ { true } {
+  setCallbacks();
+}
+
+LengthAbstractionChecker::~LengthAbstractionChecker() {
+}
+
+void LengthAbstractionChecker::start() {
+  DVLOG(VLOG_LEVEL) << "Starting the Length Abstraction Checker";
+  is_feasible_ = true;
+  visitScript(root_);
+  end();
+}
+
+void LengthAbstractionChecker::end() {
+  bounds_.clear();
+  DVLOG(VLOG_LEVEL) << "lengths are " << (is_feasible_ ? "feasible" : "infeasible");
+}
+
+void LengthAbstractionChecker::setCallbacks() {
+  auto command_callback = [this](Command_ptr command) -> bool {
+    return is_feasible_ and Command::Type::ASSERT == command->getType();
+  };
+  setCommandPreCallback(command_callback);
+}
+
+void LengthAbstractionChecker::visitAssert(Assert_ptr assert_command) {
+  if (is_feasible_) {
+    is_feasible_ = IsFeasible(assert_command->term);
+  }
+}
+
+bool LengthAbstractionChecker::is_feasible() const {
+  return is_feasible_;
+}
+
+bool LengthAbstractionChecker::IsFeasible(Term_ptr term) {
+  if (Or_ptr or_term = dynamic_cast<Or_ptr>(term)) {
+    for (auto disjunct : *(or_term->term_list)) {
+      if (IsFeasible(disjunct)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  std::vector<Term_ptr> conjuncts { term };
+  return IsFeasible(conjuncts);
+}
+
+/**
+ * Nested conjunctions are flattened, nested disjunctions are checked on their own
+ */
+bool LengthAbstractionChecker::IsFeasible(std::vector<Term_ptr>& conjuncts) {
+  std::vector<LinearTerm> constraints;
+  while (not conjuncts.empty()) {
+    Term_ptr term = conjuncts.back();
+    conjuncts.pop_back();
+    if (And_ptr and_term = dynamic_cast<And_ptr>(term)) {
+      conjuncts.insert(conjuncts.end(), and_term->term_list->begin(), and_term->term_list->end());
+    } else if (Term::Type::OR == term->type()) {
+      if (not IsFeasible(term)) {
+        return false;
+      }
+    } else if (not AddConstraints(term, constraints)) {
+      return false;
+    }
+  }
+
+  bounds_.clear();
+  return PropagateBounds(constraints);
+}
+
+bool LengthAbstractionChecker::AddConstraints(Term_ptr term, std::vector<LinearTerm>& constraints) {
+  LinearTerm left, right;
+  switch (term->type()) {
+    case Term::Type::TERMCONSTANT: {
+      auto term_constant = dynamic_cast<TermConstant_ptr>(term);
+      return not (Primitive::Type::BOOL == term_constant->getValueType() and "false" == term_constant->getValue());
+    }
+    case Term::Type::EQ: {
+      auto eq_term = dynamic_cast<Eq_ptr>(term);
+      LinearTerm left_length, right_length;
+      if (GetIntTerm(eq_term->left_term, left) and GetIntTerm(eq_term->right_term, right)) {
+        constraints.push_back(Subtract(left, right));
+        constraints.push_back(Subtract(right, left));
+      } else if (GetLengthTerm(eq_term->left_term, left_length) and GetLengthTerm(eq_term->right_term, right_length)) {
+        constraints.push_back(Subtract(left_length, right_length));
+        constraints.push_back(Subtract(right_length, left_length));
+      }
+      break;
+    }
+    case Term::Type::LT:
+    case Term::Type::LE: {
+      auto lt_term = dynamic_cast<Lt_ptr>(term);
+      auto le_term = dynamic_cast<Le_ptr>(term);
+      auto left_term = lt_term ? lt_term->left_term : le_term->left_term;
+      auto right_term = lt_term ? lt_term->right_term : le_term->right_term;
+      if (GetIntTerm(left_term, left) and GetIntTerm(right_term, right)) {
+        constraints.push_back(Subtract(left, right));
+        if (lt_term) {
+          constraints.back().constant += 1;
+        }
+      }
+      break;
+    }
+    case Term::Type::GT:
+    case Term::Type::GE: {
+      auto gt_term = dynamic_cast<Gt_ptr>(term);
+      auto ge_term = dynamic_cast<Ge_ptr>(term);
+      auto left_term = gt_term ? gt_term->left_term : ge_term->left_term;
+      auto right_term = gt_term ? gt_term->right_term : ge_term->right_term;
+      if (GetIntTerm(left_term, left) and GetIntTerm(right_term, right)) {
+        constraints.push_back(Subtract(right, left));
+        if (gt_term) {
+          constraints.back().constant += 1;
+        }
+      }
+      break;
+    }
+    case Term::Type::IN: {
+      auto in_term = dynamic_cast<In_ptr>(term);
+      auto term_constant = dynamic_cast<TermConstant_ptr>(in_term->right_term);
+      if (term_constant == nullptr or Primitive::Type::REGEX != term_constant->getValueType()
+          or not GetLengthTerm(in_term->left_term, left)) {
+        break;
+      }
+      Util::RegularExpression regular_expression(term_constant->getValue());
+      auto interval = GetLengthInterval(&regular_expression);
+      if (interval.has_upper and interval.lower > interval.upper) {
+        return false;
+      }
+      right.constant = interval.lower;
+      constraints.push_back(Subtract(right, left));
+      if (interval.has_upper) {
+        right.constant = interval.upper;
+        constraints.push_back(Subtract(left, right));
+      }
+      break;
+    }
+    case Term::Type::CONTAINS: {
+      auto contains_term = dynamic_cast<Contains_ptr>(term);
+      if (GetLengthTerm(contains_term->subject_term, left) and GetLengthTerm(contains_term->search_term, right)) {
+        constraints.push_back(Subtract(right, left));
+      }
+      break;
+    }
+    case Term::Type::BEGINS: {
+      auto begins_term = dynamic_cast<Begins_ptr>(term);
+      if (GetLengthTerm(begins_term->subject_term, left) and GetLengthTerm(begins_term->search_term, right)) {
+        constraints.push_back(Subtract(right, left));
+      }
+      break;
+    }
+    case Term::Type::ENDS: {
+      auto ends_term = dynamic_cast<Ends_ptr>(term);
+      if (GetLengthTerm(ends_term->subject_term, left) and GetLengthTerm(ends_term->search_term, right)) {
+        constraints.push_back(Subtract(right, left));
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return true;
+}
+
+bool LengthAbstractionChecker::GetLengthTerm(Term_ptr term, LinearTerm& result) {
+  switch (term->type()) {
+    case Term::Type::TERMCONSTANT: {
+      auto term_constant = dynamic_cast<TermConstant_ptr>(term);
+      if (Primitive::Type::STRING != term_constant->getValueType()) {
+        return false;
+      }
+      result.constant += term_constant->getValue().length();
+      return true;
+    }
+    case Term::Type::QUALIDENTIFIER: {
+      auto variable = symbol_table_->get_variable_unsafe(dynamic_cast<QualIdentifier_ptr>(term)->getVarName());
+      if (variable == nullptr or Variable::Type::STRING != variable->getType()) {
+        return false;
+      }
+      result.coefficients["s:" + variable->getName()] += 1;
+      return true;
+    }
+    case Term::Type::CONCAT: {
+      for (auto sub_term : *(dynamic_cast<Concat_ptr>(term)->term_list)) {
+        if (not GetLengthTerm(sub_term, result)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Term::Type::TOUPPER:
+      return GetLengthTerm(dynamic_cast<ToUpper_ptr>(term)->subject_term, result);
+    case Term::Type::TOLOWER:
+      return GetLengthTerm(dynamic_cast<ToLower_ptr>(term)->subject_term, result);
+    default:
+      return false;
+  }
+}
+
+bool LengthAbstractionChecker::GetIntTerm(Term_ptr term, LinearTerm& result) {
+  switch (term->type()) {
+    case Term::Type::TERMCONSTANT: {
+      auto term_constant = dynamic_cast<TermConstant_ptr>(term);
+      if (Primitive::Type::NUMERAL != term_constant->getValueType()) {
+        return false;
+      }
+      result.constant += Theory::BigInteger(term_constant->getValue());
+      return true;
+    }
+    case Term::Type::QUALIDENTIFIER: {
+      auto variable = symbol_table_->get_variable_unsafe(dynamic_cast<QualIdentifier_ptr>(term)->getVarName());
+      if (variable == nullptr or Variable::Type::INT != variable->getType()) {
+        return false;
+      }
+      result.coefficients["i:" + variable->getName()] += 1;
+      return true;
+    }
+    case Term::Type::LEN:
+      return GetLengthTerm(dynamic_cast<Len_ptr>(term)->term, result);
+    case Term::Type::PLUS: {
+      for (auto sub_term : *(dynamic_cast<Plus_ptr>(term)->term_list)) {
+        if (not GetIntTerm(sub_term, result)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case Term::Type::MINUS: {
+      auto minus_term = dynamic_cast<Minus_ptr>(term);
+      LinearTerm right;
+      if (not GetIntTerm(minus_term->left_term, result) or not GetIntTerm(minus_term->right_term, right)) {
+        return false;
+      }
+      result = Subtract(result, right);
+      return true;
+    }
+    case Term::Type::UMINUS: {
+      LinearTerm sub_result;
+      if (not GetIntTerm(dynamic_cast<UMinus_ptr>(term)->term, sub_result)) {
+        return false;
+      }
+      result = Subtract(result, sub_result);
+      return true;
+    }
+    case Term::Type::TIMES: {
+      // linear only when at most one factor is not a constant
+      LinearTerm product;
+      product.constant = 1;
+      bool has_variables = false;
+      for (auto sub_term : *(dynamic_cast<Times_ptr>(term)->term_list)) {
+        LinearTerm factor;
+        if (not GetIntTerm(sub_term, factor)) {
+          return false;
+        }
+        if (factor.coefficients.empty()) {
+          Scale(product, factor.constant);
+        } else if (has_variables) {
+          return false;
+        } else {
+          Scale(factor, product.constant);
+          product = factor;
+          has_variables = true;
+        }
+      }
+      Add(result, product);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+LengthAbstractionChecker::Interval LengthAbstractionChecker::GetLengthInterval(Util::RegularExpression_ptr regular_expression) {
+  const Interval any_length { true, 0, false, 0 };
+  const Interval empty_word { true, 0, true, 0 };
+  const Interval empty_language { true, 1, true, 0 };
+  auto is_empty = [](const Interval& interval) {
+    return interval.has_upper and interval.lower > interval.upper;
+  };
+
+  switch (regular_expression->type()) {
+    case Util::RegularExpression::Type::UNION: {
+      auto left = GetLengthInterval(regular_expression->get_expr1());
+      auto right = GetLengthInterval(regular_expression->get_expr2());
+      if (is_empty(left)) {
+        return right;
+      } else if (is_empty(right)) {
+        return left;
+      }
+      return Interval { true, std::min(left.lower, right.lower), left.has_upper and right.has_upper,
+          std::max(left.upper, right.upper) };
+    }
+    case Util::RegularExpression::Type::CONCATENATION: {
+      auto left = GetLengthInterval(regular_expression->get_expr1());
+      auto right = GetLengthInterval(regular_expression->get_expr2());
+      if (is_empty(left) or is_empty(right)) {
+        return empty_language;
+      }
+      return Interval { true, left.lower + right.lower, left.has_upper and right.has_upper, left.upper + right.upper };
+    }
+    case Util::RegularExpression::Type::INTERSECTION: {
+      auto left = GetLengthInterval(regular_expression->get_expr1());
+      auto right = GetLengthInterval(regular_expression->get_expr2());
+      Interval result { true, std::max(left.lower, right.lower), left.has_upper or right.has_upper, 0 };
+      if (left.has_upper and right.has_upper) {
+        result.upper = std::min(left.upper, right.upper);
+      } else if (result.has_upper) {
+        result.upper = left.has_upper ? left.upper : right.upper;
+      }
+      return result;
+    }
+    case Util::RegularExpression::Type::OPTIONAL: {
+      auto sub_interval = GetLengthInterval(regular_expression->get_expr1());
+      if (is_empty(sub_interval)) {
+        return empty_word;
+      }
+      return Interval { true, 0, sub_interval.has_upper, sub_interval.upper };
+    }
+    case Util::RegularExpression::Type::REPEAT_STAR: {
+      auto sub_interval = GetLengthInterval(regular_expression->get_expr1());
+      if (sub_interval.has_upper and sub_interval.upper <= 0) {
+        return empty_word;
+      }
+      return any_length;
+    }
+    case Util::RegularExpression::Type::REPEAT_PLUS: {
+      auto sub_interval = GetLengthInterval(regular_expression->get_expr1());
+      if (is_empty(sub_interval) or (sub_interval.has_upper and sub_interval.upper == 0)) {
+        return sub_interval;
+      }
+      return Interval { true, sub_interval.lower, false, 0 };
+    }
+    case Util::RegularExpression::Type::REPEAT_MIN: {
+      auto sub_interval = GetLengthInterval(regular_expression->get_expr1());
+      const Theory::BigInteger min = regular_expression->get_min();
+      if (is_empty(sub_interval)) {
+        return min == 0 ? empty_word : empty_language;
+      } else if (sub_interval.has_upper and sub_interval.upper == 0) {
+        return empty_word;
+      }
+      return Interval { true, sub_interval.lower * min, false, 0 };
+    }
+    case Util::RegularExpression::Type::REPEAT_MINMAX: {
+      auto sub_interval = GetLengthInterval(regular_expression->get_expr1());
+      const Theory::BigInteger min = regular_expression->get_min();
+      const Theory::BigInteger max = regular_expression->get_max();
+      if (min > max) {
+        return empty_language;
+      } else if (is_empty(sub_interval)) {
+        return min == 0 ? empty_word : empty_language;
+      }
+      return Interval { true, sub_interval.lower * min, sub_interval.has_upper, sub_interval.upper * max };
+    }
+    case Util::RegularExpression::Type::CHAR:
+    case Util::RegularExpression::Type::CHAR_RANGE:
+    case Util::RegularExpression::Type::ANYCHAR:
+      return Interval { true, 1, true, 1 };
+    case Util::RegularExpression::Type::STRING: {
+      const Theory::BigInteger length = regular_expression->get_string().length();
+      return Interval { true, length, true, length };
+    }
+    case Util::RegularExpression::Type::EMPTY:
+      return empty_language;
+    default:
+      // complements, named automata and numeric intervals may accept words of any length
+      return any_length;
+  }
+}
+
+/**
+ * Tightens variable bounds with each constraint 'sum(coefficient * variable) + constant <= 0' until
+ * nothing changes or for at most MAX_ROUNDS rounds, cyclic constraints may otherwise tighten forever.
+ */
+bool LengthAbstractionChecker::PropagateBounds(const std::vector<LinearTerm>& constraints) {
+  for (int round = 0; round < MAX_ROUNDS; ++round) {
+    bool is_changed = false;
+    for (auto& constraint : constraints) {
+      // smallest value of the left hand side, excluding variables without a bound in that direction
+      Theory::BigInteger min_sum = constraint.constant;
+      int number_of_unbounded = 0;
+      std::string unbounded_variable;
+      for (auto& entry : constraint.coefficients) {
+        auto& bounds = GetBounds(entry.first);
+        if (entry.second > 0 and bounds.has_lower) {
+          min_sum += entry.second * bounds.lower;
+        } else if (entry.second < 0 and bounds.has_upper) {
+          min_sum += entry.second * bounds.upper;
+        } else if (entry.second != 0) {
+          ++number_of_unbounded;
+          unbounded_variable = entry.first;
+        }
+      }
+
+      if (number_of_unbounded == 0 and min_sum > 0) {
+        DVLOG(VLOG_LEVEL) << "length constraints are infeasible";
+        return false;
+      } else if (number_of_unbounded > 1) {
+        continue;
+      }
+
+      for (auto& entry : constraint.coefficients) {
+        if (entry.second == 0 or (number_of_unbounded == 1 and entry.first != unbounded_variable)) {
+          continue;
+        }
+        auto& bounds = GetBounds(entry.first);
+        Theory::BigInteger rest = min_sum;
+        if (number_of_unbounded == 0) {
+          rest -= entry.second * (entry.second > 0 ? bounds.lower : bounds.upper);
+        }
+        // coefficient * variable <= -rest
+        if (entry.second > 0) {
+          Theory::BigInteger upper = -rest / entry.second;
+          if ((-rest) % entry.second != 0 and -rest < 0) {
+            upper -= 1;
+          }
+          if (not bounds.has_upper or upper < bounds.upper) {
+            bounds.has_upper = true;
+            bounds.upper = upper;
+            is_changed = true;
+          }
+        } else {
+          const Theory::BigInteger divisor = -entry.second;
+          Theory::BigInteger lower = rest / divisor;
+          if (rest % divisor != 0 and rest > 0) {
+            lower += 1;
+          }
+          if (not bounds.has_lower or lower > bounds.lower) {
+            bounds.has_lower = true;
+            bounds.lower = lower;
+            is_changed = true;
+          }
+        }
+        if (bounds.has_lower and bounds.has_upper and bounds.lower > bounds.upper) {
+          DVLOG(VLOG_LEVEL) << "length constraints are infeasible for " << entry.first;
+          return false;
+        }
+      }
+    }
+    if (not is_changed) {
+      break;
+    }
+  }
+  return true;
+}
+
+/**
+ * Lengths are not negative, neither are integers when they are unsigned
+ */
+LengthAbstractionChecker::Interval& LengthAbstractionChecker::GetBounds(const std::string& variable) {
+  auto it = bounds_.find(variable);
+  if (it == bounds_.end()) {
+    const bool is_non_negative = variable.front() == 's' or not Option::Solver::USE_SIGNED_INTEGERS;
+    it = bounds_.insert(std::make_pair(variable, Interval { is_non_negative, 0, false, 0 })).first;
+  }
+  return it->second;
+}
+
+void LengthAbstractionChecker::Add(LinearTerm& target, const LinearTerm& term) {
+  for (auto& entry : term.coefficients) {
+    target.coefficients[entry.first] += entry.second;
+  }
+  target.constant += term.constant;
+}
+
+LengthAbstractionChecker::LinearTerm LengthAbstractionChecker::Subtract(const LinearTerm& left, const LinearTerm& right) {
+  LinearTerm result = left;
+  for (auto& entry : right.coefficients) {
+    result.coefficients[entry.first] -= entry.second;
+  }
+  result.constant -= right.constant;
+  return result;
+}
+
+void LengthAbstractionChecker::Scale(LinearTerm& term, const Theory::BigInteger& factor) {
+  for (auto& entry : term.coefficients) {
+    entry.second *= factor;
+  }
+  term.constant *= factor;
+}
+
+} /* namespace Solver */
+} /* namespace Vlab */
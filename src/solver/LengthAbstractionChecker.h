@@ -0,0 +1,107 @@
+/*
+ * LengthAbstractionChecker.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_LENGTHABSTRACTIONCHECKER_H_
+#define SOLVER_LENGTHABSTRACTIONCHECKER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "../smt/ast.h"
+#include "../smt/typedefs.h"
+#include "../utils/Math.h"
+#include "../utils/RegularExpression.h"
+#include "AstTraverser.h"
+#include "options/Solver.h"
+#include "SymbolTable.h"
+
+namespace Vlab {
+namespace Solver {
+
+/**
+ * Checks the lengths of strings before any automaton is built.
+ * String terms are abstracted to their lengths; linear length and integer constraints, and length intervals
+ * of regular expressions and constants, are collected for each conjunction and their variable bounds are
+ * propagated. A conjunction is infeasible when a variable gets an empty interval.
+ * Constraints that cannot be abstracted are ignored, so an infeasible result is always unsatisfiable.
+ */
+class LengthAbstractionChecker : public AstTraverser {
+public:
+  LengthAbstractionChecker(SMT::Script_ptr, SymbolTable_ptr);
+  virtual ~LengthAbstractionChecker();
+
+  void start() override;
+  void end() override;
+  void setCallbacks();
+
+  void visitAssert(SMT::Assert_ptr) override;
+
+  /**
+   * @return false if the script is unsatisfiable because of lengths
+   */
+  bool is_feasible() const;
+
+protected:
+  /**
+   * Sum of coefficient * variable plus constant; string variables stand for their lengths and are
+   * prefixed with "s:", integer variables are prefixed with "i:"
+   */
+  struct LinearTerm {
+    std::map<std::string, Theory::BigInteger> coefficients;
+    Theory::BigInteger constant;
+  };
+
+  struct Interval {
+    bool has_lower;
+    Theory::BigInteger lower;
+    bool has_upper;
+    Theory::BigInteger upper;
+  };
+
+  bool IsFeasible(SMT::Term_ptr term);
+  bool IsFeasible(std::vector<SMT::Term_ptr>& conjuncts);
+
+  /**
+   * Adds the abstraction of the term as linear terms that are less than or equal to zero
+   * @return false if the term is trivially unsatisfiable
+   */
+  bool AddConstraints(SMT::Term_ptr term, std::vector<LinearTerm>& constraints);
+
+  bool GetLengthTerm(SMT::Term_ptr term, LinearTerm& result);
+  bool GetIntTerm(SMT::Term_ptr term, LinearTerm& result);
+
+  /**
+   * Shortest and longest word lengths of a regular expression, longest one is unbounded when has_upper is false
+   */
+  static Interval GetLengthInterval(Util::RegularExpression_ptr regular_expression);
+
+  bool PropagateBounds(const std::vector<LinearTerm>& constraints);
+  Interval& GetBounds(const std::string& variable);
+
+  static void Add(LinearTerm& target, const LinearTerm& term);
+  static LinearTerm Subtract(const LinearTerm& left, const LinearTerm& right);
+  static void Scale(LinearTerm& term, const Theory::BigInteger& factor);
+
+  SymbolTable_ptr symbol_table_;
+  bool is_feasible_;
+  std::map<std::string, Interval> bounds_;
+
+private:
+  static const int MAX_ROUNDS;
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_LENGTHABSTRACTIONCHECKER_H_ */
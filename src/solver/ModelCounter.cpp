@@ -10,12 +10,16 @@
 namespace Vlab {
 namespace Solver {
 
-ModelCounter::ModelCounter() : use_signed_integers_{true}, count_bound_exact_{false}, unconstraint_int_vars_ {0}, unconstraint_str_vars_ {0} {
+ModelCounter::ModelCounter() : is_satisfiable_{true}, use_signed_integers_{true}, count_bound_exact_{false}, int_bit_width_ {0}, unconstraint_int_vars_ {0}, unconstraint_str_vars_ {0} {
 }
 
 ModelCounter::~ModelCounter() {
 }
 
+void ModelCounter::set_satisfiable(bool value) {
+  is_satisfiable_ = value;
+}
+
 void ModelCounter::set_use_sign_integers(bool value) {
   use_signed_integers_ = value;
 }
@@ -24,6 +28,10 @@ void ModelCounter::set_count_bound_exact(bool value) {
 	count_bound_exact_ = value;
 }
 
+void ModelCounter::set_int_bit_width(int width) {
+  int_bit_width_ = width;
+}
+
 void ModelCounter::set_num_of_unconstraint_int_vars(int n) {
   unconstraint_int_vars_ = n;
 }
@@ -43,6 +51,12 @@ void ModelCounter::add_symbolic_counter(const Theory::SymbolicCounter& counter)
 
 
 Theory::BigInteger ModelCounter::CountInts(const unsigned long bound) {
+  if (not is_satisfiable_) {
+    return 0;
+  } else if (int_bit_width_ > 0) {
+    return CountFixedWidthInts();
+  }
+
   Theory::BigInteger result(1);
 
   for (int i : constant_ints_) {
@@ -88,7 +102,49 @@ Theory::BigInteger ModelCounter::CountInts(const unsigned long bound) {
   return result;
 }
 
+/**
+ * Fixed width int automata only accept words of int_bit_width_ columns and are acyclic apart from the sink,
+ * counting words of exactly that length gives the exact number of solutions.
+ */
+Theory::BigInteger ModelCounter::CountFixedWidthInts() {
+  const unsigned long width = int_bit_width_;
+  Theory::BigInteger base(1);
+  Theory::BigInteger upper_bound = (base << width) - 1;
+  Theory::BigInteger lower_bound(0);
+  if (use_signed_integers_) {
+    upper_bound = (base << (width - 1)) - 1;
+    lower_bound = -(base << (width - 1));
+  }
+
+  for (int i : constant_ints_) {
+    Theory::BigInteger value(i);
+    if (not (value <= upper_bound and value >= lower_bound)) {
+      return 0;
+    }
+  }
+
+  Theory::BigInteger result(1);
+  for (Theory::SymbolicCounter& counter : symbolic_counters_) {
+    if (Theory::SymbolicCounter::Type::BINARYINT == counter.type()) {
+      result = result * counter.Count(width - 1); // sign bit is added by the counter
+    } else if (Theory::SymbolicCounter::Type::UNARYINT == counter.type() and use_signed_integers_) {
+      result = result * counter.Count(width - 1);
+    } else if (Theory::SymbolicCounter::Type::STRING != counter.type()) {
+      result = result * counter.Count(width);
+    }
+  }
+
+  if (unconstraint_int_vars_ > 0) {
+    result = result * boost::multiprecision::pow(boost::multiprecision::cpp_int(2), unconstraint_int_vars_ * width);
+  }
+
+  return result;
+}
+
 Theory::BigInteger ModelCounter::CountStrs(const unsigned long bound) {
+  if (not is_satisfiable_) {
+    return 0;
+  }
   Theory::BigInteger result(1);
 
   for (Theory::SymbolicCounter& counter : symbolic_counters_) {
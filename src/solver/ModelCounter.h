@@ -28,7 +28,14 @@ class ModelCounter {
   ModelCounter();
   virtual ~ModelCounter();
   void set_use_sign_integers(bool value);
+
+  /**
+   * Counts of an unsatisfiable query are 0, even when solving stopped before its variables got empty values
+   * @param value
+   */
+  void set_satisfiable(bool value);
   void set_count_bound_exact(bool value);
+  void set_int_bit_width(int width);
   void set_num_of_unconstraint_int_vars(int n);
   void set_num_of_unconstraint_str_vars(int n);
   void add_constant(int c);
@@ -39,7 +46,9 @@ class ModelCounter {
 
   template <class Archive>
   void save(Archive& ar) const {
+    ar(is_satisfiable_);
     ar(use_signed_integers_);
+    ar(int_bit_width_);
     ar(unconstraint_int_vars_);
     ar(unconstraint_str_vars_);
     ar(constant_ints_);
@@ -48,7 +57,9 @@ class ModelCounter {
 
   template <class Archive>
   void load(Archive& ar) {
+    ar(is_satisfiable_);
     ar(use_signed_integers_);
+    ar(int_bit_width_);
     ar(unconstraint_int_vars_);
     ar(unconstraint_str_vars_);
     ar(constant_ints_);
@@ -57,8 +68,15 @@ class ModelCounter {
   std::string str() const;
   friend std::ostream& operator<<(std::ostream& os, const ModelCounter& mc);
  protected:
+  Theory::BigInteger CountFixedWidthInts();
+
+  bool is_satisfiable_;
   bool use_signed_integers_;
   bool count_bound_exact_;
+  /**
+   * Fixed integer width, int counts do not depend on the bound when it is set
+   */
+  int int_bit_width_;
   int unconstraint_int_vars_;
   int unconstraint_str_vars_;
   std::vector<int> constant_ints_;
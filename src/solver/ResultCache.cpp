@@ -0,0 +1,190 @@
+/*
+ * ResultCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ResultCache.h"
+
+namespace Vlab {
+namespace Solver {
+
+const int ResultCache::VLOG_LEVEL = 20;
+const int ResultCache::DEFAULT_SIZE = 1024;
+
+ResultCache::EntryList ResultCache::ENTRIES;
+std::unordered_map<std::string, ResultCache::EntryList::iterator> ResultCache::ENTRY_INDEX;
+bool ResultCache::IS_MODIFIED = false;
+std::size_t ResultCache::SIZE = ResultCache::DEFAULT_SIZE;
+std::mutex ResultCache::MUTEX;
+const std::string ResultCache::MAGIC = "ABCRSLT2";
+
+void ResultCache::SetSize(const std::size_t size) {
+  std::lock_guard<std::mutex> lock(MUTEX);
+  SIZE = size;
+  Trim();
+}
+
+std::string ResultCache::GetKey(const std::string fingerprint) {
+  std::stringstream ss;
+  ss << Option::Solver::USE_SIGNED_INTEGERS << Option::Solver::USE_MULTITRACK_AUTO
+     << Option::Solver::ENABLE_EQUIVALENCE_CLASSES << Option::Solver::ENABLE_DEPENDENCY_ANALYSIS
+     << Option::Solver::ENABLE_IMPLICATIONS << Option::Solver::ENABLE_LEN_IMPLICATIONS
+     << Option::Solver::ENABLE_SORTING_HEURISTICS << Option::Solver::FORCE_DNF_FORMULA
+     << Option::Solver::COUNT_BOUND_EXACT << Option::Solver::SAT_ONLY_MODE
+     << Option::Theory::COUNT_BOUND_EXACT << Option::Theory::DEFER_MINIMIZATION
+     << Option::Theory::USE_NATIVE_MINIMIZATION << Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS
+     << ":" << Option::Theory::INT_BIT_WIDTH << ":" << Util::RegularExpression::DEFAULT << ":" << fingerprint;
+  return ss.str();
+}
+
+bool ResultCache::Get(const std::string key, Entry& entry) {
+  std::lock_guard<std::mutex> lock(MUTEX);
+  auto it = ENTRY_INDEX.find(key);
+  if (it == ENTRY_INDEX.end()) {
+    return false;
+  }
+  ENTRIES.splice(ENTRIES.begin(), ENTRIES, it->second);
+  entry = it->second->second;
+  DVLOG(VLOG_LEVEL) << "result cache hit";
+  return true;
+}
+
+void ResultCache::Put(const std::string key, const bool is_satisfiable) {
+  std::lock_guard<std::mutex> lock(MUTEX);
+  auto it = ENTRY_INDEX.find(key);
+  if (it == ENTRY_INDEX.end()) {
+    Insert(key, Entry { is_satisfiable, "" });
+  } else {
+    ENTRIES.splice(ENTRIES.begin(), ENTRIES, it->second);
+    it->second->second.is_satisfiable = is_satisfiable;
+  }
+  IS_MODIFIED = true;
+}
+
+void ResultCache::PutModelCounter(const std::string key, const bool is_satisfiable,
+                                  const ModelCounter& model_counter) {
+  std::stringstream os;
+  {
+    cereal::BinaryOutputArchive ar(os);
+    model_counter.save(ar);
+  }
+  std::lock_guard<std::mutex> lock(MUTEX);
+  auto it = ENTRY_INDEX.find(key);
+  if (it == ENTRY_INDEX.end()) {
+    Insert(key, Entry { is_satisfiable, os.str() });
+  } else {
+    ENTRIES.splice(ENTRIES.begin(), ENTRIES, it->second);
+    it->second->second.is_satisfiable = is_satisfiable;
+    it->second->second.model_counter = os.str();
+  }
+  IS_MODIFIED = true;
+}
+
+/**
+ * File layout: magic, followed by entries from the most recently used to the least recently used
+ * [key length (uint32)][key][is satisfiable (uint8)][model counter size (uint32)][serialized model counter]
+ */
+bool ResultCache::Load(const std::string file_name) {
+  std::ifstream infile(file_name.c_str(), std::ios::binary);
+  if (!infile.good()) {
+    DVLOG(VLOG_LEVEL) << "result cache file does not exist: " << file_name;
+    return false;
+  }
+  std::string magic(MAGIC.size(), '\0');
+  infile.read(&magic[0], magic.size());
+  if (not infile.good() or magic != MAGIC) {
+    LOG(WARNING) << "not a result cache file: " << file_name;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(MUTEX);
+  EntryList entries;
+  uint32_t key_size = 0, model_counter_size = 0;
+  uint8_t is_satisfiable = 0;
+  while (infile.read(reinterpret_cast<char*>(&key_size), sizeof(key_size))) {
+    std::string key(key_size, '\0');
+    if (not infile.read(&key[0], key_size)
+        or not infile.read(reinterpret_cast<char*>(&is_satisfiable), sizeof(is_satisfiable))
+        or not infile.read(reinterpret_cast<char*>(&model_counter_size), sizeof(model_counter_size))) {
+      LOG(WARNING) << "result cache file is truncated: " << file_name;
+      break;
+    }
+    std::string model_counter(model_counter_size, '\0');
+    if (model_counter_size > 0 and not infile.read(&model_counter[0], model_counter_size)) {
+      LOG(WARNING) << "result cache file is truncated: " << file_name;
+      break;
+    }
+    entries.push_back(std::make_pair(key, Entry { is_satisfiable != 0, model_counter }));
+  }
+
+  // insert the least recently used ones first to keep the order
+  for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+    if (ENTRY_INDEX.find(it->first) == ENTRY_INDEX.end()) {
+      Insert(it->first, it->second);
+    }
+  }
+  DVLOG(VLOG_LEVEL) << "loaded " << entries.size() << " result cache entries from " << file_name;
+  return true;
+}
+
+bool ResultCache::Save(const std::string file_name) {
+  std::lock_guard<std::mutex> lock(MUTEX);
+  if (not IS_MODIFIED) {
+    return true;
+  }
+
+  const std::string tmp_file_name = file_name + ".tmp";
+  std::ofstream outfile(tmp_file_name.c_str(), std::ios::binary);
+  if (!outfile.good()) {
+    LOG(ERROR) << "cannot open file: " << tmp_file_name;
+    return false;
+  }
+  outfile.write(MAGIC.data(), MAGIC.size());
+  for (auto& entry : ENTRIES) {
+    uint32_t key_size = entry.first.size();
+    uint8_t is_satisfiable = entry.second.is_satisfiable ? 1 : 0;
+    uint32_t model_counter_size = entry.second.model_counter.size();
+    outfile.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    outfile.write(entry.first.data(), key_size);
+    outfile.write(reinterpret_cast<const char*>(&is_satisfiable), sizeof(is_satisfiable));
+    outfile.write(reinterpret_cast<const char*>(&model_counter_size), sizeof(model_counter_size));
+    outfile.write(entry.second.model_counter.data(), model_counter_size);
+  }
+  outfile.close();
+
+  if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+    LOG(ERROR) << "cannot write result cache file: " << file_name;
+    return false;
+  }
+  IS_MODIFIED = false;
+  DVLOG(VLOG_LEVEL) << "saved " << ENTRIES.size() << " result cache entries into " << file_name;
+  return true;
+}
+
+void ResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(MUTEX);
+  ENTRIES.clear();
+  ENTRY_INDEX.clear();
+  IS_MODIFIED = false;
+}
+
+void ResultCache::Insert(const std::string key, const Entry& entry) {
+  ENTRIES.push_front(std::make_pair(key, entry));
+  ENTRY_INDEX[key] = ENTRIES.begin();
+  Trim();
+}
+
+void ResultCache::Trim() {
+  while (ENTRIES.size() > SIZE) {
+    ENTRY_INDEX.erase(ENTRIES.back().first);
+    ENTRIES.pop_back();
+  }
+}
+
+} /* namespace Solver */
+} /* namespace Vlab */
@@ -0,0 +1,128 @@
+/*
+ * ResultCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_RESULTCACHE_H_
+#define SOLVER_RESULTCACHE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <glog/logging.h>
+
+#include "../cereal/archives/binary.hpp"
+#include "../theory/options/Theory.h"
+#include "../utils/RegularExpression.h"
+#include "ModelCounter.h"
+#include "options/Solver.h"
+
+namespace Vlab {
+namespace Solver {
+
+/**
+ * Results of solved queries keyed by their constraint fingerprints (see ConstraintFingerprint), shared by all drivers.
+ * Keeps at most the configured number of entries (see SetSize), least recently used ones are dropped first.
+ */
+class ResultCache {
+public:
+  struct Entry {
+    bool is_satisfiable;
+    /**
+     * Serialized model counter of all variables, empty until the query is counted
+     */
+    std::string model_counter;
+  };
+
+  /**
+   * Number of entries kept when a cache file is given without a cache size
+   */
+  static const int DEFAULT_SIZE;
+
+  /**
+   * Sets the number of entries kept for all drivers, drops the least recently used entries above it
+   * @param size
+   */
+  static void SetSize(const std::size_t size);
+
+  /**
+   * Extends a fingerprint with every option that can change the result or the count of a query;
+   * budgets, thread counts and paths are left out
+   * @param fingerprint
+   * @return
+   */
+  static std::string GetKey(const std::string fingerprint);
+
+  /**
+   * Finds the entry and marks it as the most recently used one
+   * @param key
+   * @param entry is set if the key is found
+   * @return true if the key is found
+   */
+  static bool Get(const std::string key, Entry& entry);
+
+  static void Put(const std::string key, const bool is_satisfiable);
+  /**
+   * Stores the model counter with the satisfiability of the query, the entry of the query may have been
+   * evicted since its result was stored
+   * @param key
+   * @param is_satisfiable
+   * @param model_counter
+   */
+  static void PutModelCounter(const std::string key, const bool is_satisfiable, const ModelCounter& model_counter);
+
+  /**
+   * Adds the entries in the file to the cache, entries already in the cache are kept
+   * @param file_name
+   * @return false if the file cannot be read
+   */
+  static bool Load(const std::string file_name);
+
+  /**
+   * Writes the cache into the file if it has changed since it is loaded or saved
+   * @param file_name
+   * @return false if the file cannot be written
+   */
+  static bool Save(const std::string file_name);
+
+  static void Clear();
+
+protected:
+  using EntryList = std::list<std::pair<std::string, Entry>>;
+
+  /**
+   * Inserts a new entry as the most recently used one and drops entries above the cache size
+   */
+  static void Insert(const std::string key, const Entry& entry);
+  static void Trim();
+
+  /**
+   * Entries ordered from the most recently used to the least recently used
+   */
+  static EntryList ENTRIES;
+  static std::unordered_map<std::string, EntryList::iterator> ENTRY_INDEX;
+  static bool IS_MODIFIED;
+  static std::size_t SIZE;
+  static std::mutex MUTEX;
+  static const std::string MAGIC;
+
+private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_RESULTCACHE_H_ */
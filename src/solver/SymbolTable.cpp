@@ -15,7 +15,8 @@ using namespace SMT;
 const int SymbolTable::VLOG_LEVEL = 10;
 
 SymbolTable::SymbolTable()
-  : global_assertion_result_(true) {
+  : global_assertion_result_(true),
+    is_fork_(false) {
   count_symbol_ = nullptr;
 }
 
@@ -35,6 +36,15 @@ SymbolTable::~SymbolTable() {
   }
   variable_projected_value_table_.clear();
 
+  if (is_fork_) {
+    for (auto& entry : variables_) {
+      if (shared_variables_.find(entry.second) == shared_variables_.end()) {
+        delete entry.second;
+      }
+    }
+    return;
+  }
+
   std::set<EquivalenceClass_ptr> equivalence_classes;
   for (auto& map_pair : variable_equivalence_table_) {
     for (auto& value_pair : map_pair.second) {
@@ -363,6 +373,7 @@ Value_ptr SymbolTable::get_projected_value_at_scope(Visitable_ptr scope, Variabl
   auto group_variable = get_group_variable_of(representative_variable);
   it = variable_value_table_[scope].find(group_variable);
   if (it != variable_value_table_[scope].end()) {
+    // project only the requested variable, the projection is cached for later lookups
     Value_ptr result = nullptr;
     if (Value::Type::BINARYINT_AUTOMATON == it->second->getType()) {
       auto relational_auto = it->second->getBinaryIntAutomaton();
@@ -421,6 +432,14 @@ bool SymbolTable::set_value(Variable_ptr variable, Value_ptr value) {
   } else {
     current_scope_values[group_variable] = value->clone();
   }
+  // projections of the old value are stale
+  auto pit = variable_projected_value_table_.find(top_scope());
+  if (pit != variable_projected_value_table_.end()) {
+    for (auto& projected_value : pit->second) {
+      delete projected_value.second;
+    }
+    variable_projected_value_table_.erase(pit);
+  }
   return value->is_satisfiable();
 }
 
@@ -673,6 +692,115 @@ void SymbolTable::remove_unsorted_constraint(Visitable_ptr term) {
 	last_constraints.erase(Ast2Dot::toString(term));
 }
 
+SymbolTable_ptr SymbolTable::fork(const std::set<Variable_ptr>& variables) {
+  SymbolTable_ptr forked_table = new SymbolTable();
+  forked_table->is_fork_ = true;
+  forked_table->global_assertion_result_ = global_assertion_result_;
+  forked_table->variables_ = variables_;
+  for (auto& entry : variables_) {
+    forked_table->shared_variables_.insert(entry.second);
+  }
+
+  // values can be stored under representative and group variables
+  auto& forked_variables = forked_table->forked_variables_;
+  for (auto variable : variables) {
+    forked_variables.insert(variable);
+    forked_variables.insert(get_group_variable_of(variable));
+    for (auto& map_pair : variable_equivalence_table_) {
+      auto representative_variable = get_representative_variable_of_at_scope(map_pair.first, variable);
+      forked_variables.insert(representative_variable);
+      forked_variables.insert(get_group_variable_of(representative_variable));
+    }
+  }
+
+  forked_table->scope_stack_ = scope_stack_;
+  forked_table->scopes_ = scopes_;
+  forked_table->variable_counts_table_ = variable_counts_table_;
+  forked_table->variable_equivalence_table_ = variable_equivalence_table_;
+  forked_table->variable_group_map_ = variable_group_map_;
+  for (auto& map_pair : variable_value_table_) {
+    for (auto& value_pair : map_pair.second) {
+      if (value_pair.second != nullptr and forked_variables.find(value_pair.first) != forked_variables.end()) {
+        forked_table->variable_value_table_[map_pair.first][value_pair.first] = value_pair.second->clone();
+      }
+    }
+  }
+  forked_table->term_children_table_ = term_children_table_;
+  forked_table->ite_conditions_ = ite_conditions_;
+  forked_table->last_constraints = last_constraints;
+  forked_table->count_symbol_ = count_symbol_;
+  return forked_table;
+}
+
+void SymbolTable::join(SymbolTable_ptr forked_table) {
+  auto joined_variables = join_variables(forked_table);
+  for (auto table : {&variable_value_table_, &variable_projected_value_table_}) {
+    for (auto& map_pair : *table) {
+      for (auto it = map_pair.second.begin(); it != map_pair.second.end(); ) {
+        if (joined_variables.find(it->first) != joined_variables.end()) {
+          delete it->second;
+          it = map_pair.second.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+
+  for (auto& map_pair : forked_table->variable_value_table_) {
+    join_values_at_scope(forked_table, map_pair.first, joined_variables);
+  }
+  scopes_.insert(forked_table->scopes_.begin(), forked_table->scopes_.end());
+}
+
+void SymbolTable::join(SymbolTable_ptr forked_table, Visitable_ptr scope) {
+  auto joined_variables = join_variables(forked_table);
+  for (auto& map_pair : forked_table->variable_value_table_) {
+    if (map_pair.first == scope or variable_value_table_.find(map_pair.first) == variable_value_table_.end()) {
+      join_values_at_scope(forked_table, map_pair.first, joined_variables);
+    }
+  }
+  scopes_.insert(forked_table->scopes_.begin(), forked_table->scopes_.end());
+}
+
+std::set<Variable_ptr> SymbolTable::join_variables(SymbolTable_ptr forked_table) {
+  CHECK(forked_table->is_fork_) << "only a forked table can be joined";
+  std::set<Variable_ptr> joined_variables = forked_table->forked_variables_;
+  for (auto& entry : forked_table->variables_) {
+    if (variables_.find(entry.first) == variables_.end()) {
+      variables_[entry.first] = entry.second;
+      forked_table->shared_variables_.insert(entry.second);
+      joined_variables.insert(entry.second);
+    }
+  }
+
+  for (auto& entry : forked_table->variable_group_map_) {
+    if (joined_variables.find(entry.first) != joined_variables.end()) {
+      variable_group_map_[variables_[entry.first->getName()]] = variables_[entry.second->getName()];
+    }
+  }
+  return joined_variables;
+}
+
+void SymbolTable::join_values_at_scope(SymbolTable_ptr forked_table, Visitable_ptr scope,
+                                       const std::set<Variable_ptr>& joined_variables) {
+  auto& forked_values = forked_table->variable_value_table_[scope];
+  auto& values = variable_value_table_[scope];
+  for (auto it = forked_values.begin(); it != forked_values.end(); ) {
+    if (it->second != nullptr and joined_variables.find(it->first) != joined_variables.end()) {
+      auto variable = variables_[it->first->getName()];
+      auto entry = values.find(variable);
+      if (entry != values.end()) {
+        delete entry->second;
+      }
+      values[variable] = it->second;
+      it = forked_values.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 std::string SymbolTable::generate_internal_name(std::string name, Variable::Type type) {
   std::stringstream ss;
   ss << "__vlab__";
@@ -133,11 +133,45 @@ public:
   bool is_unsorted_constraint(SMT::Visitable_ptr term);
   void remove_unsorted_constraint(SMT::Visitable_ptr term);
 
+  /**
+   * Creates a table that shares variables and equivalence classes with this table and has its own copies
+   * of the values of the given variables, a component that uses only those variables can be solved on it
+   * by another thread.
+   * @param variables
+   * @return
+   */
+  SymbolTable* fork(const std::set<SMT::Variable_ptr>& variables);
+
+  /**
+   * Replaces the values of the forked variables with the ones computed on the forked table,
+   * variables generated on the forked table are moved into this table
+   * @param forked_table
+   */
+  void join(SymbolTable* forked_table);
+
+  /**
+   * Replaces the values of the forked variables at the given scope and adds the values at the scopes that
+   * are visited only on the forked table, values at the other scopes are kept.
+   * Disjuncts of an or term are joined this way since each one updates only its own scope.
+   * @param forked_table
+   * @param scope
+   */
+  void join(SymbolTable* forked_table, SMT::Visitable_ptr scope);
+
 
 private:
   std::string generate_internal_name(std::string, SMT::Variable::Type);
+  std::set<SMT::Variable_ptr> join_variables(SymbolTable* forked_table);
+  void join_values_at_scope(SymbolTable* forked_table, SMT::Visitable_ptr scope, const std::set<SMT::Variable_ptr>& joined_variables);
 
   bool global_assertion_result_;
+
+  /**
+   * A forked table does not own the variables and equivalence classes of the table it is forked from
+   */
+  bool is_fork_;
+  std::set<SMT::Variable_ptr> forked_variables_;
+  std::set<SMT::Variable_ptr> shared_variables_;
   /**
    * Name to variable map
    */
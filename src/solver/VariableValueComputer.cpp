@@ -16,7 +16,7 @@ const int VariableValueComputer::VLOG_LEVEL = 12;
 // TODO intersect with result post
 VariableValueComputer::VariableValueComputer(SymbolTable_ptr symbol_table, VariablePathTable& variable_path_table, const TermValueMap& post_images)
         : is_satisfiable_{true}, symbol_table(symbol_table), variable_path_table (variable_path_table),
-          post_images (post_images), current_path (nullptr) {
+          post_images (post_images), current_path (nullptr), is_pruning_enabled (true) {
 }
 
 VariableValueComputer::~VariableValueComputer() {
@@ -33,6 +33,10 @@ void VariableValueComputer::start() {
   for (auto it = variable_path_table.rbegin(); it != variable_path_table.rend(); ++it) {
     current_path = &(*it);
     root_term = current_path->back();
+    // local variables of let terms are updated through their bindings, values under them are always propagated
+    is_pruning_enabled = std::none_of(current_path->begin(), current_path->end(), [](Term_ptr term) {
+      return Term::Type::LET == term->type();
+    });
 
     initial_value = getTermPreImage(root_term);
 
@@ -141,14 +145,14 @@ void VariableValueComputer::visitNot(Not_ptr not_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
   Value_ptr term_value = getTermPreImage(not_term);
   child_value = term_value->clone();
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitUMinus(UMinus_ptr u_minus_term) {
@@ -157,7 +161,7 @@ void VariableValueComputer::visitUMinus(UMinus_ptr u_minus_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -182,7 +186,7 @@ void VariableValueComputer::visitUMinus(UMinus_ptr u_minus_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitMinus(Minus_ptr minus_term) {
@@ -193,7 +197,7 @@ void VariableValueComputer::visitMinus(Minus_ptr minus_term) {
   Value_ptr result = nullptr;
 
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -212,7 +216,7 @@ void VariableValueComputer::visitMinus(Minus_ptr minus_term) {
   delete result; result = nullptr;
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 /**
@@ -224,7 +228,7 @@ void VariableValueComputer::visitPlus(Plus_ptr plus_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -281,7 +285,7 @@ void VariableValueComputer::visitPlus(Plus_ptr plus_term) {
   delete child_result; child_result = nullptr;
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitTimes(Times_ptr times_term) {
@@ -291,7 +295,7 @@ void VariableValueComputer::visitTimes(Times_ptr times_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -359,7 +363,7 @@ void VariableValueComputer::visitTimes(Times_ptr times_term) {
 
   child_value = child_post_value->intersect(child_result);
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitDiv(Div_ptr div_term) {
@@ -374,7 +378,7 @@ void VariableValueComputer::visitEq(Eq_ptr eq_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -387,7 +391,7 @@ void VariableValueComputer::visitEq(Eq_ptr eq_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 
@@ -400,7 +404,7 @@ void VariableValueComputer::visitNotEq(NotEq_ptr not_eq_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -428,7 +432,7 @@ void VariableValueComputer::visitNotEq(NotEq_ptr not_eq_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitGt(Gt_ptr gt_term) {
@@ -437,7 +441,7 @@ void VariableValueComputer::visitGt(Gt_ptr gt_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -464,7 +468,7 @@ void VariableValueComputer::visitGt(Gt_ptr gt_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitGe(Ge_ptr ge_term) {
@@ -473,7 +477,7 @@ void VariableValueComputer::visitGe(Ge_ptr ge_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -500,7 +504,7 @@ void VariableValueComputer::visitGe(Ge_ptr ge_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitLt(Lt_ptr lt_term) {
@@ -509,7 +513,7 @@ void VariableValueComputer::visitLt(Lt_ptr lt_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -536,7 +540,7 @@ void VariableValueComputer::visitLt(Lt_ptr lt_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitLe(Le_ptr le_term) {
@@ -545,7 +549,7 @@ void VariableValueComputer::visitLe(Le_ptr le_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -573,7 +577,7 @@ void VariableValueComputer::visitLe(Le_ptr le_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitConcat(Concat_ptr concat_term) {
@@ -583,7 +587,7 @@ void VariableValueComputer::visitConcat(Concat_ptr concat_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
   Value_ptr term_value = getTermPreImage(concat_term);
@@ -635,7 +639,7 @@ void VariableValueComputer::visitConcat(Concat_ptr concat_term) {
   child_value = new Value(child_post_value->getStringAutomaton()->Intersect(child_result_auto));
   delete child_result_auto; child_result_auto = nullptr;
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitIn(In_ptr in_term) {
@@ -649,7 +653,7 @@ void VariableValueComputer::visitIn(In_ptr in_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -657,7 +661,7 @@ void VariableValueComputer::visitIn(In_ptr in_term) {
 
   child_value = term_value->clone();
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitNotIn(NotIn_ptr not_in_term) {
@@ -671,14 +675,14 @@ void VariableValueComputer::visitNotIn(NotIn_ptr not_in_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
   Value_ptr term_value = getTermPreImage(not_in_term);
   child_value = term_value->clone();
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitLen(Len_ptr len_term) {
@@ -687,7 +691,7 @@ void VariableValueComputer::visitLen(Len_ptr len_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
   Value_ptr term_value = getTermPreImage(len_term);
@@ -699,7 +703,7 @@ void VariableValueComputer::visitLen(Len_ptr len_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitContains(Contains_ptr contains_term) {
@@ -709,7 +713,7 @@ void VariableValueComputer::visitContains(Contains_ptr contains_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -725,7 +729,7 @@ void VariableValueComputer::visitContains(Contains_ptr contains_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitNotContains(NotContains_ptr not_contains_term) {
@@ -735,7 +739,7 @@ void VariableValueComputer::visitNotContains(NotContains_ptr not_contains_term)
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -756,7 +760,7 @@ void VariableValueComputer::visitNotContains(NotContains_ptr not_contains_term)
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitBegins(Begins_ptr begins_term) {
@@ -766,7 +770,7 @@ void VariableValueComputer::visitBegins(Begins_ptr begins_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -782,7 +786,7 @@ void VariableValueComputer::visitBegins(Begins_ptr begins_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitNotBegins(NotBegins_ptr not_begins_term) {
@@ -792,7 +796,7 @@ void VariableValueComputer::visitNotBegins(NotBegins_ptr not_begins_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -812,7 +816,7 @@ void VariableValueComputer::visitNotBegins(NotBegins_ptr not_begins_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitEnds(Ends_ptr ends_term) {
@@ -821,7 +825,7 @@ void VariableValueComputer::visitEnds(Ends_ptr ends_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
   Value_ptr term_value = getTermPreImage(ends_term);
@@ -834,7 +838,7 @@ void VariableValueComputer::visitEnds(Ends_ptr ends_term) {
     delete suffixes_auto; suffixes_auto = nullptr;
   }
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitNotEnds(NotEnds_ptr not_ends_term) {
@@ -844,7 +848,7 @@ void VariableValueComputer::visitNotEnds(NotEnds_ptr not_ends_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -864,7 +868,7 @@ void VariableValueComputer::visitNotEnds(NotEnds_ptr not_ends_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitIndexOf(IndexOf_ptr index_of_term) {
@@ -878,7 +882,7 @@ void VariableValueComputer::visitIndexOf(IndexOf_ptr index_of_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -895,7 +899,7 @@ void VariableValueComputer::visitIndexOf(IndexOf_ptr index_of_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitLastIndexOf(LastIndexOf_ptr last_index_of_term) {
@@ -909,7 +913,7 @@ void VariableValueComputer::visitLastIndexOf(LastIndexOf_ptr last_index_of_term)
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -926,7 +930,7 @@ void VariableValueComputer::visitLastIndexOf(LastIndexOf_ptr last_index_of_term)
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 /**
@@ -940,7 +944,7 @@ void VariableValueComputer::visitCharAt(CharAt_ptr char_at_term) {
   Value_ptr child_value = getTermPreImage(child_term);
 
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -975,7 +979,7 @@ void VariableValueComputer::visitCharAt(CharAt_ptr char_at_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 /**
@@ -996,7 +1000,7 @@ void VariableValueComputer::visitSubString(SubString_ptr sub_string_term) {
 
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1092,7 +1096,7 @@ void VariableValueComputer::visitSubString(SubString_ptr sub_string_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 /**
@@ -1105,7 +1109,7 @@ void VariableValueComputer::visitToUpper(ToUpper_ptr to_upper_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1115,7 +1119,7 @@ void VariableValueComputer::visitToUpper(ToUpper_ptr to_upper_term) {
       ->PreToUpperCase(child_post_value->getStringAutomaton());
   child_value = new Value(child_pre_auto);
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitToLower(ToLower_ptr to_lower_term) {
@@ -1124,7 +1128,7 @@ void VariableValueComputer::visitToLower(ToLower_ptr to_lower_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1134,7 +1138,7 @@ void VariableValueComputer::visitToLower(ToLower_ptr to_lower_term) {
       ->PreToLowerCase(child_post_value->getStringAutomaton());
   child_value = new Value(child_pre_auto);
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitTrim(Trim_ptr trim_term) {
@@ -1143,7 +1147,7 @@ void VariableValueComputer::visitTrim(Trim_ptr trim_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1153,7 +1157,7 @@ void VariableValueComputer::visitTrim(Trim_ptr trim_term) {
       ->PreTrim(child_post_value->getStringAutomaton());
   child_value = new Value(child_pre_auto);
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitToString(ToString_ptr to_string_term) {
@@ -1162,7 +1166,7 @@ void VariableValueComputer::visitToString(ToString_ptr to_string_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1188,7 +1192,7 @@ void VariableValueComputer::visitToString(ToString_ptr to_string_term) {
   delete int_auto;
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitToInt(ToInt_ptr to_int_term) {
@@ -1197,7 +1201,7 @@ void VariableValueComputer::visitToInt(ToInt_ptr to_int_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1219,7 +1223,7 @@ void VariableValueComputer::visitToInt(ToInt_ptr to_int_term) {
 
   child_value = new Value(child_pre_auto);
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitReplace(Replace_ptr replace_term) {
@@ -1228,7 +1232,7 @@ void VariableValueComputer::visitReplace(Replace_ptr replace_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1248,7 +1252,7 @@ void VariableValueComputer::visitReplace(Replace_ptr replace_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitCount(Count_ptr count_term) {
@@ -1288,7 +1292,7 @@ void VariableValueComputer::visitUnknownTerm(Unknown_ptr unknown_term) {
   Term_ptr child_term = current_path->back();
   Value_ptr child_value = getTermPreImage(child_term);
   if (child_value not_eq nullptr) {
-    visit(child_term);
+    propagateTo(child_term);
     return;
   }
 
@@ -1307,7 +1311,7 @@ void VariableValueComputer::visitUnknownTerm(Unknown_ptr unknown_term) {
   }
 
   setTermPreImage(child_term, child_value);
-  visit(child_term);
+  propagateTo(child_term);
 }
 
 void VariableValueComputer::visitAsQualIdentifier(AsQualIdentifier_ptr as_qid_term) {
@@ -1365,6 +1369,11 @@ void VariableValueComputer::visitQualIdentifier(QualIdentifier_ptr qi_term) {
       break;
   }
 
+  if (isEqual(term_pre_value, symbol_table->get_value(qi_term->getVarName()))) {
+    DVLOG(VLOG_LEVEL) << "value is not changed: " << *qi_term;
+    return;
+  }
+  changed_variables.insert(qi_term->getVarName());
   is_satisfiable_ = symbol_table->IntersectValue(qi_term->getVarName(), term_pre_value) and is_satisfiable_;
 }
 
@@ -1408,6 +1417,10 @@ bool VariableValueComputer::is_satisfiable() {
   return is_satisfiable_;
 }
 
+const std::set<std::string>& VariableValueComputer::get_changed_variables() const {
+  return changed_variables;
+}
+
 Value_ptr VariableValueComputer::getTermPostImage(Term_ptr term) {
   auto iter = post_images.find(term);
   if (iter == post_images.end()) {
@@ -1432,6 +1445,84 @@ bool VariableValueComputer::setTermPreImage(Term_ptr term, Value_ptr value) {
   return result.second;
 }
 
+/**
+ * Pre-image operations give back at least the post image of a child when the value of its parent is not refined,
+ * propagation stops at the terms whose pre images are the same as their post images.
+ */
+void VariableValueComputer::propagateTo(Term_ptr term) {
+  if (isUnchanged(term)) {
+    DVLOG(VLOG_LEVEL) << "skip unchanged: " << *term;
+    return;
+  }
+  visit(term);
+}
+
+bool VariableValueComputer::isUnchanged(Term_ptr term) {
+  if (not is_pruning_enabled or Term::Type::QUALIDENTIFIER == term->type()) {
+    return false;
+  }
+  auto it = unchanged_terms.find(term);
+  if (it != unchanged_terms.end()) {
+    is_pruning_enabled = it->second;
+    return it->second;
+  }
+  auto pre_image = getTermPreImage(term);
+  bool is_unchanged = (pre_image not_eq nullptr) and isEqual(pre_image, getTermPostImage(term));
+  unchanged_terms[term] = is_unchanged;
+  // terms below a refined term are mostly refined too, they are not compared on this path
+  is_pruning_enabled = is_unchanged;
+  return is_unchanged;
+}
+
+/**
+ * Automata with different numbers of states are taken as different without a product construction;
+ * results of automata operations are minimized, an unminimized one only causes an extra propagation.
+ */
+bool VariableValueComputer::isEqual(Value_ptr value, Value_ptr other_value) {
+  if (value == other_value) {
+    return true;
+  } else if (value == nullptr or other_value == nullptr or value->getType() not_eq other_value->getType()) {
+    return false;
+  }
+
+  Theory::Automaton_ptr automaton = nullptr, other_automaton = nullptr;
+  switch (value->getType()) {
+    case Value::Type::BOOL_CONSTANT:
+      return value->getBoolConstant() == other_value->getBoolConstant();
+    case Value::Type::INT_CONSTANT:
+      return value->getIntConstant() == other_value->getIntConstant();
+    case Value::Type::BOOL_AUTOMATON:
+      automaton = value->getBoolAutomaton();
+      other_automaton = other_value->getBoolAutomaton();
+      break;
+    case Value::Type::INT_AUTOMATON:
+      automaton = value->getIntAutomaton();
+      other_automaton = other_value->getIntAutomaton();
+      break;
+    case Value::Type::BINARYINT_AUTOMATON:
+      automaton = value->getBinaryIntAutomaton();
+      other_automaton = other_value->getBinaryIntAutomaton();
+      break;
+    case Value::Type::STRING_AUTOMATON:
+      if (value->getStringAutomaton()->GetNumTracks() not_eq other_value->getStringAutomaton()->GetNumTracks()) {
+        return false;
+      }
+      automaton = value->getStringAutomaton();
+      other_automaton = other_value->getStringAutomaton();
+      break;
+    default:
+      return false;
+  }
+
+  if (automaton == other_automaton) {
+    return true;
+  } else if (automaton->GetNumberOfStates() not_eq other_automaton->GetNumberOfStates()
+      or automaton->get_number_of_bdd_variables() not_eq other_automaton->get_number_of_bdd_variables()) {
+    return false;
+  }
+  return automaton->IsEqual(other_automaton);
+}
+
 void VariableValueComputer::popTerm(Term_ptr term) {
   if (current_path->back() == term) {
     current_path->pop_back();
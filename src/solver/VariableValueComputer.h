@@ -8,8 +8,10 @@
 #ifndef SOLVER_VARIABLEVALUECOMPUTER_H_
 #define SOLVER_VARIABLEVALUECOMPUTER_H_
 
+#include <algorithm>
 #include <map>
 #include <iterator>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -108,11 +110,19 @@ public:
   void visitVariable(SMT::Variable_ptr) override;
 
   bool is_satisfiable();
+
+  /**
+   * @return names of the variables whose values are refined
+   */
+  const std::set<std::string>& get_changed_variables() const;
 protected:
   Value_ptr getTermPostImage(SMT::Term_ptr term);
   Value_ptr getTermPreImage(SMT::Term_ptr term);
   bool setTermPreImage(SMT::Term_ptr term, Value_ptr value);
   void popTerm(SMT::Term_ptr);
+  void propagateTo(SMT::Term_ptr term);
+  bool isUnchanged(SMT::Term_ptr term);
+  static bool isEqual(Value_ptr value, Value_ptr other_value);
 
   bool is_satisfiable_;
   SymbolTable_ptr symbol_table;
@@ -120,6 +130,12 @@ protected:
   const TermValueMap& post_images;
   TermValueMap pre_images;
   std::vector<SMT::Term_ptr>* current_path;
+  /**
+   * Terms are compared with their post images until the first refined one of a path, at most once per path
+   */
+  bool is_pruning_enabled;
+  std::map<SMT::Term_ptr, bool> unchanged_terms;
+  std::set<std::string> changed_variables;
 
 
 private:
@@ -0,0 +1,92 @@
+/*
+ * Options.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "Options.h"
+
+namespace Vlab {
+namespace Option {
+
+Options::Options()
+    : use_signed_integers_ { Solver::USE_SIGNED_INTEGERS },
+      use_multitrack_auto_ { Solver::USE_MULTITRACK_AUTO },
+      enable_equivalence_classes_ { Solver::ENABLE_EQUIVALENCE_CLASSES },
+      enable_dependency_analysis_ { Solver::ENABLE_DEPENDENCY_ANALYSIS },
+      enable_implications_ { Solver::ENABLE_IMPLICATIONS },
+      enable_len_implications_ { Solver::ENABLE_LEN_IMPLICATIONS },
+      enable_sorting_heuristics_ { Solver::ENABLE_SORTING_HEURISTICS },
+      enable_timing_refinement_ { Solver::ENABLE_TIMING_REFINEMENT },
+      force_dnf_formula_ { Solver::FORCE_DNF_FORMULA },
+      count_bound_exact_ { Solver::COUNT_BOUND_EXACT },
+      num_of_threads_ { Solver::NUM_OF_THREADS },
+      sat_only_mode_ { Solver::SAT_ONLY_MODE },
+      result_cache_size_ { Solver::RESULT_CACHE_SIZE },
+      result_cache_file_ { Solver::RESULT_CACHE_FILE },
+      timeout_ { Solver::TIMEOUT },
+      memory_limit_ { Solver::MEMORY_LIMIT },
+      output_path_ { Solver::OUTPUT_PATH },
+      script_path_ { Solver::SCRIPT_PATH },
+      tmp_path_ { Theory::TMP_PATH },
+      theory_script_path_ { Theory::SCRIPT_PATH },
+      regex_cache_file_ { Theory::REGEX_CACHE_FILE },
+      defer_minimization_ { Theory::DEFER_MINIMIZATION },
+      deferred_minimization_limit_ { Theory::DEFERRED_MINIMIZATION_LIMIT },
+      use_native_minimization_ { Theory::USE_NATIVE_MINIMIZATION },
+      use_direct_index_constructions_ { Theory::USE_DIRECT_INDEX_CONSTRUCTIONS },
+      int_bit_width_ { Theory::INT_BIT_WIDTH },
+      theory_count_bound_exact_ { Theory::COUNT_BOUND_EXACT },
+      regex_flag_ { Util::RegularExpression::DEFAULT } {
+}
+
+Options::~Options() {
+}
+
+void Options::Activate() const {
+  Solver::USE_SIGNED_INTEGERS = use_signed_integers_;
+  Solver::USE_MULTITRACK_AUTO = use_multitrack_auto_;
+  Solver::ENABLE_EQUIVALENCE_CLASSES = enable_equivalence_classes_;
+  Solver::ENABLE_DEPENDENCY_ANALYSIS = enable_dependency_analysis_;
+  Solver::ENABLE_IMPLICATIONS = enable_implications_;
+  Solver::ENABLE_LEN_IMPLICATIONS = enable_len_implications_;
+  Solver::ENABLE_SORTING_HEURISTICS = enable_sorting_heuristics_;
+  Solver::ENABLE_TIMING_REFINEMENT = enable_timing_refinement_;
+  Solver::FORCE_DNF_FORMULA = force_dnf_formula_;
+  Solver::COUNT_BOUND_EXACT = count_bound_exact_;
+  Solver::NUM_OF_THREADS = num_of_threads_;
+  Solver::SAT_ONLY_MODE = sat_only_mode_;
+  Solver::RESULT_CACHE_SIZE = result_cache_size_;
+  Solver::RESULT_CACHE_FILE = result_cache_file_;
+  Solver::TIMEOUT = timeout_;
+  Solver::MEMORY_LIMIT = memory_limit_;
+  Solver::OUTPUT_PATH = output_path_;
+  Solver::SCRIPT_PATH = script_path_;
+
+  Theory::TMP_PATH = tmp_path_;
+  Theory::SCRIPT_PATH = theory_script_path_;
+  Theory::REGEX_CACHE_FILE = regex_cache_file_;
+  Theory::DEFER_MINIMIZATION = defer_minimization_;
+  Theory::DEFERRED_MINIMIZATION_LIMIT = deferred_minimization_limit_;
+  Theory::USE_NATIVE_MINIMIZATION = use_native_minimization_;
+  Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = use_direct_index_constructions_;
+  Theory::INT_BIT_WIDTH = int_bit_width_;
+  Theory::COUNT_BOUND_EXACT = theory_count_bound_exact_;
+
+  Util::RegularExpression::DEFAULT = regex_flag_;
+}
+
+Options::Scope::Scope(const Options& options) {
+  options.Activate();
+}
+
+Options::Scope::~Scope() {
+  previous_options_.Activate();
+}
+
+} /* namespace Option */
+} /* namespace Vlab */
@@ -0,0 +1,95 @@
+/*
+ * Options.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_OPTIONS_OPTIONS_H_
+#define SRC_OPTIONS_OPTIONS_H_
+
+#include <string>
+
+#include "Solver.h"
+#include "../../theory/options/Theory.h"
+#include "../../utils/RegularExpression.h"
+
+namespace Vlab {
+namespace Option {
+
+/**
+ * Values of all solver and theory options, each driver owns one.
+ * Components read options from the thread local statics of Option::Solver, Option::Theory and
+ * Util::RegularExpression::DEFAULT; a driver activates its values on the calling thread for the
+ * duration of each call, so drivers running in different threads do not see each other's options.
+ */
+class Options {
+public:
+  /**
+   * Captures the values active on the calling thread
+   */
+  Options();
+  virtual ~Options();
+
+  /**
+   * Makes these values the active ones on the calling thread
+   */
+  void Activate() const;
+
+  class Scope;
+
+protected:
+  bool use_signed_integers_;
+  bool use_multitrack_auto_;
+  bool enable_equivalence_classes_;
+  bool enable_dependency_analysis_;
+  bool enable_implications_;
+  bool enable_len_implications_;
+  bool enable_sorting_heuristics_;
+  bool enable_timing_refinement_;
+  bool force_dnf_formula_;
+  bool count_bound_exact_;
+  int num_of_threads_;
+  bool sat_only_mode_;
+  int result_cache_size_;
+  std::string result_cache_file_;
+  int timeout_;
+  int memory_limit_;
+  std::string output_path_;
+  std::string script_path_;
+
+  std::string tmp_path_;
+  std::string theory_script_path_;
+  std::string regex_cache_file_;
+  bool defer_minimization_;
+  int deferred_minimization_limit_;
+  bool use_native_minimization_;
+  bool use_direct_index_constructions_;
+  int int_bit_width_;
+  bool theory_count_bound_exact_;
+
+  int regex_flag_;
+};
+
+/**
+ * Activates the given values and restores the previously active ones when it goes out of scope
+ */
+class Options::Scope {
+public:
+  Scope(const Options& options);
+  ~Scope();
+
+private:
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  const Options previous_options_;
+};
+
+} /* namespace Option */
+} /* namespace Vlab */
+
+#endif /* SRC_OPTIONS_OPTIONS_H_ */
@@ -13,17 +13,24 @@
 namespace Vlab {
 namespace Option {
 
-bool Solver::USE_SIGNED_INTEGERS = true;
-bool Solver::USE_MULTITRACK_AUTO = true;
-bool Solver::ENABLE_EQUIVALENCE_CLASSES = true;
-bool Solver::ENABLE_DEPENDENCY_ANALYSIS = true;
-bool Solver::ENABLE_IMPLICATIONS = true;
-bool Solver::ENABLE_LEN_IMPLICATIONS = true;
-bool Solver::ENABLE_SORTING_HEURISTICS = false;
-bool Solver::FORCE_DNF_FORMULA = false;
-bool Solver::COUNT_BOUND_EXACT = false;
+thread_local bool Solver::USE_SIGNED_INTEGERS = true;
+thread_local bool Solver::USE_MULTITRACK_AUTO = true;
+thread_local bool Solver::ENABLE_EQUIVALENCE_CLASSES = true;
+thread_local bool Solver::ENABLE_DEPENDENCY_ANALYSIS = true;
+thread_local bool Solver::ENABLE_IMPLICATIONS = true;
+thread_local bool Solver::ENABLE_LEN_IMPLICATIONS = true;
+thread_local bool Solver::ENABLE_SORTING_HEURISTICS = false;
+thread_local bool Solver::ENABLE_TIMING_REFINEMENT = false;
+thread_local bool Solver::FORCE_DNF_FORMULA = false;
+thread_local bool Solver::COUNT_BOUND_EXACT = false;
+thread_local int Solver::NUM_OF_THREADS = 1;
+thread_local bool Solver::SAT_ONLY_MODE = false;
+thread_local int Solver::RESULT_CACHE_SIZE = 0;
+thread_local std::string Solver::RESULT_CACHE_FILE = "";
+thread_local int Solver::TIMEOUT = 0;
+thread_local int Solver::MEMORY_LIMIT = 0;
 
-std::string Solver::OUTPUT_PATH         = ".";
-std::string Solver::SCRIPT_PATH         = ".";
+thread_local std::string Solver::OUTPUT_PATH         = ".";
+thread_local std::string Solver::SCRIPT_PATH         = ".";
 } /* namespace Option */
 } /* namespace Vlab */
@@ -34,22 +34,55 @@ enum class Name: int {
 	COUNT_BOUND_EXACT,
   REGEX_FLAG,
   OUTPUT_PATH,
-  SCRIPT_PATH
+  SCRIPT_PATH,
+  REGEX_CACHE_FILE,
+  ENABLE_DEFERRED_MINIMIZATION,
+  DISABLE_DEFERRED_MINIMIZATION,
+  ENABLE_NATIVE_MINIMIZATION,
+  DISABLE_NATIVE_MINIMIZATION,
+  INT_BIT_WIDTH,
+  ENABLE_DIRECT_INDEX_CONSTRUCTIONS,
+  DISABLE_DIRECT_INDEX_CONSTRUCTIONS,
+  NUM_OF_THREADS,
+  SAT_ONLY_MODE,
+  RESULT_CACHE_SIZE,
+  RESULT_CACHE_FILE,
+  TIMEOUT,
+  MEMORY_LIMIT,
+  ENABLE_TIMING_REFINEMENT,
+  DISABLE_TIMING_REFINEMENT
 };
 
+/**
+ * Options are thread local, a driver installs its own values on the thread it runs on (see Option::Options)
+ */
 class Solver {
 public:
-  static bool USE_SIGNED_INTEGERS;
-  static bool USE_MULTITRACK_AUTO;
-  static bool ENABLE_EQUIVALENCE_CLASSES;
-  static bool ENABLE_DEPENDENCY_ANALYSIS;
-  static bool ENABLE_IMPLICATIONS;
-  static bool ENABLE_LEN_IMPLICATIONS;
-  static bool ENABLE_SORTING_HEURISTICS;
-  static bool FORCE_DNF_FORMULA;
-  static bool COUNT_BOUND_EXACT;
-  static std::string OUTPUT_PATH;
-  static std::string SCRIPT_PATH;
+  static thread_local bool USE_SIGNED_INTEGERS;
+  static thread_local bool USE_MULTITRACK_AUTO;
+  static thread_local bool ENABLE_EQUIVALENCE_CLASSES;
+  static thread_local bool ENABLE_DEPENDENCY_ANALYSIS;
+  static thread_local bool ENABLE_IMPLICATIONS;
+  static thread_local bool ENABLE_LEN_IMPLICATIONS;
+  static thread_local bool ENABLE_SORTING_HEURISTICS;
+  /**
+   * Scales the estimated costs of the sorting heuristics with the solving times of earlier queries of the
+   * driver; the order then depends on timings and is not reproducible
+   */
+  static thread_local bool ENABLE_TIMING_REFINEMENT;
+  static thread_local bool FORCE_DNF_FORMULA;
+  static thread_local bool COUNT_BOUND_EXACT;
+  static thread_local int NUM_OF_THREADS;
+  static thread_local bool SAT_ONLY_MODE;
+  static thread_local int RESULT_CACHE_SIZE;
+  static thread_local std::string RESULT_CACHE_FILE;
+  /**
+   * Budgets of each call of a query, in milliseconds and megabytes; 0 for no limit
+   */
+  static thread_local int TIMEOUT;
+  static thread_local int MEMORY_LIMIT;
+  static thread_local std::string OUTPUT_PATH;
+  static thread_local std::string SCRIPT_PATH;
 };
 
 } /* namespace Option */
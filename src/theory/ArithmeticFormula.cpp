@@ -231,6 +231,7 @@ ArithmeticFormula_ptr ArithmeticFormula::Add(ArithmeticFormula_ptr other_formula
       result->variable_coefficient_map_.insert(el);
     }
   }
+  result->UpdateVariableIndices();
   result->constant_ = result->constant_ + other_formula->constant_;
 
   result->mixed_terms_.insert(other_formula->mixed_terms_.begin(), other_formula->mixed_terms_.end());
@@ -252,6 +253,7 @@ ArithmeticFormula_ptr ArithmeticFormula::Subtract(ArithmeticFormula_ptr other_fo
       result->variable_coefficient_map_[el.first] = -el.second;
     }
   }
+  result->UpdateVariableIndices();
 
   result->constant_ = result->constant_ - other_formula->constant_;
 
@@ -377,6 +379,7 @@ void ArithmeticFormula::MergeVariables(Formula_ptr formula) {
       variable_coefficient_map_[el.first] = 0;
     }
   }
+  UpdateVariableIndices();
   mixed_terms_.insert(other->mixed_terms_.begin(), other->mixed_terms_.end());
 }
 
@@ -12,13 +12,13 @@ namespace Theory {
 
 const int Automaton::VLOG_LEVEL = 9;
 
-int Automaton::name_counter = 0;
-int Automaton::next_state = 0;
+std::atomic<int> Automaton::name_counter {0};
+thread_local int Automaton::next_state = 0;
 
-unsigned long Automaton::next_id = 0;
+std::atomic<unsigned long> Automaton::next_id {0};
 
 std::unordered_map<int, int*> Automaton::bdd_variable_indices;
-bool Automaton::count_bound_exact_;
+std::mutex Automaton::bdd_variable_indices_mutex;
 
 const std::string Automaton::Name::NONE = "none";
 const std::string Automaton::Name::BOOL = "BoolAutomaton";
@@ -28,17 +28,23 @@ const std::string Automaton::Name::STRING = "StringAutomaton";
 const std::string Automaton::Name::BINARYINT = "BinaryIntAutomaton";
 
 Automaton::Automaton(Automaton::Type type)
-        : type_(type), is_counter_cached_{false}, dfa_(nullptr), num_of_bdd_variables_(0), id_(Automaton::next_id++) {
+        : type_(type), is_counter_cached_{false}, dfa_(nullptr), num_of_bdd_variables_(0), id_(Automaton::next_id++),
+          charged_budget_(nullptr), charged_memory_(0) {
 }
 
 Automaton::Automaton(Automaton::Type type, DFA_ptr dfa, int num_of_variables)
-        : type_(type), is_counter_cached_{false}, dfa_(dfa), num_of_bdd_variables_(num_of_variables), id_(Automaton::next_id++) { }
+        : type_(type), is_counter_cached_{false}, dfa_(dfa), num_of_bdd_variables_(num_of_variables), id_(Automaton::next_id++),
+          charged_budget_(nullptr), charged_memory_(0) {
+  ChargeMemory();
+}
 
 Automaton::Automaton(const Automaton& other)
-        : type_(other.type_), is_counter_cached_{false}, dfa_(nullptr), num_of_bdd_variables_(other.num_of_bdd_variables_), id_(Automaton::next_id++) {
+        : type_(other.type_), is_counter_cached_{false}, dfa_(nullptr), num_of_bdd_variables_(other.num_of_bdd_variables_), id_(Automaton::next_id++),
+          charged_budget_(nullptr), charged_memory_(0) {
           if (other.dfa_)
           {
-            dfa_ = dfaCopy(other.dfa_);
+            dfa_ = DFACopy(other.dfa_);
+            ChargeMemory();
           }
 }
 
@@ -46,6 +52,7 @@ Automaton::~Automaton() {
 	if(dfa_ != nullptr) {
 		dfaFree(dfa_);
 	}
+	Util::Cancellation::Refund(charged_budget_, charged_memory_);
 //  DVLOG(VLOG_LEVEL) << "deleted " << " [" << this->id_ << "]";
 }
 
@@ -149,6 +156,32 @@ int Automaton::GetSinkState() const {
   return sink_state;
 }
 
+int Automaton::GetNumberOfStates() const {
+  return this->dfa_->ns;
+}
+
+int Automaton::GetNumberOfBddNodes() const {
+  unsigned l, r, index; // BDD traversal variables
+  std::set<unsigned> visited;
+  std::vector<unsigned> nodes;
+  for (int s = 0; s < this->dfa_->ns; ++s) {
+    nodes.push_back(this->dfa_->q[s]);
+    while (not nodes.empty()) {
+      unsigned p = nodes.back();
+      nodes.pop_back();
+      if (not visited.insert(p).second) {
+        continue;
+      }
+      LOAD_lri(&this->dfa_->bddm->node_table[p], l, r, index);
+      if (index != BDD_LEAF_INDEX) {
+        nodes.push_back(l);
+        nodes.push_back(r);
+      }
+    }
+  }
+  return visited.size();
+}
+
 Automaton_ptr Automaton::Complement() {
   DFA_ptr complement_dfa = Automaton::DFAComplement(this->dfa_);
   Automaton_ptr complement_auto = MakeAutomaton(complement_dfa, this->GetFormula()->Complement(), num_of_bdd_variables_);
@@ -335,6 +368,7 @@ std::map<std::string,std::vector<std::string>> Automaton::GetModelsWithinBound(i
 
 	std::vector<int> shortest_accepting_path(this->dfa_->ns,INT_MAX);
 	for(int start_state = 0; start_state < this->dfa_->ns; start_state++) {
+		Util::Cancellation::Check();
 		distances[start_state] = 0;
 		states_to_process.push(start_state);
 
@@ -445,6 +479,7 @@ std::map<std::string,std::vector<std::string>> Automaton::GetModelsWithinBound(i
 
 	// BLASTOFF!
 	while(not models_to_process.empty() and get_more_models) {
+		Util::Cancellation::Check();
 		std::pair<int,std::vector<char>> current_model = models_to_process.top();
 		models_to_process.pop();
 
@@ -457,7 +492,7 @@ std::map<std::string,std::vector<std::string>> Automaton::GetModelsWithinBound(i
 
 		// check if its final state; if so, record the model
 		if(this->dfa_->f[current_state] == 1) {
-			if((count_bound_exact_ and length == bound) or (not count_bound_exact_ and length <= bound)) {
+			if((Option::Theory::COUNT_BOUND_EXACT and length == bound) or (not Option::Theory::COUNT_BOUND_EXACT and length <= bound)) {
 
 				int num_x = 0;
 				for(int k = 0; k < current_model.second.size(); k++) {
@@ -606,10 +641,6 @@ std::map<std::string,std::vector<std::string>> Automaton::GetModelsWithinBound(i
 	return variable_values;
 }
 
-void Automaton::SetCountBoundExact(bool value) {
-	count_bound_exact_ = value;
-}
-
 bool Automaton::isCyclic(int state, std::map<int, bool>& is_discovered, std::map<int, bool>& is_stack_member) {
   if (not is_discovered[state]) {
     is_discovered[state] = true;
@@ -675,6 +706,120 @@ Graph_ptr Automaton::toGraph() {
   return graph;
 }
 
+/**
+ * Each state is written as the number of its bdd paths and, for each path, the target state and the
+ * packed 2-bit values of the bdd variables
+ */
+void Automaton::DFAExportBinary(const DFA_ptr dfa, const int number_of_bdd_variables, std::ostream& out) {
+  auto write_int = [&out](int32_t value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  const int path_size = (2 * number_of_bdd_variables + 7) / 8;
+
+  write_int(dfa->ns);
+  write_int(dfa->s);
+  for (int s = 0; s < dfa->ns; ++s) {
+    out.put((char) dfa->f[s]);
+  }
+
+  std::vector<std::pair<int, std::string>> state_paths;
+  std::string packed_path (path_size, '\0');
+  for (int s = 0; s < dfa->ns; ++s) {
+    paths state_bdd_paths, pp;
+    state_bdd_paths = pp = make_paths(dfa->bddm, dfa->q[s]);
+    while (pp) {
+      // 2 for 'X'
+      std::fill(packed_path.begin(), packed_path.end(), (char) 0xAA);
+      for (trace_descr tp = pp->trace; tp; tp = tp->next) {
+        const int bit = 2 * tp->index;
+        packed_path[bit / 8] &= ~(3 << (bit % 8));
+        packed_path[bit / 8] |= (tp->value ? 1 : 0) << (bit % 8);
+      }
+      state_paths.push_back(std::make_pair(pp->to, packed_path));
+      pp = pp->next;
+    }
+    kill_paths(state_bdd_paths);
+
+    write_int(state_paths.size());
+    for (auto& path : state_paths) {
+      write_int(path.first);
+      out.write(path.second.data(), path_size);
+    }
+    state_paths.clear();
+  }
+}
+
+/**
+ * The whole input is validated before the builder is set up, malformed data returns nullptr
+ */
+DFA_ptr Automaton::DFAImportBinary(const char* data, const std::size_t size, const int number_of_bdd_variables) {
+  const int path_size = (2 * number_of_bdd_variables + 7) / 8;
+  std::size_t position = 0;
+  auto read_int = [&](int32_t& value) {
+    if (position + sizeof(value) > size) {
+      return false;
+    }
+    std::memcpy(&value, data + position, sizeof(value));
+    position += sizeof(value);
+    return true;
+  };
+
+  int32_t number_of_states = 0, initial_state = 0;
+  if (not read_int(number_of_states) or not read_int(initial_state) or number_of_states <= 0
+      or position + number_of_states > size) {
+    return nullptr;
+  }
+  std::string statuses (number_of_states, '-');
+  for (int s = 0; s < number_of_states; ++s) {
+    const signed char status = data[position++];
+    statuses[s] = (status == 1) ? '+' : ((status == 0) ? '0' : '-');
+  }
+
+  // validate before touching MONA builder state
+  const std::size_t state_section = position;
+  for (int s = 0; s < number_of_states; ++s) {
+    int32_t number_of_paths = 0, to_state = 0;
+    if (not read_int(number_of_paths) or number_of_paths <= 0) {
+      return nullptr;
+    }
+    for (int i = 0; i < number_of_paths; ++i) {
+      if (not read_int(to_state) or to_state < 0 or to_state >= number_of_states or position + path_size > size) {
+        return nullptr;
+      }
+      position += path_size;
+    }
+  }
+  position = state_section;
+
+  std::string exception (number_of_bdd_variables + 1, '\0');
+  DFABuilder builder(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  for (int s = 0; s < number_of_states; ++s) {
+    int32_t number_of_paths = 0, to_state = 0;
+    read_int(number_of_paths);
+    // paths partition the input space, last one becomes the default transition
+    builder.AllocExceptions(number_of_paths - 1);
+    for (int i = 0; i < number_of_paths; ++i) {
+      read_int(to_state);
+      if (i == number_of_paths - 1) {
+        position += path_size;
+        builder.StoreState(to_state);
+        break;
+      }
+      for (int v = 0; v < number_of_bdd_variables; ++v) {
+        const int bit = 2 * v;
+        const int value = (data[position + bit / 8] >> (bit % 8)) & 3;
+        exception[v] = (value == 0) ? '0' : ((value == 1) ? '1' : 'X');
+      }
+      position += path_size;
+      builder.StoreException(to_state, &exception[0]);
+    }
+  }
+
+  DFA_ptr result_dfa = builder.Build(&statuses[0]);
+  result_dfa->s = initial_state;
+  return result_dfa;
+}
+
 /**
  * Assumes automaton is minimized and there is a sink state
  * @returns true if automaton is a singleton
@@ -828,6 +973,7 @@ bool Automaton::getAnAcceptingWord(NextState& state, std::map<int, bool>& is_sta
 }
 
 char* Automaton::getAnExample(bool accepting) {
+  MonaLock lock;
   return dfaMakeExample(this->dfa_, 1, num_of_bdd_variables_, (unsigned*)GetBddVariableIndices(num_of_bdd_variables_));
 }
 
@@ -836,6 +982,7 @@ std::ostream& operator<<(std::ostream& os, const Automaton& automaton) {
 }
 
 void Automaton::CleanUp() {
+	std::lock_guard<std::mutex> lock(bdd_variable_indices_mutex);
 	for(auto &it : bdd_variable_indices) {
 		delete[] it.second;
 		it.second = nullptr;
@@ -910,13 +1057,13 @@ bool Automaton::DFAIsOneStepAway(const DFA_ptr dfa, const int from_state, const
 }
 
 bool Automaton::DFAIsEqual(const DFA_ptr dfa1, const DFA_ptr dfa2) {
-  DFA_ptr impl_1 = dfaProduct(dfa1, dfa2, dfaIMPL);
-  DFA_ptr impl_2 = dfaProduct(dfa2, dfa1, dfaIMPL);
-  DFA_ptr result_dfa = dfaProduct(impl_1,impl_2,dfaAND);
+  DFA_ptr impl_1 = DFAProduct(dfa1, dfa2, dfaIMPL);
+  DFA_ptr impl_2 = DFAProduct(dfa2, dfa1, dfaIMPL);
+  DFA_ptr result_dfa = DFAProduct(impl_1,impl_2,dfaAND);
   dfaFree(impl_1);
   dfaFree(impl_2);
-  dfaNegation(result_dfa);
-  DFA_ptr minimized_dfa = dfaMinimize(result_dfa);
+  DFANegation(result_dfa);
+  DFA_ptr minimized_dfa = DFAMinimize(result_dfa);
   dfaFree(result_dfa);
   bool result = DFAIsMinimizedEmtpy(minimized_dfa);
   dfaFree(minimized_dfa);
@@ -938,10 +1085,10 @@ int Automaton::DFAGetSinkState(const DFA_ptr dfa) {
 
 DFA_ptr Automaton::DFAMakePhi(const int number_of_bdd_variables) {
   char statuses[1] {'-'};
-  dfaSetup(1, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
-  dfaAllocExceptions(0);
-  dfaStoreState(0);
-  return dfaBuild(statuses);
+  DFABuilder builder(1, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  builder.AllocExceptions(0);
+  builder.StoreState(0);
+  return builder.Build(statuses);
 }
 
 /**
@@ -950,10 +1097,10 @@ DFA_ptr Automaton::DFAMakePhi(const int number_of_bdd_variables) {
  */
 DFA_ptr Automaton::DFAMakeAny(const int number_of_bdd_variables) {
   char statuses[1] {'+'};
-  dfaSetup(1, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
-  dfaAllocExceptions(0);
-  dfaStoreState(0);
-  return dfaBuild(statuses);
+  DFABuilder builder(1, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  builder.AllocExceptions(0);
+  builder.StoreState(0);
+  return builder.Build(statuses);
 }
 
 /**
@@ -962,76 +1109,440 @@ DFA_ptr Automaton::DFAMakeAny(const int number_of_bdd_variables) {
  */
 DFA_ptr Automaton::DFAMakeAnyButNotEmpty(const int number_of_bdd_variables) {
   char statuses[2] { '-', '+' };
-  dfaSetup(2, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
-  dfaAllocExceptions(0);
-  dfaStoreState(1);
-  dfaAllocExceptions(0);
-  dfaStoreState(1);
-  return dfaBuild(statuses);
+  DFABuilder builder(2, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  builder.AllocExceptions(0);
+  builder.StoreState(1);
+  builder.AllocExceptions(0);
+  builder.StoreState(1);
+  return builder.Build(statuses);
 }
 
 DFA_ptr Automaton::DFAMakeEmpty(const int number_of_bdd_variables) {
   char statuses[2] { '+', '-' };
-  dfaSetup(2, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
-  dfaAllocExceptions(0);
-  dfaStoreState(1);
-  dfaAllocExceptions(0);
-  dfaStoreState(1);
-  return dfaBuild(statuses);
+  DFABuilder builder(2, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  builder.AllocExceptions(0);
+  builder.StoreState(1);
+  builder.AllocExceptions(0);
+  builder.StoreState(1);
+  return builder.Build(statuses);
 }
 
 DFA_ptr Automaton::DFAComplement(const DFA_ptr dfa) {
-  DFA_ptr complement_dfa = dfaCopy(dfa);
+  DFA_ptr complement_dfa = DFACopy(dfa);
   dfaNegation(complement_dfa);
   return complement_dfa;
 }
 
+DFA_ptr Automaton::DFACopy(const DFA_ptr dfa) {
+  MonaLock lock;
+  return dfaCopy(dfa);
+}
+
+/**
+ * Each state keeps its bdd root and status, each bdd node a record of its children and variable
+ */
+std::size_t Automaton::DFAMemorySize(const DFA_ptr dfa) {
+  return static_cast<std::size_t>(dfa->ns) * (sizeof(bdd_ptr) + sizeof(int))
+      + static_cast<std::size_t>(bdd_size(dfa->bddm)) * sizeof(bdd_record);
+}
+
+void Automaton::ChargeMemory() {
+  auto budget = Util::Cancellation::GetBudget();
+  if (dfa_ == nullptr or budget == nullptr) {
+    return;
+  }
+  charged_budget_ = budget;
+  charged_memory_ = DFAMemorySize(dfa_);
+  Util::Cancellation::Charge(charged_memory_);
+}
+
+DFA_ptr Automaton::DFAProduct(const DFA_ptr dfa1, const DFA_ptr dfa2, const dfaProductType product_type) {
+  Util::Cancellation::Check();
+  MonaLock lock;
+  return dfaProduct(dfa1, dfa2, product_type);
+}
+
+DFA_ptr Automaton::DFAProject(const DFA_ptr dfa, const unsigned index) {
+  Util::Cancellation::Check();
+  MonaLock lock;
+  return dfaProject(dfa, index);
+}
+
+void Automaton::DFANegation(DFA_ptr dfa) {
+  dfaNegation(dfa);
+}
+
+DFA_ptr Automaton::DFAMinimize(const DFA_ptr dfa) {
+  Util::Cancellation::Check();
+  if (Option::Theory::USE_NATIVE_MINIMIZATION) {
+    return DFAMinimizeNative(dfa);
+  }
+  MonaLock lock;
+  return dfaMinimize(dfa);
+}
+
+DFA_ptr Automaton::DFAMinimizeIntermediate(DFA_ptr dfa) {
+  if (Option::Theory::DEFER_MINIMIZATION and dfa->ns <= Option::Theory::DEFERRED_MINIMIZATION_LIMIT) {
+    return dfa;
+  }
+  DFA_ptr minimized_dfa = DFAMinimize(dfa);
+  dfaFree(dfa);
+  return minimized_dfa;
+}
+
+DFA_ptr Automaton::DFAMinimizeDeferred(DFA_ptr dfa) {
+  if (not Option::Theory::DEFER_MINIMIZATION) {
+    return dfa;
+  }
+  DFA_ptr minimized_dfa = DFAMinimize(dfa);
+  dfaFree(dfa);
+  return minimized_dfa;
+}
+
+std::future<DFA_ptr> Automaton::DFAMinimizeAsync(const DFA_ptr dfa) {
+  if (Option::Theory::USE_NATIVE_MINIMIZATION) {
+    return std::async(std::launch::async, DFAMinimizeNative, dfa);
+  }
+  // MONA builds results in global state, it has to run on the calling thread
+  return std::async(std::launch::deferred, DFAMinimize, dfa);
+}
+
+/**
+ * Moore style partition refinement. A state's signature is its bdd where each leaf is replaced by the block of the
+ * target state; signatures are computed bottom up over the flattened bdd nodes in one pass per round.
+ */
+DFA_ptr Automaton::DFAMinimizeNative(const DFA_ptr dfa) {
+  struct TripleHash {
+    std::size_t operator()(const std::tuple<unsigned, int, int>& key) const {
+      std::size_t seed = std::get<0>(key);
+      seed ^= std::hash<int>()(std::get<1>(key)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      seed ^= std::hash<int>()(std::get<2>(key)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      return seed;
+    }
+  };
+
+  const int number_of_states = dfa->ns;
+  bdd_manager* bddm = dfa->bddm;
+  unsigned l, r, index; // BDD traversal variables
+
+  // flatten bdd nodes, children are placed before their parents
+  std::unordered_map<unsigned, int> node_ids;
+  std::vector<unsigned> node_index;
+  std::vector<int> node_low, node_high; // target state for leaves
+  std::vector<int> state_roots(number_of_states);
+  std::vector<std::pair<unsigned, bool>> nodes;
+  for (int s = 0; s < number_of_states; ++s) {
+    nodes.push_back(std::make_pair(dfa->q[s], false));
+    while (not nodes.empty()) {
+      auto node = nodes.back();
+      nodes.pop_back();
+      if (node_ids.find(node.first) != node_ids.end()) {
+        continue;
+      }
+      LOAD_lri(&bddm->node_table[node.first], l, r, index);
+      if (index == BDD_LEAF_INDEX) {
+        node_ids[node.first] = node_index.size();
+        node_index.push_back(index);
+        node_low.push_back(l);
+        node_high.push_back(l);
+      } else if (node.second) {
+        node_ids[node.first] = node_index.size();
+        node_index.push_back(index);
+        node_low.push_back(node_ids[l]);
+        node_high.push_back(node_ids[r]);
+      } else {
+        nodes.push_back(std::make_pair(node.first, true));
+        nodes.push_back(std::make_pair(r, false));
+        nodes.push_back(std::make_pair(l, false));
+      }
+    }
+    state_roots[s] = node_ids[dfa->q[s]];
+  }
+  const int number_of_nodes = node_index.size();
+
+  // initial partition by state status
+  std::vector<int> block(number_of_states);
+  int number_of_blocks = 0;
+  {
+    std::map<int, int> status_blocks;
+    for (int s = 0; s < number_of_states; ++s) {
+      auto it = status_blocks.find(dfa->f[s]);
+      if (it == status_blocks.end()) {
+        it = status_blocks.insert(std::make_pair(dfa->f[s], number_of_blocks++)).first;
+      }
+      block[s] = it->second;
+    }
+  }
+
+  std::vector<int> signature(number_of_nodes);
+  std::vector<int> next_block(number_of_states);
+  while (true) {
+    std::unordered_map<std::tuple<unsigned, int, int>, int, TripleHash> node_signatures;
+    int next_signature = number_of_blocks;  // leaf signatures are block ids
+    for (int n = 0; n < number_of_nodes; ++n) {
+      if (node_index[n] == BDD_LEAF_INDEX) {
+        signature[n] = block[node_low[n]];
+      } else if (signature[node_low[n]] == signature[node_high[n]]) {
+        signature[n] = signature[node_low[n]];
+      } else {
+        auto key = std::make_tuple(node_index[n], signature[node_low[n]], signature[node_high[n]]);
+        auto it = node_signatures.find(key);
+        if (it == node_signatures.end()) {
+          it = node_signatures.insert(std::make_pair(key, next_signature++)).first;
+        }
+        signature[n] = it->second;
+      }
+    }
+
+    std::map<std::pair<int, int>, int> state_signatures;
+    int next_number_of_blocks = 0;
+    for (int s = 0; s < number_of_states; ++s) {
+      auto key = std::make_pair(block[s], signature[state_roots[s]]);
+      auto it = state_signatures.find(key);
+      if (it == state_signatures.end()) {
+        it = state_signatures.insert(std::make_pair(key, next_number_of_blocks++)).first;
+      }
+      next_block[s] = it->second;
+    }
+    block.swap(next_block);
+    if (next_number_of_blocks == number_of_blocks) {
+      break;
+    }
+    number_of_blocks = next_number_of_blocks;
+  }
+
+  // number reachable blocks in bfs order, initial block becomes state 0
+  std::vector<int> representative(number_of_blocks, -1);
+  for (int s = number_of_states - 1; s >= 0; --s) {
+    representative[block[s]] = s;
+  }
+  std::vector<int> new_state(number_of_blocks, -1);
+  std::vector<int> reachable_blocks;
+  std::vector<int> node_stack;
+  std::vector<bool> is_node_visited(number_of_nodes, false);
+  new_state[block[dfa->s]] = 0;
+  reachable_blocks.push_back(block[dfa->s]);
+  for (std::size_t i = 0; i < reachable_blocks.size(); ++i) {
+    std::fill(is_node_visited.begin(), is_node_visited.end(), false);
+    node_stack.push_back(state_roots[representative[reachable_blocks[i]]]);
+    while (not node_stack.empty()) {
+      int n = node_stack.back();
+      node_stack.pop_back();
+      if (is_node_visited[n]) {
+        continue;
+      }
+      is_node_visited[n] = true;
+      if (node_index[n] == BDD_LEAF_INDEX) {
+        int target_block = block[node_low[n]];
+        if (new_state[target_block] == -1) {
+          new_state[target_block] = reachable_blocks.size();
+          reachable_blocks.push_back(target_block);
+        }
+      } else {
+        node_stack.push_back(node_high[n]);
+        node_stack.push_back(node_low[n]);
+      }
+    }
+  }
+
+  // rebuild bdds of representatives with relabeled leaves in a new manager
+  DFA_ptr result_dfa = dfaMake(reachable_blocks.size());
+  std::vector<bdd_ptr> new_nodes(number_of_nodes);
+  std::vector<bool> is_node_built(number_of_nodes, false);
+  std::vector<std::pair<int, bool>> build_stack;
+  for (std::size_t i = 0; i < reachable_blocks.size(); ++i) {
+    int s = representative[reachable_blocks[i]];
+    build_stack.push_back(std::make_pair(state_roots[s], false));
+    while (not build_stack.empty()) {
+      auto node = build_stack.back();
+      build_stack.pop_back();
+      int n = node.first;
+      if (is_node_built[n]) {
+        continue;
+      }
+      if (node_index[n] == BDD_LEAF_INDEX) {
+        new_nodes[n] = bdd_find_leaf_hashed_add_root(result_dfa->bddm, new_state[block[node_low[n]]]);
+        is_node_built[n] = true;
+      } else if (node.second) {
+        bdd_ptr low = new_nodes[node_low[n]], high = new_nodes[node_high[n]];
+        new_nodes[n] = (low == high) ? low : bdd_find_node_hashed_add_root(result_dfa->bddm, low, high, node_index[n]);
+        is_node_built[n] = true;
+      } else {
+        build_stack.push_back(std::make_pair(n, true));
+        build_stack.push_back(std::make_pair(node_high[n], false));
+        build_stack.push_back(std::make_pair(node_low[n], false));
+      }
+    }
+    result_dfa->q[i] = new_nodes[state_roots[s]];
+    result_dfa->f[i] = dfa->f[s];
+  }
+  result_dfa->s = 0;
+  return result_dfa;
+}
+
 DFA_ptr Automaton::DFAUnion(const DFA_ptr dfa1, const DFA_ptr dfa2) {
-  DFA_ptr union_dfa = dfaProduct(dfa1, dfa2, dfaOR);
-  DFA_ptr minimized_dfa = dfaMinimize(union_dfa);
+  DFA_ptr union_dfa = DFAProduct(dfa1, dfa2, dfaOR);
+  DFA_ptr minimized_dfa = DFAMinimize(union_dfa);
   dfaFree(union_dfa);
   return minimized_dfa;
 }
 
 DFA_ptr Automaton::DFAIntersect(const DFA_ptr dfa1, const DFA_ptr dfa2) {
-  DFA_ptr intersect_dfa = dfaProduct(dfa1, dfa2, dfaAND);
-  DFA_ptr minimized_dfa = dfaMinimize(intersect_dfa);
+  DFA_ptr intersect_dfa = DFAProduct(dfa1, dfa2, dfaAND);
+  DFA_ptr minimized_dfa = DFAMinimize(intersect_dfa);
   dfaFree(intersect_dfa);
   return minimized_dfa;
 }
 
 DFA_ptr Automaton::DFADifference(const DFA_ptr dfa1, DFA_ptr dfa2) {
-  dfaNegation(dfa2); // efficient
+  DFANegation(dfa2); // efficient
   DFA_ptr difference_dfa = Automaton::DFAIntersect(dfa1, dfa2);
-  dfaNegation(dfa2); // restore back
+  DFANegation(dfa2); // restore back
   return difference_dfa;
 }
 
 DFA_ptr Automaton::DFAProjectAway(const DFA_ptr dfa, const int index) {
-  DFA_ptr projected_dfa = dfaProject(dfa, (unsigned)index);
-  DFA_ptr minimized_dfa = dfaMinimize(projected_dfa);
+  DFA_ptr projected_dfa = DFAProject(dfa, (unsigned)index);
+  DFA_ptr minimized_dfa = DFAMinimize(projected_dfa);
   dfaFree(projected_dfa);
   return minimized_dfa;
 }
 
 DFA_ptr Automaton::DFAProjectAway(const DFA_ptr dfa, std::vector<int> map, const std::vector<int> indices) {
-	DFA_ptr temp,result_dfa = dfa;
-	int flag = 0;
+  return DFAProjectAwayAll(dfa, map.size(), indices, &map[0]);
+}
 
-	for(auto index : indices) {
-		temp = dfaProject(result_dfa,(unsigned)index);
-		if(flag)
-			dfaFree(result_dfa);
-		result_dfa = dfaMinimize(temp);
-		flag = 1;
-		dfaFree(temp);
-	}
-	dfaReplaceIndices(result_dfa,&map[0]);
-	return result_dfa;
+DFA_ptr Automaton::DFAProjectAwayAll(const DFA_ptr dfa, const int number_of_bdd_variables, const std::vector<int>& indices, const int* map) {
+  std::vector<bool> is_projected(number_of_bdd_variables, false);
+  for (int index : indices) {
+    is_projected[index] = true;
+  }
+  int number_of_result_variables = 0;
+  for (int i = 0; i < number_of_bdd_variables; ++i) {
+    if (not is_projected[i]) {
+      const int position = (map == nullptr) ? i : map[i];
+      number_of_result_variables = std::max(number_of_result_variables, position + 1);
+    }
+  }
+
+  bdd_manager* bddm = dfa->bddm;
+  std::map<std::vector<int>, int> subset_ids;
+  std::vector<std::vector<int>> subsets;
+  auto get_subset_id = [&subset_ids, &subsets](const std::vector<int>& subset) {
+    auto it = subset_ids.find(subset);
+    if (it != subset_ids.end()) {
+      return it->second;
+    }
+    const int id = subsets.size();
+    subset_ids[subset] = id;
+    subsets.push_back(subset);
+    return id;
+  };
+
+  // walks the bdds of all states in a subset together; projected variables follow both branches,
+  // the remaining variables are split in bdd order so that each emitted path leads to one subset
+  std::string path(number_of_result_variables, 'X');
+  std::vector<std::pair<std::string, int>> state_transitions;
+  std::function<void(const std::vector<unsigned>&)> split = [&](const std::vector<unsigned>& frontier) {
+    unsigned l, r, index; // BDD traversal variables
+    std::vector<unsigned> nodes (frontier), closure;
+    std::set<unsigned> expanded;
+    while (not nodes.empty()) {
+      unsigned p = nodes.back();
+      nodes.pop_back();
+      if (not expanded.insert(p).second) {
+        continue;
+      }
+      LOAD_lri(&bddm->node_table[p], l, r, index);
+      if (index != BDD_LEAF_INDEX and is_projected[index]) {
+        nodes.push_back(l);
+        nodes.push_back(r);
+      } else {
+        closure.push_back(p);
+      }
+    }
+
+    bool is_leaf_frontier = true;
+    unsigned split_index = 0;
+    std::vector<int> targets;
+    for (auto p : closure) {
+      LOAD_lri(&bddm->node_table[p], l, r, index);
+      if (index == BDD_LEAF_INDEX) {
+        targets.push_back(l);
+      } else if (is_leaf_frontier or index < split_index) {
+        is_leaf_frontier = false;
+        split_index = index;
+      }
+    }
+
+    if (is_leaf_frontier) {
+      std::sort(targets.begin(), targets.end());
+      targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+      state_transitions.push_back(std::make_pair(path, get_subset_id(targets)));
+      return;
+    }
+
+    const int position = (map == nullptr) ? split_index : map[split_index];
+    for (int branch = 0; branch < 2; ++branch) {
+      std::vector<unsigned> next_frontier;
+      for (auto p : closure) {
+        LOAD_lri(&bddm->node_table[p], l, r, index);
+        if (index == split_index) {
+          next_frontier.push_back(branch == 0 ? l : r);
+        } else {
+          next_frontier.push_back(p);
+        }
+      }
+      path[position] = (branch == 0) ? '0' : '1';
+      split(next_frontier);
+    }
+    path[position] = 'X';
+  };
+
+  std::vector<std::vector<std::pair<std::string, int>>> transitions;
+  get_subset_id(std::vector<int> { dfa->s });
+  for (std::size_t i = 0; i < subsets.size(); ++i) {
+    std::vector<unsigned> frontier;
+    for (int s : subsets[i]) {
+      frontier.push_back(dfa->q[s]);
+    }
+    state_transitions.clear();
+    split(frontier);
+    transitions.push_back(state_transitions);
+  }
+
+  // paths are disjoint and cover all inputs, the last one becomes the default transition
+  const int number_of_states = subsets.size();
+  char* statuses = new char[number_of_states + 1];
+  DFABuilder builder(number_of_states, number_of_result_variables, GetBddVariableIndices(number_of_result_variables));
+  for (int i = 0; i < number_of_states; ++i) {
+    builder.AllocExceptions(transitions[i].size() - 1);
+    for (std::size_t j = 0; j + 1 < transitions[i].size(); ++j) {
+      builder.StoreException(transitions[i][j].second, &transitions[i][j].first[0]);
+    }
+    builder.StoreState(transitions[i].back().second);
+
+    statuses[i] = '0';
+    for (int s : subsets[i]) {
+      if (dfa->f[s] == 1) {
+        statuses[i] = '+';
+        break;
+      } else if (dfa->f[s] == -1) {
+        statuses[i] = '-';
+      }
+    }
+  }
+  statuses[number_of_states] = '\0';
+
+  DFA_ptr projected_dfa = builder.Build(statuses);
+  delete[] statuses;
+  DFA_ptr minimized_dfa = DFAMinimize(projected_dfa);
+  dfaFree(projected_dfa);
+  return minimized_dfa;
 }
 
 DFA_ptr Automaton::DFAProjectAwayAndReMap(const DFA_ptr dfa, const int number_of_bdd_variables, const int index) {
-  DFA_ptr projected_dfa = dfaProject(dfa, (unsigned)index);
+  DFA_ptr projected_dfa = DFAProject(dfa, (unsigned)index);
   if (index < (unsigned)(number_of_bdd_variables - 1)) {
     int* indices_map = new int[number_of_bdd_variables];
     for (int i = 0, j = 0; i < number_of_bdd_variables; i++) {
@@ -1044,27 +1555,36 @@ DFA_ptr Automaton::DFAProjectAwayAndReMap(const DFA_ptr dfa, const int number_of
     delete[] indices_map;
   }
 
-  DFA_ptr minimized_dfa = dfaMinimize(projected_dfa);
+  DFA_ptr minimized_dfa = DFAMinimize(projected_dfa);
   dfaFree(projected_dfa);
   return minimized_dfa;
 }
 
 DFA_ptr Automaton::DFAProjectTo(const DFA_ptr dfa, const int number_of_bdd_variables, const int index) {
-  DFA_ptr projected_dfa = dfaCopy(dfa);
-  for (int i = 0 ; i < number_of_bdd_variables; ++i) {
-    if (i != index) {
-      DFA_ptr tmp_dfa = projected_dfa;
-      projected_dfa = Automaton::DFAProjectAway(tmp_dfa, i);
-      dfaFree(tmp_dfa);
+  return DFAProjectTo(dfa, number_of_bdd_variables, std::vector<int> { index });
+}
+
+DFA_ptr Automaton::DFAProjectTo(const DFA_ptr dfa, const int number_of_bdd_variables, const std::vector<int> indices) {
+  std::vector<bool> is_kept(number_of_bdd_variables, false);
+  for (int index : indices) {
+    is_kept[index] = true;
+  }
+
+  // kept variables are moved to the front in the given order
+  std::vector<int> indices_map(number_of_bdd_variables);
+  std::vector<int> projected_indices;
+  int position = 0;
+  for (int index : indices) {
+    indices_map[index] = position++;
+  }
+  for (int i = 0; i < number_of_bdd_variables; ++i) {
+    if (not is_kept[i]) {
+      indices_map[i] = position++;
+      projected_indices.push_back(i);
     }
   }
 
-  int* indices_map = CreateBddVariableIndices(number_of_bdd_variables);
-  indices_map[index] = 0;
-  indices_map[0] = index;
-  dfaReplaceIndices(projected_dfa, indices_map);
-  delete[] indices_map;
-  return projected_dfa;
+  return DFAProjectAwayAll(dfa, number_of_bdd_variables, projected_indices, &indices_map[0]);
 }
 
 DFA_ptr Automaton::DFAMakeAcceptingAnyWithInRange(const int start, const int end, const int number_of_bdd_variables) {
@@ -1072,12 +1592,12 @@ DFA_ptr Automaton::DFAMakeAcceptingAnyWithInRange(const int start, const int end
   // 1 initial state and 1 sink state
   const int number_of_states = end + 2;
   char *statuses = new char[number_of_states+1];
-  dfaSetup(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  DFABuilder builder(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
 
   // 0 to start - 1 not accepting, start to end accepting states
   for(int i = 0; i <= end; ++i) {
-    dfaAllocExceptions(0);
-    dfaStoreState(i + 1);
+    builder.AllocExceptions(0);
+    builder.StoreState(i + 1);
     if(i >= start) {
       statuses[i] = '+';
     } else {
@@ -1086,12 +1606,12 @@ DFA_ptr Automaton::DFAMakeAcceptingAnyWithInRange(const int start, const int end
   }
 
   //the sink state
-  dfaAllocExceptions(0);
-  dfaStoreState(number_of_states - 1);  // sink state
+  builder.AllocExceptions(0);
+  builder.StoreState(number_of_states - 1);  // sink state
   statuses[number_of_states - 1] = '-';
   statuses[number_of_states] = '\0';
 
-  DFA_ptr result_dfa = dfaBuild(statuses);
+  DFA_ptr result_dfa = builder.Build(statuses);
   delete[] statuses;
   return result_dfa;
 }
@@ -1101,25 +1621,130 @@ DFA_ptr Automaton::DFAMakeAcceptingAnyAfterLength(const int length, const int nu
   // 1 initial state
   const int number_of_states = length + 1;
   char *statuses = new char[number_of_states+1];
-  dfaSetup(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  DFABuilder builder(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
 
   // 0 to length - 1 not accepting
   for(int i = 0; i < length; ++i) {
-    dfaAllocExceptions(0);
-    dfaStoreState(i + 1);
+    builder.AllocExceptions(0);
+    builder.StoreState(i + 1);
     statuses[i] = '-';
   }
 
   // final state
-  dfaAllocExceptions(0);
-  dfaStoreState(length);
+  builder.AllocExceptions(0);
+  builder.StoreState(length);
   statuses[length] = '+';
   statuses[number_of_states] = '\0';
-  DFA_ptr result_dfa = dfaBuild(statuses);
+  DFA_ptr result_dfa = builder.Build(statuses);
   delete[] statuses;
   return result_dfa;
 }
 
+DFA_ptr Automaton::DFAMakeUnaryLengthDfa(const DFA_ptr dfa) {
+  const int number_of_states = dfa->ns;
+  unsigned p, l, r, index; // BDD traversal variables
+
+  // collapse transition labels, keep distinct successors only
+  std::vector<std::vector<int>> successors(number_of_states);
+  std::vector<unsigned> nodes;
+  std::vector<int> marks(number_of_states, -1);
+  for (int s = 0; s < number_of_states; ++s) {
+    nodes.push_back(dfa->q[s]);
+    while (not nodes.empty()) {
+      p = nodes.back();
+      nodes.pop_back();
+      LOAD_lri(&dfa->bddm->node_table[p], l, r, index);
+      if (index == BDD_LEAF_INDEX) {
+        if (marks[l] != s) {
+          marks[l] = s;
+          successors[s].push_back(l);
+        }
+      } else {
+        nodes.push_back(l);
+        nodes.push_back(r);
+      }
+    }
+  }
+
+  // states that cannot reach an accepting state do not contribute to lengths
+  std::vector<std::vector<int>> predecessors(number_of_states);
+  for (int s = 0; s < number_of_states; ++s) {
+    for (int t : successors[s]) {
+      predecessors[t].push_back(s);
+    }
+  }
+  std::vector<bool> is_live(number_of_states, false);
+  std::vector<int> worklist;
+  for (int s = 0; s < number_of_states; ++s) {
+    if (dfa->f[s] == 1) {
+      is_live[s] = true;
+      worklist.push_back(s);
+    }
+  }
+  while (not worklist.empty()) {
+    int t = worklist.back();
+    worklist.pop_back();
+    for (int s : predecessors[t]) {
+      if (not is_live[s]) {
+        is_live[s] = true;
+        worklist.push_back(s);
+      }
+    }
+  }
+
+  // unary subset construction; the sequence of subsets reached after each step is eventually periodic
+  std::map<std::vector<int>, int> subset_ids;
+  std::vector<bool> is_accepting_subset;
+  std::vector<int> current_subset, next_subset;
+  std::fill(marks.begin(), marks.end(), -1);
+  if (is_live[dfa->s]) {
+    current_subset.push_back(dfa->s);
+  }
+  int step = 0;
+  while (subset_ids.find(current_subset) == subset_ids.end()) {
+    subset_ids[current_subset] = step;
+    bool is_accepting = false;
+    next_subset.clear();
+    for (int s : current_subset) {
+      is_accepting = is_accepting or (dfa->f[s] == 1);
+      for (int t : successors[s]) {
+        if (is_live[t] and marks[t] != step) {
+          marks[t] = step;
+          next_subset.push_back(t);
+        }
+      }
+    }
+    is_accepting_subset.push_back(is_accepting);
+    std::sort(next_subset.begin(), next_subset.end());
+    current_subset.swap(next_subset);
+    ++step;
+  }
+  const int cycle_head = subset_ids[current_subset];
+
+  // step states followed by a sink state for '0'
+  const int sink = step;
+  char unary_exception[2] = {'1', '\0'};
+  std::vector<char> statuses(step + 2, '-');
+  int* indices = GetBddVariableIndices(1);
+  DFABuilder builder(step + 1, 1, indices);
+  for (int i = 0; i < step; ++i) {
+    builder.AllocExceptions(1);
+    builder.StoreException((i + 1 < step) ? i + 1 : cycle_head, unary_exception);
+    builder.StoreState(sink);
+    if (is_accepting_subset[i]) {
+      statuses[i] = '+';
+    }
+  }
+  builder.AllocExceptions(0);
+  builder.StoreState(sink);
+  statuses[step + 1] = '\0';
+
+  DFA_ptr unary_dfa = builder.Build(&statuses[0]);
+  DFA_ptr minimized_dfa = DFAMinimize(unary_dfa);
+  dfaFree(unary_dfa);
+  return minimized_dfa;
+}
+
 std::set<std::string> Automaton::DFAGetTransitionsFromTo(DFA_ptr dfa, const int from, const int to, const int number_of_bdd_variables) {
   const int* bdd_indices = GetBddVariableIndices(number_of_bdd_variables);
   std::set<std::string> transitions;
@@ -1150,13 +1775,14 @@ std::set<std::string> Automaton::DFAGetTransitionsFromTo(DFA_ptr dfa, const int
 
 DFA_ptr Automaton::DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int number_of_bdd_variables) {
   //LOG(FATAL) << "I'm broken, fix me! Use StringAutomaton::concat instead";
+  Util::Cancellation::Check();
 
 	if (DFAIsMinimizedEmtpy(dfa1) or DFAIsMinimizedEmtpy(dfa2)) {
 		return DFAMakeEmpty(number_of_bdd_variables);
 	} else if (DFAIsMinimizedOnlyAcceptingEmptyInput(dfa1)) {
-		return dfaCopy(dfa2);
+		return DFACopy(dfa2);
 	} else if (DFAIsMinimizedOnlyAcceptingEmptyInput(dfa2)) {
-		return dfaCopy(dfa1);
+		return DFACopy(dfa1);
 	}
 	// TODO refactor handling empty string case
 	bool left_hand_side_accepts_emtpy_input = DFAIsAcceptingState(dfa1, dfa1->s);
@@ -1165,18 +1791,25 @@ DFA_ptr Automaton::DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int n
 
 	if (left_hand_side_accepts_emtpy_input or right_hand_side_accepts_empty_input) {
 		auto any_input_other_than_empty = Automaton::DFAMakeAcceptingAnyAfterLength(1, number_of_bdd_variables);
+		// left side is minimized while the right side product is computed
+		std::future<DFA_ptr> left_minimized_dfa;
 		if (left_hand_side_accepts_emtpy_input) {
-			left_dfa = DFAIntersect(dfa1, any_input_other_than_empty);
+			left_dfa = DFAProduct(dfa1, any_input_other_than_empty, dfaAND);
+			left_minimized_dfa = DFAMinimizeAsync(left_dfa);
 		}
 
-
 		if (right_hand_side_accepts_empty_input) {
 			right_dfa = DFAIntersect(dfa2, any_input_other_than_empty);
 		}
+
+		if (left_hand_side_accepts_emtpy_input) {
+			DFA_ptr left_product_dfa = left_dfa;
+			left_dfa = left_minimized_dfa.get();
+			dfaFree(left_product_dfa);
+		}
 		dfaFree(any_input_other_than_empty);
 	}
 
-	int* indices = GetBddVariableIndices(number_of_bdd_variables);
 	int tmp_num_of_variables,
 			state_id_shift_amount,
 			expected_num_of_states,
@@ -1184,16 +1817,14 @@ DFA_ptr Automaton::DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int n
 			sink_state_right_auto,
 			to_state = 0,
 			loc,
-			i = 0,
-			j = 0;
+			i = 0;
 
 	bool is_start_state_reachable = false;
-	paths state_paths = nullptr, pp = nullptr;
-	trace_descr tp = nullptr;
 
-	std::map<std::string, int> exceptions_left_auto;
-	std::map<std::string, int> exceptions_right_auto;
-	std::map<std::string, int> exceptions_fix;
+	using ExceptionMap = std::unordered_map<TernaryException, int, TernaryException::Hasher>;
+	ExceptionMap exceptions_left_auto;
+	ExceptionMap exceptions_right_auto;
+	ExceptionMap exceptions_fix;
 	char* statuses = nullptr;
 	tmp_num_of_variables = number_of_bdd_variables + 1; // add one extra bit
 	state_id_shift_amount = left_dfa->ns;
@@ -1226,92 +1857,49 @@ DFA_ptr Automaton::DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int n
 	statuses = new char[expected_num_of_states + 1];
 	int* concat_indices = GetBddVariableIndices(tmp_num_of_variables);
 
-	dfaSetup(expected_num_of_states, tmp_num_of_variables, concat_indices); //sink states are merged
-	state_paths = pp = make_paths(right_dfa->bddm, right_dfa->q[right_dfa->s]);
-	while (pp) {
-		if (!right_sink || pp->to != sink_state_right_auto ) {
-			to_state = pp->to + state_id_shift_amount;
+	DFABuilder builder(expected_num_of_states, tmp_num_of_variables, concat_indices); //sink states are merged
+	TernaryException current_exception(tmp_num_of_variables);
+	current_exception.SetBit(number_of_bdd_variables, true); // new path
+	DFAForEachPath(right_dfa, right_dfa->s, current_exception, [&](const int to, const TernaryException& exception) {
+		if (!right_sink || to != sink_state_right_auto ) {
+			to_state = to + state_id_shift_amount;
 			// if there is a self loop keep it
-			if (pp->to == (unsigned)right_dfa->s ) {
+			if (to == right_dfa->s ) {
 				to_state -= 2;
 			} else {
-				if (left_sink && right_sink && pp->to > (unsigned)sink_state_right_auto ) {
+				if (left_sink && right_sink && to > sink_state_right_auto ) {
 					to_state--; //to new state, sink state will be eliminated and hence need -1
 				}
-				if ((not is_start_state_reachable) && pp->to > (unsigned)right_dfa->s) {
+				if ((not is_start_state_reachable) && to > right_dfa->s) {
 					to_state--; // to new state, init state will be eliminated if init is not reachable
 				}
 			}
-
-			std::string current_exception = "";
-			for (j = 0; j < number_of_bdd_variables; j++) {
-				//the following for loop can be avoided if the indices are in order
-				for (tp = pp->trace; tp && (tp->index != (unsigned)indices[j]); tp = tp->next);
-				if (tp) {
-					if (tp->value) {
-						current_exception.push_back('1');
-					}
-					else {
-						current_exception.push_back('0');
-					}
-				}
-				else {
-					current_exception.push_back('X');
-				}
-			}
-
-			current_exception.push_back('1'); // new path
-			current_exception.push_back('\0');
-			exceptions_right_auto[current_exception] = to_state;
+			exceptions_right_auto[exception] = to_state;
 		}
-		tp = nullptr;
-		pp = pp->next;
-	}
+	});
 
-	kill_paths(state_paths);
-	state_paths = pp = nullptr;
+	current_exception.SetBit(number_of_bdd_variables, false); // add extra bit, '0' is used for the exceptions coming from left auto
 	for (i = 0; i < left_dfa->ns; i++) {
-		state_paths = pp = make_paths(left_dfa->bddm, left_dfa->q[i]);
-		while (pp) {
-			if (left_sink && pp->to == (unsigned)sink_state_left_auto) {
-				pp = pp->next;
-				continue;
-			}
-			to_state = pp->to;
-			std::string current_exception = "";
-			for (j = 0; j < number_of_bdd_variables; j++) {
-				for (tp = pp->trace; tp && (tp->index != (unsigned)indices[j]); tp = tp->next);
-				if (tp) {
-					if (tp->value) {
-						current_exception.push_back('1');
-					} else {
-						current_exception.push_back('0');
-					}
-				} else {
-					current_exception.push_back('X');
-				}
+		DFAForEachPath(left_dfa, i, current_exception, [&](const int to, const TernaryException& exception) {
+			if (left_sink && to == sink_state_left_auto) {
+				return;
 			}
-
-			current_exception.push_back('0'); // add extra bit, '0' is used for the exceptions coming from left auto
-			current_exception.push_back('\0');
-			exceptions_left_auto[current_exception] = to_state;
-			tp = nullptr;
-			pp = pp->next;
-		}
+			exceptions_left_auto[exception] = to;
+		});
 		// generate concat automaton
 
 		if (DFAIsAcceptingState(left_dfa,i) && next_state == i) {
-			dfaAllocExceptions(exceptions_left_auto.size() + exceptions_right_auto.size());
-			for (auto entry : exceptions_left_auto) {
-				dfaStoreException(entry.second, const_cast<char*>(entry.first.data()));
+			builder.AllocExceptions(exceptions_left_auto.size() + exceptions_right_auto.size());
+			for (auto& entry : exceptions_left_auto) {
+				builder.StoreException(entry.second, const_cast<char*>(entry.first.ToString().data()));
 			}
 
-			for (auto entry : exceptions_right_auto) {
-				dfaStoreException(entry.second, const_cast<char*>(entry.first.data()));
+			for (auto& entry : exceptions_right_auto) {
+				builder.StoreException(entry.second, const_cast<char*>(entry.first.ToString().data()));
 			}
 			exceptions_right_auto.clear();
 
-			dfaStoreState(sink);
+			builder.StoreState(sink);
 			if (DFAIsAcceptingState(right_dfa,0)) {
 				statuses[i]='+';
 			}
@@ -1319,65 +1907,41 @@ DFA_ptr Automaton::DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int n
 				statuses[i]='-';
 			}
 		} else {
-			dfaAllocExceptions(exceptions_left_auto.size());
-			for (auto entry : exceptions_left_auto) {
-				dfaStoreException(entry.second, const_cast<char*>(entry.first.data()));
+			builder.AllocExceptions(exceptions_left_auto.size());
+			for (auto& entry : exceptions_left_auto) {
+				builder.StoreException(entry.second, const_cast<char*>(entry.first.ToString().data()));
 			}
-			dfaStoreState(sink);
+			builder.StoreState(sink);
 			statuses[i] = '-';
 		}
 		exceptions_left_auto.clear();
-
-		kill_paths(state_paths);
-		state_paths = pp = nullptr;
 	}
 
 	//  initflag is 1 iff init is reached by some state. In this case,
 	for (i = 0; i < right_dfa->ns; i++) {
 		if (i != sink_state_right_auto ) {
 			if ( i != right_dfa->s || is_start_state_reachable) {
-				state_paths = pp = make_paths(right_dfa->bddm, right_dfa->q[i]);
-				while (pp) {
-					if (!right_sink || pp->to != (unsigned)sink_state_right_auto) {
-						to_state = pp->to + state_id_shift_amount;
+				DFAForEachPath(right_dfa, i, current_exception, [&](const int to, const TernaryException& exception) {
+					if (!right_sink || to != sink_state_right_auto) {
+						to_state = to + state_id_shift_amount;
 
-						if ( right_sink && left_sink && pp->to > (unsigned)sink_state_right_auto) {
+						if ( right_sink && left_sink && to > sink_state_right_auto) {
 							to_state--; //to new state, sink state will be eliminated and hence need -1
 						}
 
-						if ( (not is_start_state_reachable) && pp->to > (unsigned)right_dfa->s) {
+						if ( (not is_start_state_reachable) && to > right_dfa->s) {
 							to_state--; // to new state, init state will be eliminated if init is not reachable
 						}
-
-						std::string current_exception = "";
-						for (j = 0; j < number_of_bdd_variables; j++) {
-							for (tp = pp->trace; tp && (tp->index != (unsigned)indices[j]); tp =tp->next);
-							if (tp) {
-								if (tp->value){
-									current_exception.push_back('1');
-								}
-								else {
-									current_exception.push_back('0');
-								}
-							}
-							else {
-								current_exception.push_back('X');
-							}
-						}
-						current_exception.push_back('0'); // old value
-						current_exception.push_back('\0');
-						exceptions_fix[current_exception] = to_state;
-						tp = nullptr;
+						exceptions_fix[exception] = to_state; // old value
 					}
-					pp = pp->next;
-				}
+				});
 
-				dfaAllocExceptions(exceptions_fix.size());
-				for (auto entry : exceptions_fix) {
-					dfaStoreException(entry.second, const_cast<char*>(entry.first.data()));
+				builder.AllocExceptions(exceptions_fix.size());
+				for (auto& entry : exceptions_fix) {
+					builder.StoreException(entry.second, const_cast<char*>(entry.first.ToString().data()));
 				}
 
-				dfaStoreState(sink);
+				builder.StoreState(sink);
 
 				loc = state_id_shift_amount + i;
 				if ( (not is_start_state_reachable) && i > right_dfa->s) {
@@ -1392,30 +1956,27 @@ DFA_ptr Automaton::DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int n
 				} else {
 					statuses[loc]='-';
 				}
-
-				kill_paths(state_paths);
-				state_paths = pp = nullptr;
 			}
 		} else if(!left_sink && right_sink) {
-			dfaAllocExceptions(0);
-			dfaStoreState(sink);
+			builder.AllocExceptions(0);
+			builder.StoreState(sink);
 			statuses[sink] = '-';
 		}
 		exceptions_fix.clear();
 	}
 	if(!right_sink && !left_sink) {
-		dfaAllocExceptions(0);
-		dfaStoreState(sink);
+		builder.AllocExceptions(0);
+		builder.StoreState(sink);
 		statuses[sink] = '-';
 	}
 
 
 	statuses[expected_num_of_states]='\0';
-	DFA_ptr concat_dfa = dfaBuild(statuses);
+	DFA_ptr concat_dfa = builder.Build(statuses);
 	delete[] statuses; statuses = nullptr;
-	DFA_ptr tmp_dfa = dfaProject(concat_dfa, (unsigned) number_of_bdd_variables);
+	DFA_ptr tmp_dfa = DFAProject(concat_dfa, (unsigned) number_of_bdd_variables);
 	dfaFree(concat_dfa);
-	concat_dfa = dfaMinimize(tmp_dfa);
+	concat_dfa = DFAMinimize(tmp_dfa);
 	dfaFree(tmp_dfa); tmp_dfa = nullptr;
 
 	if (left_hand_side_accepts_emtpy_input) {
@@ -1433,7 +1994,29 @@ DFA_ptr Automaton::DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int n
 	return concat_dfa;
 }
 
+void Automaton::DFAForEachPath(const DFA_ptr dfa, const int state, TernaryException& exception,
+                               const std::function<void(const int, const TernaryException&)>& visit, const int* positions) {
+  DFAForEachPath(dfa->bddm, dfa->q[state], exception, visit, positions);
+}
+
+void Automaton::DFAForEachPath(bdd_manager* bddm, const unsigned node, TernaryException& exception,
+                               const std::function<void(const int, const TernaryException&)>& visit, const int* positions) {
+  unsigned l, r, index; // BDD traversal variables
+  LOAD_lri(&bddm->node_table[node], l, r, index);
+  if (index == BDD_LEAF_INDEX) {
+    visit((int) l, exception);
+    return;
+  }
+  const int position = (positions == nullptr) ? (int) index : positions[index];
+  exception.SetBit(position, false);
+  DFAForEachPath(bddm, l, exception, visit, positions);
+  exception.SetBit(position, true);
+  DFAForEachPath(bddm, r, exception, visit, positions);
+  exception.SetDontCare(position);
+}
+
 int* Automaton::GetBddVariableIndices(const int number_of_bdd_variables) {
+  std::lock_guard<std::mutex> lock(bdd_variable_indices_mutex);
   auto it = bdd_variable_indices.find(number_of_bdd_variables);
   if (it != bdd_variable_indices.end())
   {
@@ -1531,14 +2114,14 @@ std::vector<char> Automaton::getReservedWord(char last_char, int length, bool ex
 
 void Automaton::Minimize() {
   DFA_ptr tmp = this->dfa_;
-  this->dfa_ = dfaMinimize(tmp);
+  this->dfa_ = DFAMinimize(tmp);
   dfaFree(tmp);
   DVLOG(VLOG_LEVEL) << this->id_ << " = [" << this->id_ << "]->minimize()";
 }
 
 void Automaton::ProjectAway(unsigned index) {
   DFA_ptr tmp = this->dfa_;
-  this->dfa_ = dfaProject(tmp, index);
+  this->dfa_ = DFAProject(tmp, index);
   dfaFree(tmp);
 
   if (index < (unsigned)(this->num_of_bdd_variables_ - 1)) {
@@ -1807,6 +2390,7 @@ void Automaton::SetSymbolicCounter() {
   const int sink_state = GetSinkState();
   unsigned left, right, index;
   for (int s = 0; s < this->dfa_->ns; ++s) {
+    Util::Cancellation::Check();
     if (sink_state != s) {
       // Node is a pair<sbdd_node_id, bdd_depth>
       Node current_bdd_node {dfa_->q[s], 0}, left_node, right_node;
@@ -1857,7 +2441,7 @@ void Automaton::SetSymbolicCounter() {
  */
 void Automaton::decide_counting_schema(Eigen::SparseMatrix<BigInteger>& count_matrix) {
   counter_.set_type(SymbolicCounter::Type::STRING);
-  if(count_bound_exact_) {
+  if(Option::Theory::COUNT_BOUND_EXACT) {
   	count_matrix.insert(this->dfa_->ns, this->dfa_->ns) = 0;
   } else {
   	count_matrix.insert(this->dfa_->ns, this->dfa_->ns) = 1; // allows us to count all lengths up to given bound
@@ -2342,15 +2926,36 @@ void Automaton::exportDfa(std::string file_name) {
     names[0] = &*name.begin();
   }
 
+  MonaLock lock(MonaLock::Globals::EXTERNAL);
   dfaExport(this->dfa_, nullptr, this->num_of_bdd_variables_, names, orders);
 }
 
 DFA_ptr Automaton::importDFA(std::string file_name) {
   char **names = new char*[this->num_of_bdd_variables_];
   int ** orders = new int*[this->num_of_bdd_variables_];
+  MonaLock lock(MonaLock::Globals::EXTERNAL);
   return dfaImport(&*file_name.begin(), &names, orders);
 }
 
+void Automaton::exportDfaBinary(std::string file_name) {
+  std::ofstream outfile(file_name.c_str(), std::ios::binary);
+  if (!outfile.good()) {
+    LOG(ERROR) << "cannot open file: " << file_name;
+    return;
+  }
+  DFAExportBinary(this->dfa_, this->num_of_bdd_variables_, outfile);
+}
+
+DFA_ptr Automaton::importDfaBinary(std::string file_name) {
+  std::ifstream infile(file_name.c_str(), std::ios::binary);
+  if (!infile.good()) {
+    LOG(ERROR) << "cannot open file: " << file_name;
+    return nullptr;
+  }
+  std::string data ((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+  return DFAImportBinary(data.data(), data.size(), this->num_of_bdd_variables_);
+}
+
 int Automaton::inspectAuto(bool print_sink, bool force_mona_format) {
   std::stringstream file_name;
   file_name << "./output/inspect_auto_" << name_counter++ << ".dot";
@@ -2845,7 +3450,7 @@ DFA* Automaton::dfaPrePostToLowerUpperCaseHelper(DFA* M, int var, int* oldIndice
 	int size = 0;
 
 
-	dfaSetup(ns, len, indices);
+	DFABuilder builder(ns, len, indices);
 	for (i = 0; i < M->ns; i++) {
 		state_paths = pp = make_paths(M->bddm, M->q[i]);
 		k = 0;
@@ -2884,10 +3489,10 @@ DFA* Automaton::dfaPrePostToLowerUpperCaseHelper(DFA* M, int var, int* oldIndice
 		kill_paths(state_paths);
 
 		// if accept state create a self loop on lambda
-		dfaAllocExceptions(k);
+		builder.AllocExceptions(k);
 		for (k--; k >= 0; k--)
-			dfaStoreException(to_states[k], exeps + k * (len + 1));
-		dfaStoreState(sink);
+			builder.StoreException(to_states[k], exeps + k * (len + 1));
+		builder.StoreState(sink);
 
 		if (M->f[i] == 1)
 			statuces[i] = '+';
@@ -2897,16 +3502,16 @@ DFA* Automaton::dfaPrePostToLowerUpperCaseHelper(DFA* M, int var, int* oldIndice
 
 	// create artificial sink if original dfa did not have one
 	if(not has_sink) {
-		dfaAllocExceptions(0);
-		dfaStoreState(sink);
+		builder.AllocExceptions(0);
+		builder.StoreState(sink);
 		statuces[sink] = '-';
 	}
 
 	statuces[ns] = '\0';
-	DFA* tmpM = dfaBuild(statuces);
-	result = dfaProject(tmpM, ((unsigned)var));
+	DFA* tmpM = builder.Build(statuces);
+	result = DFAProject(tmpM, ((unsigned)var));
 	dfaFree(tmpM);
-	tmpM = dfaMinimize(result);
+	tmpM = DFAMinimize(result);
 	dfaFree(result);result = NULL;
 
 	free(exeps);
@@ -2960,7 +3565,7 @@ DFA_ptr Automaton::DFAExtendExtrabit(DFA_ptr M, int var) {
 	int *indices = GetBddVariableIndices(nvar);
 	char* statuses = new char[num_states+1];
 
-	dfaSetup(num_states,nvar,indices);
+	DFABuilder builder(num_states,nvar,indices);
 
 	for(int i = 0; i < M->ns; i++) {
 		state_paths = pp = make_paths(M->bddm, M->q[i]);
@@ -2986,11 +3591,11 @@ DFA_ptr Automaton::DFAExtendExtrabit(DFA_ptr M, int var) {
 		}
 		kill_paths(state_paths);
 
-		dfaAllocExceptions(state_exeps.size());
+		builder.AllocExceptions(state_exeps.size());
 		for(unsigned k = 0; k < state_exeps.size(); ++k) {
-			dfaStoreException(state_exeps[k].second,&state_exeps[k].first[0]);
+			builder.StoreException(state_exeps[k].second,&state_exeps[k].first[0]);
 		}
-		dfaStoreState(sink);
+		builder.StoreState(sink);
 		state_exeps.clear();
 
 		if(M->f[i] == 1) {
@@ -3002,14 +3607,14 @@ DFA_ptr Automaton::DFAExtendExtrabit(DFA_ptr M, int var) {
 
 	// if necessary, create new sink state
 	if(not has_sink) {
-		dfaAllocExceptions(0);
-		dfaStoreState(sink);
+		builder.AllocExceptions(0);
+		builder.StoreState(sink);
 		statuses[sink] = '-';
 	}
 
 	statuses[num_states] = '\0';
-	temp_dfa = dfaBuild(statuses);
-	result_dfa = dfaMinimize(temp_dfa);
+	temp_dfa = builder.Build(statuses);
+	result_dfa = DFAMinimize(temp_dfa);
 	dfaFree(temp_dfa);
 	delete[] statuses;
 	return result_dfa;
@@ -3036,6 +3641,7 @@ int Automaton::check_emptiness(DFA_ptr M1, int var, int* indices) {
 		uindices[i] = (indices[i] <= 0 ? 0 : indices[i]);
 	uindices[i] = '\0';
 
+	MonaLock lock;
 	satisfyingexample = dfaMakeExample(M1, 1, var, uindices);
 
 	mem_free(uindices);
@@ -3057,8 +3663,8 @@ int Automaton::check_equivalence(DFA_ptr M1, DFA_ptr M2, int var, int* indices)
 	DFA *M[4];
 	int result, i;
 
-	M[0] = dfaProduct(M1, M2, dfaIMPL);
-	M[1] = dfaProduct(M2, M1, dfaIMPL);
+	M[0] = DFAProduct(M1, M2, dfaIMPL);
+	M[1] = DFAProduct(M2, M1, dfaIMPL);
 	M[2] = DFAIntersect(M[0], M[1]);
 	//M[3] = dfa_negate(M[2], var, indices);
 	M[3] = DFAComplement(M[2]);
@@ -3139,14 +3745,14 @@ DFA *Automaton::dfaSharpStringWithExtraBit(int var, int *indices) {
 
 	char *sharp1;
 	sharp1 = getSharp1WithExtraBit(var);
-	dfaSetup(2, var + 1, indices);
-	dfaAllocExceptions(1);
-	dfaStoreException(1, sharp1);
-	dfaStoreState(0);
-	dfaAllocExceptions(0);
-	dfaStoreState(1);
+	DFABuilder builder(2, var + 1, indices);
+	builder.AllocExceptions(1);
+	builder.StoreException(1, sharp1);
+	builder.StoreState(0);
+	builder.AllocExceptions(0);
+	builder.StoreState(1);
 
-	return dfaBuild("-+");
+	return builder.Build("-+");
 }
 
 //Sharp0 is 111111110 which will be used as a reserved symbol
@@ -3168,22 +3774,22 @@ char * Automaton::getArbitraryStringWithExtraBit(int k) {
 // A DFA that accepts all strings (Sigma*) except 11111111 and 111111110
 DFA * Automaton::dfaAllStringASCIIExceptReserveWords(int var, int *indices) {
 
-	dfaSetup(2, var, indices);
-	dfaAllocExceptions(2);
+	DFABuilder builder(2, var, indices);
+	builder.AllocExceptions(2);
 	//n = 255; //reserve word for sharp1
 	char* sharp1 = getSharp1(var);
-	dfaStoreException(1, sharp1);
+	builder.StoreException(1, sharp1);
 	free(sharp1); sharp1 = NULL;
 	//n = 254;
 	char* sharp0 = getSharp0(var);
-	dfaStoreException(1, sharp0);
+	builder.StoreException(1, sharp0);
 	free(sharp0); sharp0 = NULL;
-	dfaStoreState(0);
+	builder.StoreState(0);
 
-	dfaAllocExceptions(0);
-	dfaStoreState(1);
+	builder.AllocExceptions(0);
+	builder.StoreState(1);
 
-	return dfaBuild("+-");
+	return builder.Build("+-");
 }
 
 DFA_ptr Automaton::dfa_star_M_star(DFA *M, int var, int *indices) {
@@ -3217,7 +3823,7 @@ DFA_ptr Automaton::dfa_star_M_star(DFA *M, int var, int *indices) {
 	//assert(sink>-1);
 	//printf("\n\n SINK %d\n\n\n", sink);
 
-	dfaSetup(ns, len, indices);
+	DFABuilder builder(ns, len, indices);
 	exeps = (char *) malloc(max_exeps * (len + 1) * sizeof(char));
 	addedexeps = (char *) malloc(max_exeps * (len + 1) * sizeof(char));
 	to_states = (int *) malloc(max_exeps * sizeof(int));
@@ -3254,11 +3860,11 @@ DFA_ptr Automaton::dfa_star_M_star(DFA *M, int var, int *indices) {
 	kill_paths(state_paths);
 
 	//initial state
-	dfaAllocExceptions(k + 1);
+	builder.AllocExceptions(k + 1);
 	for (k--; k >= 0; k--)
-		dfaStoreException(added_to_states[k], addedexeps + k * (len + 1));
-	dfaStoreException(0, arbitrary);
-	dfaStoreState(sink + shift);
+		builder.StoreException(added_to_states[k], addedexeps + k * (len + 1));
+	builder.StoreException(0, arbitrary);
+	builder.StoreState(sink + shift);
 	statuces[0] = '-';
 
 	//M
@@ -3291,17 +3897,17 @@ DFA_ptr Automaton::dfa_star_M_star(DFA *M, int var, int *indices) {
 			pp = pp->next;
 		}
 		if (M->f[i] == 1) { //add added paths
-			dfaAllocExceptions(k + 1);
+			builder.AllocExceptions(k + 1);
 			for (k--; k >= 0; k--)
-				dfaStoreException(to_states[k], exeps + k * (len + 1));
-			dfaStoreException(i + shift, arbitrary); //for appending S* for the final state
-			dfaStoreState(sink + shift);
+				builder.StoreException(to_states[k], exeps + k * (len + 1));
+			builder.StoreException(i + shift, arbitrary); //for appending S* for the final state
+			builder.StoreState(sink + shift);
 			statuces[i + shift] = '+';
 		} else {
-			dfaAllocExceptions(k);
+			builder.AllocExceptions(k);
 			for (k--; k >= 0; k--)
-				dfaStoreException(to_states[k], exeps + k * (len + 1));
-			dfaStoreState(sink + shift);
+				builder.StoreException(to_states[k], exeps + k * (len + 1));
+			builder.StoreState(sink + shift);
 			statuces[i + shift] = '-';
 		}
 		kill_paths(state_paths);
@@ -3309,21 +3915,21 @@ DFA_ptr Automaton::dfa_star_M_star(DFA *M, int var, int *indices) {
 
 	// add artificial sink state if necessary
 	if(not has_sink) {
-		dfaAllocExceptions(0);
-		dfaStoreState(sink);
+		builder.AllocExceptions(0);
+		builder.StoreState(sink);
 		statuces[sink] = '-';
 	}
 
 	statuces[ns] = '\0';
 	//result = dfaBuild(statuces);
-	tmpM = dfaBuild(statuces);
+	tmpM = builder.Build(statuces);
 	//dfaPrintVitals(tmpM);
 	//printf("Original M\n");
 	//dfaPrintVerbose(M);
 	//printf("Star M Star\n");
 	//dfaPrintVerbose(tmpM);
 
-	result = dfaProject(tmpM, (unsigned) var); //var is the index of the extra bit
+	result = DFAProject(tmpM, (unsigned) var); //var is the index of the extra bit
 	//printf("Projection of Star M Star\n");
 	//dfaPrintVerbose(result);
 
@@ -3334,7 +3940,7 @@ DFA_ptr Automaton::dfa_star_M_star(DFA *M, int var, int *indices) {
 	free(statuces);
     free(arbitrary);
 	dfaFree(tmpM);
-    tmpM = dfaMinimize(result);
+    tmpM = DFAMinimize(result);
     dfaFree(result);
 	return tmpM;
 }
@@ -3356,11 +3962,11 @@ DFA_ptr Automaton::dfa_general_replace_extrabit(DFA* M1, DFA* M2, DFA* M3, int v
 	if(check_intersection(M_sharp, M_inter, var, indices)>0){
 		//replace match patterns
 		M_rep = dfa_replace_step3_general_replace(M_inter, M3, var, indices);
-		result = dfaProject(M_rep, (unsigned) var);
+		result = DFAProject(M_rep, (unsigned) var);
 		dfaFree(M_rep);
 
 	}else { //no match
-		result = dfaCopy(M1);
+		result = DFACopy(M1);
 	}
 	//printf("free M1_bar\n");
 	dfaFree(M1_bar);
@@ -3371,7 +3977,7 @@ DFA_ptr Automaton::dfa_general_replace_extrabit(DFA* M1, DFA* M2, DFA* M3, int v
 	//printf("free M_sharp\n");
 	dfaFree(M_sharp);
 
-	DFA *tmp = dfaMinimize(result);
+	DFA *tmp = DFAMinimize(result);
 	dfaFree(result);
 	return tmp;
 }
@@ -3410,7 +4016,7 @@ DFA_ptr Automaton::dfa_replace_step1_duplicate(DFA *M, int var, int *indices) {
 	}
 
 
-	dfaSetup(newns, len, indices);
+	DFABuilder builder(newns, len, indices);
 	exeps = (char *) malloc(max_exeps * (len + 1) * sizeof(char));
 	to_states = (int *) malloc(max_exeps * sizeof(int));
 	statuces = (char *) malloc((newns + 1) * sizeof(char));
@@ -3444,15 +4050,15 @@ DFA_ptr Automaton::dfa_replace_step1_duplicate(DFA *M, int var, int *indices) {
 				}
 				pp = pp->next;
 			}
-			dfaAllocExceptions(k + 1);
+			builder.AllocExceptions(k + 1);
 			for (k--; k >= 0; k--)
-				dfaStoreException(to_states[k], exeps + k * (len + 1));
+				builder.StoreException(to_states[k], exeps + k * (len + 1));
 			if (i > sink)
-				dfaStoreException(i + shift - 1, sharp1);
+				builder.StoreException(i + shift - 1, sharp1);
 			else
-				dfaStoreException(i + shift, sharp1);
+				builder.StoreException(i + shift, sharp1);
 
-			dfaStoreState(sink);
+			builder.StoreState(sink);
 
 			if (M->f[i] == 1)
 				statuces[i] = '+';
@@ -3460,8 +4066,8 @@ DFA_ptr Automaton::dfa_replace_step1_duplicate(DFA *M, int var, int *indices) {
 				statuces[i] = '-';
 			kill_paths(state_paths);
 		} else {
-			dfaAllocExceptions(0);
-			dfaStoreState(sink);
+			builder.AllocExceptions(0);
+			builder.StoreState(sink);
 			statuces[i] = '-';
 		}
 	}
@@ -3499,11 +4105,11 @@ DFA_ptr Automaton::dfa_replace_step1_duplicate(DFA *M, int var, int *indices) {
 				pp = pp->next;
 			}
 
-			dfaAllocExceptions(k + 1);
+			builder.AllocExceptions(k + 1);
 			for (k--; k >= 0; k--)
-				dfaStoreException(to_states[k], exeps + k * (len + 1));
-			dfaStoreException(i, sharp0);
-			dfaStoreState(sink);
+				builder.StoreException(to_states[k], exeps + k * (len + 1));
+			builder.StoreException(i, sharp0);
+			builder.StoreState(sink);
 			if (M->f[i] == 1)
 				statuces[i + shift] = '-';
 			else if (M->f[i] == -1)
@@ -3516,14 +4122,14 @@ DFA_ptr Automaton::dfa_replace_step1_duplicate(DFA *M, int var, int *indices) {
 
 	// add artificial sink state if necessary
 	if(not has_sink) {
-		dfaAllocExceptions(0);
-		dfaStoreState(sink);
+		builder.AllocExceptions(0);
+		builder.StoreState(sink);
 		statuces[sink] = '-';
 	}
 
 	statuces[newns] = '\0';
 	//assert(i+shift == newns);
-	temp = dfaBuild(statuces);
+	temp = builder.Build(statuces);
 	//dfaPrintVitals(result);
 	//printf("FREE EXEPS\n");
 	free(exeps);
@@ -3532,7 +4138,7 @@ DFA_ptr Automaton::dfa_replace_step1_duplicate(DFA *M, int var, int *indices) {
 	//printf("FREE STATUCES\n");
 	free(statuces);
 	//dfaFree(tmpM);
-		result = dfaMinimize(temp);
+		result = DFAMinimize(temp);
 		dfaFree(temp);
 
 	return result;
@@ -3559,7 +4165,7 @@ DFA_ptr Automaton::dfa_replace_step2_match_compliment(DFA *M, int var, int *indi
 
 	M_tneg = dfa_star_M_star(M, var, indices);
 
-	dfaNegation(M_tneg);
+	DFANegation(M_tneg);
 
 	//Union empty string manually
 	//M_neg = dfa_union_empty_M(M_tneg, var, indices);
@@ -3596,7 +4202,7 @@ DFA_ptr Automaton::dfa_replace_step2_match_compliment(DFA *M, int var, int *indi
 		sink += shift;
 	}
 
-	dfaSetup(newns, len, indices);
+	DFABuilder builder(newns, len, indices);
 	exeps = (char *) malloc(max_exeps * (len + 1) * sizeof(char));
 	to_states = (int *) malloc(max_exeps * sizeof(int));
 	statuces = (char *) malloc((newns + 1) * sizeof(char));
@@ -3635,17 +4241,17 @@ DFA_ptr Automaton::dfa_replace_step2_match_compliment(DFA *M, int var, int *indi
 			}
 
 			if (M_neg->f[i] == 1) {
-				dfaAllocExceptions(k + 1);
+				builder.AllocExceptions(k + 1);
 				for (k--; k >= 0; k--)
-					dfaStoreException(to_states[k], exeps + k * (len + 1));
-				dfaStoreException(shift, sharp1);
-				dfaStoreState(sink);
+					builder.StoreException(to_states[k], exeps + k * (len + 1));
+				builder.StoreException(shift, sharp1);
+				builder.StoreState(sink);
 				statuces[y] = '+';
 			} else {
-				dfaAllocExceptions(k);
+				builder.AllocExceptions(k);
 				for (k--; k >= 0; k--)
-					dfaStoreException(to_states[k], exeps + k * (len + 1));
-				dfaStoreState(sink);
+					builder.StoreException(to_states[k], exeps + k * (len + 1));
+				builder.StoreState(sink);
 				if (M_neg->f[i] == -1)
 					statuces[y + shift] = '-';
 				else
@@ -3656,8 +4262,8 @@ DFA_ptr Automaton::dfa_replace_step2_match_compliment(DFA *M, int var, int *indi
 		}
 		/*		else {
 		 //if M_neg exists sink state
-		 dfaAllocExceptions(0);
-		 dfaStoreState(sink);
+		 builder.AllocExceptions(0);
+		 builder.StoreState(sink);
 		 statuces[i]='0';
 		 }
 		 */
@@ -3698,17 +4304,17 @@ DFA_ptr Automaton::dfa_replace_step2_match_compliment(DFA *M, int var, int *indi
 			}
 
 			if (M->f[i] == 1) {
-				dfaAllocExceptions(k + 1);
+				builder.AllocExceptions(k + 1);
 				for (k--; k >= 0; k--)
-					dfaStoreException(to_states[k], exeps + k * (len + 1));
-				dfaStoreException(0, sharp0); //add sharp1 to the initial state of M
-				dfaStoreState(sink);
+					builder.StoreException(to_states[k], exeps + k * (len + 1));
+				builder.StoreException(0, sharp0); //add sharp1 to the initial state of M
+				builder.StoreState(sink);
 				statuces[i + shift] = '-';
 			} else {
-				dfaAllocExceptions(k);
+				builder.AllocExceptions(k);
 				for (k--; k >= 0; k--)
-					dfaStoreException(to_states[k], exeps + k * (len + 1));
-				dfaStoreState(sink);
+					builder.StoreException(to_states[k], exeps + k * (len + 1));
+				builder.StoreState(sink);
 				if (M->f[i] == -1)
 					statuces[i + shift] = '-';
 				else
@@ -3716,22 +4322,22 @@ DFA_ptr Automaton::dfa_replace_step2_match_compliment(DFA *M, int var, int *indi
 			}
 			kill_paths(state_paths);
 		} else { //sink state
-			dfaAllocExceptions(0);
-			dfaStoreState(sink);
+			builder.AllocExceptions(0);
+			builder.StoreState(sink);
 			statuces[i + shift] = '-';
 		}
 	}
 
 	// add artificial sink state if necessary
 	if(not has_sink) {
-		dfaAllocExceptions(0);
-		dfaStoreState(sink);
+		builder.AllocExceptions(0);
+		builder.StoreState(sink);
 		statuces[sink] = '-';
 	}
 
 	statuces[newns] = '\0';
 	//assert(i+shift == newns);
-	temp = dfaBuild(statuces);
+	temp = builder.Build(statuces);
 	//dfaPrintVitals(result);
 	//printf("FREE EXEPS\n");
 	free(exeps);
@@ -3742,7 +4348,7 @@ DFA_ptr Automaton::dfa_replace_step2_match_compliment(DFA *M, int var, int *indi
 	dfaFree(M_neg);
 	dfaFree(M_tneg);
 	//dfaFree(M_e);
-		result = dfaMinimize(temp);
+		result = DFAMinimize(temp);
 		dfaFree(temp);
 	return result;
 }
@@ -3845,7 +4451,7 @@ DFA_ptr Automaton::dfa_replace_delete(DFA *M, int var, int *oldindices)
   //pairs[i] is the list of all reachable states by \sharp1 \bar \sharp0 from i
 
 
-  dfaSetup(M->ns, len, indices);
+  DFABuilder builder(M->ns, len, indices);
   exeps=(char *)malloc(max_exeps*(len+1)*sizeof(char)); //plus 1 for \0 end of the string
   to_states=(int *)malloc(max_exeps*sizeof(int));
   statuces=(char *)malloc((ns+1)*sizeof(char));
@@ -3894,10 +4500,10 @@ DFA_ptr Automaton::dfa_replace_delete(DFA *M, int var, int *oldindices)
       pp = pp->next;
     }//end while
 
-    dfaAllocExceptions(k);
+    builder.AllocExceptions(k);
     for(k--;k>=0;k--)
-      dfaStoreException(to_states[k],exeps+k*(len+1));
-    dfaStoreState(sink);
+      builder.StoreException(to_states[k],exeps+k*(len+1));
+    builder.StoreState(sink);
 
     if(M->f[i]==1)
       statuces[i]='+';
@@ -3911,20 +4517,20 @@ DFA_ptr Automaton::dfa_replace_delete(DFA *M, int var, int *oldindices)
 
   // add artificial sink state if necessary
   if(not has_sink) {
-  	dfaAllocExceptions(0);
-  	dfaStoreState(sink);
+  	builder.AllocExceptions(0);
+  	builder.StoreState(sink);
   	statuces[sink] = '-';
   }
 
   statuces[ns]='\0';
-  tmpM2=dfaBuild(statuces);
+  tmpM2=builder.Build(statuces);
   //dfaPrintVitals(result);
   for(i=0; i<aux; i++){
     j=len -i;
-    tmpM1 =dfaProject(tmpM2, (unsigned) j);
+    tmpM1 =DFAProject(tmpM2, (unsigned) j);
       dfaFree(tmpM2); tmpM2 = NULL;
-    tmpM2 = dfaMinimize(tmpM1);
-      dfaFree(tmpM1); tmpM1 = NULL;
+    tmpM2 = DFAMinimizeIntermediate(tmpM1);
+      tmpM1 = NULL;
   }
   free(exeps);
   //printf("FREE ToState\n");
@@ -3937,7 +4543,7 @@ DFA_ptr Automaton::dfa_replace_delete(DFA *M, int var, int *oldindices)
   for(i=0; i<M->ns; i++)
     free_ilt(pairs[i]);
   free(pairs);
-  result = dfaMinimize(tmpM2);	//MUST BE CAREFUL FOR INDICES..INDICES MAY NOT MATCH!!
+  result = DFAMinimize(tmpM2);	//MUST BE CAREFUL FOR INDICES..INDICES MAY NOT MATCH!!
     dfaFree(tmpM2);
     return result;
 
@@ -3999,7 +4605,7 @@ DFA * Automaton::dfa_replace_M_dot(DFA *M, DFA* Mr, int var, int *oldindices)
   //pairs[i] is the list of all reachable states by \sharp1 \bar \sharp0 from i
 
 
-  dfaSetup(ns, len, indices);
+  DFABuilder builder(ns, len, indices);
   exeps=(char *)malloc(max_exeps*(len+1)*sizeof(char)); //plus 1 for \0 end of the string
   to_states=(int *)malloc(max_exeps*sizeof(int));
   statuces=(char *)malloc((ns+1)*sizeof(char));
@@ -4055,10 +4661,10 @@ DFA * Automaton::dfa_replace_M_dot(DFA *M, DFA* Mr, int var, int *oldindices)
       }	//end for z
     }
 
-    dfaAllocExceptions(k);
+    builder.AllocExceptions(k);
     for(k--;k>=0;k--)
-      dfaStoreException(to_states[k],exeps+k*(len+1));
-    dfaStoreState(sink);
+      builder.StoreException(to_states[k],exeps+k*(len+1));
+    builder.StoreState(sink);
 
     if(M->f[i]==1)
       statuces[i]='+';
@@ -4072,18 +4678,19 @@ DFA * Automaton::dfa_replace_M_dot(DFA *M, DFA* Mr, int var, int *oldindices)
 
   // add artificial sink state if necessary
   if(not has_sink) {
-  	dfaAllocExceptions(0);
-  	dfaStoreState(sink);
+  	builder.AllocExceptions(0);
+  	builder.StoreState(sink);
   	statuces[sink] = '-';
   }
 
   statuces[ns]='\0';
-  result=dfaBuild(statuces);
+  result=builder.Build(statuces);
   //dfaPrintVitals(result);
   for(i=0; i<aux; i++){
     j=len-i;
-    tmpM =dfaProject(result, (unsigned) j);
-    result = dfaMinimize(tmpM);
+    tmpM =DFAProject(result, (unsigned) j);
+    dfaFree(result);
+    result = DFAMinimizeIntermediate(tmpM);
   }
   free(exeps);
   //printf("FREE ToState\n");
@@ -4103,7 +4710,7 @@ DFA * Automaton::dfa_replace_M_dot(DFA *M, DFA* Mr, int var, int *oldindices)
     free_ilt(pairs[i]);
   free(pairs);
 
-  return dfaMinimize(result);
+  return DFAMinimize(result);
 
 }// End dfa_replace_M_dot
 
@@ -4184,7 +4791,7 @@ DFA_ptr Automaton::dfa_replace_M_arbitrary(DFA *M, DFA *Mr, int var, int *oldind
 
 
   //pairs[i] is the list of all reachable states by \sharp1 \bar \sharp0 from i
-  dfaSetup(ns, len, indices);
+  DFABuilder builder(ns, len, indices);
   exeps=(char *)malloc(max_exeps*(len+1)*sizeof(char)); //plus 1 for \0 end of the string
   to_states=(int *)malloc(max_exeps*sizeof(int));
   statuces=(char *)malloc((ns+1)*sizeof(char));
@@ -4236,10 +4843,10 @@ DFA_ptr Automaton::dfa_replace_M_arbitrary(DFA *M, DFA *Mr, int var, int *oldind
       s++;
     }
 
-    dfaAllocExceptions(k);
+    builder.AllocExceptions(k);
     for(k--;k>=0;k--)
-      dfaStoreException(to_states[k],exeps+k*(len+1));
-    dfaStoreState(sink);
+      builder.StoreException(to_states[k],exeps+k*(len+1));
+    builder.StoreState(sink);
 
     if(M->f[i]==1)
       statuces[i]='+';
@@ -4261,15 +4868,15 @@ DFA_ptr Automaton::dfa_replace_M_arbitrary(DFA *M, DFA *Mr, int var, int *oldind
     numsharp2 = pairs[startStates[n]]->count;
     for(i=0; i<Mr->ns; i++){ //internal M (exclude the first and the last char)
       if(numOfOutFinal[i]==0){
-	dfaAllocExceptions(numOfOut[i]);
+	builder.AllocExceptions(numOfOut[i]);
 	for(o =0; o<numOfOut[i]; o++){
-	  dfaStoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
+	  builder.StoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
 	}
-	dfaStoreState(sink);
+	builder.StoreState(sink);
       }else{//need to add aux edges back to sharp destination, for each edge leads to accepting state
-	dfaAllocExceptions(numOfOut[i]+numOfOutFinal[i]*numsharp2);
+	builder.AllocExceptions(numOfOut[i]+numOfOutFinal[i]*numsharp2);
 	for(o =0; o<numOfOut[i]; o++){
-	  dfaStoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
+	  builder.StoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
 	  if(Mr->f[toOfOut[i][o]]==1){ //add auxiliary back edges
 	    for(z=0, tmp=pairs[startStates[n]]->head;z< numsharp2; z++, tmp = tmp->next){
 	      aux_to_states[z]=tmp->value;
@@ -4282,10 +4889,10 @@ DFA_ptr Automaton::dfa_replace_M_arbitrary(DFA *M, DFA *Mr, int var, int *oldind
 	    }
 
 	    for(z--;z>=0;z--)
-	      dfaStoreException(aux_to_states[z],auxexeps+z*(len+1));
+	      builder.StoreException(aux_to_states[z],auxexeps+z*(len+1));
 	  }
 	}
-	dfaStoreState(sink);
+	builder.StoreState(sink);
       }
     }//end for Mr internal
   }
@@ -4294,21 +4901,20 @@ DFA_ptr Automaton::dfa_replace_M_arbitrary(DFA *M, DFA *Mr, int var, int *oldind
 
   // add artificial sink state if necessary
   if(not has_sink) {
-  	dfaAllocExceptions(0);
-  	dfaStoreState(sink);
+  	builder.AllocExceptions(0);
+  	builder.StoreState(sink);
   }
 
   statuces[ns]='\0';
-  result=dfaBuild(statuces);
+  result=builder.Build(statuces);
 
   for(i=0; i<aux; i++){
     j=len-i;
 
-    tmpM =dfaProject(dfaMinimize(result), (unsigned) j);
+    tmpM =DFAProject(result, (unsigned) j);
 
     dfaFree(result);
-    result = dfaMinimize(tmpM);
-    dfaFree(tmpM);
+    result = DFAMinimizeIntermediate(tmpM);
   }
   free(exeps);
   //printf("FREE ToState\n");
@@ -4343,7 +4949,7 @@ DFA_ptr Automaton::dfa_replace_M_arbitrary(DFA *M, DFA *Mr, int var, int *oldind
 
   free(pairs);
 
-  return dfaMinimize(result);
+  return DFAMinimize(result);
 
 }
 
@@ -4615,18 +5221,18 @@ int* Automaton::allocateArbitraryIndex(int length) {
 // A DFA that accepts only one arbitrary character
 DFA * Automaton::dfaDot(int var, int *indices){
 
-   dfaSetup(3,var,indices);
+   DFABuilder builder(3,var,indices);
 
-   dfaAllocExceptions(2);
-   dfaStoreException(2, getSharp1(var));
-   dfaStoreException(2, getSharp0(var));
-   dfaStoreState(1);
-   dfaAllocExceptions(0);
-   dfaStoreState(2);
-   dfaAllocExceptions(0);
-   dfaStoreState(2);
+   builder.AllocExceptions(2);
+   builder.StoreException(2, getSharp1(var));
+   builder.StoreException(2, getSharp0(var));
+   builder.StoreState(1);
+   builder.AllocExceptions(0);
+   builder.StoreState(2);
+   builder.AllocExceptions(0);
+   builder.StoreState(2);
 
-   return dfaBuild("-+-");
+   return builder.Build("-+-");
 }
 
 int Automaton::count_accepted_chars(DFA* M){
@@ -4789,24 +5395,24 @@ DFA * Automaton::dfa_construct_string(char *reg, int var, int *indices) {
 	DFA* result;
 	int len = (int) strlen(reg);
 	finals = (char *) malloc((len + 2) * sizeof(char));
-	dfaSetup(len + 2, var, indices);
+	DFABuilder builder(len + 2, var, indices);
 	for (i = 0; i < len; i++) {
-		dfaAllocExceptions(1);
+		builder.AllocExceptions(1);
 		binChar = bintostr((unsigned long) reg[i], var);
-		dfaStoreException(i + 1, binChar);
+		builder.StoreException(i + 1, binChar);
 		free(binChar);
-		dfaStoreState(len + 1);
+		builder.StoreState(len + 1);
 		finals[i] = '-';
 	}
-	dfaAllocExceptions(0);
-	dfaStoreState(len + 1);
+	builder.AllocExceptions(0);
+	builder.StoreState(len + 1);
 	finals[len] = '+';
 	//assert(len==i);
 	//sink state
-	dfaAllocExceptions(0);
-	dfaStoreState(len + 1);
+	builder.AllocExceptions(0);
+	builder.StoreState(len + 1);
 	finals[len + 1] = '-';
-	result = dfaBuild(finals);
+	result = builder.Build(finals);
 	free(finals);
 	return result;
 }
@@ -4854,7 +5460,7 @@ DFA * Automaton::dfa_insert_M_dot(DFA *M, DFA* Mr, int var, int *indices)
 
 
 
-  dfaSetup(num_states, len, indices);
+  DFABuilder builder(num_states, len, indices);
   exeps=(char *)malloc(max_exeps*(len+1)*sizeof(char)); //plus 1 for \0 end of the string
   to_states=(int *)malloc(max_exeps*sizeof(int));
   statuces=(char *)malloc((num_states+1)*sizeof(char));
@@ -4894,10 +5500,10 @@ DFA * Automaton::dfa_insert_M_dot(DFA *M, DFA* Mr, int var, int *indices)
 				k++;
       } // end for nc
     }
-    dfaAllocExceptions(k);
+    builder.AllocExceptions(k);
     for(k--;k>=0;k--)
-      dfaStoreException(to_states[k],exeps+k*(len+1));
-    dfaStoreState(sink);
+      builder.StoreException(to_states[k],exeps+k*(len+1));
+    builder.StoreState(sink);
 
     if(M->f[i]==1)
       statuces[i]='+';
@@ -4909,15 +5515,15 @@ DFA * Automaton::dfa_insert_M_dot(DFA *M, DFA* Mr, int var, int *indices)
 
   // if original dfa had no sink, add one
   if(not has_sink) {
-  	dfaAllocExceptions(0);
-  	dfaStoreState(sink);
+  	builder.AllocExceptions(0);
+  	builder.StoreState(sink);
   	statuces[sink] = '-';
   }
 
   statuces[num_states]='\0';
-  result=dfaBuild(statuces);
-  tmpM =dfaProject(result, (unsigned) len-1);
-  result = dfaMinimize(tmpM);
+  result=builder.Build(statuces);
+  tmpM =DFAProject(result, (unsigned) len-1);
+  result = DFAMinimize(tmpM);
 
   free(exeps);
   free(to_states);
@@ -4972,7 +5578,7 @@ DFA * Automaton::dfa_insert_M_arbitrary(DFA *M, DFA *Mr, int var, int *indices)
   //assert(sink >-1);
 
 
-  dfaSetup(ns, len, indices);
+  DFABuilder builder(ns, len, indices);
   exeps=(char *)malloc(max_exeps*(len+1)*sizeof(char)); //plus 1 for \0 end of the string
   to_states=(int *)malloc(max_exeps*sizeof(int));
   statuces=(char *)malloc((ns+1)*sizeof(char));
@@ -5019,10 +5625,10 @@ DFA * Automaton::dfa_insert_M_arbitrary(DFA *M, DFA *Mr, int var, int *indices)
     }
 
 
-    dfaAllocExceptions(k);
+    builder.AllocExceptions(k);
     for(k--;k>=0;k--)
-      dfaStoreException(to_states[k],exeps+k*(len+1));
-    dfaStoreState(sink);
+      builder.StoreException(to_states[k],exeps+k*(len+1));
+    builder.StoreState(sink);
 
     if(M->f[i]==1)
       statuces[i]='+';
@@ -5040,23 +5646,23 @@ DFA * Automaton::dfa_insert_M_arbitrary(DFA *M, DFA *Mr, int var, int *indices)
   for(n=0; n< M->ns; n++){
     for(i=0; i<Mr->ns; i++){ //internal M (exclude the first and the last char)
       if(numOfOutFinal[i]==0){
-	dfaAllocExceptions(numOfOut[i]);
+	builder.AllocExceptions(numOfOut[i]);
 	for(o =0; o<numOfOut[i]; o++){
-	  dfaStoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
+	  builder.StoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
 	}
-	dfaStoreState(sink);
+	builder.StoreState(sink);
       }else{//need to add aux edges back to sharp destination, for each edge leads to accepting state
-	dfaAllocExceptions(numOfOut[i]+numOfOutFinal[i]);
+	builder.AllocExceptions(numOfOut[i]+numOfOutFinal[i]);
 	for(o =0; o<numOfOut[i]; o++){
-	  dfaStoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
+	  builder.StoreException(M->ns+n*(extrastates)+toOfOut[i][o], binOfOut[i][o]);
 	  if(Mr->f[toOfOut[i][o]]==1){ //add auxiliary back edge to n
 	    for (j = 0; j < var; j++) auxexeps[j]=binOfOut[i][o][j];
 	    auxexeps[j]='1';
 	    auxexeps[len]='\0';
-	    dfaStoreException(n,auxexeps);
+	    builder.StoreException(n,auxexeps);
 	  }
 	}
-	dfaStoreState(sink);
+	builder.StoreState(sink);
       }
     }//end for Mr internal
   }//end for n
@@ -5064,21 +5670,20 @@ DFA * Automaton::dfa_insert_M_arbitrary(DFA *M, DFA *Mr, int var, int *indices)
   for(i=M->ns; i<ns; i++) statuces[i]='-';
   // add artificial sink state if necessary
   if(not has_sink) {
-  	dfaAllocExceptions(0);
-  	dfaStoreState(sink);
+  	builder.AllocExceptions(0);
+  	builder.StoreState(sink);
   }
 
   statuces[ns]='\0';
-  result=dfaBuild(statuces);
+  result=builder.Build(statuces);
 
   // dfaPrintVerbose(dfaMinimize(result));
 
-  tmpM =dfaProject(dfaMinimize(result), (unsigned) len-1);
+  tmpM =DFAProject(result, (unsigned) len-1);
   //dfaPrintVerbose(tmpM);
 
   dfaFree(result);
-  result = dfaMinimize(tmpM);
-  dfaFree(tmpM);
+  result = DFAMinimizeIntermediate(tmpM);
 
   free(exeps);
   free(auxexeps);
@@ -5098,7 +5703,7 @@ DFA * Automaton::dfa_insert_M_arbitrary(DFA *M, DFA *Mr, int var, int *indices)
   free(numOfOut);
   free(numOfOutFinal);
 
-  return dfaMinimize(result);
+  return DFAMinimize(result);
 
 }//End dfa_insert_M_arbitrary
 
@@ -10,19 +10,23 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <random>
 #include <ctime>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -34,15 +38,18 @@
 #include <mona/dfa.h>
 #include <mona/mem.h>
 
+#include "../utils/Cancellation.h"
 #include "../utils/Cmd.h"
 #include "../utils/Math.h"
 #include "../boost/multiprecision/cpp_int.hpp"
 #include "../Eigen/SparseCore"
+#include "DFABuilder.h"
 #include "Graph.h"
 #include "GraphNode.h"
 #include "options/Theory.h"
 #include "SymbolicCounter.h"
 #include "Formula.h"
+#include "TernaryException.h"
 
 namespace Vlab {
 namespace Theory {
@@ -158,6 +165,18 @@ public:
    */
   int GetSinkState() const;
 
+  /**
+   * Gets the number of states
+   * @return
+   */
+  int GetNumberOfStates() const;
+
+  /**
+   * Gets the number of distinct bdd nodes reachable from the states, leaves included
+   * @return
+   */
+  int GetNumberOfBddNodes() const;
+
   /**
    * Generates a specific type of automaton that wraps dfa instance
    * @param dfa
@@ -210,7 +229,6 @@ public:
   virtual BigInteger SymbolicCount(double bound, bool count_less_than_or_equal_to_bound = true);
   virtual std::map<std::string,std::vector<std::string>> GetModelsWithinBound(int num_models, int bound);
   SymbolicCounter GetSymbolicCounter();
-  static void SetCountBoundExact(bool value);
 
   class Name {
   public:
@@ -230,6 +248,8 @@ public:
   void toBDD(std::ostream& out = std::cout);
   void exportDfa(std::string file_name);
   DFA_ptr importDFA(std::string file_name);
+  void exportDfaBinary(std::string file_name);
+  DFA_ptr importDfaBinary(std::string file_name);
   int inspectAuto(bool print_sink = false, bool force_mona_format = false);
   int inspectBDD();
 
@@ -349,6 +369,61 @@ protected:
    */
   static DFA_ptr DFAComplement(const DFA_ptr dfa);
 
+  /**
+   * MONA's dfaCopy, dfaProduct and dfaProject under MonaLock and dfaNegation; results are not minimized
+   */
+  static DFA_ptr DFACopy(const DFA_ptr dfa);
+
+  /**
+   * Bytes of the states and the bdd nodes of the dfa
+   * @param dfa
+   */
+  static std::size_t DFAMemorySize(const DFA_ptr dfa);
+  static DFA_ptr DFAProduct(const DFA_ptr dfa1, const DFA_ptr dfa2, const dfaProductType product_type);
+  static DFA_ptr DFAProject(const DFA_ptr dfa, const unsigned index);
+  static void DFANegation(DFA_ptr dfa);
+
+  /**
+   * Minimizes a dfa with the configured minimizer (MONA or native partition refinement)
+   * @param dfa
+   * @return minimized dfa, caller keeps the ownership of the given dfa
+   */
+  static DFA_ptr DFAMinimize(const DFA_ptr dfa);
+
+  /**
+   * Minimization step inside a chain of dfa operations, takes the ownership of the given dfa.
+   * When minimization is deferred the dfa is returned as it is unless it has more states than
+   * the deferral limit; the chain must end with DFAMinimizeDeferred.
+   * @param dfa
+   * @return
+   */
+  static DFA_ptr DFAMinimizeIntermediate(DFA_ptr dfa);
+
+  /**
+   * Ends a chain of dfa operations started with DFAMinimizeIntermediate, takes the ownership of the given dfa.
+   * @param dfa
+   * @return minimized dfa
+   */
+  static DFA_ptr DFAMinimizeDeferred(DFA_ptr dfa);
+
+  /**
+   * Starts minimizing a dfa; runs the native minimizer on a worker thread if it is enabled,
+   * otherwise minimization runs on the calling thread when the result is requested.
+   * The given dfa must not be changed or freed before the result is taken.
+   * @param dfa
+   * @return
+   */
+  static std::future<DFA_ptr> DFAMinimizeAsync(const DFA_ptr dfa);
+
+  /**
+   * Minimizes a dfa with partition refinement over flat arrays of its bdd nodes.
+   * Only works on the bdd managers of the given and the new dfa, it does not need MonaLock and
+   * it is safe to call from a worker thread.
+   * @param dfa
+   * @return minimized dfa whose initial state is 0
+   */
+  static DFA_ptr DFAMinimizeNative(const DFA_ptr dfa);
+
   /**
    * Generates a dfa with the union of the two given dfas
    * @param dfa1
@@ -385,6 +460,17 @@ protected:
 	 */
 	static DFA_ptr DFAProjectAway(const DFA_ptr dfa, std::vector<int> map, const std::vector<int> indices);
 
+  /**
+   * Generates a dfa where all bdd variables in the given indices are projected away with a single subset construction.
+   * Projected variables are eliminated symbolically while walking the bdds of a subset, no intermediate dfa is built.
+   * @param dfa
+   * @param number_of_bdd_variables
+   * @param indices bdd variables to project away
+   * @param map optional new index for each remaining bdd variable
+   * @return a minimized dfa
+   */
+  static DFA_ptr DFAProjectAwayAll(const DFA_ptr dfa, const int number_of_bdd_variables, const std::vector<int>& indices, const int* map = nullptr);
+
   /**
    * Generates a dfa where the bdd variable in the given index of the given dfa projected away and the index mapping is done again
    * @param dfa
@@ -429,6 +515,15 @@ protected:
    */
   static DFA_ptr DFAMakeAcceptingAnyAfterLength(const int length, const int number_of_bdd_variables);
 
+  /**
+   * Generates a unary dfa (one bdd variable, '1' per input symbol) that accepts the lengths of the inputs
+   * accepted by the given dfa. Transition labels are collapsed and a single unary subset construction is run
+   * on the state graph, no projection is needed.
+   * @param dfa
+   * @return
+   */
+  static DFA_ptr DFAMakeUnaryLengthDfa(const DFA_ptr dfa);
+
   /**
    * Gets set of transitions between two states
    * @param dfa
@@ -448,6 +543,38 @@ protected:
 	 */
   static DFA_ptr DFAConcat(const DFA_ptr dfa1, const DFA_ptr dfa2, const int number_of_bdd_variables);
 
+  /**
+   * Enumerates the bdd paths of a state by walking bdd nodes directly instead of building make_paths lists.
+   * Variables on a path are written into the given exception and reset to 'X' afterwards.
+   * @param dfa
+   * @param state
+   * @param exception
+   * @param visit called with the target state and the exception for each path
+   * @param positions optional mapping from bdd variable index to exception position
+   */
+  static void DFAForEachPath(const DFA_ptr dfa, const int state, TernaryException& exception,
+                             const std::function<void(const int, const TernaryException&)>& visit, const int* positions = nullptr);
+  static void DFAForEachPath(bdd_manager* bddm, const unsigned node, TernaryException& exception,
+                             const std::function<void(const int, const TernaryException&)>& visit, const int* positions);
+
+  /**
+   * Writes a dfa in a compact binary format; statuses followed by the bdd paths of each state,
+   * a path uses 2 bits per bdd variable (0, 1, X)
+   * @param dfa
+   * @param number_of_bdd_variables
+   * @param out
+   */
+  static void DFAExportBinary(const DFA_ptr dfa, const int number_of_bdd_variables, std::ostream& out);
+
+  /**
+   * Rebuilds a dfa written with DFAExportBinary
+   * @param data
+   * @param size
+   * @param number_of_bdd_variables
+   * @return dfa or nullptr if data is malformed
+   */
+  static DFA_ptr DFAImportBinary(const char* data, const std::size_t size, const int number_of_bdd_variables);
+
 
   bool isAcceptingSingleWord();
   // TODO update it to work for non-accepting inputs
@@ -617,18 +744,23 @@ protected:
   static DFA *dfa_insert_M_arbitrary(DFA *M, DFA *Mr, int var, int *indices);
   static DFA *dfa_insert_everywhere(DFA *M, DFA* Mr, int var, int *indices);
 
-  static unsigned long next_id;
+  static std::atomic<unsigned long> next_id;
 
   /**
-   * Bdd variable indices cache used in MONA dfa manipulation
+   * Bdd variable indices cache used in MONA dfa manipulation, arrays are never freed while automata are in use
    */
   static std::unordered_map<int, int*> bdd_variable_indices;
+  static std::mutex bdd_variable_indices_mutex;
 
   /**
    * Automaton id used for debuggin purposes
    */
   unsigned long id_;
-  static int next_state;
+
+  /**
+   * Accepting state of the left dfa that DFAConcat connects to the right dfa, set by the caller
+   */
+  static thread_local int next_state;
 
   const Automaton::Type type_; // TODO remove type
 
@@ -650,11 +782,19 @@ protected:
    */
   SymbolicCounter counter_;
 
-  static bool count_bound_exact_;
+  /**
+   * Charges the dfa to the memory budget of the running query, the charge is refunded to the same budget
+   * when the automaton is deleted
+   */
+  void ChargeMemory();
+
+  Util::Cancellation::Budget_ptr charged_budget_;
+  std::size_t charged_memory_;
+
 private:
   char* getAnExample(bool accepting=true); // MONA version
   // for debugging
-  static int name_counter;
+  static std::atomic<int> name_counter;
   static const int VLOG_LEVEL;
 };
 
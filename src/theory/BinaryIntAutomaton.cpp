@@ -14,6 +14,7 @@ namespace Vlab {
 namespace Theory {
 
 const int BinaryIntAutomaton::VLOG_LEVEL = 9;
+const std::size_t BinaryIntAutomaton::MAX_NUMBER_OF_SEMILINEAR_VALUES = 1 << 24;
 
 BinaryIntAutomaton::BinaryIntAutomaton(bool is_natural_number)
     : Automaton(Automaton::Type::BINARYINT),
@@ -74,7 +75,14 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakePhi(ArithmeticFormula_ptr formula
  * Binary int automaton does not accept empty string
  */
 BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAnyInt(ArithmeticFormula_ptr formula, bool is_natural_number) {
-  auto any_binary_int_dfa = Automaton::DFAMakeAnyButNotEmpty(formula->GetNumberOfVariables());
+  DFA_ptr any_binary_int_dfa = nullptr;
+  if (Option::Theory::INT_BIT_WIDTH > 0) {
+    any_binary_int_dfa = Automaton::DFAMakeAcceptingAnyWithInRange(Option::Theory::INT_BIT_WIDTH,
+                                                                   Option::Theory::INT_BIT_WIDTH,
+                                                                   formula->GetNumberOfVariables());
+  } else {
+    any_binary_int_dfa = Automaton::DFAMakeAnyButNotEmpty(formula->GetNumberOfVariables());
+  }
   auto any_int = new BinaryIntAutomaton(any_binary_int_dfa, formula, is_natural_number);
 
   DVLOG(VLOG_LEVEL) << any_int->id_ << " = MakeAnyInt(" << *formula << ")";
@@ -84,6 +92,20 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAnyInt(ArithmeticFormula_ptr form
 BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAutomaton(ArithmeticFormula_ptr formula, bool is_natural_number) {
   BinaryIntAutomaton_ptr result_auto = nullptr;
 
+  if (Option::Theory::INT_BIT_WIDTH > 0 and formula->GetBooleans().empty()) {
+    switch (formula->GetType()) {
+      case ArithmeticFormula::Type::EQ:
+      case ArithmeticFormula::Type::NOTEQ:
+      case ArithmeticFormula::Type::GT:
+      case ArithmeticFormula::Type::GE:
+      case ArithmeticFormula::Type::LT:
+      case ArithmeticFormula::Type::LE:
+        return BinaryIntAutomaton::MakeBitVectorRelation(formula, is_natural_number);
+      default:
+        break;
+    }
+  }
+
   switch (formula->GetType()) {
     case ArithmeticFormula::Type::EQ: {
       result_auto = BinaryIntAutomaton::MakeEquality(formula, is_natural_number);
@@ -145,9 +167,13 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAutomaton(SemilinearSet_ptr semil
                                                          ArithmeticFormula_ptr formula, bool add_leading_zeros) {
   DVLOG(VLOG_LEVEL) << "BinaryIntAutomaton::MakeAutomaton("<< *semilinear_set << ", " << var_name;
 
+  // signed words end with a zero sign column; fixed width natural numbers are padded with zeros up to the width
+  // but do not need a zero column, values up to 2^width - 1 fit
+  const bool is_natural_number = not add_leading_zeros;
+  const bool is_padded = add_leading_zeros or Option::Theory::INT_BIT_WIDTH > 0;
   int var_index = formula->GetVariableIndex(var_name);
   int number_of_variables = formula->GetNumberOfVariables(), lz_index = 0;
-  if (add_leading_zeros) {
+  if (is_padded) {
     ++number_of_variables;
     lz_index = number_of_variables - 1;
   }
@@ -161,7 +187,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAutomaton(SemilinearSet_ptr semil
   int number_of_binary_states = binary_states.size();
   int number_of_states = number_of_binary_states + 1;
   int leading_zero_state = 0;  // only used if we add leading zeros
-  if (add_leading_zeros) {
+  if (is_padded) {
     ++number_of_states;
     leading_zero_state = number_of_states - 2;
   }
@@ -170,86 +196,86 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAutomaton(SemilinearSet_ptr semil
   int* indices = GetBddVariableIndices(number_of_variables);
   std::string statuses(number_of_states + 1, '-');
   statuses[number_of_states] = '\0';
-  dfaSetup(number_of_states, number_of_variables, indices);
+  DFABuilder builder(number_of_states, number_of_variables, indices);
   bool is_final_state = false;
   for (int i = 0; i < number_of_binary_states; i++) {
     is_final_state = is_accepting_binary_state(binary_states[i], semilinear_set);
 
-    if (add_leading_zeros and is_final_state) {
+    if (is_padded and is_final_state) {
       if (binary_states[i]->getd0() >= 0 && binary_states[i]->getd1() >= 0) {
-        dfaAllocExceptions(3);
+        builder.AllocExceptions(3);
         bit_transition[var_index] = '0';
         bit_transition[lz_index] = '0';
-        dfaStoreException(binary_states[i]->getd0(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd0(), &bit_transition[0]);
         bit_transition[var_index] = '1';
         bit_transition[lz_index] = 'X';
-        dfaStoreException(binary_states[i]->getd1(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd1(), &bit_transition[0]);
         bit_transition[var_index] = '0';
         bit_transition[lz_index] = '1';
-        dfaStoreException(leading_zero_state, &bit_transition[0]);
+        builder.StoreException(leading_zero_state, &bit_transition[0]);
       } else if (binary_states[i]->getd0() >= 0 && binary_states[i]->getd1() < 0) {
-        dfaAllocExceptions(2);
+        builder.AllocExceptions(2);
         bit_transition[var_index] = '0';
         bit_transition[lz_index] = '0';
-        dfaStoreException(binary_states[i]->getd0(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd0(), &bit_transition[0]);
         bit_transition[var_index] = '0';
         bit_transition[lz_index] = '1';
-        dfaStoreException(leading_zero_state, &bit_transition[0]);
+        builder.StoreException(leading_zero_state, &bit_transition[0]);
       } else if (binary_states[i]->getd0() < 0 && binary_states[i]->getd1() >= 0) {
-        dfaAllocExceptions(2);
+        builder.AllocExceptions(2);
         bit_transition[var_index] = '1';
         bit_transition[lz_index] = 'X';
-        dfaStoreException(binary_states[i]->getd1(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd1(), &bit_transition[0]);
         bit_transition[var_index] = '0';
         bit_transition[lz_index] = '1';
-        dfaStoreException(leading_zero_state, &bit_transition[0]);
+        builder.StoreException(leading_zero_state, &bit_transition[0]);
       } else {
-        dfaAllocExceptions(1);
+        builder.AllocExceptions(1);
         bit_transition[var_index] = '0';
         bit_transition[lz_index] = '1';
-        dfaStoreException(leading_zero_state, &bit_transition[0]);
+        builder.StoreException(leading_zero_state, &bit_transition[0]);
       }
       bit_transition[lz_index] = 'X';
     } else {
       if (binary_states[i]->getd0() >= 0 && binary_states[i]->getd1() >= 0) {
-        dfaAllocExceptions(2);
+        builder.AllocExceptions(2);
         bit_transition[var_index] = '0';
-        dfaStoreException(binary_states[i]->getd0(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd0(), &bit_transition[0]);
         bit_transition[var_index] = '1';
-        dfaStoreException(binary_states[i]->getd1(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd1(), &bit_transition[0]);
       } else if (binary_states[i]->getd0() >= 0 && binary_states[i]->getd1() < 0) {
-        dfaAllocExceptions(1);
+        builder.AllocExceptions(1);
         bit_transition[var_index] = '0';
-        dfaStoreException(binary_states[i]->getd0(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd0(), &bit_transition[0]);
       } else if (binary_states[i]->getd0() < 0 && binary_states[i]->getd1() >= 0) {
-        dfaAllocExceptions(1);
+        builder.AllocExceptions(1);
         bit_transition[var_index] = '1';
-        dfaStoreException(binary_states[i]->getd1(), &bit_transition[0]);
+        builder.StoreException(binary_states[i]->getd1(), &bit_transition[0]);
       } else {
-        dfaAllocExceptions(0);
+        builder.AllocExceptions(0);
       }
     }
 
-    dfaStoreState(sink_state);
+    builder.StoreState(sink_state);
 
-    if (is_final_state and (not add_leading_zeros)) {
+    if (is_final_state and is_natural_number) {
       statuses[i] = '+';
     }
   }
 
   // for the leading zero state
-  if (add_leading_zeros) {
-    dfaAllocExceptions(1);
+  if (is_padded) {
+    builder.AllocExceptions(1);
     bit_transition[var_index] = '0';
     bit_transition[lz_index] = '1';
-    dfaStoreException(leading_zero_state, &bit_transition[0]);
-    dfaStoreState(sink_state);
+    builder.StoreException(leading_zero_state, &bit_transition[0]);
+    builder.StoreState(sink_state);
     statuses[leading_zero_state] = '+';
   }
 
   // for the sink state
-  dfaAllocExceptions(0);
-  dfaStoreState(sink_state);
+  builder.AllocExceptions(0);
+  builder.StoreState(sink_state);
 
   int zero_state = binary_states[0]->getd0();  // adding leading zeros makes accepting zero 00, fix here
   if (zero_state > -1 and is_accepting_binary_state(binary_states[zero_state], semilinear_set)) {
@@ -257,27 +283,27 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAutomaton(SemilinearSet_ptr semil
     //    statuses[zero_state] = '+';
   }
 
-  auto binary_dfa = dfaBuild(&statuses[0]);
+  auto binary_dfa = builder.Build(&statuses[0]);
   // cleanup
   for (auto bin_state : binary_states) {
     delete bin_state;
   }
   binary_states.clear();
   //delete[] indices;
-  if (add_leading_zeros) {
+  if (is_padded) {
     auto tmp_dfa = binary_dfa;
-    binary_dfa = dfaProject(binary_dfa, (unsigned) (lz_index));
+    binary_dfa = DFAProject(binary_dfa, (unsigned) (lz_index));
     dfaFree(tmp_dfa);
     tmp_dfa = nullptr;
     number_of_variables = number_of_variables - 1;
   }
 
-  auto binary_auto = new BinaryIntAutomaton(dfaMinimize(binary_dfa), formula, not add_leading_zeros);
+  auto binary_auto = new BinaryIntAutomaton(DFAMinimize(binary_dfa), formula, is_natural_number);
   dfaFree(binary_dfa);
   binary_dfa = nullptr;
 
   // binary state computation for semilinear sets may have leading zeros, remove them
-  if ((not add_leading_zeros) and (not semilinear_set->has_only_constants())) {
+  if ((not is_padded) and (not semilinear_set->has_only_constants())) {
     auto trim_helper_auto = BinaryIntAutomaton::MakeTrimHelperAuto(var_index, number_of_variables);
     trim_helper_auto->SetFormula(formula->clone());
     auto tmp_auto = binary_auto;
@@ -286,6 +312,14 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeAutomaton(SemilinearSet_ptr semil
     delete tmp_auto;
   }
 
+  if (Option::Theory::INT_BIT_WIDTH > 0) {
+    auto any_bit_vector_auto = BinaryIntAutomaton::MakeAnyInt(formula->clone(), binary_auto->is_natural_number_);
+    auto tmp_auto = binary_auto;
+    binary_auto = binary_auto->Intersect(any_bit_vector_auto);
+    delete any_bit_vector_auto;
+    delete tmp_auto;
+  }
+
   DVLOG(VLOG_LEVEL) << binary_auto->getId() << " = BinaryIntAutomaton::MakeAutomaton(<semilinear_set>, " << var_name
                     << ", " << *(binary_auto->formula_) << ", " << std::boolalpha << add_leading_zeros << ")";
   return binary_auto;
@@ -328,9 +362,9 @@ bool BinaryIntAutomaton::HasNegative1() {
 }
 
 BinaryIntAutomaton_ptr BinaryIntAutomaton::Complement() {
-  DFA_ptr complement_dfa = dfaCopy(this->dfa_);
+  DFA_ptr complement_dfa = DFACopy(this->dfa_);
 
-  dfaNegation(complement_dfa);
+  DFANegation(complement_dfa);
 
   auto tmp_auto = new BinaryIntAutomaton(complement_dfa, this->formula_->clone(), is_natural_number_);
   // a complemented auto may have initial state accepting, we should be safely avoided from that
@@ -390,8 +424,21 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::Difference(BinaryIntAutomaton_ptr oth
 }
 
 BinaryIntAutomaton_ptr BinaryIntAutomaton::Exists(std::string var_name) {
-  LOG(FATAL)<< "implement me";
-  return nullptr;
+  CHECK_EQ(num_of_bdd_variables_, formula_->GetNumberOfVariables())<< "number of variables is not consistent with formula";
+  int bdd_var_index = formula_->GetVariableIndex(var_name);
+  // variables are indexed in name order, the ones after the projected variable shift down by one
+  std::vector<int> indices_map(num_of_bdd_variables_);
+  for (int i = 0; i < num_of_bdd_variables_; ++i) {
+    indices_map[i] = (i < bdd_var_index) ? i : i - 1;
+  }
+  indices_map[bdd_var_index] = num_of_bdd_variables_ - 1;
+  auto exists_dfa = Automaton::DFAProjectAwayAll(this->dfa_, num_of_bdd_variables_, std::vector<int> { bdd_var_index }, &indices_map[0]);
+  auto exists_formula = formula_->clone();
+  exists_formula->RemoveVariable(var_name);
+  auto exists_auto = new BinaryIntAutomaton(exists_dfa, exists_formula, is_natural_number_);
+
+  DVLOG(VLOG_LEVEL) << exists_auto->id_ << " = [" << this->id_ << "]->Exists(" << var_name << ")";
+  return exists_auto;
 }
 
 BinaryIntAutomaton_ptr BinaryIntAutomaton::GetBinaryAutomatonFor(std::string var_name) {
@@ -407,6 +454,15 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::GetBinaryAutomatonFor(std::string var
   return single_var_auto;
 }
 
+std::map<std::string, BinaryIntAutomaton_ptr> BinaryIntAutomaton::GetBinaryAutomataForAllVariables() {
+  std::map<std::string, BinaryIntAutomaton_ptr> single_var_autos;
+  for (auto& el : formula_->GetVariableCoefficientMap()) {
+    single_var_autos[el.first] = GetBinaryAutomatonFor(el.first);
+  }
+  DVLOG(VLOG_LEVEL) << "[" << this->id_ << "]->GetBinaryAutomataForAllVariables()";
+  return single_var_autos;
+}
+
 BinaryIntAutomaton_ptr BinaryIntAutomaton::GetPositiveValuesFor(std::string var_name) {
   std::vector<int> indexes;
   int var_index = formula_->GetVariableIndex(var_name);
@@ -499,190 +555,50 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::AddLeadingZeros() {
   return leading_zero_auto;
 }
 
-/*
- *  TODO options to fix problems, works for automaton that has 1 variable
- *  Search to improve period search part to make it sound
- *
+/**
+ * Works for single track automata over natural numbers.
+ * A set of numbers accepted by a binary automaton is ultimately periodic. Numbers n and m are interchangeable when
+ * {x : n + x is accepted} and {x : m + x is accepted} are the same; these residual sets are computed symbolically by
+ * adding n to the input. The period and the cycle head are derived from the size of the value automaton with a
+ * polynomial number of residuals (see GetPeriodicPart), accepted numbers are enumerated over the automaton.
+ * Sets that cannot be represented with int values are over-approximated by all numbers.
  */
 SemilinearSet_ptr BinaryIntAutomaton::GetSemilinearSet() {
-  SemilinearSet_ptr semilinear_set = nullptr, current_set = nullptr, tmp_set = nullptr;
-  BinaryIntAutomaton_ptr subject_auto = nullptr, tmp_1_auto = nullptr, tmp_2_auto = nullptr, diff_auto = nullptr;
-  std::vector<SemilinearSet_ptr> semilinears;
-  std::string var_name = this->formula_->GetVariableCoefficientMap().begin()->first;
-  int current_state = this->dfa_->s, sink_state = this->GetSinkState();
-  std::vector<int> constants, bases;
-  bool is_cyclic = false;
-  std::map<int, bool> cycle_status;
-
-  semilinear_set = new SemilinearSet();
-
-  // 1- First get the constants that are reachable by only taking an edge of a SCC that has one state inside
-
-  is_cyclic = GetCycleStatus(cycle_status);
-  GetConstants(cycle_status, constants);
-  Util::List::sort_and_remove_duplicate(constants);
-  cycle_status.clear();
-  semilinear_set->set_constants(constants);
-
-  // CASE automaton has only constants
-  if (not is_cyclic) {
+  CHECK_EQ(1, num_of_bdd_variables_)<< "semilinear set extraction is implemented for single track automaton";
+  auto semilinear_set = new SemilinearSet();
+  std::vector<int> constants;
+  std::vector<bool> cycle_status;
+
+  // CASE automaton has only constants, all of them are reachable without taking a cycle
+  if (not GetCycleStatus(cycle_status)) {
+    GetConstants(cycle_status, constants);
+    Util::List::sort_and_remove_duplicate(constants);
+    semilinear_set->set_constants(constants);
     DVLOG(VLOG_LEVEL) << *semilinear_set;
     DVLOG(VLOG_LEVEL) << "<semilinear set> = [" << this->id_ << "]->GetSemilinearSet()";
     return semilinear_set;
   }
 
-  /*
-   * - Get the maximum constant and make an automaton Ac that accepts 0 <= x <= max
-   * - Make new constants equal to the numbers that are accepted by original automaton (A)
-   * intersection with Ac
-   * Delete these numbers from original automaton
-   */
-  if (semilinear_set->has_constants()) {
-
-    int max_constant = constants.back();  // it is already sorted
-    constants.clear();
-    for (int i = 0; i <= max_constant; i++) {
-      constants.push_back(i);
-    }
-    semilinear_set->set_constants(constants);
-    constants.clear();
-    tmp_1_auto = BinaryIntAutomaton::MakeAutomaton(semilinear_set, var_name, formula_->clone(), false);
-    semilinear_set->clear();
-
-    tmp_2_auto = this->Intersect(tmp_1_auto);
-    delete tmp_1_auto;
-    tmp_1_auto = nullptr;
-
-    tmp_2_auto->GetBaseConstants(constants);  // if automaton is acyclic, it will return all constants
-    Util::List::sort_and_remove_duplicate(constants);
-    semilinear_set->set_constants(constants);
+  const ValueDfa value_dfa = MinimizeValueDfa(GetValueDfa());
+  unsigned long cycle_head = 0, period = 0;
+  std::vector<int> periodic_constants;
+  bool is_representable = GetPeriodicPart(value_dfa, cycle_head, period)
+      and GetAcceptedValues(value_dfa, cycle_head, constants)
+      and GetAcceptedValues(MinimizeValueDfa(ShiftValueDfa(value_dfa, cycle_head)), period, periodic_constants);
+  if (not is_representable) {
+    LOG(ERROR) << "semilinear set of automaton " << this->id_ << " does not fit into int values, "
+               << "over-approximating it with all numbers";
     constants.clear();
-
-    subject_auto = this->Difference(tmp_2_auto);
-    delete tmp_2_auto;
-    tmp_2_auto = nullptr;
-  } else {
-    subject_auto = this->clone();
-  }
-
-  semilinears.push_back(semilinear_set);
-
-  unsigned i = 0;
-  int cycle_head = 0;
-  std::vector<int> tmp_periods;
-  int bound = 0;
-  while (not subject_auto->IsEmptyLanguage() and (bound++ < 5)) {
-    i = 0;
+    periodic_constants = { 0 };
     cycle_head = 0;
-    tmp_periods.clear();
-    semilinear_set = new SemilinearSet();
-    subject_auto->GetBaseConstants(bases);
-    Util::List::sort_and_remove_duplicate(bases);
-
-    // usually we do not need to much numbers once they are sorted, note that this is not sound
-    // to make it sound iteratively check for periods instead of deleting them
-    if (bases.size() > 10) {
-      bases.erase(bases.begin() + 10, bases.end());
-    }
-
-    if (bases.size() == 1) {
-      semilinear_set->set_period(bases[0]);
-      semilinear_set->add_periodic_constant(0);
-      semilinears.push_back(semilinear_set->clone());
-      // no need to verify period
-    } else if (bases.size() > 1) {
-      int possible_period = 0;
-
-      for (auto it = bases.begin(); it < bases.end() - 1; it++) {
-
-        cycle_head = *it;
-        bool period_found = false;
-        for (auto jt = it + 1; jt < bases.end(); jt++) {
-          possible_period = *jt - cycle_head;
-
-          bool add_me = true;
-          for (auto p : tmp_periods) {
-            if ((possible_period % p) == 0) {
-              add_me = false;
-              break;
-            }
-          }
-          if (add_me) {
-            current_set = new SemilinearSet();
-            current_set->set_cycle_head(cycle_head);
-            current_set->set_period(possible_period);
-            current_set->add_periodic_constant(0);
-
-            tmp_1_auto = BinaryIntAutomaton::MakeAutomaton(current_set, var_name, formula_->clone(), false);
-            tmp_2_auto = subject_auto->Intersect(tmp_1_auto);
-            diff_auto = tmp_1_auto->Difference(tmp_2_auto);
-            delete tmp_1_auto;
-            tmp_1_auto = nullptr;
-            delete tmp_2_auto;
-            tmp_2_auto = nullptr;
-            if (diff_auto->IsEmptyLanguage()) {
-              tmp_set = semilinear_set;
-              semilinear_set = tmp_set->Merge(current_set);
-              delete tmp_set;
-              tmp_set = nullptr;
-              semilinears.push_back(current_set);
-              tmp_periods.push_back(possible_period);
-              period_found = true;
-              delete diff_auto;
-              diff_auto = nullptr;
-              break;
-            } else {
-              delete current_set;
-            }
-            delete diff_auto;
-            diff_auto = nullptr;
-            current_set = nullptr;
-          }
-        }
-
-        if (period_found) {
-          for (auto rt = it + 1; rt < bases.end();) {
-            possible_period = *rt - cycle_head;
-            bool remove_me = false;
-            for (auto p : tmp_periods) {
-              if ((possible_period % p) == 0) {
-                remove_me = true;
-                break;
-              }
-            }
-            if (remove_me) {
-              rt = bases.erase(rt);
-            } else {
-              rt++;
-            }
-          }
-          period_found = false;
-        }
-      }
-    } else {
-      LOG(FATAL)<< "Automaton must have an accepting state, check base extraction algorithm";
-    }
-    tmp_1_auto = BinaryIntAutomaton::MakeAutomaton(semilinear_set, var_name, formula_->clone(), false);
-    tmp_2_auto = subject_auto;
-    subject_auto = tmp_2_auto->Difference(tmp_1_auto);
-    delete tmp_1_auto;
-    tmp_1_auto = nullptr;
-    delete tmp_2_auto;
-    tmp_2_auto = nullptr;
-    delete semilinear_set;
-    semilinear_set = nullptr;
-    bases.clear();
+    period = 1;
   }
 
-  delete subject_auto;
-  subject_auto = nullptr;
-
-  semilinear_set = new SemilinearSet();
-  for (auto s : semilinears) {
-    tmp_set = semilinear_set;
-    semilinear_set = tmp_set->Merge(s);
-    delete tmp_set;
-    delete s;
+  semilinear_set->set_constants(constants);
+  if (not periodic_constants.empty()) {
+    semilinear_set->set_periodic_constants(periodic_constants);
+    semilinear_set->set_cycle_head(cycle_head);
+    semilinear_set->set_period(period);
   }
 
   DVLOG(VLOG_LEVEL) << *semilinear_set;
@@ -1016,7 +932,7 @@ std::map<std::string,std::vector<std::string>> BinaryIntAutomaton::GetModelsWith
 		// all leading zeros or ones (except for one) and add the transition if we haven't
 		// seen it yet
 		if(this->dfa_->f[current_state] == 1) {
-			if((count_bound_exact_ and length == bound) or (not count_bound_exact_ and length <= bound)) {
+			if((Option::Theory::COUNT_BOUND_EXACT and length == bound) or (not Option::Theory::COUNT_BOUND_EXACT and length <= bound)) {
 //				LOG(INFO) << "Length: " << length;
 
 				// for each track, truncate leading zeros or ones (except for one)
@@ -1251,20 +1167,20 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeBoolean(ArithmeticFormula_ptr for
 	exception[index] = (boolean_variables[boolean_var] ? '1' : '0');
 	exception.push_back('\0');
 
-	dfaSetup(3, number_of_variables, bin_variable_indices);
-	dfaAllocExceptions(1);
-	dfaStoreException(1, &*exception.begin());
-	dfaStoreState(2);
+	DFABuilder builder(3, number_of_variables, bin_variable_indices);
+	builder.AllocExceptions(1);
+	builder.StoreException(1, &*exception.begin());
+	builder.StoreState(2);
 
-	dfaAllocExceptions(1);
+	builder.AllocExceptions(1);
 	exception[index] = '0';
-	dfaStoreException(1, &*exception.begin());
-	dfaStoreState(2);
+	builder.StoreException(1, &*exception.begin());
+	builder.StoreState(2);
 
-	dfaAllocExceptions(0);
-	dfaStoreState(2);
+	builder.AllocExceptions(0);
+	builder.StoreState(2);
 
-	auto boolean_dfa = dfaBuild(statuses);
+	auto boolean_dfa = builder.Build(statuses);
 	auto boolean_auto = new BinaryIntAutomaton(boolean_dfa,formula,false);
 
 	DVLOG(VLOG_LEVEL) << boolean_auto->id_ << " = [BinaryIntAutomaton]->MakeBoolean()";
@@ -1285,25 +1201,25 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntGraterThanOrEqualToZero(std::v
   }
   exception.push_back('\0');
 
-  dfaSetup(3, number_of_variables, bin_variable_indices);
-  dfaAllocExceptions(1);
+  DFABuilder builder(3, number_of_variables, bin_variable_indices);
+  builder.AllocExceptions(1);
   for (int i : indexes) {
     exception[i] = '0';
   }
-  dfaStoreException(1, &*exception.begin());
-  dfaStoreState(0);
+  builder.StoreException(1, &*exception.begin());
+  builder.StoreState(0);
 
-  dfaAllocExceptions(1);
+  builder.AllocExceptions(1);
   for (int i : indexes) {
     exception[i] = '1';
   }
-  dfaStoreException(0, &*exception.begin());
-  dfaStoreState(1);
+  builder.StoreException(0, &*exception.begin());
+  builder.StoreState(1);
 
-  dfaAllocExceptions(0);
-  dfaStoreState(2);
+  builder.AllocExceptions(0);
+  builder.StoreState(2);
 
-  auto positive_numbers_dfa = dfaBuild(statuses);
+  auto positive_numbers_dfa = builder.Build(statuses);
   auto postivie_numbers_auto = new BinaryIntAutomaton(positive_numbers_dfa, number_of_variables, false);
 
   //delete[] bin_variable_indices;
@@ -1314,6 +1230,209 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntGraterThanOrEqualToZero(std::v
   return postivie_numbers_auto;
 }
 
+DFA_ptr BinaryIntAutomaton::MakeCarryDfa(ArithmeticFormula_ptr formula, const int number_of_keys, const int initial_key,
+        std::function<int(const int, const int)> next_key, std::function<bool(const int)> is_accepting_key,
+        const bool is_sink_accepting) {
+  auto coeffs = formula->GetCoefficients();
+  std::vector<int> active_indices;
+  int min_sum = 0, max_sum = 0;
+  for (int i = 0; i < (int)coeffs.size(); ++i) {
+    if (coeffs[i] > 0) {
+      max_sum += coeffs[i];
+    } else if (coeffs[i] < 0) {
+      min_sum += coeffs[i];
+    }
+    if (coeffs[i] != 0) {
+      active_indices.push_back(i);
+    }
+  }
+
+  // partial sums reachable after deciding the first k active variables, offset by min_sum
+  const int number_of_levels = active_indices.size();
+  const int width = max_sum - min_sum + 1;
+  std::vector<std::vector<bool>> is_partial_sum(number_of_levels + 1, std::vector<bool>(width, false));
+  is_partial_sum[0][-min_sum] = true;
+  for (int level = 0; level < number_of_levels; ++level) {
+    const int coeff = coeffs[active_indices[level]];
+    for (int p = 0; p < width; ++p) {
+      if (is_partial_sum[level][p]) {
+        is_partial_sum[level + 1][p] = true;
+        is_partial_sum[level + 1][p + coeff] = true;
+      }
+    }
+  }
+
+  // discover states over column sums; state 0 is a copy of the initial key so that it is never re-entered
+  const int sink_key = -1;
+  std::vector<int> key_states(number_of_keys, -1);
+  std::vector<int> state_keys {initial_key};
+  int sink_state = -1;
+  auto get_state = [&](const int key) {
+    if (key == sink_key) {
+      if (sink_state == -1) {
+        sink_state = state_keys.size();
+        state_keys.push_back(sink_key);
+      }
+      return sink_state;
+    }
+    CHECK(key >= 0 and key < number_of_keys) << "carry out of range: " << key;
+    if (key_states[key] == -1) {
+      key_states[key] = state_keys.size();
+      state_keys.push_back(key);
+    }
+    return key_states[key];
+  };
+
+  std::vector<std::vector<int>> sum_targets;
+  for (std::size_t state = 0; state < state_keys.size(); ++state) {
+    const int key = state_keys[state];
+    std::vector<int> targets(width, state);
+    if (key != sink_key) {
+      for (int p = 0; p < width; ++p) {
+        if (is_partial_sum[number_of_levels][p]) {
+          targets[p] = get_state(next_key(key, p + min_sum));
+        }
+      }
+    }
+    sum_targets.push_back(targets);
+  }
+
+  // bdd of a state is the sum lattice with leaves replaced by the targets of the column sums
+  const int number_of_states = state_keys.size();
+  DFA_ptr carry_dfa = dfaMake(number_of_states);
+  bdd_manager* bddm = carry_dfa->bddm;
+  std::vector<std::vector<bdd_ptr>> nodes(number_of_levels + 1, std::vector<bdd_ptr>(width));
+  for (int state = 0; state < number_of_states; ++state) {
+    for (int p = 0; p < width; ++p) {
+      if (is_partial_sum[number_of_levels][p]) {
+        nodes[number_of_levels][p] = bdd_find_leaf_hashed_add_root(bddm, sum_targets[state][p]);
+      }
+    }
+    for (int level = number_of_levels - 1; level >= 0; --level) {
+      const int coeff = coeffs[active_indices[level]];
+      for (int p = 0; p < width; ++p) {
+        if (is_partial_sum[level][p]) {
+          bdd_ptr low = nodes[level + 1][p];
+          bdd_ptr high = nodes[level + 1][p + coeff];
+          nodes[level][p] = (low == high) ? low : bdd_find_node_hashed_add_root(bddm, low, high, active_indices[level]);
+        }
+      }
+    }
+    carry_dfa->q[state] = nodes[0][-min_sum];
+
+    const int key = state_keys[state];
+    bool is_accepting = false;
+    if (state == 0) {
+      is_accepting = false;
+    } else if (key == sink_key) {
+      is_accepting = is_sink_accepting;
+    } else {
+      is_accepting = is_accepting_key(key);
+    }
+    carry_dfa->f[state] = is_accepting ? 1 : -1;
+  }
+  carry_dfa->s = 0;
+
+  DFA_ptr minimized_dfa = DFAMinimize(carry_dfa);
+  dfaFree(carry_dfa);
+  return minimized_dfa;
+}
+
+/**
+ * Columns are added least significant bit first together with the bits of the constant, so carries stay in
+ * [min_sum, max_sum + 1] no matter how large the constant is. The last column computes the outcome of the
+ * relation directly, keys of the final column only store whether the value is zero and whether it is negative.
+ */
+BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeBitVectorRelation(ArithmeticFormula_ptr formula,
+                                                                 bool is_natural_number) {
+  const int width = Option::Theory::INT_BIT_WIDTH;
+  CHECK_GT(width, 0) << "integer width is not set";
+  const ArithmeticFormula::Type type = formula->GetType();
+  const bool is_modular = (not is_natural_number)
+          and (ArithmeticFormula::Type::EQ == type or ArithmeticFormula::Type::NOTEQ == type);
+
+  int min_sum = 0, max_sum = 0;
+  for (int coeff : formula->GetCoefficients()) {
+    if (coeff > 0) {
+      max_sum += coeff;
+    } else {
+      min_sum += coeff;
+    }
+  }
+
+  // arithmetic shift of the constant, bits above the width of an int repeat the sign
+  const long long constant = formula->GetConstant();
+  auto get_constant_bits = [constant](const int shift) -> long long {
+    return (shift < 32) ? (constant >> shift) : (constant < 0 ? -1 : 0);
+  };
+
+  const int min_carry = min_sum;
+  const int number_of_carries = max_sum - min_sum + 2;
+  const int number_of_keys = (width + 1) * number_of_carries * 4;
+  auto make_key = [min_carry, number_of_carries](const int column, const int carry, const bool is_zero, const bool bit) {
+    return (((column * number_of_carries) + (carry - min_carry)) * 2 + (is_zero ? 1 : 0)) * 2 + (bit ? 1 : 0);
+  };
+
+  auto next_key = [&](const int key, const int column_sum) {
+    const bool is_zero = (key >> 1) & 1;
+    const int carry = (key >> 2) % number_of_carries + min_carry;
+    const int column = (key >> 2) / number_of_carries;
+    if (column == width) {
+      return -1;
+    }
+
+    if (column < width - 1 or is_modular or is_natural_number) {
+      const long long result = carry + column_sum + (get_constant_bits(column) & 1);
+      const long long bit = result & 1;
+      const long long next_carry = (result - bit) / 2;
+      if (column < width - 1) {
+        return make_key(column + 1, next_carry, is_zero and bit == 0, bit == 1);
+      } else if (is_modular) {
+        return make_key(width, min_carry, is_zero and bit == 0, false);
+      }
+      // value is low bits + (next_carry + high bits of the constant) * 2^width
+      const long long high = next_carry + get_constant_bits(width);
+      return make_key(width, min_carry, is_zero and bit == 0 and high == 0, high < 0);
+    }
+
+    // sign column has weight -2^(width - 1), value is low bits + result * 2^(width - 1)
+    const long long result = carry - column_sum + get_constant_bits(width - 1);
+    return make_key(width, min_carry, is_zero and result == 0, result < 0);
+  };
+
+  auto is_accepting_key = [&](const int key) {
+    if ((key >> 2) / number_of_carries != width) {
+      return false;
+    }
+    const bool is_negative = key & 1;
+    const bool is_zero = (key >> 1) & 1;
+    switch (type) {
+      case ArithmeticFormula::Type::EQ:
+        return is_zero;
+      case ArithmeticFormula::Type::NOTEQ:
+        return not is_zero;
+      case ArithmeticFormula::Type::LT:
+        return is_negative;
+      case ArithmeticFormula::Type::LE:
+        return is_negative or is_zero;
+      case ArithmeticFormula::Type::GT:
+        return not (is_negative or is_zero);
+      case ArithmeticFormula::Type::GE:
+        return not is_negative;
+      default:
+        LOG(FATAL)<< "not a relation: " << *formula;
+        return false;
+    }
+  };
+
+  auto relation_dfa = MakeCarryDfa(formula, number_of_keys, make_key(0, 0, true, false), next_key, is_accepting_key,
+                                   false);
+  auto relation_auto = new BinaryIntAutomaton(relation_dfa, formula, is_natural_number);
+
+  DVLOG(VLOG_LEVEL) << relation_auto->id_ << " = MakeBitVectorRelation(" << *formula << ", " << width << ")";
+  return relation_auto;
+}
+
 BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeEquality(ArithmeticFormula_ptr formula, bool is_natural_number) {
   if (is_natural_number) {
     return MakeNaturalNumberEquality(formula);
@@ -1350,6 +1469,29 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
     min = constant;
   }
 
+  const bool is_equality = (ArithmeticFormula::Type::EQ == formula->GetType());
+  // boolean variables are pinned per exception, only pure integer formulas are built symbolically
+  if (boolean_variables.empty()) {
+    // keys are 2 * (carry - min) for carries reached by a self loop and 2 * (carry - min) + 1 for their rejecting clones
+    auto equality_dfa = MakeCarryDfa(formula, 2 * (max - min + 1), 2 * (constant - min) + 1,
+        [min](const int key, const int sum) {
+          const int carry = key / 2 + min;
+          const int result = carry + sum;
+          if (result & 1) {
+            return -1;
+          }
+          const int target = result / 2;
+          return 2 * (target - min) + ((target == carry) ? 0 : 1);
+        },
+        [is_equality](const int key) {
+          return ((key & 1) == 0) == is_equality;
+        }, not is_equality);
+    auto equality_auto = new BinaryIntAutomaton(equality_dfa, formula, false);
+    CHECK_EQ(false, equality_auto->IsInitialStateAccepting());
+    DVLOG(VLOG_LEVEL) << equality_auto->id_ << " = MakeIntEquality(" << *formula << ")";
+    return equality_auto;
+  }
+
   const int num_of_states = 2 * (max - min + 2);
   const int sink_state = num_of_states - 2;
   const int shifted_initial_state = num_of_states - 1;
@@ -1365,7 +1507,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
   unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
 
   int* indices = GetBddVariableIndices(total_num_variables);
-  dfaSetup(num_of_states, total_num_variables, indices);
+  DFABuilder builder(num_of_states, total_num_variables, indices);
 
   std::map<std::vector<char>, int> transitions_from_initial_state; // populated if initial state is in cycle and accepting
 
@@ -1374,7 +1516,6 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
   carry_map[constant].i = -1;
   carry_map[constant].ir = 0;
 
-  const bool is_equality = (ArithmeticFormula::Type::EQ == formula->GetType());
   const bool needs_shift_state = (not is_equality);
   bool is_initial_state_shifted = false;
 
@@ -1389,7 +1530,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
       carry_map[next_label].sr = 2;
     }
 
-    dfaAllocExceptions(transitions / 2);
+    builder.AllocExceptions(transitions / 2);
     int result, target;
     for (unsigned long j = 0; j < transitions; j++) {
       result = next_label + formula->CountOnes(j);
@@ -1438,11 +1579,11 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
             transitions_from_initial_state[current_exception] = to_state;
           }
         }
-        dfaStoreException(to_state, &current_exception[0]);
+        builder.StoreException(to_state, &current_exception[0]);
       }
     }
 
-    dfaStoreState(sink_state);
+    builder.StoreState(sink_state);
 
     ++current_state;
 
@@ -1455,15 +1596,15 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
 
   for (; current_state < num_of_states; ++current_state) {
     if (is_initial_state_shifted and current_state == shifted_initial_state) {
-      dfaAllocExceptions(transitions_from_initial_state.size());
+      builder.AllocExceptions(transitions_from_initial_state.size());
       for (auto& el : transitions_from_initial_state) {
         auto excep = el.first;
-        dfaStoreException(el.second, &excep[0]);
+        builder.StoreException(el.second, &excep[0]);
       }
-      dfaStoreState(sink_state);
+      builder.StoreState(sink_state);
     } else {
-      dfaAllocExceptions(0);
-      dfaStoreState(sink_state);
+      builder.AllocExceptions(0);
+      builder.StoreState(sink_state);
     }
   }
 
@@ -1493,8 +1634,8 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntEquality(ArithmeticFormula_ptr
   }
 
   statuses[num_of_states] = '\0';
-  auto tmp_dfa = dfaBuild(statuses);
-  auto equality_dfa = dfaMinimize(tmp_dfa);
+  auto tmp_dfa = builder.Build(statuses);
+  auto equality_dfa = DFAMinimize(tmp_dfa);
   dfaFree(tmp_dfa);
   //delete[] indices;
   delete[] statuses;
@@ -1534,6 +1675,27 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
     min = constant;
   }
 
+  const bool is_equality = (ArithmeticFormula::Type::EQ == formula->GetType());
+  // boolean variables are pinned per exception, only pure integer formulas are built symbolically
+  if (boolean_variables.empty()) {
+    // keys are carry - min
+    auto equality_dfa = MakeCarryDfa(formula, max - min + 1, constant - min,
+        [min](const int key, const int sum) {
+          const int result = key + min + sum;
+          if (result & 1) {
+            return -1;
+          }
+          return result / 2 - min;
+        },
+        [min, is_equality](const int key) {
+          return (key + min == 0) == is_equality;
+        }, not is_equality);
+    auto equality_auto = new BinaryIntAutomaton(equality_dfa, formula, true);
+    CHECK_EQ(false, equality_auto->IsInitialStateAccepting());
+    DVLOG(VLOG_LEVEL) << equality_auto->id_ << " = MakeNaturalNumberEquality(" << *formula << ")";
+    return equality_auto;
+  }
+
   const int num_of_states = max - min + 3;
   const int sink_state = num_of_states - 2;
   const int shifted_initial_state = num_of_states - 1;
@@ -1549,7 +1711,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
   unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
 
   int* indices = GetBddVariableIndices(total_num_variables);
-  dfaSetup(num_of_states, total_num_variables, indices);
+  DFABuilder builder(num_of_states, total_num_variables, indices);
 
   std::map<std::vector<char>, int> transitions_from_initial_state; // populated if initial state is in cycle and accepting
 
@@ -1557,7 +1719,6 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
   carry_map[constant].s = 1;
   carry_map[constant].i = 0;
 
-  const bool is_equality = (ArithmeticFormula::Type::EQ == formula->GetType());
   const bool needs_shift_state = ((is_equality and constant == 0) or ((not is_equality) and constant != 0));
   bool is_initial_state_shifted = false;
 
@@ -1568,7 +1729,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
   while (next_label < max + 1) {  //there is a state to expand (excuding sink)
     carry_map[next_label].s = 2;
 
-    dfaAllocExceptions(transitions / 2);
+    builder.AllocExceptions(transitions / 2);
     int result, target;
     for (unsigned long j = 0; j < transitions; ++j) {
       result = next_label + formula->CountOnes(j);
@@ -1608,11 +1769,11 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
             transitions_from_initial_state[current_exception] = to_state;
           }
         }
-        dfaStoreException(to_state, &current_exception[0]);
+        builder.StoreException(to_state, &current_exception[0]);
       }
     }
 
-    dfaStoreState(sink_state);
+    builder.StoreState(sink_state);
 
     ++current_state;
 
@@ -1626,15 +1787,15 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
 
   for (; current_state < num_of_states; ++current_state) {
     if (is_initial_state_shifted and current_state == shifted_initial_state) {
-      dfaAllocExceptions(transitions_from_initial_state.size());
+      builder.AllocExceptions(transitions_from_initial_state.size());
       for (auto& el : transitions_from_initial_state) {
         auto excep = el.first;
-        dfaStoreException(el.second, &excep[0]);
+        builder.StoreException(el.second, &excep[0]);
       }
-      dfaStoreState(sink_state);
+      builder.StoreState(sink_state);
     } else {
-      dfaAllocExceptions(0);
-      dfaStoreState(sink_state);
+      builder.AllocExceptions(0);
+      builder.StoreState(sink_state);
     }
   }
 
@@ -1662,8 +1823,8 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberEquality(ArithmeticF
 
   statuses[num_of_states] = '\0';
 
-  auto tmp_dfa = dfaBuild(statuses);
-  auto equality_dfa = dfaMinimize(tmp_dfa);
+  auto tmp_dfa = builder.Build(statuses);
+  auto equality_dfa = DFAMinimize(tmp_dfa);
   dfaFree(tmp_dfa);
   //delete[] indices;
   delete[] statuses;
@@ -1707,6 +1868,31 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
     min = constant;
   }
 
+  // boolean variables are pinned per exception, only pure integer formulas are built symbolically
+  if (boolean_variables.empty()) {
+    // keys are 2 * (carry - min) when the sign column would make the sum negative, 2 * (carry - min) + 1 otherwise
+    auto less_than_dfa = MakeCarryDfa(formula, 2 * (max - min + 1), 2 * (constant - min) + 1,
+        [min](const int key, const int sum) {
+          auto floor_half = [](const int n) { return (n >= 0) ? n / 2 : (n - 1) / 2; };
+          int result = key / 2 + min + sum;
+          const int target = floor_half(result);
+          int label = target;
+          // the carry reached by repeating the current column as sign bits decides acceptance
+          while (floor_half(label + sum) != label) {
+            label = floor_half(label + sum);
+          }
+          result = label + sum;
+          return 2 * (target - min) + ((result & 1) ? 0 : 1);
+        },
+        [](const int key) {
+          return (key & 1) == 0;
+        }, false);
+    auto less_than_auto = new BinaryIntAutomaton(less_than_dfa, formula, false);
+    CHECK_EQ(false, less_than_auto->IsInitialStateAccepting());
+    DVLOG(VLOG_LEVEL) << less_than_auto->id_ << " = MakeIntLessThan(" << *formula << ")";
+    return less_than_auto;
+  }
+
   const int num_of_states = 2 * (max - min + 1);
 
   unsigned max_states_allowed = 0x80000000;
@@ -1720,7 +1906,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
   unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
 
   int* indices = GetBddVariableIndices(total_num_variables);
-  dfaSetup(num_of_states, total_num_variables, indices);
+  DFABuilder builder(num_of_states, total_num_variables, indices);
 
   std::map<int, StateIndices> carry_map;  // maps carries to state indices
   carry_map[constant].sr = 1;
@@ -1739,7 +1925,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
     }
 
     // TODO instead of allocating that many of transitions, try to reduce them with a preprocessing
-    dfaAllocExceptions(transitions);
+    builder.AllocExceptions(transitions);
     int result, target, write1, label1, label2;
     for (unsigned long j = 0; j < transitions; j++) {
       int ones = formula->CountOnes(j);
@@ -1789,18 +1975,18 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
           next_index++;
           carry_map[target].i = next_index;
         }
-        dfaStoreException(carry_map[target].i, &current_exception[0]);
+        builder.StoreException(carry_map[target].i, &current_exception[0]);
       } else {
         if (carry_map[target].sr == 0) {
           carry_map[target].sr = 1;
           next_index++;
           carry_map[target].ir = next_index;
         }
-        dfaStoreException(carry_map[target].ir, &current_exception[0]);
+        builder.StoreException(carry_map[target].ir, &current_exception[0]);
       }
     }
 
-    dfaStoreState(current_state);
+    builder.StoreState(current_state);
 
     ++current_state;
 
@@ -1813,8 +1999,8 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
   }
 
   for (; current_state < num_of_states; ++current_state) {
-    dfaAllocExceptions(0);
-    dfaStoreState(current_state);
+    builder.AllocExceptions(0);
+    builder.StoreState(current_state);
   }
 
   //define accepting and rejecting states
@@ -1830,8 +2016,8 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeIntLessThan(ArithmeticFormula_ptr
   }
   statuses[num_of_states] = '\0';
 
-  auto tmp_dfa = dfaBuild(statuses);
-  auto less_than_dfa = dfaMinimize(tmp_dfa);
+  auto tmp_dfa = builder.Build(statuses);
+  auto less_than_dfa = DFAMinimize(tmp_dfa);
   dfaFree(tmp_dfa);
   //delete[] indices;
   delete[] statuses;
@@ -1867,6 +2053,23 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
     min = constant;
   }
 
+  // boolean variables are pinned per exception, only pure integer formulas are built symbolically
+  if (boolean_variables.empty()) {
+    // keys are carry - min
+    auto less_than_dfa = MakeCarryDfa(formula, max - min + 1, constant - min,
+        [min](const int key, const int sum) {
+          const int result = key + min + sum;
+          return ((result >= 0) ? result / 2 : (result - 1) / 2) - min;
+        },
+        [min](const int key) {
+          return key + min < 0;
+        }, false);
+    auto less_than_auto = new BinaryIntAutomaton(less_than_dfa, formula, true);
+    CHECK_EQ(false, less_than_auto->IsInitialStateAccepting());
+    DVLOG(VLOG_LEVEL) << less_than_auto->id_ << " = MakeNaturalNumberLessThan(" << *formula << ")";
+    return less_than_auto;
+  }
+
   const int num_of_states = max - min + 2;
   const int shifted_initial_state = num_of_states - 1;
 
@@ -1881,7 +2084,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
   unsigned long transitions = 1 << active_num_variables;  //number of transitions from each state
 
   int* indices = GetBddVariableIndices(total_num_variables);
-  dfaSetup(num_of_states, total_num_variables, indices);
+  DFABuilder builder(num_of_states, total_num_variables, indices);
 
   std::map<std::vector<char>, int> transitions_from_initial_state; // populated if initial state is in cycle and accepting
   bool is_initial_state_in_cycle = false;
@@ -1897,7 +2100,7 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
   while (next_label < max + 1) {  //there is a state to expand (excuding sink)
     carry_map[next_label].s = 2;
 
-    dfaAllocExceptions(transitions);
+    builder.AllocExceptions(transitions);
 
     int result, target;
     for (unsigned long j = 0; j < transitions; ++j) {
@@ -1939,13 +2142,13 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
         to_state = shifted_initial_state;
         is_initial_state_in_cycle = true;
       }
-      if (current_state == 0 and is_initial_state_in_cycle) { // save transition for shifted initial start
+      if (current_state == 0) { // save transition for shifted initial start
         transitions_from_initial_state[current_exception] = to_state;
       }
-      dfaStoreException(to_state, &current_exception[0]);
+      builder.StoreException(to_state, &current_exception[0]);
     }
 
-    dfaStoreState(current_state);
+    builder.StoreState(current_state);
     ++current_state;
 
     //find next state to expand
@@ -1958,15 +2161,15 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
 
   for (; current_state < num_of_states; ++current_state) {
     if (is_initial_state_in_cycle and current_state == shifted_initial_state) {
-      dfaAllocExceptions(transitions_from_initial_state.size());
+      builder.AllocExceptions(transitions_from_initial_state.size());
       for (auto& el : transitions_from_initial_state) {
         auto excep = el.first;
-        dfaStoreException(el.second, &excep[0]);
+        builder.StoreException(el.second, &excep[0]);
       }
-      dfaStoreState(current_state);
+      builder.StoreState(current_state);
     } else {
-      dfaAllocExceptions(0);
-      dfaStoreState(current_state);
+      builder.AllocExceptions(0);
+      builder.StoreState(current_state);
     }
   }
 
@@ -1988,8 +2191,8 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeNaturalNumberLessThan(ArithmeticF
     }
   }
   statuses[num_of_states] = '\0';
-  auto tmp_dfa = dfaBuild(statuses);
-  auto less_than_dfa = dfaMinimize(tmp_dfa);
+  auto tmp_dfa = builder.Build(statuses);
+  auto less_than_dfa = DFAMinimize(tmp_dfa);
   dfaFree(tmp_dfa);
   //delete[] indices;
   delete[] statuses;
@@ -2047,38 +2250,38 @@ BinaryIntAutomaton_ptr BinaryIntAutomaton::MakeTrimHelperAuto(int var_index, int
 
   int* indices = GetBddVariableIndices(number_of_variables);
   int number_of_states = 5;
-  dfaSetup(number_of_states, number_of_variables, indices);
+  DFABuilder builder(number_of_states, number_of_variables, indices);
   // state 0
-  dfaAllocExceptions(2);
+  builder.AllocExceptions(2);
   exception[var_index] = '0';
-  dfaStoreException(1, exception);
+  builder.StoreException(1, exception);
   exception[var_index] = '1';
-  dfaStoreException(2, exception);
-  dfaStoreState(0);
+  builder.StoreException(2, exception);
+  builder.StoreState(0);
   // state 1
-  dfaAllocExceptions(2);
+  builder.AllocExceptions(2);
   exception[var_index] = '0';
-  dfaStoreException(3, exception);
+  builder.StoreException(3, exception);
   exception[var_index] = '1';
-  dfaStoreException(2, exception);
-  dfaStoreState(1);
+  builder.StoreException(2, exception);
+  builder.StoreState(1);
   // state 2
-  dfaAllocExceptions(1);
+  builder.AllocExceptions(1);
   exception[var_index] = '0';
-  dfaStoreException(4, exception);
-  dfaStoreState(2);
+  builder.StoreException(4, exception);
+  builder.StoreState(2);
   // state 3
-  dfaAllocExceptions(1);
+  builder.AllocExceptions(1);
   exception[var_index] = '1';
-  dfaStoreException(2, exception);
-  dfaStoreState(3);
+  builder.StoreException(2, exception);
+  builder.StoreState(3);
   // state 4
-  dfaAllocExceptions(1);
+  builder.AllocExceptions(1);
   exception[var_index] = '1';
-  dfaStoreException(2, exception);
-  dfaStoreState(4);
+  builder.StoreException(2, exception);
+  builder.StoreState(4);
 
-  auto trim_helper_dfa = dfaBuild(statuses);
+  auto trim_helper_dfa = builder.Build(statuses);
   auto trim_helper_auto = new BinaryIntAutomaton(trim_helper_dfa, number_of_variables, false);
 
   //delete[] indices;
@@ -2205,75 +2408,86 @@ bool BinaryIntAutomaton::is_accepting_binary_state(BinaryState_ptr binary_state,
   return false;
 }
 
-bool BinaryIntAutomaton::GetCycleStatus(std::map<int, bool>& cycle_status) {
-  std::map<int, int> disc;
-  std::map<int, int> low;
-  std::map<int, bool> is_stack_member;
+/**
+ * Marks states that are on a cycle (sink state is marked to avoid exploring it), iterative Tarjan's algorithm
+ * @return true if automaton is cyclic apart from the sink state
+ */
+bool BinaryIntAutomaton::GetCycleStatus(std::vector<bool>& cycle_status) {
+  const int number_of_states = this->dfa_->ns;
+  const int sink_state = GetSinkState();
+  std::vector<std::array<int, 2>> next_states(number_of_states);
+  std::vector<char> exception = { '0' };
+  for (int s = 0; s < number_of_states; ++s) {
+    exception[0] = '0';
+    next_states[s][0] = getNextState(s, exception);
+    exception[0] = '1';
+    next_states[s][1] = getNextState(s, exception);
+  }
+
+  cycle_status.assign(number_of_states, false);
+  std::vector<int> disc(number_of_states, -1), low(number_of_states, 0);
+  std::vector<bool> is_stack_member(number_of_states, false);
   std::vector<int> st;
-  std::vector<bool> path;
+  std::vector<std::pair<int, int>> call_stack;  // state and the next branch to explore
   int time = 0;
-  int sink_state = GetSinkState();
+  bool is_cyclic = false;
 
-  if (sink_state > 0) {
-    disc[sink_state] = 0;  // avoid exploring sink state
-    is_stack_member[sink_state] = false;  // avoid looping to sink state
+  if (sink_state > -1) {
+    disc[sink_state] = time++;  // avoid exploring sink state
     cycle_status[sink_state] = true;
   }
-  GetCycleStatus(this->dfa_->s, disc, low, st, is_stack_member, cycle_status, time);
-  DVLOG(VLOG_LEVEL) << cycle_status[-2] << " = [" << this->id_ << "]->getCycleStatus(<constants>)";
-  return cycle_status[-2];  // -2 is to keep if it is cyclic at all or not
-}
-
-void BinaryIntAutomaton::GetCycleStatus(int state, std::map<int, int>& disc, std::map<int, int>& low,
-                                        std::vector<int>& st, std::map<int, bool>& is_stack_member,
-                                        std::map<int, bool>& cycle_status, int& time) {
-  int next_state = 0;
-  std::vector<char> exception = { '0' };
-  int l, r;
-//  std::cout << "visiting: " << state << std::endl;
-  disc[state] = low[state] = time;
-  time++;
-  st.push_back(state);
-  is_stack_member[state] = true;
-
-  l = getNextState(state, exception);
-  exception[0] = '1';
-  r = getNextState(state, exception);
 
-  for (int b = 0; b < 2; b++) {
-    next_state = (b == 0) ? l : r;
-    if (disc.find(next_state) == disc.end()) {
-      GetCycleStatus(next_state, disc, low, st, is_stack_member, cycle_status, time);
-      low[state] = std::min(low[state], low[next_state]);
-    } else if (is_stack_member[next_state]) {
-      low[state] = std::min(low[state], disc[next_state]);
+  if (disc[this->dfa_->s] == -1) {
+    call_stack.push_back(std::make_pair(this->dfa_->s, 0));
+    disc[this->dfa_->s] = low[this->dfa_->s] = time++;
+    st.push_back(this->dfa_->s);
+    is_stack_member[this->dfa_->s] = true;
+  }
+
+  while (not call_stack.empty()) {
+    const int state = call_stack.back().first;
+    const int branch = call_stack.back().second;
+    if (branch < 2) {
+      ++call_stack.back().second;
+      const int next_state = next_states[state][branch];
+      if (disc[next_state] == -1) {
+        disc[next_state] = low[next_state] = time++;
+        st.push_back(next_state);
+        is_stack_member[next_state] = true;
+        call_stack.push_back(std::make_pair(next_state, 0));
+      } else if (is_stack_member[next_state]) {
+        low[state] = std::min(low[state], disc[next_state]);
+      }
+      continue;
     }
-  }
 
-  if (low[state] == disc[state]) {  // head of SCC
-    int current_state = st.back();
-
-    while (current_state != state) {
-      st.pop_back();
-      is_stack_member[current_state] = false;
-      cycle_status[current_state] = true;
-      cycle_status[-2] = true;
-      current_state = st.back();
+    call_stack.pop_back();
+    if (not call_stack.empty()) {
+      const int parent = call_stack.back().first;
+      low[parent] = std::min(low[parent], low[state]);
     }
 
-    is_stack_member[current_state] = false;
-    st.pop_back();
-
-    if (current_state == l or current_state == r) {
-      cycle_status[current_state] = true;
-      cycle_status[-2] = true;
+    if (low[state] == disc[state]) {  // head of SCC
+      const bool has_self_loop = (next_states[state][0] == state or next_states[state][1] == state);
+      const bool is_singleton = (st.back() == state);
+      int current_state = -1;
+      do {
+        current_state = st.back();
+        st.pop_back();
+        is_stack_member[current_state] = false;
+        if (has_self_loop or not is_singleton) {
+          cycle_status[current_state] = true;
+          is_cyclic = true;
+        }
+      } while (current_state != state);
     }
   }
 
-  return;
+  DVLOG(VLOG_LEVEL) << is_cyclic << " = [" << this->id_ << "]->GetCycleStatus(<cycle status>)";
+  return is_cyclic;
 }
 
-void BinaryIntAutomaton::GetConstants(std::map<int, bool>& cycle_status, std::vector<int>& constants) {
+void BinaryIntAutomaton::GetConstants(std::vector<bool>& cycle_status, std::vector<int>& constants) {
   std::vector<bool> path;
 
   // current state cannot be accepting in binary automaton
@@ -2285,7 +2499,7 @@ void BinaryIntAutomaton::GetConstants(std::map<int, bool>& cycle_status, std::ve
   return;
 }
 
-void BinaryIntAutomaton::GetConstants(int state, std::map<int, bool>& cycle_status, std::vector<bool>& path,
+void BinaryIntAutomaton::GetConstants(int state, std::vector<bool>& cycle_status, std::vector<bool>& path,
                                       std::vector<int>& constants) {
   int next_state = 0;
   std::vector<char> exception = { '0' };
@@ -2410,68 +2624,286 @@ void BinaryIntAutomaton::GetConstants(int state, std::map<int, bool>& cycle_stat
 //
 //  return is_in_cycle;
 //}
-void BinaryIntAutomaton::GetBaseConstants(std::vector<int>& constants, unsigned max_number_of_bit_limit) {
-  unsigned char *is_visited = new unsigned char[this->dfa_->ns];
-  std::vector<bool> path;
-
-  for (int i = 0; i < this->dfa_->ns; i++) {
-    is_visited[i] = false;
+/**
+ * Makes the value automaton of a single track natural number automaton. A state is a pair of the state reached
+ * before the last zeros of the input and the current state; the pair is accepting when the first one accepts the
+ * value with some number of leading zeros.
+ */
+BinaryIntAutomaton::ValueDfa BinaryIntAutomaton::GetValueDfa() {
+  const int number_of_states = this->dfa_->ns;
+  std::vector<std::array<int, 2>> next_states(number_of_states);
+  std::vector<char> exception = { '0' };
+  for (int s = 0; s < number_of_states; ++s) {
+    exception[0] = '0';
+    next_states[s][0] = getNextState(s, exception);
+    exception[0] = '1';
+    next_states[s][1] = getNextState(s, exception);
+  }
+
+  // states that reach an accepting state with zeros only
+  std::vector<bool> is_zero_accepting(number_of_states, false);
+  bool is_changed = true;
+  while (is_changed) {
+    is_changed = false;
+    for (int s = 0; s < number_of_states; ++s) {
+      if ((not is_zero_accepting[s]) and (IsAcceptingState(s) or is_zero_accepting[next_states[s][0]])) {
+        is_zero_accepting[s] = true;
+        is_changed = true;
+      }
+    }
   }
 
-  if (not IsSinkState(this->dfa_->s)) {
-    GetBaseConstants(this->dfa_->s, is_visited, path, constants, max_number_of_bit_limit);
+  ValueDfa value_dfa;
+  value_dfa.initial = 0;
+  std::map<std::pair<int, int>, int> pair_states;
+  std::vector<std::pair<int, int>> state_pairs;
+  auto get_state = [&](const int before_zeros, const int current) {
+    auto key = std::make_pair(before_zeros, current);
+    auto it = pair_states.find(key);
+    if (it != pair_states.end()) {
+      return it->second;
+    }
+    const int state = state_pairs.size();
+    pair_states[key] = state;
+    state_pairs.push_back(key);
+    return state;
+  };
+
+  get_state(this->dfa_->s, this->dfa_->s);
+  for (std::size_t state = 0; state < state_pairs.size(); ++state) {
+    const int before_zeros = state_pairs[state].first;
+    const int current = state_pairs[state].second;
+    std::array<int, 2> next;
+    next[0] = get_state(before_zeros, next_states[current][0]);
+    next[1] = get_state(next_states[current][1], next_states[current][1]);
+    value_dfa.next.push_back(next);
+    value_dfa.is_accepting.push_back(is_zero_accepting[before_zeros]);
+  }
+
+  return value_dfa;
+}
+
+/**
+ * Moore's partition refinement; states of the result are numbered in breadth first order from the initial state so
+ * that automata of the same language are equal
+ */
+BinaryIntAutomaton::ValueDfa BinaryIntAutomaton::MinimizeValueDfa(const ValueDfa& value_dfa) {
+  const int number_of_states = value_dfa.next.size();
+  std::vector<int> blocks(number_of_states);
+  for (int s = 0; s < number_of_states; ++s) {
+    blocks[s] = value_dfa.is_accepting[s] ? 1 : 0;
+  }
+
+  int number_of_blocks = 0;
+  while (true) {
+    std::map<std::array<int, 3>, int> signatures;
+    std::vector<int> next_blocks(number_of_states);
+    for (int s = 0; s < number_of_states; ++s) {
+      std::array<int, 3> signature { { blocks[s], blocks[value_dfa.next[s][0]], blocks[value_dfa.next[s][1]] } };
+      auto it = signatures.find(signature);
+      if (it == signatures.end()) {
+        it = signatures.insert(std::make_pair(signature, (int)signatures.size())).first;
+      }
+      next_blocks[s] = it->second;
+    }
+    blocks = next_blocks;
+    if ((int)signatures.size() == number_of_blocks) {
+      break;
+    }
+    number_of_blocks = signatures.size();
   }
 
-  delete[] is_visited;
+  std::vector<int> block_representatives(number_of_blocks, -1);
+  for (int s = 0; s < number_of_states; ++s) {
+    if (block_representatives[blocks[s]] == -1) {
+      block_representatives[blocks[s]] = s;
+    }
+  }
 
-  DVLOG(VLOG_LEVEL) << "<void> = [" << this->id_ << "]->getBaseConstants(<base constants>)";
+  ValueDfa minimized_dfa;
+  minimized_dfa.initial = 0;
+  std::vector<int> block_states(number_of_blocks, -1);
+  std::vector<int> state_blocks {blocks[value_dfa.initial]};
+  block_states[blocks[value_dfa.initial]] = 0;
+  for (std::size_t state = 0; state < state_blocks.size(); ++state) {
+    const int representative = block_representatives[state_blocks[state]];
+    std::array<int, 2> next;
+    for (int b = 0; b < 2; ++b) {
+      const int next_block = blocks[value_dfa.next[representative][b]];
+      if (block_states[next_block] == -1) {
+        block_states[next_block] = state_blocks.size();
+        state_blocks.push_back(next_block);
+      }
+      next[b] = block_states[next_block];
+    }
+    minimized_dfa.next.push_back(next);
+    minimized_dfa.is_accepting.push_back(value_dfa.is_accepting[representative]);
+  }
 
-  return;
+  return minimized_dfa;
 }
 
 /**
- * @param is_visited to keep track of visited transition; 1st is for '0' transition, 2nd bit is for '1' transition
- * @returns populated constants, ignores the value of initial state whether is an accepted or not
+ * Reads the input and the shift together with a carry bit; at the end of the input the remaining bits of the shift
+ * and the carry are read as well
  */
-void BinaryIntAutomaton::GetBaseConstants(int state, unsigned char *is_visited, std::vector<bool>& path,
-                                          std::vector<int>& constants, unsigned max_number_of_bit_limit) {
-  int next_state = 0;
-  std::vector<char> exception = { '0' };
+BinaryIntAutomaton::ValueDfa BinaryIntAutomaton::ShiftValueDfa(const ValueDfa& value_dfa, const unsigned long shift) {
+  int number_of_shift_bits = 0;
+  while (number_of_shift_bits < 64 and (shift >> number_of_shift_bits) != 0) {
+    ++number_of_shift_bits;
+  }
+
+  ValueDfa shifted_dfa;
+  shifted_dfa.initial = 0;
+  std::map<std::array<int, 3>, int> triple_states;
+  std::vector<std::array<int, 3>> state_triples;  // state, carry, number of shift bits read
+  auto get_state = [&](const std::array<int, 3>& triple) {
+    auto it = triple_states.find(triple);
+    if (it != triple_states.end()) {
+      return it->second;
+    }
+    const int state = state_triples.size();
+    triple_states[triple] = state;
+    state_triples.push_back(triple);
+    return state;
+  };
+
+  get_state(std::array<int, 3> { { value_dfa.initial, 0, 0 } });
+  for (std::size_t state = 0; state < state_triples.size(); ++state) {
+    const std::array<int, 3> triple = state_triples[state];
+    const int shift_bit = (triple[2] < number_of_shift_bits) ? ((shift >> triple[2]) & 1) : 0;
+    std::array<int, 2> next;
+    for (int b = 0; b < 2; ++b) {
+      const int sum = b + shift_bit + triple[1];
+      next[b] = get_state(std::array<int, 3> { { value_dfa.next[triple[0]][sum & 1], sum >> 1,
+                                                 std::min(triple[2] + 1, number_of_shift_bits) } });
+    }
+    shifted_dfa.next.push_back(next);
 
-  if (path.size() > max_number_of_bit_limit) {  // limit samples to integer length for now
-    return;
+    unsigned long rest = (triple[2] < number_of_shift_bits) ? (shift >> triple[2]) : 0;
+    rest += triple[1];
+    shifted_dfa.is_accepting.push_back(IsAcceptedValue(value_dfa, rest, triple[0]));
   }
 
-  if (IsAcceptingState(state)) {
-    unsigned c = 0;
-    for (unsigned i = 0; i < path.size(); i++) {
-      if (path[i]) {
-        c += (1 << i);
-      }
-    }
-    constants.push_back(c);
+  return shifted_dfa;
+}
+
+bool BinaryIntAutomaton::IsAcceptedValue(const ValueDfa& value_dfa, unsigned long value, int state) {
+  if (state == -1) {
+    state = value_dfa.initial;
+  }
+  while (value != 0) {
+    state = value_dfa.next[state][value & 1];
+    value >>= 1;
   }
+  return value_dfa.is_accepting[state];
+}
 
-  next_state = getNextState(state, exception);  // taking transition 0
+/**
+ * Residuals of n and n + d are equal for every n >= h if and only if d is a multiple of the period and h is at least
+ * the cycle head. Values are read one bit per transition, and the states reached after the low bits have to tell
+ * apart the residues modulo the odd part of the period, so both the exponent of 2 and the odd part of the period
+ * are at most the number of states. The smallest odd q with a valid 2^31 * q is the odd part of the period, the
+ * smallest a with a valid 2^a * q is the exponent; a binary search finds the cycle head.
+ * Returns false if the set is not ultimately periodic within int values.
+ */
+bool BinaryIntAutomaton::GetPeriodicPart(const ValueDfa& value_dfa, unsigned long& cycle_head,
+                                         unsigned long& period) {
+  const unsigned long max_value = std::numeric_limits<int>::max();
+  const int max_exponent = 31;
+  // any cycle head that fits into an int is below
+  const unsigned long head_bound = 1ul << max_exponent;
+  const unsigned long number_of_states = value_dfa.next.size();
+  auto get_residual = [&value_dfa](const unsigned long n) {
+    return MinimizeValueDfa(ShiftValueDfa(value_dfa, n));
+  };
+  const ValueDfa bound_residual = get_residual(head_bound);
+  auto is_period = [&](const unsigned long d) {
+    return get_residual(head_bound + d) == bound_residual;
+  };
+
+  unsigned long odd_part = 1;
+  while (odd_part <= number_of_states and not is_period(odd_part << max_exponent)) {
+    odd_part += 2;
+  }
+  if (odd_part > number_of_states or odd_part > max_value) {
+    return false;
+  }
+  int exponent = 0;
+  while (exponent < max_exponent and not is_period(odd_part << exponent)) {
+    ++exponent;
+  }
+  period = odd_part << exponent;
+  if (period > max_value) {
+    return false;
+  }
 
-  if ((is_visited[state] & 1) == 0 and (not IsSinkState(next_state))) {
-    is_visited[state] |= 1;
-    path.push_back(false);
-    GetBaseConstants(next_state, is_visited, path, constants, max_number_of_bit_limit);
-    path.pop_back();
-    is_visited[state] &= 2;
+  // once residuals of n and n + period are equal they stay equal, search for the smallest such n
+  unsigned long low = 0, high = head_bound;
+  while (low < high) {
+    unsigned long middle = low + (high - low) / 2;
+    if (get_residual(middle) == get_residual(middle + period)) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
   }
+  cycle_head = low;
+  return cycle_head + period <= max_value;
+}
 
-  exception[0] = '1';
-  next_state = getNextState(state, exception);  // taking transition 1
+/**
+ * Values are read least significant bit first and acceptance does not change with leading zeros, so a value below
+ * 2^k is accepted iff some k bit word reaches an accepting state. Prefixes that cannot reach an accepting state
+ * within the remaining bits are not extended.
+ */
+bool BinaryIntAutomaton::GetAcceptedValues(const ValueDfa& value_dfa, const unsigned long bound,
+                                           std::vector<int>& values) {
+  int number_of_bits = 0;
+  while (number_of_bits < 63 and (1ul << number_of_bits) < bound) {
+    ++number_of_bits;
+  }
+
+  // is_live[k][s]: an accepting state is reachable from s with k bits
+  const int number_of_states = value_dfa.next.size();
+  std::vector<std::vector<bool>> is_live(number_of_bits + 1, std::vector<bool>(number_of_states, false));
+  is_live[0] = value_dfa.is_accepting;
+  for (int k = 1; k <= number_of_bits; ++k) {
+    for (int s = 0; s < number_of_states; ++s) {
+      is_live[k][s] = is_live[k - 1][value_dfa.next[s][0]] or is_live[k - 1][value_dfa.next[s][1]];
+    }
+  }
 
-  if ((is_visited[state] & 2) == 0 and (not IsSinkState(next_state))) {
-    is_visited[state] |= 2;
-    path.push_back(true);
-    GetBaseConstants(next_state, is_visited, path, constants, max_number_of_bit_limit);
-    path.pop_back();
-    is_visited[state] &= 1;
+  std::vector<std::pair<int, unsigned long>> prefixes;  // state and value of the low bits read
+  std::vector<int> prefix_lengths;
+  if (bound > 0 and is_live[number_of_bits][value_dfa.initial]) {
+    prefixes.push_back(std::make_pair(value_dfa.initial, 0ul));
+    prefix_lengths.push_back(0);
+  }
+  while (not prefixes.empty()) {
+    auto prefix = prefixes.back();
+    const int length = prefix_lengths.back();
+    prefixes.pop_back();
+    prefix_lengths.pop_back();
+    if (length == number_of_bits) {
+      if (prefix.second < bound) {
+        if (values.size() >= MAX_NUMBER_OF_SEMILINEAR_VALUES) {
+          return false;
+        }
+        values.push_back(prefix.second);
+      }
+      continue;
+    }
+    for (int b = 1; b >= 0; --b) {
+      const int next_state = value_dfa.next[prefix.first][b];
+      if (is_live[number_of_bits - length - 1][next_state]) {
+        prefixes.push_back(std::make_pair(next_state, prefix.second | ((unsigned long)b << length)));
+        prefix_lengths.push_back(length + 1);
+      }
+    }
   }
+  std::sort(values.begin(), values.end());
+  return true;
 }
 
 //void BinaryIntAutomaton::getBaseConstants2(std::vector<int>& constants) {
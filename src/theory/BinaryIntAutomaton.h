@@ -12,14 +12,18 @@
 #define THEORY_BINARYINTAUTOMATON_H_
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -75,6 +79,7 @@ public:
   BinaryIntAutomaton_ptr Difference(BinaryIntAutomaton_ptr);
   BinaryIntAutomaton_ptr Exists(std::string var_name);
   BinaryIntAutomaton_ptr GetBinaryAutomatonFor(std::string var_name);
+  std::map<std::string, BinaryIntAutomaton_ptr> GetBinaryAutomataForAllVariables();
   BinaryIntAutomaton_ptr GetPositiveValuesFor(std::string var_name);
   BinaryIntAutomaton_ptr GetNegativeValuesFor(std::string var_name);
   BinaryIntAutomaton_ptr TrimLeadingZeros();
@@ -101,6 +106,33 @@ protected:
   static BinaryIntAutomaton_ptr MakeGreaterThan(ArithmeticFormula_ptr, bool is_natural_number);
   static BinaryIntAutomaton_ptr MakeGreaterThanOrEqual(ArithmeticFormula_ptr, bool is_natural_number);
   static BinaryIntAutomaton_ptr MakeTrimHelperAuto(int var_index, int number_of_variables);
+
+  /**
+   * Builds a relation over fixed width (Option::Theory::INT_BIT_WIDTH) integers; accepts words of exactly width
+   * columns, so the automaton is acyclic apart from the sink. Signed equalities are evaluated modulo 2^width as JVM
+   * arithmetic does, signed inequalities and all natural number relations are evaluated exactly over the
+   * width bit values of the variables.
+   * @param formula
+   * @param is_natural_number
+   * @return
+   */
+  static BinaryIntAutomaton_ptr MakeBitVectorRelation(ArithmeticFormula_ptr formula, bool is_natural_number);
+
+  /**
+   * Builds the carry automaton of a linear formula symbolically. Transitions of a carry state only depend on the
+   * weighted sum of the current column, so bdds are built once per state over the reachable partial sums
+   * instead of enumerating every bit combination.
+   * @param formula
+   * @param number_of_keys carry states are identified by dense keys in [0, number_of_keys)
+   * @param initial_key
+   * @param next_key maps a key and a column sum to the next key, -1 for the sink state
+   * @param is_accepting_key
+   * @param is_sink_accepting
+   * @return a minimized dfa, its initial state is a non-accepting copy of the initial key
+   */
+  static DFA_ptr MakeCarryDfa(ArithmeticFormula_ptr formula, const int number_of_keys, const int initial_key,
+          std::function<int(const int, const int)> next_key, std::function<bool(const int)> is_accepting_key,
+          const bool is_sink_accepting);
   static void ComputeBinaryStates(std::vector<BinaryState_ptr>& binary_states,
           SemilinearSet_ptr semilinear_set);
   static void AddBinaryState(std::vector<BinaryState_ptr>& binary_states,
@@ -111,16 +143,58 @@ protected:
 
   void decide_counting_schema(Eigen::SparseMatrix<BigInteger>& count_matrix) override;
 
-  bool GetCycleStatus(std::map<int, bool>& cycle_status);
-  void GetCycleStatus(int state, std::map<int, int>& disc, std::map<int, int>& low, std::vector<int>& st,
-            std::map<int, bool>& is_stack_member, std::map<int, bool>& cycle_status, int& time);
+  bool GetCycleStatus(std::vector<bool>& cycle_status);
 //  bool getConstants(std::vector<int>& constants);
 //  bool getConstants(int state, std::map<int, int>& disc, std::map<int, int>& low, std::vector<int>& st,
 //          std::map<int, bool>& is_stack_member, std::vector<bool>& path, std::vector<int>& constants, int& time);
-  void GetConstants(std::map<int, bool>& cycle_status, std::vector<int>& constants);
-  void GetConstants(int state, std::map<int, bool>& cycle_status, std::vector<bool>& path, std::vector<int>& constants);
-  void GetBaseConstants(std::vector<int>& constants, unsigned max_number_of_bit_limit = 15);
-  void GetBaseConstants(int state, unsigned char *is_visited, std::vector<bool>& path, std::vector<int>& constants, unsigned max_number_of_bit_limit);
+  void GetConstants(std::vector<bool>& cycle_status, std::vector<int>& constants);
+  void GetConstants(int state, std::vector<bool>& cycle_status, std::vector<bool>& path, std::vector<int>& constants);
+
+  /**
+   * Single track automaton over natural numbers, least significant bit first, that accepts a word iff it accepts
+   * the word followed by zeros; acceptance only depends on the value of the word.
+   */
+  struct ValueDfa {
+    int initial;
+    std::vector<std::array<int, 2>> next;
+    std::vector<bool> is_accepting;
+
+    bool operator==(const ValueDfa& other) const {
+      return initial == other.initial and next == other.next and is_accepting == other.is_accepting;
+    }
+    bool operator<(const ValueDfa& other) const {
+      return std::tie(initial, next, is_accepting) < std::tie(other.initial, other.next, other.is_accepting);
+    }
+  };
+
+  ValueDfa GetValueDfa();
+  static ValueDfa MinimizeValueDfa(const ValueDfa& value_dfa);
+
+  /**
+   * @param value_dfa
+   * @param shift
+   * @return value automaton of {x : x + shift is accepted by value_dfa}
+   */
+  static ValueDfa ShiftValueDfa(const ValueDfa& value_dfa, const unsigned long shift);
+  static bool IsAcceptedValue(const ValueDfa& value_dfa, unsigned long value, int state = -1);
+
+  /**
+   * Finds the smallest period and cycle head of the numbers accepted by the value automaton
+   * @param value_dfa minimized
+   * @param cycle_head
+   * @param period
+   * @return false if they do not fit into int values
+   */
+  static bool GetPeriodicPart(const ValueDfa& value_dfa, unsigned long& cycle_head, unsigned long& period);
+
+  /**
+   * Appends the accepted numbers below the bound in increasing order
+   * @param value_dfa
+   * @param bound
+   * @param values
+   * @return false if there are more than MAX_NUMBER_OF_SEMILINEAR_VALUES numbers
+   */
+  static bool GetAcceptedValues(const ValueDfa& value_dfa, const unsigned long bound, std::vector<int>& values);
   //  void getBaseConstants2(std::vector<int>& constants);
   //  void getBaseConstants(int state, bool *is_stack_member, std::vector<bool>& path, std::vector<int>& constants);
 
@@ -136,6 +210,7 @@ protected:
   ArithmeticFormula_ptr formula_;
 private:
   static const int VLOG_LEVEL;
+  static const std::size_t MAX_NUMBER_OF_SEMILINEAR_VALUES;
 };
 
 } /* namespace Theory */
@@ -27,7 +27,7 @@ BoolAutomaton::BoolAutomaton(DFA_ptr dfa, int num_of_variables)
 }
 
 BoolAutomaton::BoolAutomaton(const BoolAutomaton& other)
-        : Automaton(Automaton::Type::STRING), dfa(dfaCopy(other.dfa)), num_of_variables(other.num_of_variables) {
+        : Automaton(Automaton::Type::STRING), dfa(DFACopy(other.dfa)), num_of_variables(other.num_of_variables) {
 }
 
 BoolAutomaton_ptr BoolAutomaton::clone() const {
@@ -71,6 +71,7 @@ BoolAutomaton_ptr BoolAutomaton::makeFalse(int num_of_variables,int* variable_in
 }
 
 void BoolAutomaton::toDot() {
+  MonaLock lock(MonaLock::Globals::EXTERNAL);
   dfaPrintGraphviz(dfa, 0, nullptr);
 }
 
@@ -0,0 +1,85 @@
+/*
+ * DFABuilder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "DFABuilder.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int DFABuilder::VLOG_LEVEL = 20;
+
+MonaLock::MonaLock(const Globals globals)
+    : mutex_(GetMutex(globals)) {
+  mutex_.lock();
+}
+
+MonaLock::~MonaLock() {
+  mutex_.unlock();
+}
+
+std::mutex& MonaLock::GetMutex(const Globals globals) {
+  static std::mutex operations_mutex, external_mutex;
+  return (Globals::EXTERNAL == globals) ? external_mutex : operations_mutex;
+}
+
+DFABuilder::DFABuilder(const int number_of_states, const int number_of_bdd_variables, const int* indices)
+    : number_of_states_(number_of_states),
+      number_of_bdd_variables_(number_of_bdd_variables),
+      indices_(indices, indices + number_of_bdd_variables) {
+  states_.reserve(number_of_states);
+}
+
+DFABuilder::~DFABuilder() {
+}
+
+void DFABuilder::AllocExceptions(const int number_of_exceptions) {
+  DCHECK_LT(states_.size(), static_cast<std::size_t>(number_of_states_)) << "too many states";
+  states_.push_back(State {number_of_exceptions, {}, -1});
+  states_.back().exceptions.reserve(number_of_exceptions);
+}
+
+void DFABuilder::StoreException(const int target, const char* path) {
+  states_.back().exceptions.push_back(std::make_pair(target, std::string(path, strnlen(path, number_of_bdd_variables_))));
+}
+
+void DFABuilder::StoreException(const int target, const std::string& path) {
+  states_.back().exceptions.push_back(std::make_pair(target, path));
+}
+
+void DFABuilder::StoreState(const int default_target) {
+  DCHECK_EQ(states_.back().exceptions.size(), static_cast<std::size_t>(states_.back().number_of_exceptions))
+      << "number of exceptions does not match";
+  states_.back().default_target = default_target;
+  Util::Cancellation::Check();
+}
+
+DFA* DFABuilder::Build(const char* statuses) {
+  DCHECK_EQ(states_.size(), static_cast<std::size_t>(number_of_states_)) << "missing states";
+  // MONA's construction cannot be left half way, cancellation is checked before it starts
+  Util::Cancellation::Check();
+  MonaLock lock;
+  dfaSetup(number_of_states_, number_of_bdd_variables_, indices_.data());
+  for (auto& state : states_) {
+    dfaAllocExceptions(state.number_of_exceptions);
+    for (auto& exception : state.exceptions) {
+      dfaStoreException(exception.first, const_cast<char*>(exception.second.c_str()));
+    }
+    dfaStoreState(state.default_target);
+  }
+  DVLOG(VLOG_LEVEL) << "built dfa with " << number_of_states_ << " states";
+  return dfaBuild(const_cast<char*>(statuses));
+}
+
+DFA* DFABuilder::Build(const std::string& statuses) {
+  return Build(statuses.c_str());
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
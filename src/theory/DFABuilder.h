@@ -0,0 +1,114 @@
+/*
+ * DFABuilder.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_DFABUILDER_H_
+#define THEORY_DFABUILDER_H_
+
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+#include <mona/dfa.h>
+
+#include "../utils/Cancellation.h"
+
+namespace Vlab {
+namespace Theory {
+
+/**
+ * Guards MONA's process wide state. The dfa builder (dfaSetup to dfaBuild) and the operand and result
+ * managers of the bdd apply functions are globals, dfaCopy, dfaProduct, dfaProject, dfaMinimize and
+ * dfaMakeExample use them and run under OPERATIONS. dfaExport, dfaImport and dfaPrintGraphviz keep their
+ * node tables in globals and run under EXTERNAL.
+ * Calls that only touch the bdd manager of a dfa owned by the calling thread (dfaNegation, dfaReplaceIndices,
+ * dfaFree and reading states and bdd nodes) do not need a lock. Locks are not recursive, a locked region
+ * only contains MONA calls.
+ */
+class MonaLock {
+public:
+  enum class Globals : int {
+    OPERATIONS = 0,
+    EXTERNAL
+  };
+
+  MonaLock(const Globals globals = Globals::OPERATIONS);
+  ~MonaLock();
+
+private:
+  MonaLock(const MonaLock&) = delete;
+  MonaLock& operator=(const MonaLock&) = delete;
+
+  static std::mutex& GetMutex(const Globals globals);
+
+  std::mutex& mutex_;
+};
+
+/**
+ * Builder context that replaces MONA's global builder (dfaSetup, dfaAllocExceptions, dfaStoreException,
+ * dfaStoreState and dfaBuild) with the same calls on an object.
+ * States and exceptions are recorded in the object, so any number of automata can be under construction
+ * at the same time in different threads; they are replayed to MONA under MonaLock when the dfa is built.
+ */
+class DFABuilder {
+public:
+  DFABuilder(const int number_of_states, const int number_of_bdd_variables, const int* indices);
+  virtual ~DFABuilder();
+
+  /**
+   * Starts the next state, it will have the given number of exceptions
+   * @param number_of_exceptions
+   */
+  void AllocExceptions(const int number_of_exceptions);
+
+  /**
+   * Adds a transition from the current state on the given bdd path ('0', '1' or 'X' per bdd variable)
+   * @param target
+   * @param path
+   */
+  void StoreException(const int target, const char* path);
+  void StoreException(const int target, const std::string& path);
+
+  /**
+   * Finishes the current state with the transition taken on all other paths
+   * @param default_target
+   */
+  void StoreState(const int default_target);
+
+  /**
+   * Generates the dfa, statuses[i] is '+' for accepting, '-' for rejecting and '0' for don't care states
+   * @param statuses
+   * @return
+   */
+  DFA* Build(const char* statuses);
+  DFA* Build(const std::string& statuses);
+
+protected:
+  struct State {
+    int number_of_exceptions;
+    std::vector<std::pair<int, std::string>> exceptions;
+    int default_target;
+  };
+
+  const int number_of_states_;
+  const int number_of_bdd_variables_;
+  std::vector<int> indices_;
+  std::vector<State> states_;
+
+private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_DFABUILDER_H_ */
@@ -19,21 +19,24 @@ Formula::~Formula() {
 
 Formula::Formula(const Formula& other) {
 	this->variable_coefficient_map_ = other.variable_coefficient_map_;
+	this->variable_order_ = other.variable_order_;
+	this->ordered_variables_ = other.ordered_variables_;
+	this->variable_indices_ = other.variable_indices_;
 }
 
 int Formula::GetVariableIndex(std::string variable_name) const {
-	auto it = variable_coefficient_map_.find(variable_name);
-	if (it != variable_coefficient_map_.end()) {
-		return std::distance(variable_coefficient_map_.begin(), it);
+	auto it = variable_indices_.find(variable_name);
+	if (it != variable_indices_.end()) {
+		return it->second;
 	}
 	LOG(FATAL)<< "Variable '" << variable_name << "' is not in formula: " << str();
 	return -1;
 }
 
 int Formula::GetVariableIndex(const std::size_t param_index) const {
-  for (auto it = variable_coefficient_map_.begin(); it != variable_coefficient_map_.end(); ++it) {
-    if (it->second == param_index) {
-      return std::distance(variable_coefficient_map_.begin(), it);
+  for (std::size_t i = 0; i < ordered_variables_.size(); ++i) {
+    if (variable_coefficient_map_.at(ordered_variables_[i]) == param_index) {
+      return i;
     }
   }
 
@@ -58,12 +61,10 @@ void Formula::SetVariableCoefficient(std::string variable_name, int coeff) {
 }
 
 std::string Formula::GetVariableAtIndex(const std::size_t index) const {
-	if (index >= variable_coefficient_map_.size()) {
+	if (index >= ordered_variables_.size()) {
 		LOG(FATAL) << "Index out of range";
 	}
-	auto it = variable_coefficient_map_.begin();
-	std::advance(it, index);
-	return it->first;
+	return ordered_variables_[index];
 }
 
 int Formula::GetNumberOfVariables() const {
@@ -74,8 +75,9 @@ std::map<std::string,int> Formula::GetVariableCoefficientMap() const {
 	return variable_coefficient_map_;
 }
 
-void Formula::SetVariableCoefficientMap(std::map<std::string, int>& coefficient_map) {
+void Formula::SetVariableCoefficientMap(const std::map<std::string, int>& coefficient_map) {
 	variable_coefficient_map_ = coefficient_map;
+	UpdateVariableIndices();
 }
 
 void Formula::AddVariable(std::string name, int coefficient) {
@@ -83,20 +85,49 @@ void Formula::AddVariable(std::string name, int coefficient) {
 		LOG(FATAL)<< "Variable has already been added! : " << name;
 	}
 	variable_coefficient_map_[name] = coefficient;
+	UpdateVariableIndices();
 }
 
 void Formula::RemoveVariable(std::string var_name) {
-	variable_coefficient_map_.erase(var_name);
+	if (variable_coefficient_map_.erase(var_name) > 0) {
+		UpdateVariableIndices();
+	}
 }
 
 std::vector<int> Formula::GetCoefficients() const {
 	std::vector<int> coefficients;
-	for (const auto& el : variable_coefficient_map_) {
-		coefficients.push_back(el.second);
+	coefficients.reserve(ordered_variables_.size());
+	for (const auto& variable_name : ordered_variables_) {
+		coefficients.push_back(variable_coefficient_map_.at(variable_name));
 	}
 	return coefficients;
 }
 
+void Formula::SetVariableOrder(const std::vector<std::string>& variable_order) {
+	variable_order_ = variable_order;
+	UpdateVariableIndices();
+}
+
+const std::vector<std::string>& Formula::GetVariableOrder() const {
+	return ordered_variables_;
+}
+
+void Formula::UpdateVariableIndices() {
+	ordered_variables_.clear();
+	variable_indices_.clear();
+	for (const auto& variable_name : variable_order_) {
+		if (variable_coefficient_map_.find(variable_name) != variable_coefficient_map_.end()
+				and variable_indices_.insert(std::make_pair(variable_name, ordered_variables_.size())).second) {
+			ordered_variables_.push_back(variable_name);
+		}
+	}
+	for (const auto& el : variable_coefficient_map_) {
+		if (variable_indices_.insert(std::make_pair(el.first, ordered_variables_.size())).second) {
+			ordered_variables_.push_back(el.first);
+		}
+	}
+}
+
 void Formula::ResetCoefficients(int value) {
 	for (auto& el : variable_coefficient_map_) {
 		el.second = value;
@@ -8,10 +8,12 @@
 #ifndef THEORY_FORMULA_H_
 #define THEORY_FORMULA_H_
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <locale>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -49,17 +51,42 @@ public:
 	std::string GetVariableAtIndex(const std::size_t index) const;
 	int GetNumberOfVariables() const;
 	std::map<std::string,int> GetVariableCoefficientMap() const;
-	void SetVariableCoefficientMap(std::map<std::string, int>& coefficient_map);
+	void SetVariableCoefficientMap(const std::map<std::string, int>& coefficient_map);
 	void AddVariable(std::string,int);
 	void RemoveVariable(std::string);
 	std::vector<int> GetCoefficients() const;
+
+	/**
+	 * Sets the order of the bdd variables; variables that are not in the order come after the ordered ones in
+	 * name order. Without an order, variables are in name order.
+	 * @param variable_order
+	 */
+	void SetVariableOrder(const std::vector<std::string>& variable_order);
+
+	/**
+	 * @return variable names in bdd variable order
+	 */
+	const std::vector<std::string>& GetVariableOrder() const;
 	virtual void ResetCoefficients(int coeff = 0);
 
 	virtual bool UpdateMixedConstraintRelations() = 0;
 	virtual bool Simplify();
 
 protected:
+	/**
+	 * Rebuilds the variable indices, called whenever variables are added or removed or the order changes
+	 */
+	void UpdateVariableIndices();
+
 	std::map<std::string,int> variable_coefficient_map_;
+	std::vector<std::string> variable_order_;
+
+	/**
+	 * Variable names in bdd variable order and the index of each; kept up to date by the modifying
+	 * methods so that lookups neither rebuild the order nor write to a formula shared by threads
+	 */
+	std::vector<std::string> ordered_variables_;
+	std::map<std::string, int> variable_indices_;
 };
 
 } /* namespace Theory */
@@ -83,12 +83,12 @@ IntAutomaton_ptr IntAutomaton::makeZero(int num_of_variables) {
   char statuses[2] { '+', '-' };
   int* variable_indices = GetBddVariableIndices(num_of_variables);
 
-  dfaSetup(2, num_of_variables, variable_indices);
-  dfaAllocExceptions(0);
-  dfaStoreState(1);
-  dfaAllocExceptions(0);
-  dfaStoreState(1);
-  zero_int_dfa = dfaBuild(statuses);
+  DFABuilder builder(2, num_of_variables, variable_indices);
+  builder.AllocExceptions(0);
+  builder.StoreState(1);
+  builder.AllocExceptions(0);
+  builder.StoreState(1);
+  zero_int_dfa = builder.Build(statuses);
   zero_int = new IntAutomaton(zero_int_dfa, num_of_variables);
   //delete[] variable_indices;
 
@@ -106,11 +106,11 @@ IntAutomaton_ptr IntAutomaton::makeAnyInt(int num_of_variables) {
   char statuses[1] { '+' };
   int* variable_indices = GetBddVariableIndices(num_of_variables);
 
-  dfaSetup(1, num_of_variables, variable_indices);
-  dfaAllocExceptions(0);
-  dfaStoreState(0);
+  DFABuilder builder(1, num_of_variables, variable_indices);
+  builder.AllocExceptions(0);
+  builder.StoreState(0);
 
-  any_int_dfa = dfaBuild(statuses);
+  any_int_dfa = builder.Build(statuses);
   any_int = new IntAutomaton(any_int_dfa, true, num_of_variables);
   //delete[] variable_indices;
 
@@ -250,6 +250,16 @@ IntAutomaton_ptr IntAutomaton::makeInts(std::vector<int> values, int num_of_vari
   return int_auto;
 }
 
+IntAutomaton_ptr IntAutomaton::makeAutomaton(SemilinearSet_ptr semilinear_set, int num_of_variables) {
+  auto unary_auto = UnaryAutomaton::MakeAutomaton(semilinear_set);
+  auto int_auto = unary_auto->toIntAutomaton(num_of_variables);
+  delete unary_auto;
+
+  DVLOG(VLOG_LEVEL) << int_auto->id_ << " = makeAutomaton(" << *semilinear_set << ")";
+
+  return int_auto;
+}
+
 void IntAutomaton::setMinus1(bool has_minus_one) {
   has_negative_1 = has_minus_one;
 }
@@ -258,18 +268,18 @@ bool IntAutomaton::hasNegative1() {
   return has_negative_1;
 }
 IntAutomaton_ptr IntAutomaton::complement() {
-  DFA_ptr complement_dfa = nullptr, minimized_dfa = nullptr, current_dfa = dfaCopy(dfa_);
+  DFA_ptr complement_dfa = nullptr, minimized_dfa = nullptr, current_dfa = DFACopy(dfa_);
   IntAutomaton_ptr complement_auto = nullptr;
   IntAutomaton_ptr any_int = IntAutomaton::makeAnyInt();
 
-  dfaNegation(current_dfa);
-  complement_dfa = dfaProduct(any_int->dfa_, current_dfa, dfaAND);
+  DFANegation(current_dfa);
+  complement_dfa = DFAProduct(any_int->dfa_, current_dfa, dfaAND);
   delete any_int;
   any_int = nullptr;
   dfaFree(current_dfa);
   current_dfa = nullptr;
 
-  minimized_dfa = dfaMinimize(complement_dfa);
+  minimized_dfa = DFAMinimize(complement_dfa);
   dfaFree(complement_dfa);
   complement_dfa = nullptr;
 
@@ -425,11 +435,24 @@ IntAutomaton_ptr IntAutomaton::times(int value) {
     times_auto = this->clone();
   } else if (value == -1) {
     times_auto = this->uminus();
+  } else if (not has_negative_1) {
+    int bound = (value > 0) ? value : -value;
+    auto semilinear_set = this->getSemilinearSet();
+    auto scaled_set = semilinear_set->Times(bound);
+    times_auto = IntAutomaton::makeAutomaton(scaled_set, num_of_bdd_variables_);
+    delete semilinear_set;
+    delete scaled_set;
+
+    if (value < 0) {
+      tmp_auto = times_auto;
+      times_auto = tmp_auto->uminus();
+      delete tmp_auto;
+    }
   } else {
     int bound = (value > 0) ? value : -value;
     times_auto = this->clone();
 
-    for (int i = 1; i < value; i++) {
+    for (int i = 1; i < bound; i++) {
       tmp_auto = times_auto;
       times_auto = tmp_auto->plus(this);
       delete tmp_auto; tmp_auto = nullptr;
@@ -785,14 +808,14 @@ UnaryAutomaton_ptr IntAutomaton::toUnaryAutomaton() {
   char* statuses = new char[number_of_states + 1];
   std::vector<char> exception = {'0', '0', '0', '0', '0', '0', '0', '0'};
 
-  dfaSetup(number_of_states, number_of_variables, indices);
+  DFABuilder builder(number_of_states, number_of_variables, indices);
 
   for (int s = 0; s < this->dfa_->ns; s++) {
     to_state = getNextState(s, exception);
-    dfaAllocExceptions(1);
-    dfaStoreException(to_state, &*unary_exception.begin());
+    builder.AllocExceptions(1);
+    builder.StoreException(to_state, &*unary_exception.begin());
 
-    dfaStoreState(sink_state);
+    builder.StoreState(sink_state);
 
     if (IsAcceptingState(s)) {
       statuses[s] = '+';
@@ -803,12 +826,12 @@ UnaryAutomaton_ptr IntAutomaton::toUnaryAutomaton() {
   statuses[number_of_states] = '\0';
 
   if(!has_sink) {
-    dfaAllocExceptions(0);
-    dfaStoreState(sink_state);
+    builder.AllocExceptions(0);
+    builder.StoreState(sink_state);
     statuses[sink_state] = '-';
   }
 
-  unary_dfa = dfaBuild(statuses);
+  unary_dfa = builder.Build(statuses);
 
   if(!has_sink) {
     for(int i = 0; i < unary_dfa->ns; i++) {
@@ -826,6 +849,13 @@ UnaryAutomaton_ptr IntAutomaton::toUnaryAutomaton() {
   return unary_auto;
 }
 
+SemilinearSet_ptr IntAutomaton::getSemilinearSet() {
+  auto unary_auto = this->toUnaryAutomaton();
+  auto semilinear_set = unary_auto->getSemilinearSet();
+  delete unary_auto;
+  return semilinear_set;
+}
+
 ArithmeticFormula_ptr IntAutomaton::GetFormula() {
 	return formula_;
 }
@@ -841,11 +871,15 @@ void IntAutomaton::SetFormula(ArithmeticFormula_ptr formula) {
  * TODO WILL: Don't use multitrack for this, too much work
  */
 IntAutomaton_ptr IntAutomaton::__plus(IntAutomaton_ptr other_auto) {
-  DFA_ptr d1,d2,d3;
-  d1 = this->dfa_;
-  d2 = other_auto->getDFA();
-  d3 = StringAutomaton::concat(d1,d2,num_of_bdd_variables_);
-  return new IntAutomaton(d3);
+  // sums are computed on semilinear sets, automata are only built for the result
+  auto left_set = this->getSemilinearSet();
+  auto right_set = other_auto->getSemilinearSet();
+  auto sum_set = left_set->Plus(right_set);
+  auto plus_auto = IntAutomaton::makeAutomaton(sum_set, num_of_bdd_variables_);
+  delete left_set;
+  delete right_set;
+  delete sum_set;
+  return plus_auto;
 /*
   DFA_ptr concat_dfa = nullptr, tmp_dfa = nullptr;
   IntAutomaton_ptr concat_auto = nullptr, to_union_auto = nullptr;
@@ -897,7 +931,7 @@ IntAutomaton_ptr IntAutomaton::__plus(IntAutomaton_ptr other_auto) {
   }
   statuses = new char[expected_num_of_states + 1];
   int* concat_indices = getIndices(tmp_num_of_variables);
-  dfaSetup(expected_num_of_states, tmp_num_of_variables, concat_indices); //sink states are merged
+  DFABuilder builder(expected_num_of_states, tmp_num_of_variables, concat_indices); //sink states are merged
   state_paths = pp = make_paths(other_auto->dfa->bddm, other_auto->dfa->q[other_auto->dfa->s]);
   while (pp) {
     if ( pp->to != (unsigned)sink_state_right_auto ) {
@@ -969,20 +1003,20 @@ IntAutomaton_ptr IntAutomaton::__plus(IntAutomaton_ptr other_auto) {
     current_exception = nullptr;
     // generate concat automaton
     if (this->isAcceptingState(i)) {
-      dfaAllocExceptions(exceptions_left_auto.size() + exceptions_right_auto.size());
+      builder.AllocExceptions(exceptions_left_auto.size() + exceptions_right_auto.size());
       for (auto it = exceptions_left_auto.begin(); it != exceptions_left_auto.end();) {
-        dfaStoreException(it->second, &*it->first->begin());
+        builder.StoreException(it->second, &*it->first->begin());
         current_exception = it->first;
         it = exceptions_left_auto.erase(it);
         delete current_exception;
       }
       for (auto it = exceptions_right_auto.begin(); it != exceptions_right_auto.end();) {
-        dfaStoreException(it->second, &*it->first->begin());
+        builder.StoreException(it->second, &*it->first->begin());
         current_exception = it->first;
         it = exceptions_right_auto.erase(it);
         delete current_exception;
       }
-      dfaStoreState(sink_state_left_auto);
+      builder.StoreState(sink_state_left_auto);
       if (other_auto->isAcceptingState(0)) {
         statuses[i]='+';
       }
@@ -990,14 +1024,14 @@ IntAutomaton_ptr IntAutomaton::__plus(IntAutomaton_ptr other_auto) {
         statuses[i]='-';
       }
     } else {
-      dfaAllocExceptions(exceptions_left_auto.size());
+      builder.AllocExceptions(exceptions_left_auto.size());
       for (auto it = exceptions_left_auto.begin(); it != exceptions_left_auto.end();) {
-        dfaStoreException(it->second, &*it->first->begin());
+        builder.StoreException(it->second, &*it->first->begin());
         current_exception = it->first;
         it = exceptions_left_auto.erase(it);
         delete current_exception;
       }
-      dfaStoreState(sink_state_left_auto);
+      builder.StoreState(sink_state_left_auto);
       statuses[i] = '-';
     }
     current_exception = nullptr;
@@ -1041,14 +1075,14 @@ IntAutomaton_ptr IntAutomaton::__plus(IntAutomaton_ptr other_auto) {
           }
           pp = pp->next;
         }
-        dfaAllocExceptions(exceptions_fix.size());
+        builder.AllocExceptions(exceptions_fix.size());
         for (auto it = exceptions_fix.begin(); it != exceptions_fix.end();) {
-          dfaStoreException(it->second, &*it->first->begin());
+          builder.StoreException(it->second, &*it->first->begin());
           current_exception = it->first;
           it = exceptions_fix.erase(it);
           delete current_exception;
         }
-        dfaStoreState(sink_state_left_auto);
+        builder.StoreState(sink_state_left_auto);
         loc = state_id_shift_amount + i;
         if ( (not is_start_state_reachable) && i > other_auto->dfa->s) {
           loc--;
@@ -1067,12 +1101,12 @@ IntAutomaton_ptr IntAutomaton::__plus(IntAutomaton_ptr other_auto) {
     }
   }
   statuses[expected_num_of_states]='\0';
-  concat_dfa = dfaBuild(statuses);
+  concat_dfa = builder.Build(statuses);
   delete[] statuses; statuses = nullptr;
   delete[] concat_indices; concat_indices = nullptr;
-  tmp_dfa = dfaProject(concat_dfa, (unsigned) var);
+  tmp_dfa = DFAProject(concat_dfa, (unsigned) var);
   dfaFree(concat_dfa);
-  concat_dfa = dfaMinimize(tmp_dfa);
+  concat_dfa = DFAMinimize(tmp_dfa);
   dfaFree(tmp_dfa); tmp_dfa = nullptr;
   concat_auto = new IntAutomaton(concat_dfa, num_of_variables);
   if (has_empty_string) {
@@ -57,6 +57,7 @@ public:
   static IntAutomaton_ptr makeIntGreaterThanOrEqual(int value, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static IntAutomaton_ptr makeIntRange(int start, int end, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
   static IntAutomaton_ptr makeInts(std::vector<int> values, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
+  static IntAutomaton_ptr makeAutomaton(SemilinearSet_ptr semilinear_set, int num_of_variables = IntAutomaton::DEFAULT_NUM_OF_VARIABLES);
 
   void setMinus1(bool has_minus_one);
   bool hasNegative1();
@@ -106,6 +107,7 @@ public:
   int getAnAcceptingInt();
 
   UnaryAutomaton_ptr toUnaryAutomaton();
+  SemilinearSet_ptr getSemilinearSet();
 
   ArithmeticFormula_ptr GetFormula();
   void SetFormula(ArithmeticFormula_ptr);
@@ -0,0 +1,431 @@
+/*
+ * RegexCompiler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "RegexCompiler.h"
+
+namespace Vlab {
+namespace Theory {
+
+const int RegexCompiler::VLOG_LEVEL = 15;
+
+RegexCompiler::RegexCompiler(const int number_of_bdd_variables)
+    : number_of_bdd_variables_(number_of_bdd_variables),
+      alphabet_size_(1UL << number_of_bdd_variables) {
+}
+
+RegexCompiler::~RegexCompiler() {
+}
+
+bool RegexCompiler::IsSupported(Util::RegularExpression_ptr regular_expression, const int number_of_bdd_variables) {
+  if (number_of_bdd_variables < 1 or number_of_bdd_variables > 8) {
+    return false;
+  }
+  switch (regular_expression->type()) {
+    case Util::RegularExpression::Type::UNION:
+    case Util::RegularExpression::Type::CONCATENATION:
+      return IsSupported(regular_expression->get_expr1(), number_of_bdd_variables)
+          and IsSupported(regular_expression->get_expr2(), number_of_bdd_variables);
+    case Util::RegularExpression::Type::OPTIONAL:
+    case Util::RegularExpression::Type::REPEAT_STAR:
+    case Util::RegularExpression::Type::REPEAT_PLUS:
+    case Util::RegularExpression::Type::REPEAT_MIN:
+    case Util::RegularExpression::Type::REPEAT_MINMAX:
+      return IsSupported(regular_expression->get_expr1(), number_of_bdd_variables);
+    case Util::RegularExpression::Type::CHAR:
+    case Util::RegularExpression::Type::CHAR_RANGE:
+    case Util::RegularExpression::Type::ANYCHAR:
+    case Util::RegularExpression::Type::EMPTY:
+    case Util::RegularExpression::Type::STRING:
+    case Util::RegularExpression::Type::ANYSTRING:
+      return true;
+    default:
+      return false;
+  }
+}
+
+DFA_ptr RegexCompiler::Compile(Util::RegularExpression_ptr regular_expression, int* indices) {
+  position_chars_.clear();
+  follow_.clear();
+  is_last_.clear();
+
+  // initial position
+  position_chars_.push_back(CharSet());
+  follow_.push_back(std::vector<int>());
+
+  Fragment fragment = Linearize(regular_expression);
+  follow_[0] = fragment.first;
+
+  is_last_.resize(position_chars_.size(), false);
+  for (auto position : fragment.last) {
+    is_last_[position] = true;
+  }
+  is_last_[0] = fragment.nullable;
+
+  for (auto& positions : follow_) {
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+  }
+
+  ComputeCharClasses();
+  DVLOG(VLOG_LEVEL) << "regex compiler: " << position_chars_.size() << " positions, " << char_classes_.size() << " character classes";
+  return Determinize(indices);
+}
+
+std::vector<std::string> RegexCompiler::GetExceptions(const CharSet& chars, const int number_of_bdd_variables) {
+  std::vector<std::string> exceptions;
+  std::string path (number_of_bdd_variables, 'X');
+  GetExceptions(chars, number_of_bdd_variables, 0, 0, path, exceptions);
+  return exceptions;
+}
+
+RegexCompiler::Fragment RegexCompiler::Linearize(Util::RegularExpression_ptr regular_expression) {
+  switch (regular_expression->type()) {
+    case Util::RegularExpression::Type::UNION: {
+      Fragment left = Linearize(regular_expression->get_expr1());
+      Fragment right = Linearize(regular_expression->get_expr2());
+      return MakeUnion(left, right);
+    }
+    case Util::RegularExpression::Type::CONCATENATION: {
+      Fragment left = Linearize(regular_expression->get_expr1());
+      Fragment right = Linearize(regular_expression->get_expr2());
+      return MakeConcat(left, right);
+    }
+    case Util::RegularExpression::Type::OPTIONAL: {
+      Fragment fragment = Linearize(regular_expression->get_expr1());
+      return MakeOptional(fragment);
+    }
+    case Util::RegularExpression::Type::REPEAT_STAR: {
+      Fragment fragment = Linearize(regular_expression->get_expr1());
+      return MakeStar(fragment);
+    }
+    case Util::RegularExpression::Type::REPEAT_PLUS: {
+      Fragment fragment = Linearize(regular_expression->get_expr1());
+      return MakePlus(fragment);
+    }
+    case Util::RegularExpression::Type::REPEAT_MIN:
+      return MakeRepeat(regular_expression->get_expr1(), regular_expression->get_min());
+    case Util::RegularExpression::Type::REPEAT_MINMAX:
+      return MakeRepeat(regular_expression->get_expr1(), regular_expression->get_min(), regular_expression->get_max());
+    case Util::RegularExpression::Type::CHAR: {
+      CharSet chars;
+      chars.set((unsigned char) regular_expression->get_character() & (alphabet_size_ - 1));
+      return MakePosition(chars);
+    }
+    case Util::RegularExpression::Type::CHAR_RANGE: {
+      unsigned long from_char = (unsigned char) regular_expression->get_from_character();
+      unsigned long to_char = (unsigned char) regular_expression->get_to_character();
+      if (from_char > to_char) {
+        std::swap(from_char, to_char);
+      }
+      CharSet chars;
+      for (unsigned long c = from_char; c <= to_char; ++c) {
+        chars.set(c & (alphabet_size_ - 1));
+      }
+      return MakePosition(chars);
+    }
+    case Util::RegularExpression::Type::ANYCHAR: {
+      CharSet chars;
+      for (unsigned long c = 0; c < alphabet_size_; ++c) {
+        chars.set(c);
+      }
+      return MakePosition(chars);
+    }
+    case Util::RegularExpression::Type::EMPTY: {
+      Fragment fragment;
+      fragment.nullable = false;
+      return fragment;
+    }
+    case Util::RegularExpression::Type::STRING: {
+      Fragment result = MakeEpsilon();
+      for (auto ch : regular_expression->get_string()) {
+        CharSet chars;
+        chars.set((unsigned char) ch & (alphabet_size_ - 1));
+        Fragment char_fragment = MakePosition(chars);
+        result = MakeConcat(result, char_fragment);
+      }
+      return result;
+    }
+    case Util::RegularExpression::Type::ANYSTRING: {
+      CharSet chars;
+      for (unsigned long c = 0; c < alphabet_size_; ++c) {
+        chars.set(c);
+      }
+      Fragment fragment = MakePosition(chars);
+      return MakeStar(fragment);
+    }
+    default:
+      LOG(FATAL) << "Unsupported regular expression" << *regular_expression;
+      break;
+  }
+  return MakeEpsilon();
+}
+
+RegexCompiler::Fragment RegexCompiler::MakeEpsilon() {
+  Fragment fragment;
+  fragment.nullable = true;
+  return fragment;
+}
+
+RegexCompiler::Fragment RegexCompiler::MakePosition(const CharSet& chars) {
+  int position = position_chars_.size();
+  position_chars_.push_back(chars);
+  follow_.push_back(std::vector<int>());
+  Fragment fragment;
+  fragment.nullable = false;
+  fragment.first.push_back(position);
+  fragment.last.push_back(position);
+  return fragment;
+}
+
+RegexCompiler::Fragment RegexCompiler::MakeUnion(Fragment& left, Fragment& right) {
+  Fragment fragment;
+  fragment.nullable = left.nullable or right.nullable;
+  fragment.first = left.first;
+  fragment.first.insert(fragment.first.end(), right.first.begin(), right.first.end());
+  fragment.last = left.last;
+  fragment.last.insert(fragment.last.end(), right.last.begin(), right.last.end());
+  return fragment;
+}
+
+RegexCompiler::Fragment RegexCompiler::MakeConcat(Fragment& left, Fragment& right) {
+  AddFollow(left.last, right.first);
+  Fragment fragment;
+  fragment.nullable = left.nullable and right.nullable;
+  fragment.first = left.first;
+  if (left.nullable) {
+    fragment.first.insert(fragment.first.end(), right.first.begin(), right.first.end());
+  }
+  fragment.last = right.last;
+  if (right.nullable) {
+    fragment.last.insert(fragment.last.end(), left.last.begin(), left.last.end());
+  }
+  return fragment;
+}
+
+RegexCompiler::Fragment RegexCompiler::MakeStar(Fragment& fragment) {
+  Fragment result = MakePlus(fragment);
+  result.nullable = true;
+  return result;
+}
+
+RegexCompiler::Fragment RegexCompiler::MakePlus(Fragment& fragment) {
+  AddFollow(fragment.last, fragment.first);
+  return fragment;
+}
+
+RegexCompiler::Fragment RegexCompiler::MakeOptional(Fragment& fragment) {
+  Fragment result = fragment;
+  result.nullable = true;
+  return result;
+}
+
+/**
+ * r{min,} is linearized as r...r r* with min fresh copies of r
+ */
+RegexCompiler::Fragment RegexCompiler::MakeRepeat(Util::RegularExpression_ptr regular_expression, unsigned long min) {
+  Fragment result = MakeEpsilon();
+  for (unsigned long i = 0; i < min; ++i) {
+    Fragment copy = Linearize(regular_expression);
+    result = MakeConcat(result, copy);
+  }
+  Fragment copy = Linearize(regular_expression);
+  Fragment star = MakeStar(copy);
+  return MakeConcat(result, star);
+}
+
+/**
+ * r{min,max} is linearized as r...r (r(r(r)?)?)? with nested optionals,
+ * nesting keeps the follow relation linear in (max - min)
+ */
+RegexCompiler::Fragment RegexCompiler::MakeRepeat(Util::RegularExpression_ptr regular_expression, unsigned long min, unsigned long max) {
+  if (min > max) {
+    Fragment empty;
+    empty.nullable = false;
+    return empty;
+  }
+  Fragment result = MakeEpsilon();
+  for (unsigned long i = 0; i < min; ++i) {
+    Fragment copy = Linearize(regular_expression);
+    result = MakeConcat(result, copy);
+  }
+  Fragment optional_part = MakeEpsilon();
+  for (unsigned long i = min; i < max; ++i) {
+    Fragment copy = Linearize(regular_expression);
+    Fragment concat = MakeConcat(copy, optional_part);
+    optional_part = MakeOptional(concat);
+  }
+  return MakeConcat(result, optional_part);
+}
+
+void RegexCompiler::AddFollow(const std::vector<int>& from_positions, const std::vector<int>& to_positions) {
+  for (auto from : from_positions) {
+    auto& follow = follow_[from];
+    follow.insert(follow.end(), to_positions.begin(), to_positions.end());
+  }
+}
+
+/**
+ * Refines the alphabet with each distinct position character set,
+ * subset construction then works on classes instead of individual characters
+ */
+void RegexCompiler::ComputeCharClasses() {
+  std::vector<int> class_of (alphabet_size_, 0);
+  int number_of_classes = 1;
+  std::set<std::string> seen;
+  for (std::size_t p = 1; p < position_chars_.size(); ++p) {
+    auto& chars = position_chars_[p];
+    if (not seen.insert(chars.to_string()).second) {
+      continue;
+    }
+    std::map<std::pair<int, bool>, int> refined;
+    for (unsigned long c = 0; c < alphabet_size_; ++c) {
+      auto key = std::make_pair(class_of[c], (bool) chars.test(c));
+      auto it = refined.find(key);
+      if (it == refined.end()) {
+        it = refined.insert(std::make_pair(key, (int) refined.size())).first;
+      }
+      class_of[c] = it->second;
+    }
+    number_of_classes = refined.size();
+  }
+
+  char_classes_.assign(number_of_classes, CharSet());
+  char_class_representatives_.assign(number_of_classes, 0);
+  std::vector<bool> has_representative (number_of_classes, false);
+  for (unsigned long c = 0; c < alphabet_size_; ++c) {
+    char_classes_[class_of[c]].set(c);
+    if (not has_representative[class_of[c]]) {
+      char_class_representatives_[class_of[c]] = c;
+      has_representative[class_of[c]] = true;
+    }
+  }
+}
+
+DFA_ptr RegexCompiler::Determinize(int* indices) {
+  std::map<std::vector<int>, int> state_ids;
+  std::vector<std::vector<int>> states;
+  // transitions of each state, target state and the characters leading to it
+  std::vector<std::vector<std::pair<int, CharSet>>> transitions;
+
+  std::vector<int> initial_state {0};
+  state_ids[initial_state] = 0;
+  states.push_back(initial_state);
+
+  std::vector<int> stamp (position_chars_.size(), -1);
+  for (std::size_t s = 0; s < states.size(); ++s) {
+    std::vector<int> candidates;
+    for (auto position : states[s]) {
+      for (auto next_position : follow_[position]) {
+        if (stamp[next_position] != (int) s) {
+          stamp[next_position] = s;
+          candidates.push_back(next_position);
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    std::map<int, CharSet> targets;
+    for (std::size_t k = 0; k < char_classes_.size(); ++k) {
+      std::vector<int> next_state;
+      for (auto position : candidates) {
+        if (position_chars_[position].test(char_class_representatives_[k])) {
+          next_state.push_back(position);
+        }
+      }
+      auto it = state_ids.find(next_state);
+      int next_state_id;
+      if (it == state_ids.end()) {
+        next_state_id = states.size();
+        state_ids[next_state] = next_state_id;
+        states.push_back(next_state);
+      } else {
+        next_state_id = it->second;
+      }
+      targets[next_state_id] |= char_classes_[k];
+    }
+    transitions.push_back(std::vector<std::pair<int, CharSet>>(targets.begin(), targets.end()));
+  }
+
+  const int number_of_states = states.size();
+  std::string statuses (number_of_states, '-');
+  DFABuilder builder(number_of_states, number_of_bdd_variables_, indices);
+  for (int s = 0; s < number_of_states; ++s) {
+    bool is_accepting = false;
+    for (auto position : states[s]) {
+      if (is_last_[position]) {
+        is_accepting = true;
+        break;
+      }
+    }
+    statuses[s] = is_accepting ? '+' : '-';
+
+    // the target reached with most characters becomes the default transition
+    std::size_t default_index = 0;
+    for (std::size_t i = 1; i < transitions[s].size(); ++i) {
+      if (transitions[s][i].second.count() > transitions[s][default_index].second.count()) {
+        default_index = i;
+      }
+    }
+
+    std::vector<std::pair<int, std::string>> exceptions;
+    for (std::size_t i = 0; i < transitions[s].size(); ++i) {
+      if (i == default_index) {
+        continue;
+      }
+      for (auto& path : GetExceptions(transitions[s][i].second, number_of_bdd_variables_)) {
+        exceptions.push_back(std::make_pair(transitions[s][i].first, path));
+      }
+    }
+    builder.AllocExceptions(exceptions.size());
+    for (auto& exception : exceptions) {
+      builder.StoreException(exception.first, &exception.second[0]);
+    }
+    builder.StoreState(transitions[s][default_index].first);
+  }
+
+  DFA_ptr result_dfa = DFAMinimizeAndFree(builder.Build(&statuses[0]));
+  DVLOG(VLOG_LEVEL) << "regex compiler: " << number_of_states << " subset states, " << result_dfa->ns << " minimized states";
+  return result_dfa;
+}
+
+void RegexCompiler::GetExceptions(const CharSet& chars, const int number_of_bdd_variables, const int depth, const unsigned long prefix, std::string& path, std::vector<std::string>& exceptions) {
+  const int remaining_bits = number_of_bdd_variables - depth;
+  const unsigned long from = prefix << remaining_bits;
+  const unsigned long to = (prefix + 1) << remaining_bits;
+  unsigned long count = 0;
+  for (unsigned long c = from; c < to; ++c) {
+    if (chars.test(c)) {
+      ++count;
+    }
+  }
+
+  if (count == 0) {
+    return;
+  } else if (count == (to - from)) {
+    exceptions.push_back(path);
+    return;
+  }
+
+  path[depth] = '0';
+  GetExceptions(chars, number_of_bdd_variables, depth + 1, prefix << 1, path, exceptions);
+  path[depth] = '1';
+  GetExceptions(chars, number_of_bdd_variables, depth + 1, (prefix << 1) | 1, path, exceptions);
+  path[depth] = 'X';
+}
+
+DFA_ptr RegexCompiler::DFAMinimizeAndFree(DFA_ptr dfa) {
+  MonaLock lock;
+  DFA_ptr minimized_dfa = dfaMinimize(dfa);
+  dfaFree(dfa);
+  return minimized_dfa;
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,122 @@
+/*
+ * RegexCompiler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_REGEXCOMPILER_H_
+#define THEORY_REGEXCOMPILER_H_
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+#include <mona/dfa.h>
+
+#include "../utils/RegularExpression.h"
+#include "DFABuilder.h"
+
+namespace Vlab {
+namespace Theory {
+
+using DFA_ptr = DFA*;
+
+/**
+ * Compiles a regular expression into a single dfa without building intermediate automata.
+ * Uses Glushkov position automaton construction followed by one subset construction.
+ * Character classes are kept as sets of characters and stored into MONA as ternary (0/1/X)
+ * exceptions, so a class like [a-z] becomes a few bdd paths instead of one transition per character.
+ * Intersection, complement and named automata are not supported, callers are expected to check
+ * IsSupported() and fall back to automata operations for those expressions.
+ */
+class RegexCompiler {
+public:
+  using CharSet = std::bitset<256>;
+
+  RegexCompiler(const int number_of_bdd_variables);
+  virtual ~RegexCompiler();
+
+  /**
+   * Checks if the regular expression can be compiled directly
+   * @param regular_expression
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static bool IsSupported(Util::RegularExpression_ptr regular_expression, const int number_of_bdd_variables);
+
+  /**
+   * Generates a minimized dfa that accepts the language of the given regular expression
+   * @param regular_expression
+   * @param indices bdd variable indices
+   * @return
+   */
+  DFA_ptr Compile(Util::RegularExpression_ptr regular_expression, int* indices);
+
+  /**
+   * Generates ternary exceptions (MSB first) that covers exactly the given set of characters
+   * @param chars
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static std::vector<std::string> GetExceptions(const CharSet& chars, const int number_of_bdd_variables);
+
+protected:
+  /**
+   * Glushkov attributes of a sub expression
+   */
+  struct Fragment {
+    bool nullable;
+    std::vector<int> first;
+    std::vector<int> last;
+  };
+
+  Fragment Linearize(Util::RegularExpression_ptr regular_expression);
+  Fragment MakeEpsilon();
+  Fragment MakePosition(const CharSet& chars);
+  Fragment MakeUnion(Fragment& left, Fragment& right);
+  Fragment MakeConcat(Fragment& left, Fragment& right);
+  Fragment MakeStar(Fragment& fragment);
+  Fragment MakePlus(Fragment& fragment);
+  Fragment MakeOptional(Fragment& fragment);
+  Fragment MakeRepeat(Util::RegularExpression_ptr regular_expression, unsigned long min);
+  Fragment MakeRepeat(Util::RegularExpression_ptr regular_expression, unsigned long min, unsigned long max);
+  void AddFollow(const std::vector<int>& from_positions, const std::vector<int>& to_positions);
+  void ComputeCharClasses();
+  DFA_ptr Determinize(int* indices);
+
+  static void GetExceptions(const CharSet& chars, const int number_of_bdd_variables, const int depth, const unsigned long prefix, std::string& path, std::vector<std::string>& exceptions);
+  static DFA_ptr DFAMinimizeAndFree(DFA_ptr dfa);
+
+  const int number_of_bdd_variables_;
+  const unsigned long alphabet_size_;
+
+  /**
+   * Position 0 is the initial position, it does not consume any character
+   */
+  std::vector<CharSet> position_chars_;
+  std::vector<std::vector<int>> follow_;
+  std::vector<bool> is_last_;
+
+  /**
+   * Alphabet partition; characters in the same class are not distinguished by any position
+   */
+  std::vector<CharSet> char_classes_;
+  std::vector<unsigned long> char_class_representatives_;
+
+private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_REGEXCOMPILER_H_ */
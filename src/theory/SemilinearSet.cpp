@@ -13,6 +13,8 @@
 namespace Vlab {
 namespace Theory {
 
+const long SemilinearSet::MAX_SIZE = 4096;
+
 SemilinearSet::SemilinearSet() :
       C(0), R(0) {
 }
@@ -99,77 +101,160 @@ int SemilinearSet::get_number_of_periodic_constants() {
   return periodic_constants.size();
 }
 
-// TODO test and fix me
 SemilinearSet_ptr SemilinearSet::Merge(SemilinearSet_ptr other) {
-  SemilinearSet_ptr result = nullptr;
-  if (this->is_empty_set()) {
-    return other->clone();
-  } else if (other->is_empty_set()) {
+  return Union(other);
+}
+
+SemilinearSet_ptr SemilinearSet::Union(SemilinearSet_ptr other) {
+  const long cycle_head = std::max(this->get_periodic_head(), other->get_periodic_head());
+  const long period = GetCommonPeriod(R, other->R);
+  if (not IsInRange(cycle_head, period)) {
+    LOG(ERROR) << "union of semilinear sets is too large, over-approximating it with all numbers";
+    return MakeAllNumbers();
+  }
+  return MakeSemilinearSet(cycle_head, period, [this, other](int value) {
+    return this->has_value(value) or other->has_value(value);
+  });
+}
+
+SemilinearSet_ptr SemilinearSet::Intersect(SemilinearSet_ptr other) {
+  const long cycle_head = std::max(this->get_periodic_head(), other->get_periodic_head());
+  const long period = GetCommonPeriod(R, other->R);
+  if (not IsInRange(cycle_head, period)) {
+    LOG(ERROR) << "intersection of semilinear sets is too large, over-approximating it with one operand";
     return this->clone();
   }
+  return MakeSemilinearSet(cycle_head, period, [this, other](int value) {
+    return this->has_value(value) and other->has_value(value);
+  });
+}
 
-  result = new SemilinearSet();
+SemilinearSet_ptr SemilinearSet::Complement() {
+  if (not IsInRange(get_periodic_head(), std::max(R, 1))) {
+    LOG(ERROR) << "complement of semilinear set is too large, over-approximating it with all numbers";
+    return MakeAllNumbers();
+  }
+  return MakeSemilinearSet(get_periodic_head(), std::max(R, 1), [this](int value) {
+    return not this->has_value(value);
+  });
+}
 
-  result->constants = constants;
-  result->constants.insert(result->constants.end(), other->constants.begin(), other->constants.end());
-  Util::List::sort_and_remove_duplicate(result->constants);
-  int cycle_head = 0;
-  int p1 = this->R;
-  int p2 = other->R;
-  int lcm_value = Util::Math::lcm(p1, p2);
+/**
+ * Let P be the lcm of the periods and Ha, Hb the heads of the operands. For n >= Ha + Hb + P, n + P = a + b implies
+ * either a - P is in the first set or b - P is in the second one, hence the sum is periodic after Ha + Hb + P.
+ */
+SemilinearSet_ptr SemilinearSet::Plus(SemilinearSet_ptr other) {
+  if (this->is_empty_set() or other->is_empty_set()) {
+    return new SemilinearSet();
+  }
 
-  if (not result->constants.empty()) {
-    cycle_head = result->constants.back() + 1;
-    int max_head = std::max(this->get_cycle_head(), other->get_cycle_head());
-    if (max_head > lcm_value) {
-      cycle_head = std::max(cycle_head, max_head);
-    }
-  } else {
-    cycle_head = std::max(this->get_cycle_head(), other->get_cycle_head());
-    if (cycle_head < lcm_value) {
-      cycle_head = 0;
+  const long period = GetCommonPeriod(R, other->R);
+  const long cycle_head = static_cast<long>(this->get_periodic_head()) + other->get_periodic_head() + period;
+  if (not IsInRange(cycle_head, period)) {
+    LOG(ERROR) << "sum of semilinear sets is too large, over-approximating it with all numbers";
+    return MakeAllNumbers();
+  }
+  std::vector<int> left_values;
+  for (int value = 0; value < cycle_head + period; ++value) {
+    if (this->has_value(value)) {
+      left_values.push_back(value);
     }
   }
 
-  result->set_cycle_head(cycle_head);
-
-  int period;
-  if (p1 == 0) {
-    result->periodic_constants = other->periodic_constants;
-    result->R = p2;
-  } else if (p2 == 0) {
-    result->periodic_constants = this->periodic_constants;
-    result->R = this->R;
-  } else {
-    result->R = lcm_value;
-
-    auto compute_periods = [result](SemilinearSet_ptr other) {
-      int period = result->get_period();
-      int cycle_head = result->get_cycle_head();
-      int other_cycle_head = other->get_cycle_head();
-      int other_period = other->get_period();
-      for (auto p : other->get_periodic_constants()) {
-        int sum = 0;
-        while (sum < period) {
-          int value = (other_cycle_head + p + sum);
-          if (value >= cycle_head) {
-            result->add_periodic_constant(value - cycle_head);
-          } else {
-            result->add_constant(value);
-            result->add_periodic_constant(value - cycle_head + period);
-          }
-          sum += other_period;
-        }
+  return MakeSemilinearSet(cycle_head, period, [&left_values, other](int value) {
+    for (int left_value : left_values) {
+      if (left_value > value) {
+        break;
+      } else if (other->has_value(value - left_value)) {
+        return true;
       }
-    };
+    }
+    return false;
+  });
+}
+
+SemilinearSet_ptr SemilinearSet::Times(int value) {
+  CHECK_GE(value, 0) << "semilinear sets are defined over natural numbers";
+  if (this->is_empty_set()) {
+    return new SemilinearSet();
+  } else if (value == 0) {
+    auto zero_set = new SemilinearSet();
+    zero_set->add_constant(0);
+    return zero_set;
+  }
+
+  const long cycle_head = static_cast<long>(get_periodic_head()) * value;
+  const long period = static_cast<long>(std::max(R, 1)) * value;
+  if (not IsInRange(cycle_head, period)) {
+    LOG(ERROR) << "scaled semilinear set is too large, over-approximating it with all numbers";
+    return MakeAllNumbers();
+  }
+  return MakeSemilinearSet(cycle_head, period, [this, value](int n) {
+    return (n % value == 0) and this->has_value(n / value);
+  });
+}
+
+bool SemilinearSet::has_value(int value) {
+  if (std::find(constants.begin(), constants.end(), value) != constants.end()) {
+    return true;
+  }
+  if (R == 0) {
+    return false;
+  }
+  for (int r : periodic_constants) {
+    const int offset = value - C - r;
+    if (offset >= 0 and (offset % R) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
 
-    compute_periods(this);
-    compute_periods(other);
+SemilinearSet_ptr SemilinearSet::MakeSemilinearSet(int cycle_head, int period, std::function<bool(int)> is_member) {
+  std::vector<bool> is_periodic_member(period);
+  for (int r = 0; r < period; ++r) {
+    is_periodic_member[r] = is_member(cycle_head + r);
   }
 
-  Util::List::sort_and_remove_duplicate(result->periodic_constants);
+  // smallest period that repeats the pattern
+  for (int d = 1; d < period; ++d) {
+    if (period % d != 0) {
+      continue;
+    }
+    bool is_repeating = true;
+    for (int r = d; r < period and is_repeating; ++r) {
+      is_repeating = (is_periodic_member[r] == is_periodic_member[r - d]);
+    }
+    if (is_repeating) {
+      is_periodic_member.resize(d);
+      period = d;
+      break;
+    }
+  }
 
-  return result;
+  // move the cycle head back as long as the pattern continues
+  while (cycle_head > 0 and is_member(cycle_head - 1) == is_periodic_member[period - 1]) {
+    --cycle_head;
+    std::rotate(is_periodic_member.begin(), is_periodic_member.end() - 1, is_periodic_member.end());
+  }
+
+  auto semilinear_set = new SemilinearSet();
+  for (int value = 0; value < cycle_head; ++value) {
+    if (is_member(value)) {
+      semilinear_set->add_constant(value);
+    }
+  }
+  for (int r = 0; r < period; ++r) {
+    if (is_periodic_member[r]) {
+      semilinear_set->add_periodic_constant(r);
+    }
+  }
+  if (semilinear_set->get_number_of_periodic_constants() > 0) {
+    semilinear_set->set_cycle_head(cycle_head);
+    semilinear_set->set_period(period);
+  }
+
+  return semilinear_set;
 }
 
 bool SemilinearSet::is_empty_set() {
@@ -191,6 +276,33 @@ void SemilinearSet::clear() {
   periodic_constants.clear();
 }
 
+int SemilinearSet::get_periodic_head() {
+  int head = (R == 0) ? 0 : C;
+  for (int r : periodic_constants) {
+    head = std::max(head, C + r);
+  }
+  for (int c : constants) {
+    head = std::max(head, c + 1);
+  }
+  return head;
+}
+
+long SemilinearSet::GetCommonPeriod(int period, int other_period) {
+  const long left = std::max(period, 1), right = std::max(other_period, 1);
+  return left / Util::Math::gcd(left, right) * right;
+}
+
+bool SemilinearSet::IsInRange(long cycle_head, long period) {
+  return cycle_head >= 0 and period > 0 and cycle_head + period <= MAX_SIZE;
+}
+
+SemilinearSet_ptr SemilinearSet::MakeAllNumbers() {
+  auto semilinear_set = new SemilinearSet();
+  semilinear_set->add_periodic_constant(0);
+  semilinear_set->set_period(1);
+  return semilinear_set;
+}
+
 std::ostream& operator<<(std::ostream& os, const SemilinearSet& semilinear_set) {
   return os << semilinear_set.str();
 }
@@ -12,11 +12,15 @@
 #define THEORY_SEMILINEARSET_H_
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <glog/logging.h>
+
 #include "../utils/List.h"
 #include "../utils/Math.h"
 
@@ -48,6 +52,38 @@ public:
   int get_number_of_constants();
   int get_number_of_periodic_constants();
   SemilinearSet_ptr Merge(SemilinearSet_ptr other);
+
+  /**
+   * Set operations over natural numbers; they work on cycle heads and periods and never build automata.
+   * Results are normalized to the smallest period and cycle head.
+   */
+  SemilinearSet_ptr Union(SemilinearSet_ptr other);
+  SemilinearSet_ptr Intersect(SemilinearSet_ptr other);
+  SemilinearSet_ptr Complement();
+
+  /**
+   * Minkowski sum, {a + b : a in this, b in other}
+   * @param other
+   * @return
+   */
+  SemilinearSet_ptr Plus(SemilinearSet_ptr other);
+
+  /**
+   * Scaling, {value * a : a in this}
+   * @param value non-negative
+   * @return
+   */
+  SemilinearSet_ptr Times(int value);
+  bool has_value(int value);
+
+  /**
+   * Makes a normalized semilinear set of the numbers that satisfy is_member
+   * @param cycle_head membership has to be periodic after the cycle head
+   * @param period
+   * @param is_member
+   * @return
+   */
+  static SemilinearSet_ptr MakeSemilinearSet(int cycle_head, int period, std::function<bool(int)> is_member);
   bool is_empty_set();
   bool has_only_constants();
   bool has_constants();
@@ -55,6 +91,28 @@ public:
 
   friend std::ostream& operator<<(std::ostream& os, const SemilinearSet& semilinear_set);
 protected:
+  /**
+   * @return a value after which membership only depends on the value modulo period
+   */
+  int get_periodic_head();
+
+  /**
+   * Lcm of two periods, 0 is treated as 1
+   */
+  static long GetCommonPeriod(int period, int other_period);
+
+  /**
+   * Results are computed by testing membership of every value up to cycle head plus period, which takes time
+   * quadratic in that sum. Results with a larger sum are over-approximated instead.
+   */
+  static bool IsInRange(long cycle_head, long period);
+  static SemilinearSet_ptr MakeAllNumbers();
+
+  /**
+   * Largest cycle head plus period of a result that is computed exactly
+   */
+  static const long MAX_SIZE;
+
   int C;
   int R;
 
@@ -14,6 +14,14 @@ const int StringAutomaton::VLOG_LEVEL = 8;
 bool StringAutomaton::debug = false;
 
 StringAutomaton::TransitionTable StringAutomaton::TRANSITION_TABLE;
+std::mutex StringAutomaton::TRANSITION_TABLE_MUTEX;
+
+StringAutomaton::RegexCache StringAutomaton::REGEX_CACHE;
+bool StringAutomaton::REGEX_CACHE_IS_MODIFIED = false;
+std::mutex StringAutomaton::REGEX_CACHE_MUTEX;
+void* StringAutomaton::REGEX_CACHE_MAPPED_DATA = nullptr;
+std::size_t StringAutomaton::REGEX_CACHE_MAPPED_SIZE = 0;
+const std::string StringAutomaton::REGEX_CACHE_MAGIC = "ABCREGX1";
 
 StringAutomaton::StringAutomaton(const DFA_ptr dfa, const int number_of_bdd_variables)
 		:	Automaton(Automaton::Type::MULTITRACK, dfa, number_of_bdd_variables),
@@ -34,9 +42,7 @@ StringAutomaton::StringAutomaton(const DFA_ptr dfa, const int i_track, const int
 			num_tracks_(number_of_tracks),
 			formula_(new StringFormula()) {
 	DFA_ptr M = dfa, temp = nullptr, result = nullptr;
-	trace_descr tp;
-	paths state_paths, pp;
-	std::vector<std::pair<std::vector<char>,int>> state_exeps;
+	std::vector<std::pair<std::string,int>> state_exeps;
 	int sink;
 	char* statuses;
 	int* mindices;
@@ -46,7 +52,17 @@ StringAutomaton::StringAutomaton(const DFA_ptr dfa, const int i_track, const int
 	int var = VAR_PER_TRACK;
 	int len = (num_tracks_ * var)+1; // extrabit for nondeterminism
 	mindices = GetBddVariableIndices(len);
-	int *indices = GetBddVariableIndices(in_num_vars);
+	// bdd variable j of the input dfa is placed on variable j of the i_track
+	std::vector<int> track_positions(in_num_vars);
+	for(int j = 0; j < in_num_vars; j++) {
+		track_positions[j] = i_track+num_tracks_*j;
+	}
+	TernaryException curr_exep(len);
+	// if default_num_Var, make default_num_var+1 index '0' for non-lambda
+	if(in_num_vars == DEFAULT_NUM_OF_VARIABLES) {
+		curr_exep.SetBit(i_track+num_tracks_*(DEFAULT_NUM_OF_VARIABLES), false);
+	}
+	curr_exep.SetBit(len-1, false); // old transition, end with '0'
 	sink = find_sink(M);
 	if(sink < 0) {
 		has_sink = false;
@@ -58,79 +74,57 @@ StringAutomaton::StringAutomaton(const DFA_ptr dfa, const int i_track, const int
 	// old transitions end in '0'
 	// new transitions end in '1' (lambda transitions)
 
-	dfaSetup(num_states, len, mindices);
+	DFABuilder builder(num_states, len, mindices);
 	for(unsigned i = 0; i < M->ns; i++) {
-		state_paths = pp = make_paths(M->bddm, M->q[i]);
-
 		// if state is final, add lambda transition to lambda state
 		if(M->f[i] == 1) {
-			std::vector<char> curr(len,'X');
+			std::string curr(len,'X');
 			for(int k = 0; k < var; k++) {
 				curr[i_track+num_tracks_*k] = '1';
 			}
 			curr[len-1] = '1'; // new transition, end with '1'
-			curr.push_back('\0');
 			state_exeps.push_back(std::make_pair(curr,lambda_state));
 		}
 
-		while(pp) {
-			if(pp->to != sink) {
-				std::vector<char> curr(len,'X');
-				for(unsigned j = 0; j < in_num_vars; j++) {
-					for(tp = pp->trace; tp && (tp->index != indices[j]); tp = tp->next);
-					if(tp) {
-						if(tp->value) curr[i_track+num_tracks_*j] = '1';
-						else curr[i_track+num_tracks_*j] = '0';
-					}
-					else
-						curr[i_track+num_tracks_*j] = 'X';
-				}
-				// if default_num_Var, make default_num_var+1 index '0' for non-lambda
-				if(in_num_vars == DEFAULT_NUM_OF_VARIABLES) {
-					curr[i_track+num_tracks_*(DEFAULT_NUM_OF_VARIABLES)] = '0';
-				}
-				curr[len-1] = '0'; // old transition, end with '0'
-				curr.push_back('\0');
-				state_exeps.push_back(std::make_pair(curr,pp->to));
+		DFAForEachPath(M, i, curr_exep, [&](const int to, const TernaryException& exception) {
+			if(to != sink) {
+				state_exeps.push_back(std::make_pair(exception.ToString(),to));
 			}
-			pp = pp->next;
-		}
-		kill_paths(state_paths);
+		}, &track_positions[0]);
 
-		dfaAllocExceptions(state_exeps.size());
+		builder.AllocExceptions(state_exeps.size());
 		for(unsigned k = 0; k < state_exeps.size(); ++k) {
-			dfaStoreException(state_exeps[k].second,&state_exeps[k].first[0]);
+			builder.StoreException(state_exeps[k].second,&state_exeps[k].first[0]);
 		}
-		dfaStoreState(sink);
+		builder.StoreState(sink);
 		state_exeps.clear();
 
 		statuses[i] = '-';
 	}
 	// lambda state, loop de loop
-	dfaAllocExceptions(1);
+	builder.AllocExceptions(1);
 	std::vector<char> str(len,'X');
 	for(int i = 0; i < var; i++) {
 		str[i_track+num_tracks_*i] = '1';
 	}
 	str[len-1] = '1';
 	str.push_back('\0');
-	dfaStoreException(lambda_state,&str[0]);
-	dfaStoreState(sink);
+	builder.StoreException(lambda_state,&str[0]);
+	builder.StoreState(sink);
 	statuses[lambda_state] = '+';
 	// extra sink state, if needed
 	if(!has_sink) {
-		dfaAllocExceptions(0);
-		dfaStoreState(sink);
+		builder.AllocExceptions(0);
+		builder.StoreState(sink);
 		statuses[sink] = '-';
 	}
 	statuses[num_states] = '\0';
-	result = dfaBuild(statuses);
-	temp = dfaMinimize(result);
-	dfaFree(result);
+	result = builder.Build(statuses);
+	temp = DFAMinimizeIntermediate(result);
 	// project away the extra bit
-	result = dfaProject(temp,len-1);
+	result = DFAProject(temp,len-1);
 	dfaFree(temp);
-	temp = dfaMinimize(result);
+	temp = DFAMinimize(result);
 	dfaFree(result);
 	result = temp;
 
@@ -162,10 +156,16 @@ StringAutomaton::StringAutomaton(const StringAutomaton& other)
 	if(other.formula_ != nullptr) {
 		this->formula_ = other.formula_->clone();
 	}
+	if(other.length_dfa_ != nullptr) {
+		this->length_dfa_ = DFACopy(other.length_dfa_);
+	}
 }
 
 StringAutomaton::~StringAutomaton() {
 	delete formula_;
+	if(length_dfa_ != nullptr) {
+		dfaFree(length_dfa_);
+	}
 }
 
 StringAutomaton_ptr StringAutomaton::clone() const {
@@ -213,26 +213,26 @@ StringAutomaton_ptr StringAutomaton::MakeString(const std::string str, const int
   const int number_of_states = str_length + 2;
   char* statuses = new char[number_of_states];
 
-  dfaSetup(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  DFABuilder builder(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
 
   for (int i = 0; i < str_length; i++) {
-    dfaAllocExceptions(1);
-    dfaStoreException(i + 1, const_cast<char*>(GetBinaryStringMSB((unsigned long) str[i], number_of_bdd_variables).data()));
-    dfaStoreState(str_length + 1);
+    builder.AllocExceptions(1);
+    builder.StoreException(i + 1, const_cast<char*>(GetBinaryStringMSB((unsigned long) str[i], number_of_bdd_variables).data()));
+    builder.StoreState(str_length + 1);
     statuses[i] = '-';
   }
 
-  dfaAllocExceptions(0);
-  dfaStoreState(str_length + 1);
+  builder.AllocExceptions(0);
+  builder.StoreState(str_length + 1);
   statuses[str_length] = '+';
 
   //sink state
-  dfaAllocExceptions(0);
-  dfaStoreState(str_length + 1);
+  builder.AllocExceptions(0);
+  builder.StoreState(str_length + 1);
   statuses[str_length + 1] = '-';
 
-  DFA_ptr temp_dfa = dfaBuild(statuses);
-  DFA_ptr result_dfa = dfaMinimize(temp_dfa);
+  DFA_ptr temp_dfa = builder.Build(statuses);
+  DFA_ptr result_dfa = DFAMinimize(temp_dfa);
   dfaFree(temp_dfa);
   StringAutomaton_ptr result_auto = new StringAutomaton(result_dfa, number_of_bdd_variables);
   delete[] statuses;
@@ -245,10 +245,10 @@ StringAutomaton_ptr StringAutomaton::MakeString(const std::string str, const int
 StringAutomaton_ptr StringAutomaton::MakeAnyString(const int number_of_bdd_variables) {
   //char statuses[2] { '+', '\0' };
   int *variable_indices = GetBddVariableIndices(number_of_bdd_variables);
-  dfaSetup(1, number_of_bdd_variables, variable_indices);
-  dfaAllocExceptions(0);
-  dfaStoreState(0);
-  DFA_ptr any_string_dfa = dfaBuild("+");
+  DFABuilder builder(1, number_of_bdd_variables, variable_indices);
+  builder.AllocExceptions(0);
+  builder.StoreState(0);
+  DFA_ptr any_string_dfa = builder.Build("+");
   StringAutomaton_ptr any_string = new StringAutomaton(any_string_dfa, number_of_bdd_variables);
   DVLOG(VLOG_LEVEL) << any_string->id_ << " = MakeAnyString()";
   return any_string;
@@ -272,27 +272,27 @@ StringAutomaton_ptr StringAutomaton::MakeCharRange(const char from, const char t
   char statuses[3] { '-', '+', '-' };
   int* variable_indices = GetBddVariableIndices(number_of_bdd_variables);
 
-  dfaSetup(3, number_of_bdd_variables, variable_indices);
+  DFABuilder builder(3, number_of_bdd_variables, variable_indices);
 
   int initial_state = to_char - from_char;
 
   //state 0
-  dfaAllocExceptions(initial_state + 1);
+  builder.AllocExceptions(initial_state + 1);
   for (unsigned long index = from_char; index <= to_char; index++) {
     std::vector<char> v = GetBinaryFormat(index,number_of_bdd_variables);
-    dfaStoreException(1, const_cast<char*>(GetBinaryStringMSB(index, number_of_bdd_variables).data()));
+    builder.StoreException(1, const_cast<char*>(GetBinaryStringMSB(index, number_of_bdd_variables).data()));
   }
-  dfaStoreState(2);
+  builder.StoreState(2);
 
   //state 1
-  dfaAllocExceptions(0);
-  dfaStoreState(2);
+  builder.AllocExceptions(0);
+  builder.StoreState(2);
 
   //state 2
-  dfaAllocExceptions(0);
-  dfaStoreState(2);
+  builder.AllocExceptions(0);
+  builder.StoreState(2);
 
-  DFA_ptr range_dfa = dfaBuild(statuses);
+  DFA_ptr range_dfa = builder.Build(statuses);
   StringAutomaton_ptr range_auto = new StringAutomaton(range_dfa, number_of_bdd_variables);
 
   DVLOG(VLOG_LEVEL) << range_auto->id_ << " = MakeCharRange('" << from << "', '" << to << "')";
@@ -307,8 +307,35 @@ StringAutomaton_ptr StringAutomaton::MakeAnyChar(const int number_of_bdd_variabl
 }
 
 StringAutomaton_ptr StringAutomaton::MakeRegexAuto(const std::string regex, const int number_of_bdd_variables) {
+  const std::string cache_key = GetRegexCacheKey(regex, number_of_bdd_variables);
+  {
+    std::lock_guard<std::mutex> lock(REGEX_CACHE_MUTEX);
+    auto it = REGEX_CACHE.find(cache_key);
+    if (it != REGEX_CACHE.end()) {
+      if (it->second.dfa == nullptr) {
+        it->second.dfa = Automaton::DFAImportBinary(it->second.data, it->second.size, number_of_bdd_variables);
+      }
+      if (it->second.dfa != nullptr) {
+        StringAutomaton_ptr regex_auto = new StringAutomaton(DFACopy(it->second.dfa), number_of_bdd_variables);
+        DVLOG(VLOG_LEVEL) << regex_auto->id_ << " = MakeRegexAuto(" << regex << ") (cached)";
+        return regex_auto;
+      }
+      LOG(WARNING) << "malformed regex cache entry, recompiling: " << regex;
+      REGEX_CACHE.erase(it);
+    }
+  }
+
+  // compiled without holding the cache lock, another thread may add the same regex meanwhile
   Util::RegularExpression regular_expression (regex);
   StringAutomaton_ptr regex_auto = StringAutomaton::MakeRegexAuto(&regular_expression, number_of_bdd_variables);
+  {
+    std::lock_guard<std::mutex> lock(REGEX_CACHE_MUTEX);
+    auto result = REGEX_CACHE.insert(std::make_pair(cache_key, RegexCacheEntry {nullptr, nullptr, 0}));
+    if (result.second) {
+      result.first->second.dfa = DFACopy(regex_auto->dfa_);
+      REGEX_CACHE_IS_MODIFIED = true;
+    }
+  }
   DVLOG(VLOG_LEVEL) << regex_auto->id_ << " = MakeRegexAuto(" << regex << ")";
 
   return regex_auto;
@@ -319,6 +346,15 @@ StringAutomaton_ptr StringAutomaton::MakeRegexAuto(Util::RegularExpression_ptr r
   StringAutomaton_ptr regex_expr1_auto = nullptr;
   StringAutomaton_ptr regex_expr2_auto = nullptr;
 
+  // compile directly into a single dfa when possible, automata operations below are used
+  // only for the parts of the expression that the compiler does not support (intersection, complement)
+  if (RegexCompiler::IsSupported(regular_expression, number_of_bdd_variables)) {
+    RegexCompiler regex_compiler (number_of_bdd_variables);
+    DFA_ptr regex_dfa = regex_compiler.Compile(regular_expression, GetBddVariableIndices(number_of_bdd_variables));
+    regex_auto = new StringAutomaton(regex_dfa, number_of_bdd_variables);
+    return regex_auto;
+  }
+
   switch (regular_expression->type()) {
   case Util::RegularExpression::Type::UNION:
     regex_expr1_auto = StringAutomaton::MakeRegexAuto(regular_expression->get_expr1(), number_of_bdd_variables);
@@ -403,6 +439,276 @@ StringAutomaton_ptr StringAutomaton::MakeRegexAuto(Util::RegularExpression_ptr r
   return regex_auto;
 }
 
+/**
+ * File layout: magic, followed by entries of
+ * [key length (uint32)][key][dfa size (uint32)][dfa in Automaton::DFAExportBinary format]
+ */
+bool StringAutomaton::LoadRegexCache(const std::string file_name) {
+  std::lock_guard<std::mutex> lock(REGEX_CACHE_MUTEX);
+  // entries compiled in this process are kept, entries from a previously mapped file are dropped
+  for (auto it = REGEX_CACHE.begin(); it != REGEX_CACHE.end(); ) {
+    if (it->second.dfa == nullptr) {
+      it = REGEX_CACHE.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (REGEX_CACHE_MAPPED_DATA != nullptr) {
+    munmap(REGEX_CACHE_MAPPED_DATA, REGEX_CACHE_MAPPED_SIZE);
+    REGEX_CACHE_MAPPED_DATA = nullptr;
+    REGEX_CACHE_MAPPED_SIZE = 0;
+  }
+
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    DVLOG(VLOG_LEVEL) << "regex cache file does not exist: " << file_name;
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 or (std::size_t) file_stat.st_size < REGEX_CACHE_MAGIC.size()) {
+    close(fd);
+    LOG(WARNING) << "cannot read regex cache file: " << file_name;
+    return false;
+  }
+  const std::size_t size = file_stat.st_size;
+  void* mapped_data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped_data == MAP_FAILED) {
+    LOG(WARNING) << "cannot map regex cache file: " << file_name;
+    return false;
+  }
+
+  const char* data = static_cast<const char*>(mapped_data);
+  if (REGEX_CACHE_MAGIC.compare(0, REGEX_CACHE_MAGIC.size(), data, REGEX_CACHE_MAGIC.size()) != 0) {
+    munmap(mapped_data, size);
+    LOG(WARNING) << "not a regex cache file: " << file_name;
+    return false;
+  }
+
+  REGEX_CACHE_MAPPED_DATA = mapped_data;
+  REGEX_CACHE_MAPPED_SIZE = size;
+  std::size_t position = REGEX_CACHE_MAGIC.size();
+  uint32_t key_size = 0, dfa_size = 0;
+  while (position + sizeof(key_size) <= size) {
+    std::memcpy(&key_size, data + position, sizeof(key_size));
+    position += sizeof(key_size);
+    if (position + key_size + sizeof(dfa_size) > size) {
+      break;
+    }
+    std::string key (data + position, key_size);
+    position += key_size;
+    std::memcpy(&dfa_size, data + position, sizeof(dfa_size));
+    position += sizeof(dfa_size);
+    if (position + dfa_size > size) {
+      break;
+    }
+    REGEX_CACHE.insert(std::make_pair(key, RegexCacheEntry {nullptr, data + position, dfa_size}));
+    position += dfa_size;
+  }
+  if (position != size) {
+    LOG(WARNING) << "regex cache file is truncated: " << file_name;
+  }
+
+  DVLOG(VLOG_LEVEL) << "loaded " << REGEX_CACHE.size() << " regex cache entries from " << file_name;
+  return true;
+}
+
+bool StringAutomaton::SaveRegexCache(const std::string file_name) {
+  std::lock_guard<std::mutex> lock(REGEX_CACHE_MUTEX);
+  if (not REGEX_CACHE_IS_MODIFIED) {
+    return true;
+  }
+
+  // write into a temporary file first, current file may still be mapped
+  const std::string tmp_file_name = file_name + ".tmp";
+  std::ofstream outfile(tmp_file_name.c_str(), std::ios::binary);
+  if (!outfile.good()) {
+    LOG(ERROR) << "cannot open file: " << tmp_file_name;
+    return false;
+  }
+  outfile.write(REGEX_CACHE_MAGIC.data(), REGEX_CACHE_MAGIC.size());
+
+  std::stringstream dfa_data;
+  for (auto& entry : REGEX_CACHE) {
+    uint32_t key_size = entry.first.size();
+    outfile.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+    outfile.write(entry.first.data(), key_size);
+    if (entry.second.dfa == nullptr) {
+      uint32_t dfa_size = entry.second.size;
+      outfile.write(reinterpret_cast<const char*>(&dfa_size), sizeof(dfa_size));
+      outfile.write(entry.second.data, dfa_size);
+    } else {
+      const int number_of_bdd_variables = std::stoi(entry.first.substr(entry.first.find(':') + 1));
+      dfa_data.str("");
+      Automaton::DFAExportBinary(entry.second.dfa, number_of_bdd_variables, dfa_data);
+      const std::string dfa_bytes = dfa_data.str();
+      uint32_t dfa_size = dfa_bytes.size();
+      outfile.write(reinterpret_cast<const char*>(&dfa_size), sizeof(dfa_size));
+      outfile.write(dfa_bytes.data(), dfa_size);
+    }
+  }
+  outfile.close();
+
+  if (std::rename(tmp_file_name.c_str(), file_name.c_str()) != 0) {
+    LOG(ERROR) << "cannot write regex cache file: " << file_name;
+    return false;
+  }
+  REGEX_CACHE_IS_MODIFIED = false;
+  DVLOG(VLOG_LEVEL) << "saved " << REGEX_CACHE.size() << " regex cache entries into " << file_name;
+  return true;
+}
+
+void StringAutomaton::ClearRegexCache() {
+  std::lock_guard<std::mutex> lock(REGEX_CACHE_MUTEX);
+  for (auto& entry : REGEX_CACHE) {
+    if (entry.second.dfa != nullptr) {
+      dfaFree(entry.second.dfa);
+    }
+  }
+  REGEX_CACHE.clear();
+  if (REGEX_CACHE_MAPPED_DATA != nullptr) {
+    munmap(REGEX_CACHE_MAPPED_DATA, REGEX_CACHE_MAPPED_SIZE);
+    REGEX_CACHE_MAPPED_DATA = nullptr;
+    REGEX_CACHE_MAPPED_SIZE = 0;
+  }
+  REGEX_CACHE_IS_MODIFIED = false;
+}
+
+std::string StringAutomaton::GetRegexCacheKey(const std::string regex_string, const int number_of_bdd_variables) {
+  std::stringstream key;
+  key << Util::RegularExpression::DEFAULT << ":" << number_of_bdd_variables << ":" << regex_string;
+  return key.str();
+}
+
+StringAutomaton_ptr StringAutomaton::MakeContainsAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables) {
+  std::vector<std::vector<int>> matched_patterns;
+  auto transitions = MakeAhoCorasickTable(patterns, number_of_bdd_variables, matched_patterns);
+  std::string statuses (transitions.size(), '-');
+  for (std::size_t s = 0; s < transitions.size(); ++s) {
+    if (not matched_patterns[s].empty()) {
+      statuses[s] = '+';
+      std::fill(transitions[s].begin(), transitions[s].end(), s);
+    }
+  }
+  StringAutomaton_ptr contains_auto = new StringAutomaton(MakeDfaFromTable(transitions, statuses, number_of_bdd_variables), number_of_bdd_variables);
+  DVLOG(VLOG_LEVEL) << contains_auto->id_ << " = MakeContainsAnyOf(" << patterns.size() << " patterns)";
+  return contains_auto;
+}
+
+StringAutomaton_ptr StringAutomaton::MakeContainsAllOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables) {
+  CHECK_LE(patterns.size(), 64);
+  std::vector<std::vector<int>> matched_patterns;
+  auto table = MakeAhoCorasickTable(patterns, number_of_bdd_variables, matched_patterns);
+  std::vector<unsigned long> matched_masks (table.size(), 0);
+  for (std::size_t s = 0; s < table.size(); ++s) {
+    for (auto p : matched_patterns[s]) {
+      matched_masks[s] |= (1UL << p);
+    }
+  }
+  const unsigned long all_matched = (patterns.size() == 64) ? ~0UL : ((1UL << patterns.size()) - 1);
+
+  // pairs of aho-corasick state and seen patterns, once all seen the accepting state loops
+  std::map<std::pair<int, unsigned long>, int> state_ids;
+  std::vector<std::pair<int, unsigned long>> states;
+  std::vector<std::vector<int>> transitions;
+  auto get_state = [&](const int node, unsigned long mask) {
+    mask |= matched_masks[node];
+    auto key = (mask == all_matched) ? std::make_pair(-1, mask) : std::make_pair(node, mask);
+    auto it = state_ids.find(key);
+    if (it != state_ids.end()) {
+      return it->second;
+    }
+    int id = states.size();
+    state_ids[key] = id;
+    states.push_back(key);
+    return id;
+  };
+
+  get_state(0, 0);
+  for (std::size_t s = 0; s < states.size(); ++s) {
+    const int node = states[s].first;
+    const unsigned long mask = states[s].second;
+    std::vector<int> next_states (table[0].size(), s);
+    if (node != -1) {
+      for (std::size_t c = 0; c < next_states.size(); ++c) {
+        next_states[c] = get_state(table[node][c], mask);
+      }
+    }
+    transitions.push_back(next_states);
+  }
+
+  std::string statuses (states.size(), '-');
+  for (std::size_t s = 0; s < states.size(); ++s) {
+    if (states[s].second == all_matched) {
+      statuses[s] = '+';
+    }
+  }
+  StringAutomaton_ptr contains_auto = new StringAutomaton(MakeDfaFromTable(transitions, statuses, number_of_bdd_variables), number_of_bdd_variables);
+  DVLOG(VLOG_LEVEL) << contains_auto->id_ << " = MakeContainsAllOf(" << patterns.size() << " patterns)";
+  return contains_auto;
+}
+
+StringAutomaton_ptr StringAutomaton::MakeNotContainsAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables) {
+  std::vector<std::vector<int>> matched_patterns;
+  auto transitions = MakeAhoCorasickTable(patterns, number_of_bdd_variables, matched_patterns);
+  std::string statuses (transitions.size(), '+');
+  for (std::size_t s = 0; s < transitions.size(); ++s) {
+    if (not matched_patterns[s].empty()) {
+      statuses[s] = '-';
+      std::fill(transitions[s].begin(), transitions[s].end(), s);
+    }
+  }
+  StringAutomaton_ptr not_contains_auto = new StringAutomaton(MakeDfaFromTable(transitions, statuses, number_of_bdd_variables), number_of_bdd_variables);
+  DVLOG(VLOG_LEVEL) << not_contains_auto->id_ << " = MakeNotContainsAnyOf(" << patterns.size() << " patterns)";
+  return not_contains_auto;
+}
+
+StringAutomaton_ptr StringAutomaton::MakeBeginsWithAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables) {
+  const unsigned long alphabet_size = 1UL << number_of_bdd_variables;
+  // pattern trie, state 0 is the root, state 1 is the sink
+  std::vector<std::vector<int>> transitions (2, std::vector<int>(alphabet_size, 1));
+  std::vector<bool> is_pattern_end (2, false);
+  for (auto& pattern : patterns) {
+    int state = 0;
+    for (auto ch : pattern) {
+      unsigned long c = (unsigned char) ch;
+      CHECK_LT(c, alphabet_size);
+      if (transitions[state][c] == 1) {
+        transitions[state][c] = transitions.size();
+        transitions.push_back(std::vector<int>(alphabet_size, 1));
+        is_pattern_end.push_back(false);
+      }
+      state = transitions[state][c];
+    }
+    is_pattern_end[state] = true;
+  }
+
+  std::string statuses (transitions.size(), '-');
+  for (std::size_t s = 0; s < transitions.size(); ++s) {
+    if (is_pattern_end[s]) {
+      statuses[s] = '+';
+      std::fill(transitions[s].begin(), transitions[s].end(), s);
+    }
+  }
+  StringAutomaton_ptr begins_auto = new StringAutomaton(MakeDfaFromTable(transitions, statuses, number_of_bdd_variables), number_of_bdd_variables);
+  DVLOG(VLOG_LEVEL) << begins_auto->id_ << " = MakeBeginsWithAnyOf(" << patterns.size() << " patterns)";
+  return begins_auto;
+}
+
+StringAutomaton_ptr StringAutomaton::MakeEndsWithAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables) {
+  std::vector<std::vector<int>> matched_patterns;
+  auto transitions = MakeAhoCorasickTable(patterns, number_of_bdd_variables, matched_patterns);
+  std::string statuses (transitions.size(), '-');
+  for (std::size_t s = 0; s < transitions.size(); ++s) {
+    if (not matched_patterns[s].empty()) {
+      statuses[s] = '+';
+    }
+  }
+  StringAutomaton_ptr ends_auto = new StringAutomaton(MakeDfaFromTable(transitions, statuses, number_of_bdd_variables), number_of_bdd_variables);
+  DVLOG(VLOG_LEVEL) << ends_auto->id_ << " = MakeEndsWithAnyOf(" << patterns.size() << " patterns)";
+  return ends_auto;
+}
+
 StringAutomaton_ptr StringAutomaton::MakeAnyStringLengthEqualTo(const int length, const int number_of_bdd_variables) {
   DFA_ptr length_dfa = Automaton::DFAMakeAcceptingAnyWithInRange(length, length, number_of_bdd_variables);
   StringAutomaton_ptr length_auto = new StringAutomaton(length_dfa, number_of_bdd_variables);
@@ -511,8 +817,8 @@ StringAutomaton_ptr StringAutomaton::MakeBegins(StringFormula_ptr formula) {
 
 	std::vector<char> exep_lambda(var,'1');
 	tv = GenerateTransitionsForRelation(StringFormula::Type::EQ,var);
-	dfaSetup(4,len,mindices);
-	dfaAllocExceptions(2*tv.size() + 1); // 1 extra for lambda stuff below
+	DFABuilder builder(4,len,mindices);
+	builder.AllocExceptions(2*tv.size() + 1); // 1 extra for lambda stuff below
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for(int k = 0; k < var; k++) {
@@ -520,7 +826,7 @@ StringAutomaton_ptr StringAutomaton::MakeBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = tv[i].second[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(0,&str[0]);
+		builder.StoreException(0,&str[0]);
 	}
 
 	// if right is lambda, left can be anything, but go to next state
@@ -531,7 +837,7 @@ StringAutomaton_ptr StringAutomaton::MakeBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = exep_lambda[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(1,&str[0]);
+		builder.StoreException(1,&str[0]);
 	}
 
 	// if both are lambda, go to next state
@@ -542,11 +848,11 @@ StringAutomaton_ptr StringAutomaton::MakeBegins(StringFormula_ptr formula) {
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
 	str.push_back('\0');
-	dfaStoreException(2,&str[0]);
-	dfaStoreState(3);
+	builder.StoreException(2,&str[0]);
+	builder.StoreState(3);
 
 	// left anything, right lambda, loop back here
-	dfaAllocExceptions(tv.size()+1);
+	builder.AllocExceptions(tv.size()+1);
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for (int k = 0; k < var; k++) {
@@ -554,7 +860,7 @@ StringAutomaton_ptr StringAutomaton::MakeBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = exep_lambda[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(1,&str[0]);
+		builder.StoreException(1,&str[0]);
 	}
 	// if both lambda, goto 2
 	str = std::vector<char>(len,'X');
@@ -563,20 +869,20 @@ StringAutomaton_ptr StringAutomaton::MakeBegins(StringFormula_ptr formula) {
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
 	str.push_back('\0');
-	dfaStoreException(2,&str[0]);
-	dfaStoreState(3);
+	builder.StoreException(2,&str[0]);
+	builder.StoreState(3);
 
 	// lambda/lambda state, loop back on lambda
-	dfaAllocExceptions(1);
-	dfaStoreException(2,&str[0]);
-	dfaStoreState(3);
+	builder.AllocExceptions(1);
+	builder.StoreException(2,&str[0]);
+	builder.StoreState(3);
 
 	// sink
-	dfaAllocExceptions(0);
-	dfaStoreState(3);
+	builder.AllocExceptions(0);
+	builder.StoreState(3);
 
-	temp_dfa = dfaBuild("--+-");
-	result_dfa = dfaMinimize(temp_dfa);
+	temp_dfa = builder.Build("--+-");
+	result_dfa = DFAMinimize(temp_dfa);
 	dfaFree(temp_dfa);
 	result_auto = new StringAutomaton(result_dfa,formula,var*num_tracks);
 	DVLOG(VLOG_LEVEL) << result_auto->id_ << " = MakeBegins(" << formula->str() << ")";
@@ -602,10 +908,10 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 	std::vector<char> exep_lambda(var,'1');
 	tv = GenerateTransitionsForRelation(StringFormula::Type::EQ,var);
 
-	dfaSetup(6,len,mindices);
+	DFABuilder builder(6,len,mindices);
 	// ------init/eq_eq state
 	// if both the same, and not lambda, loop back
-	dfaAllocExceptions(3*tv.size() + 1); // 1 extra for lambda stuff below
+	builder.AllocExceptions(3*tv.size() + 1); // 1 extra for lambda stuff below
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for(int k = 0; k < var; k++) {
@@ -613,7 +919,7 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = tv[i].second[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(eq_eq,&str[0]);
+		builder.StoreException(eq_eq,&str[0]);
 	}
 
 	// if left is lambda, right can be anything, but go to lambda_star
@@ -625,13 +931,13 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = tv[i].first[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(lambda_star,&str[0]);
+		builder.StoreException(lambda_star,&str[0]);
 
 		for (int k = 0; k < var; k++) {
 			str[left_track+num_tracks*k] = tv[i].first[k];
 			str[right_track+num_tracks*k] = exep_lambda[k];
 		}
-		dfaStoreException(sink,&str[0]);
+		builder.StoreException(sink,&str[0]);
 	}
 
 	// if both are lambda, go to sink
@@ -642,14 +948,14 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
 	str.push_back('\0');
-	dfaStoreException(sink,&str[0]);
+	builder.StoreException(sink,&str[0]);
 	// otherwise, go to not_eq_eq
-	dfaStoreState(not_eq_eq);
+	builder.StoreState(not_eq_eq);
 
 
 	// ------ lambda_star state
 	// left lambda, right star, loop back here
-	dfaAllocExceptions(tv.size() + 1);
+	builder.AllocExceptions(tv.size() + 1);
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for (int k = 0; k < var; k++) {
@@ -657,7 +963,7 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = tv[i].first[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(lambda_star,&str[0]);
+		builder.StoreException(lambda_star,&str[0]);
 	}
 	// if both lambda, goto lambda_lambda
 	str = std::vector<char>(len,'X');
@@ -666,9 +972,9 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
 	str.push_back('\0');
-	dfaStoreException(lambda_lambda,&str[0]);
+	builder.StoreException(lambda_lambda,&str[0]);
 	// otherwise, goto sink
-	dfaStoreState(sink);
+	builder.StoreState(sink);
 
 
 
@@ -677,7 +983,7 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 	// star_lambda goto star_lambda,
 	// lambda_lambda goto lambda,
 	// else loop back
-	dfaAllocExceptions(tv.size()*2 + 1);
+	builder.AllocExceptions(tv.size()*2 + 1);
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for (int k = 0; k < var; k++) {
@@ -685,13 +991,13 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = tv[i].first[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(lambda_star,&str[0]);
+		builder.StoreException(lambda_star,&str[0]);
 
 		for (int k = 0; k < var; k++) {
 			str[left_track+num_tracks*k] = tv[i].first[k];
 			str[right_track+num_tracks*k] = exep_lambda[k];
 		}
-		dfaStoreException(star_lambda,&str[0]);
+		builder.StoreException(star_lambda,&str[0]);
 	}
 	str = std::vector<char>(len,'X');
 	for(int k = 0; k < var; k++) {
@@ -699,16 +1005,16 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
 	str.push_back('\0');
-	dfaStoreException(lambda_lambda,&str[0]);
-	dfaStoreState(not_eq_eq);
+	builder.StoreException(lambda_lambda,&str[0]);
+	builder.StoreState(not_eq_eq);
 
 
 
 
 	// ------ lambda/lambda state, loop back on lambda
-	dfaAllocExceptions(1);
-	dfaStoreException(lambda_lambda,&str[0]);
-	dfaStoreState(sink);
+	builder.AllocExceptions(1);
+	builder.StoreException(lambda_lambda,&str[0]);
+	builder.StoreState(sink);
 
 
 
@@ -716,7 +1022,7 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 	// ------ star/lambda state
 	// loop back on star/lambda, goto lambda_lambda on lambda/lambda
 	// if right is lambda, left can be anything, but go to next state
-	dfaAllocExceptions(tv.size() + 1);
+	builder.AllocExceptions(tv.size() + 1);
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for (int k = 0; k < var; k++) {
@@ -724,7 +1030,7 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 			str[right_track+num_tracks*k] = exep_lambda[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(star_lambda,&str[0]);
+		builder.StoreException(star_lambda,&str[0]);
 	}
 
 	// if both are lambda, go to next state
@@ -734,15 +1040,15 @@ StringAutomaton_ptr StringAutomaton::MakeNotBegins(StringFormula_ptr formula) {
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
 	str.push_back('\0');
-	dfaStoreException(lambda_lambda,&str[0]);
-	dfaStoreState(sink);
+	builder.StoreException(lambda_lambda,&str[0]);
+	builder.StoreState(sink);
 
 	// sink
-	dfaAllocExceptions(0);
-	dfaStoreState(sink);
+	builder.AllocExceptions(0);
+	builder.StoreState(sink);
 
-	temp_dfa = dfaBuild("---+--");
-	result_dfa = dfaMinimize(temp_dfa);
+	temp_dfa = builder.Build("---+--");
+	result_dfa = DFAMinimize(temp_dfa);
 	dfaFree(temp_dfa);
 	result_auto = new StringAutomaton(result_dfa,formula,var*num_tracks);
 	DVLOG(VLOG_LEVEL) << result_auto->id_ << " = MakeNotBegins(" << formula->str() << ")";
@@ -769,7 +1075,7 @@ StringAutomaton_ptr StringAutomaton::MakeEquality(StringFormula_ptr formula) {
 
 		formula->SetConstant("");
 		if(num_tracks == 1) {
-			equality_auto = new StringAutomaton(dfaCopy(string_auto->getDFA()),num_tracks,DEFAULT_NUM_OF_VARIABLES);
+			equality_auto = new StringAutomaton(DFACopy(string_auto->getDFA()),num_tracks,DEFAULT_NUM_OF_VARIABLES);
 		} else {
 			equality_auto = new StringAutomaton(string_auto->getDFA(),left_track,num_tracks,DEFAULT_NUM_OF_VARIABLES);
 		}
@@ -838,7 +1144,7 @@ StringAutomaton_ptr StringAutomaton::MakeNotEquality(	StringFormula_ptr formula)
 
 		formula->SetConstant("");
 		if(num_tracks == 1) {
-			not_equality_auto = new StringAutomaton(dfaCopy(complement_auto->getDFA()),num_tracks,DEFAULT_NUM_OF_VARIABLES);
+			not_equality_auto = new StringAutomaton(DFACopy(complement_auto->getDFA()),num_tracks,DEFAULT_NUM_OF_VARIABLES);
 		} else {
 			not_equality_auto = new StringAutomaton(complement_auto->getDFA(),left_track,num_tracks,DEFAULT_NUM_OF_VARIABLES);
 		}
@@ -1126,12 +1432,12 @@ StringAutomaton_ptr StringAutomaton::MakeAnyStringUnaligned(StringFormula_ptr fo
   int len = VAR_PER_TRACK * formula->GetNumberOfVariables();
   int *mindices = Automaton::GetBddVariableIndices(len);
 
-  dfaSetup(1, len, mindices);
-  dfaAllocExceptions(0);
-  dfaStoreState(0);
+  DFABuilder builder(1, len, mindices);
+  builder.AllocExceptions(0);
+  builder.StoreState(0);
 
-  temp = dfaBuild("+");
-  result = dfaMinimize(temp);
+  temp = builder.Build("+");
+  result = DFAMinimize(temp);
   dfaFree(temp);
   //delete[] mindices;
   result_auto = new StringAutomaton(result, formula,len);
@@ -1307,7 +1613,7 @@ StringAutomaton_ptr StringAutomaton::Closure() {
   std::vector<std::pair<int,std::vector<char>>> added_exeps, original_exeps;
   std::vector<char> exep;
 
-  dfaSetup(ns, len, indices);
+  DFABuilder builder(ns, len, indices);
   //construct the added paths
   state_paths = pp = make_paths(dfa_->bddm, dfa_->q[dfa_->s]);
   exep = std::vector<char>(len,'X');
@@ -1356,42 +1662,42 @@ StringAutomaton_ptr StringAutomaton::Closure() {
       pp = pp->next;
     }
     if (dfa_->f[i] == 1) { //add added paths
-      dfaAllocExceptions(added_exeps.size() + original_exeps.size());
+      builder.AllocExceptions(added_exeps.size() + original_exeps.size());
       for(int k = 0; k < added_exeps.size(); k++) {
-        dfaStoreException(added_exeps[k].first,&added_exeps[k].second[0]);
+        builder.StoreException(added_exeps[k].first,&added_exeps[k].second[0]);
       }
       for(int k = 0; k < original_exeps.size(); k++) {
-        dfaStoreException(original_exeps[k].first,&original_exeps[k].second[0]);
+        builder.StoreException(original_exeps[k].first,&original_exeps[k].second[0]);
       }
       statuses[i] = '+';
     } else {
-      dfaAllocExceptions(original_exeps.size());
+      builder.AllocExceptions(original_exeps.size());
       for(int k = 0; k < original_exeps.size(); k++) {
-        dfaStoreException(original_exeps[k].first,&original_exeps[k].second[0]);
+        builder.StoreException(original_exeps[k].first,&original_exeps[k].second[0]);
       }
       if (dfa_->f[i] == -1)
         statuses[i] = '-';
       else
         statuses[i] = '0';
     }
-    dfaStoreState(sink);
+    builder.StoreState(sink);
     kill_paths(state_paths);
     original_exeps.clear();
   }
 
   // store sink state
   if(not has_sink) {
-  	dfaAllocExceptions(0);
-  	dfaStoreState(sink);
+  	builder.AllocExceptions(0);
+  	builder.StoreState(sink);
   	statuses[sink] = '-';
   }
 
   statuses[ns] = '\0';
-  temp_dfa = dfaBuild(statuses);
-  result_dfa = dfaProject(temp_dfa, (unsigned) var); //var is the index of the extra bit
+  temp_dfa = builder.Build(statuses);
+  result_dfa = DFAProject(temp_dfa, (unsigned) var); //var is the index of the extra bit
   dfaFree(temp_dfa);
   temp_dfa = result_dfa;
-  result_dfa = dfaMinimize(temp_dfa);
+  result_dfa = DFAMinimize(temp_dfa);
   dfaFree(temp_dfa);
 
   result_auto = new StringAutomaton(result_dfa, num_of_bdd_variables_);
@@ -1424,12 +1730,14 @@ StringAutomaton_ptr StringAutomaton::Repeat(unsigned min) {
     repeated_auto = this->KleeneClosure();
   } else if (min == 1) {
     repeated_auto = this->Closure();
+  } else if (num_of_bdd_variables_ <= DEFAULT_NUM_OF_VARIABLES) {
+    repeated_auto = new StringAutomaton(MakeRepeatDfa(min, 0, false), num_of_bdd_variables_);
   } else {
-    StringAutomaton_ptr closure_auto = this->Closure();
-    StringAutomaton_ptr range_auto = StringAutomaton::MakeAnyStringLengthGreaterThanOrEqualTo(min);
-    repeated_auto = closure_auto->Intersect(range_auto);
-    delete range_auto; range_auto = nullptr;
+    StringAutomaton_ptr prefix_auto = this->Repeat(min, min);
+    StringAutomaton_ptr closure_auto = this->KleeneClosure();
+    repeated_auto = prefix_auto->Concat(closure_auto);
     delete closure_auto; closure_auto = nullptr;
+    delete prefix_auto; prefix_auto = nullptr;
   }
 
   DVLOG(VLOG_LEVEL) << repeated_auto->id_ << " = [" << this->id_ << "]->repeat(" << min << ")";
@@ -1441,23 +1749,183 @@ StringAutomaton_ptr StringAutomaton::Repeat(unsigned min, unsigned max) {
 	CHECK_EQ(this->num_tracks_,1);
   StringAutomaton_ptr repeated_auto = nullptr;
 
-  if (min == 0) {
-    repeated_auto = this->KleeneClosure();
+  if (min > max) {
+    repeated_auto = StringAutomaton::MakePhi(num_of_bdd_variables_);
+  } else if (max == 0) {
+    repeated_auto = StringAutomaton::MakeEmptyString(num_of_bdd_variables_);
+  } else if (num_of_bdd_variables_ <= DEFAULT_NUM_OF_VARIABLES) {
+    repeated_auto = new StringAutomaton(MakeRepeatDfa(min, max, true), num_of_bdd_variables_);
   } else {
-    repeated_auto = this->Closure();
+    // too many characters to enumerate, unroll with concatenations
+    StringAutomaton_ptr optional_auto = this->Optional();
+    StringAutomaton_ptr tmp_auto = nullptr;
+    repeated_auto = StringAutomaton::MakeEmptyString(num_of_bdd_variables_);
+    for (unsigned i = 0; i < max; ++i) {
+      tmp_auto = repeated_auto;
+      repeated_auto = tmp_auto->Concat(i < min ? this : optional_auto);
+      delete tmp_auto; tmp_auto = nullptr;
+    }
+    delete optional_auto; optional_auto = nullptr;
   }
 
-  StringAutomaton_ptr range_auto = StringAutomaton::MakeAnyStringWithLengthInRange(min, max);
-  StringAutomaton_ptr tmp_auto = repeated_auto;
-  repeated_auto = tmp_auto->Intersect(range_auto);
-  delete range_auto; range_auto = nullptr;
-  delete tmp_auto; tmp_auto = nullptr;
-
   DVLOG(VLOG_LEVEL) << repeated_auto->id_ << " = [" << this->id_ << "]->repeat(" << min << ", " << max << ")";
 
   return repeated_auto;
 }
 
+/**
+ * A configuration is a sorted set of (completed copies, operand state) pairs encoded as
+ * completed copies * ns + state. For an unbounded repetition the number of completed copies
+ * saturates at min, which keeps the number of configurations finite.
+ */
+DFA_ptr StringAutomaton::MakeRepeatDfa(unsigned min, unsigned max, bool is_max_bounded) {
+  const int var = num_of_bdd_variables_;
+  const int ns = dfa_->ns;
+  const unsigned long alphabet_size = 1UL << var;
+  const int initial_marker = -1;  // distinguishes initial configuration that accepts zero copies
+  int* indices = GetBddVariableIndices(var);
+  paths state_paths, pp;
+  trace_descr tp;
+
+  // operand transitions on concrete characters
+  std::vector<int> next_state(ns * alphabet_size, -1);
+  for (int i = 0; i < ns; i++) {
+    state_paths = pp = make_paths(dfa_->bddm, dfa_->q[i]);
+    while (pp) {
+      unsigned long mask = 0, value = 0;
+      for (tp = pp->trace; tp; tp = tp->next) {
+        unsigned long bit = 1UL << (var - 1 - tp->index);
+        mask |= bit;
+        if (tp->value) {
+          value |= bit;
+        }
+      }
+      for (unsigned long c = 0; c < alphabet_size; c++) {
+        if ((c & mask) == value) {
+          next_state[i * alphabet_size + c] = pp->to;
+        }
+      }
+      pp = pp->next;
+    }
+    kill_paths(state_paths);
+  }
+
+  // states that cannot reach an accepting state are dropped from configurations
+  std::vector<bool> is_live(ns, false);
+  bool is_changed = true;
+  for (int i = 0; i < ns; i++) {
+    is_live[i] = (dfa_->f[i] == 1);
+  }
+  while (is_changed) {
+    is_changed = false;
+    for (int i = 0; i < ns; i++) {
+      if (is_live[i]) {
+        continue;
+      }
+      for (unsigned long c = 0; c < alphabet_size; c++) {
+        if (is_live[next_state[i * alphabet_size + c]]) {
+          is_live[i] = is_changed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  auto add_with_closure = [&](std::set<int>& configuration, unsigned copies, int state) {
+    while (is_live[state] and configuration.insert(copies * ns + state).second and dfa_->f[state] == 1) {
+      if (is_max_bounded) {
+        if (copies + 1 >= max) {
+          break;
+        }
+        ++copies;
+      } else if (copies < min) {
+        ++copies;
+      }
+      state = dfa_->s;
+    }
+  };
+
+  std::map<std::vector<int>, int> configuration_ids;
+  std::vector<std::vector<int>> configurations;
+  std::vector<std::vector<int>> transitions;
+  std::set<int> configuration;
+
+  if (min == 0) {
+    configuration.insert(initial_marker);
+  }
+  add_with_closure(configuration, 0, dfa_->s);
+  configurations.push_back(std::vector<int>(configuration.begin(), configuration.end()));
+  configuration_ids[configurations.back()] = 0;
+
+  for (std::size_t current = 0; current < configurations.size(); ++current) {
+    std::vector<int> targets(alphabet_size);
+    for (unsigned long c = 0; c < alphabet_size; c++) {
+      configuration.clear();
+      for (int element : configurations[current]) {
+        if (element == initial_marker) {
+          continue;
+        }
+        add_with_closure(configuration, element / ns, next_state[(element % ns) * alphabet_size + c]);
+      }
+      std::vector<int> next_configuration(configuration.begin(), configuration.end());
+      auto it = configuration_ids.find(next_configuration);
+      if (it == configuration_ids.end()) {
+        targets[c] = configurations.size();
+        configuration_ids[next_configuration] = configurations.size();
+        configurations.push_back(next_configuration);
+      } else {
+        targets[c] = it->second;
+      }
+    }
+    transitions.push_back(targets);
+  }
+
+  const int result_ns = configurations.size();
+  char* statuses = new char[result_ns + 1];
+  DFABuilder builder(result_ns, var, indices);
+  for (int i = 0; i < result_ns; i++) {
+    std::map<int, RegexCompiler::CharSet> groups;
+    for (unsigned long c = 0; c < alphabet_size; c++) {
+      groups[transitions[i][c]].set(c);
+    }
+    int default_target = groups.begin()->first;
+    for (auto& group : groups) {
+      if (group.second.count() > groups[default_target].count()) {
+        default_target = group.first;
+      }
+    }
+    std::vector<std::pair<int, std::string>> exceptions;
+    for (auto& group : groups) {
+      if (group.first == default_target) {
+        continue;
+      }
+      for (auto& exception : RegexCompiler::GetExceptions(group.second, var)) {
+        exceptions.push_back(std::make_pair(group.first, exception));
+      }
+    }
+    builder.AllocExceptions(exceptions.size());
+    for (auto& exception : exceptions) {
+      builder.StoreException(exception.first, const_cast<char*>(exception.second.data()));
+    }
+    builder.StoreState(default_target);
+
+    statuses[i] = '-';
+    for (int element : configurations[i]) {
+      if (element == initial_marker or (dfa_->f[element % ns] == 1 and (unsigned) (element / ns) + 1 >= min)) {
+        statuses[i] = '+';
+        break;
+      }
+    }
+  }
+  statuses[result_ns] = '\0';
+
+  DFA_ptr temp_dfa = builder.Build(statuses);
+  DFA_ptr result_dfa = DFAMinimize(temp_dfa);
+  dfaFree(temp_dfa);
+  delete[] statuses;
+  return result_dfa;
+}
+
 StringAutomaton_ptr StringAutomaton::Suffixes() {
 	CHECK_EQ(this->num_tracks_,1);
   StringAutomaton_ptr suffixes_auto = nullptr;
@@ -1559,34 +2027,34 @@ StringAutomaton_ptr StringAutomaton::Suffixes() {
 
   char* statuses = new char[number_of_states + 1];
 
-  dfaSetup(number_of_states, number_of_variables, indices);
+  DFABuilder builder(number_of_states, number_of_variables, indices);
   for (int s = 0; s < number_of_states; s++) {
     statuses[s] = '-';
     if (s != sink_state) {
       statuses[s] = '-'; // initially
-      dfaAllocExceptions(exception_map[s].size());
+      builder.AllocExceptions(exception_map[s].size());
       for (auto it = exception_map[s].begin(); it != exception_map[s].end();) {
-        dfaStoreException(it->second, &*it->first->begin());
+        builder.StoreException(it->second, &*it->first->begin());
         current_exception = it->first;
         it = exception_map[s].erase(it);
         delete current_exception;
       }
-      dfaStoreState(sink_state);
+      builder.StoreState(sink_state);
       current_exception = nullptr;
       if (IsAcceptingState(s)) {
         statuses[s] = '+';
       }
     } else {
-      dfaAllocExceptions(0);
-      dfaStoreState(s);
+      builder.AllocExceptions(0);
+      builder.StoreState(s);
     }
   }
 
   statuses[number_of_states] = '\0';
-  DFA_ptr result_dfa = dfaBuild(statuses);
+  DFA_ptr result_dfa = builder.Build(statuses);
   //delete[] indices;
   delete[] statuses;
-  suffixes_auto = new StringAutomaton(dfaMinimize(result_dfa), number_of_variables);
+  suffixes_auto = new StringAutomaton(DFAMinimize(result_dfa), number_of_variables);
   dfaFree(result_dfa); result_dfa = nullptr;
 
   while (number_of_extra_bits_needed > 0) {
@@ -1619,6 +2087,12 @@ StringAutomaton_ptr StringAutomaton::SuffixesFromTo(int start, int end) {
     return suffixes_auto;
   }
 
+  if (Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS) {
+    suffixes_auto = this->SuffixesFromToDirect(start, end, -1, false);
+    DVLOG(VLOG_LEVEL) << suffixes_auto->id_ << " = [" << this->id_ << "]->suffixes(" << start << ", " << end << ")";
+    return suffixes_auto;
+  }
+
   std::set<int> suffixes_from = getStatesReachableBy(start, end);
   unsigned max = suffixes_from.size();
   if (max == 0) {
@@ -1708,35 +2182,35 @@ StringAutomaton_ptr StringAutomaton::SuffixesFromTo(int start, int end) {
     ++sink_state; // old states are off by one
   }
 
-  dfaSetup(number_of_states, number_of_variables, indices);
+  DFABuilder builder(number_of_states, number_of_variables, indices);
   for (int s = 0; s < number_of_states; s++) {
     statuses[s] = '-';
     if (s != sink_state) {
       int old_state = s - 1;
       statuses[s] = '-'; // initially
-      dfaAllocExceptions(exception_map[s].size());
+      builder.AllocExceptions(exception_map[s].size());
       for (auto it = exception_map[s].begin(); it != exception_map[s].end();) {
-        dfaStoreException(it->second, &*it->first->begin());
+        builder.StoreException(it->second, &*it->first->begin());
         current_exception = it->first;
         it = exception_map[s].erase(it);
         delete current_exception;
       }
-      dfaStoreState(sink_state);
+      builder.StoreState(sink_state);
       current_exception = nullptr;
       if (old_state > -1 and IsAcceptingState(old_state)) {
         statuses[s] = '+';
       }
     } else {
-      dfaAllocExceptions(0);
-      dfaStoreState(s);
+      builder.AllocExceptions(0);
+      builder.StoreState(s);
     }
   }
 
   statuses[number_of_states] = '\0';
-  DFA_ptr result_dfa = dfaBuild(statuses);
+  DFA_ptr result_dfa = builder.Build(statuses);
   //delete[] indices;
   delete[] statuses;
-  suffixes_auto = new StringAutomaton(dfaMinimize(result_dfa), number_of_variables);
+  suffixes_auto = new StringAutomaton(DFAMinimize(result_dfa), number_of_variables);
   dfaFree(result_dfa); result_dfa = nullptr;
 
   for ( int i = 0; i < number_of_extra_bits_needed; ++i) {
@@ -1817,6 +2291,11 @@ StringAutomaton_ptr StringAutomaton::CharAt(const int index) {
     return charat_auto;
   }
 
+  if (Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS) {
+    auto charat_auto = this->SuffixesFromToDirect(index, index, 1, false);
+    DVLOG(VLOG_LEVEL) << charat_auto->id_ << " = [" << this->id_ << "]->charAt(" << index << ")";
+    return charat_auto;
+  }
 
   std::set<int> states_at_index = getStatesReachableBy(index);
   unsigned max = states_at_index.size();
@@ -1876,26 +2355,26 @@ StringAutomaton_ptr StringAutomaton::CharAt(const int index) {
   }
 
   char statuses[3] = {'-', '+', '-'};
-  dfaSetup(3, number_of_variables, indices);
+  DFABuilder builder(3, number_of_variables, indices);
   // 0 -> 1
-  dfaAllocExceptions(exceptions.size());
+  builder.AllocExceptions(exceptions.size());
   for (auto it = exceptions.begin(); it != exceptions.end();) {
     auto ex = *it;
-    dfaStoreException(1, &(*ex->begin()));
+    builder.StoreException(1, &(*ex->begin()));
     it = exceptions.erase(it);
     delete ex;
   }
-  dfaStoreState(2); // 0 -> 2
+  builder.StoreState(2); // 0 -> 2
 
-  dfaAllocExceptions(0);
-  dfaStoreState(2); // 1 -> 2
+  builder.AllocExceptions(0);
+  builder.StoreState(2); // 1 -> 2
 
-  dfaAllocExceptions(0);
-  dfaStoreState(2); // 2 -> 2
+  builder.AllocExceptions(0);
+  builder.StoreState(2); // 2 -> 2
 
-  DFA_ptr result_dfa = dfaBuild(statuses);
+  DFA_ptr result_dfa = builder.Build(statuses);
   //delete[] indices;
-  auto charat_auto = new StringAutomaton(dfaMinimize(result_dfa), number_of_variables);
+  auto charat_auto = new StringAutomaton(DFAMinimize(result_dfa), number_of_variables);
   dfaFree(result_dfa); result_dfa = nullptr;
 
   for ( int i = 0; i < number_of_extra_bits_needed; ++i) {
@@ -1934,26 +2413,26 @@ StringAutomaton_ptr StringAutomaton::CharAt(IntAutomaton_ptr index_auto) {
   }
 
   const int number_of_exceptions = exceptions.size();
-  dfaSetup(3, number_of_variables, GetBddVariableIndices(number_of_variables));
+  DFABuilder builder(3, number_of_variables, GetBddVariableIndices(number_of_variables));
   char statuses[3] { '-', '+', '-' };
   //state 0
-  dfaAllocExceptions(number_of_exceptions);
+  builder.AllocExceptions(number_of_exceptions);
   for (std::string exception : exceptions) {
-    dfaStoreException(1, &exception[0]);
+    builder.StoreException(1, &exception[0]);
   }
-  dfaStoreState(2);
+  builder.StoreState(2);
 
   //state 1
-  dfaAllocExceptions(0);
-  dfaStoreState(2);
+  builder.AllocExceptions(0);
+  builder.StoreState(2);
 
   //state 2
-  dfaAllocExceptions(0);
-  dfaStoreState(2);
+  builder.AllocExceptions(0);
+  builder.StoreState(2);
 
-  DFA_ptr result_dfa = dfaBuild(statuses);
+  DFA_ptr result_dfa = builder.Build(statuses);
 
-  StringAutomaton_ptr charat_auto = new StringAutomaton(dfaMinimize(result_dfa), number_of_variables);
+  StringAutomaton_ptr charat_auto = new StringAutomaton(DFAMinimize(result_dfa), number_of_variables);
   dfaFree(result_dfa); result_dfa = nullptr;
 
 
@@ -1982,6 +2461,13 @@ StringAutomaton_ptr StringAutomaton::SubString(const int start, const int end) {
     return substring_auto;
   }
 
+  if (Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS and start < end) {
+    // a substring of length 1 is also empty when the string ends at start, see PrefixesAtIndex
+    auto substring_auto = this->SuffixesFromToDirect(start, start, end - start, (end - start) == 1);
+    DVLOG(VLOG_LEVEL) << substring_auto->id_ << " = [" << this->id_ << "]->subString(" << start << "," << end << ")";
+    return substring_auto;
+  }
+
   int adjusted_end = end;
   if (start < end) {
     --adjusted_end;
@@ -2175,7 +2661,11 @@ IntAutomaton_ptr StringAutomaton::IndexOf(StringAutomaton_ptr search_auto) {
     has_negative_1 = true;
   }
   delete difference_auto;
-  index_of_auto = contains_auto->IndexOfHelper(search_param_auto);
+  if (Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS and search_param_auto->IsAcceptingSingleString()) {
+    index_of_auto = contains_auto->IndexOfHelper(search_param_auto->GetAnAcceptingString());
+  } else {
+    index_of_auto = contains_auto->IndexOfHelper(search_param_auto);
+  }
   delete contains_auto; contains_auto = nullptr;
 
   length_auto = index_of_auto->Length();
@@ -2265,6 +2755,14 @@ StringAutomaton_ptr StringAutomaton::Contains(StringAutomaton_ptr search_auto) {
   StringAutomaton_ptr contains_auto = nullptr, any_string_auto = nullptr,
           tmp_auto_1 = nullptr, tmp_auto_2 = nullptr;
 
+  if (search_auto->IsAcceptingSingleString()) {
+    tmp_auto_1 = StringAutomaton::MakeContainsAnyOf({search_auto->GetAnAcceptingString()}, num_of_bdd_variables_);
+    contains_auto = this->Intersect(tmp_auto_1);
+    delete tmp_auto_1;
+    DVLOG(VLOG_LEVEL) << contains_auto->id_ << " = [" << this->id_ << "]->contains(" << search_auto->id_ << ")";
+    return contains_auto;
+  }
+
   any_string_auto = StringAutomaton::MakeAnyString();
   tmp_auto_1 = any_string_auto->Concat(search_auto);
   tmp_auto_2 = tmp_auto_1->Concat(any_string_auto);
@@ -2283,12 +2781,16 @@ StringAutomaton_ptr StringAutomaton::Begins(StringAutomaton_ptr search_auto) {
   StringAutomaton_ptr begins_auto = nullptr, any_string_auto = nullptr,
           tmp_auto_1 = nullptr;
 
-  any_string_auto = StringAutomaton::MakeAnyString();
-  tmp_auto_1 = search_auto->Concat(any_string_auto);
+  if (search_auto->IsAcceptingSingleString()) {
+    tmp_auto_1 = StringAutomaton::MakeBeginsWithAnyOf({search_auto->GetAnAcceptingString()}, num_of_bdd_variables_);
+  } else {
+    any_string_auto = StringAutomaton::MakeAnyString();
+    tmp_auto_1 = search_auto->Concat(any_string_auto);
+    delete any_string_auto;
+  }
 
   begins_auto = this->Intersect(tmp_auto_1);
   delete tmp_auto_1;
-  delete any_string_auto;
   DVLOG(VLOG_LEVEL) << begins_auto->id_ << " = [" << this->id_ << "]->begins(" << search_auto->id_ << ")";
 
   return begins_auto;
@@ -2299,12 +2801,16 @@ StringAutomaton_ptr StringAutomaton::Ends(StringAutomaton_ptr search_auto) {
   StringAutomaton_ptr ends_auto = nullptr, any_string_auto = nullptr,
           tmp_auto_1 = nullptr;
 
-  any_string_auto = StringAutomaton::MakeAnyString();
-  tmp_auto_1 = any_string_auto->Concat(search_auto);
+  if (search_auto->IsAcceptingSingleString()) {
+    tmp_auto_1 = StringAutomaton::MakeEndsWithAnyOf({search_auto->GetAnAcceptingString()}, num_of_bdd_variables_);
+  } else {
+    any_string_auto = StringAutomaton::MakeAnyString();
+    tmp_auto_1 = any_string_auto->Concat(search_auto);
+    delete any_string_auto;
+  }
 
   ends_auto = this->Intersect(tmp_auto_1);
   delete tmp_auto_1;
-  delete any_string_auto;
 
   DVLOG(VLOG_LEVEL) << ends_auto->id_ << " = [" << this->id_ << "]->ends(" << search_auto->id_ << ")";
 
@@ -2313,22 +2819,9 @@ StringAutomaton_ptr StringAutomaton::Ends(StringAutomaton_ptr search_auto) {
 
 StringAutomaton_ptr StringAutomaton::ToUpperCase() {
 	CHECK_EQ(this->num_tracks_,1);
-  DFA_ptr upper_case_dfa = nullptr;
-  StringAutomaton_ptr upper_case_auto = nullptr;
-
-  int var = this->num_of_bdd_variables_;
-	int nvar = var+1;
-
-	// dfa1 will have var+1 indices, with all valid transitions having extrabit=0
-	DFA_ptr dfa1 = Automaton::DFAExtendExtrabit(this->dfa_,var);
-	int *indices = Automaton::GetBddVariableIndices(nvar);
-
-  upper_case_dfa = Automaton::dfaToUpperCase(dfa1, nvar, indices);
-  DFA_ptr temp_dfa = Automaton::DFAProjectAway(upper_case_dfa,var);
-  dfaFree(upper_case_dfa);
-
-  upper_case_auto = new StringAutomaton(temp_dfa,var);
-
+  Transducer_ptr upper_case_transducer = Transducer::MakeToUpperCase();
+  StringAutomaton_ptr upper_case_auto = this->Transduce(upper_case_transducer);
+  delete upper_case_transducer;
 
   DVLOG(VLOG_LEVEL) << upper_case_auto->id_ << " = [" << this->id_ << "]->toUpperCase()";
 
@@ -2337,21 +2830,9 @@ StringAutomaton_ptr StringAutomaton::ToUpperCase() {
 
 StringAutomaton_ptr StringAutomaton::ToLowerCase() {
   CHECK_EQ(this->num_tracks_,1);
-  DFA_ptr lower_case_dfa = nullptr;
-  StringAutomaton_ptr lower_case_auto = nullptr;
-
-  int var = this->num_of_bdd_variables_;
-	int nvar = var+1;
-
-	// dfa1 will have var+1 indices, with all valid transitions having extrabit=0
-	DFA_ptr dfa1 = Automaton::DFAExtendExtrabit(this->dfa_,var);
-	int *indices = Automaton::GetBddVariableIndices(nvar);
-
-	lower_case_dfa = Automaton::dfaToLowerCase(dfa1, nvar, indices);
-
-	DFA_ptr temp_dfa = Automaton::DFAProjectAway(lower_case_dfa,var);
-	dfaFree(lower_case_dfa);
-	lower_case_auto = new StringAutomaton(temp_dfa, var);
+  Transducer_ptr lower_case_transducer = Transducer::MakeToLowerCase();
+  StringAutomaton_ptr lower_case_auto = this->Transduce(lower_case_transducer);
+  delete lower_case_transducer;
 
   DVLOG(VLOG_LEVEL) << lower_case_auto->id_ << " = [" << this->id_ << "]->toLowerCase()";
 
@@ -2360,17 +2841,9 @@ StringAutomaton_ptr StringAutomaton::ToLowerCase() {
 
 StringAutomaton_ptr StringAutomaton::Trim() {
 	CHECK_EQ(this->num_tracks_,1);
-  DFA_ptr trimmed_prefix_dfa = nullptr, trimmed_dfa = nullptr;
-  StringAutomaton_ptr trimmed_auto = nullptr, trim_auto = nullptr;
-
-  std::string trim_regex = "' '*";
-  trim_auto = StringAutomaton::MakeRegexAuto(trim_regex, num_of_bdd_variables_);
-  trimmed_prefix_dfa = StringAutomaton::TrimPrefix(this->dfa_,trim_auto->getDFA(),num_of_bdd_variables_);
-  trimmed_dfa = StringAutomaton::TrimSuffix(trimmed_prefix_dfa, trim_auto->getDFA(), num_of_bdd_variables_);
-  delete trim_auto;
-  dfaFree(trimmed_prefix_dfa);
-
-  trimmed_auto = new StringAutomaton(trimmed_dfa, num_of_bdd_variables_);
+  Transducer_ptr trim_transducer = Transducer::MakeTrim();
+  StringAutomaton_ptr trimmed_auto = this->Transduce(trim_transducer);
+  delete trim_transducer;
 
   DVLOG(VLOG_LEVEL) << trimmed_auto->id_ << " = [" << this->id_ << "]->trim()";
 
@@ -2382,7 +2855,20 @@ StringAutomaton_ptr StringAutomaton::Replace(StringAutomaton_ptr search_auto,
 	CHECK_EQ(this->num_tracks_,1);
   DFA_ptr result_dfa = nullptr, temp_dfa = nullptr;
   StringAutomaton_ptr result_auto = nullptr,temp_auto = nullptr;
-  //LOG(FATAL) << "implement me";
+
+  // constant search and replace strings are handled by a replace transducer,
+  // regular search languages still go through the extra bit construction
+  if (search_auto->IsAcceptingSingleString() and replace_auto->IsAcceptingSingleString()) {
+    std::string search_string = search_auto->GetAnAcceptingString();
+    if (not search_string.empty()) {
+      Transducer_ptr replace_transducer = Transducer::MakeReplace(search_string, replace_auto->GetAnAcceptingString());
+      result_auto = this->Transduce(replace_transducer);
+      delete replace_transducer;
+      DVLOG(VLOG_LEVEL) << result_auto->id_ << " = [" << this->id_ << "]->replace(" << search_auto->id_ << ", " << replace_auto->id_ << ")";
+      return result_auto;
+    }
+  }
+
   int var = this->num_of_bdd_variables_;
   int nvar = var+1;
 
@@ -2406,11 +2892,27 @@ StringAutomaton_ptr StringAutomaton::Replace(StringAutomaton_ptr search_auto,
   return result_auto;
 }
 
+StringAutomaton_ptr StringAutomaton::Transduce(const Transducer_ptr transducer) {
+  CHECK_EQ(this->num_tracks_,1);
+  DFA_ptr result_dfa = transducer->Image(this->dfa_, num_of_bdd_variables_, GetBddVariableIndices(num_of_bdd_variables_));
+  StringAutomaton_ptr result_auto = new StringAutomaton(result_dfa, num_of_bdd_variables_);
+
+  DVLOG(VLOG_LEVEL) << result_auto->id_ << " = [" << this->id_ << "]->transduce()";
+
+  return result_auto;
+}
+
 StringAutomaton_ptr StringAutomaton::GetAnyStringNotContainsMe() {
 	CHECK_EQ(this->num_tracks_,1);
 	StringAutomaton_ptr not_contains_auto = nullptr, any_string_auto = nullptr,
 					contains_auto = nullptr, tmp_auto_1 = nullptr;
 
+	if (this->IsAcceptingSingleString()) {
+		not_contains_auto = StringAutomaton::MakeNotContainsAnyOf({this->GetAnAcceptingString()}, num_of_bdd_variables_);
+		DVLOG(VLOG_LEVEL) << not_contains_auto->id_ << " = [" << this->id_ << "]->getAnyStringNotContainsMe()";
+		return not_contains_auto;
+	}
+
 	any_string_auto = StringAutomaton::MakeAnyString();
 	tmp_auto_1 = any_string_auto->Concat(this);
 	contains_auto = tmp_auto_1->Concat(any_string_auto);
@@ -2426,117 +2928,11 @@ StringAutomaton_ptr StringAutomaton::GetAnyStringNotContainsMe() {
 
 UnaryAutomaton_ptr StringAutomaton::ToUnaryAutomaton() {
 	CHECK_EQ(this->num_tracks_,1);
-  UnaryAutomaton_ptr unary_auto = nullptr;
-  DFA_ptr unary_dfa = nullptr, tmp_dfa = nullptr;
-
-  int sink_state = this->GetSinkState(),
-          number_of_variables = num_of_bdd_variables_ + 1, // one extra bit
-          to_state = 0;
-  bool has_sink = true;
-  int original_num_states = dfa_->ns;
-  if(sink_state < 0) {
-    has_sink = false;
-    sink_state = 0;
+  // lengths do not change with minimization or bit projection, the cache stays valid for this automaton
+  if (length_dfa_ == nullptr) {
+    length_dfa_ = DFAMakeUnaryLengthDfa(this->dfa_);
   }
-
-  int* indices = GetBddVariableIndices(number_of_variables);
-  char* statuses = new char[original_num_states + 1];
-  std::map<std::vector<char>*, int> exceptions;
-  std::vector<char>* current_exception = nullptr;
-
-  paths state_paths = nullptr, pp = nullptr;
-  trace_descr tp = nullptr;
-
-
-  dfaSetup(original_num_states, number_of_variables, indices);
-
-  for (int i = 0; i < original_num_states; i++) {
-
-    if(i == sink_state && has_sink) {
-      dfaAllocExceptions(0);
-      dfaStoreState(sink_state);
-      statuses[sink_state] = '-';
-      continue;
-    }
-
-    state_paths = pp = make_paths(dfa_->bddm, dfa_->q[i]);
-    while (pp) {
-      if (!has_sink || pp->to != (unsigned)sink_state) {
-        to_state = pp->to;
-        current_exception = new std::vector<char>();
-        for (int j = 0; j < number_of_variables - 1; j++) {
-          //the following for loop can be avoided if the indices are in order
-          for (tp = pp->trace; tp && (tp->index != (unsigned)indices[j]); tp= tp->next);
-
-          if (tp) {
-            if (tp->value){
-              current_exception->push_back('1');
-            } else{
-              current_exception->push_back('0');
-            }
-          } else {
-            current_exception->push_back('X');
-          }
-        }
-
-        current_exception->push_back('1');
-        current_exception->push_back('\0');
-        exceptions[current_exception] = to_state;
-      }
-      current_exception = nullptr;
-      tp = nullptr;
-      pp = pp->next;
-    }
-
-    dfaAllocExceptions(exceptions.size());
-    for (auto it = exceptions.begin(); it != exceptions.end();) {
-      dfaStoreException(it->second, &*it->first->begin());
-      current_exception = it->first;
-      it = exceptions.erase(it);
-      delete current_exception;
-    }
-    dfaStoreState(sink_state);
-    current_exception = nullptr;
-    exceptions.clear();
-
-    if (dfa_->f[i] == 1) {
-      statuses[i] = '+';
-    } else if (dfa_->f[i] == -1) {
-      statuses[i] = '-';
-    } else {
-      statuses[i] = '0';
-    }
-
-    kill_paths(state_paths);
-    state_paths = pp = nullptr;
-  }
-  statuses[this->dfa_->ns] = '\0';
-  unary_dfa = dfaBuild(statuses);
-  //delete[] indices; indices = nullptr;
-  delete[] statuses; statuses = nullptr;
-
-  for (int i = 0; i < number_of_variables - 1; i++) { // project away all bits
-    tmp_dfa = unary_dfa;
-    unary_dfa = dfaProject(tmp_dfa,  (unsigned)i);
-    dfaFree(tmp_dfa);
-    tmp_dfa = unary_dfa;
-    unary_dfa = dfaMinimize(tmp_dfa);
-    dfaFree(tmp_dfa);
-  }
-
-  int* indices_map = CreateBddVariableIndices(number_of_variables);
-  indices_map[number_of_variables - 1] = 0;
-  dfaReplaceIndices(unary_dfa, indices_map);
-  delete[] indices_map;
-
-  // make sure no "dont care" states
-  for(int i = 0; i < unary_dfa->ns; i++) {
-    if(unary_dfa->f[i] == 0) {
-      unary_dfa->f[i] = -1;
-    }
-  }
-
-  unary_auto = new UnaryAutomaton(unary_dfa);
+  UnaryAutomaton_ptr unary_auto = new UnaryAutomaton(DFACopy(length_dfa_));
   DVLOG(VLOG_LEVEL) << unary_auto->getId() << " = [" << this->id_ << "]->toUnaryAutomaton()";
   return unary_auto;
 }
@@ -2676,6 +3072,59 @@ StringAutomaton_ptr StringAutomaton::RestrictIndexOfTo(int index,StringAutomaton
 	CHECK_EQ(this->num_tracks_,1);
   StringAutomaton_ptr restricted_auto = nullptr;
   IntAutomaton_ptr index_auto = nullptr;
+  if (Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS and index >= 0 and search_auto->IsAcceptingSingleString()
+          and not search_auto->HasEmptyString()) {
+    // strings whose first index characters do not contain the search string and continue with it
+    const std::string search = search_auto->GetAnAcceptingString();
+    const int search_length = search.size();
+    std::vector<std::vector<int>> matched_patterns;
+    auto kmp_transitions = MakeAhoCorasickTable({search}, num_of_bdd_variables_, matched_patterns);
+    const std::size_t alphabet_size = kmp_transitions[0].size();
+
+    // (position, kmp state) before index, (index + matched length, 0) after, (-1, 0) is the sink
+    std::map<std::pair<int, int>, int> state_ids;
+    std::vector<std::pair<int, int>> states;
+    auto get_state = [&](const std::pair<int, int>& key) {
+      auto it = state_ids.find(key);
+      if (it != state_ids.end()) {
+        return it->second;
+      }
+      int id = states.size();
+      state_ids[key] = id;
+      states.push_back(key);
+      return id;
+    };
+
+    std::vector<std::vector<int>> transitions;
+    std::string statuses;
+    get_state(std::make_pair(0, 0));
+    for (std::size_t s = 0; s < states.size(); ++s) {
+      const int position = states[s].first, kmp_state = states[s].second;
+      std::vector<int> next_states (alphabet_size, -1);
+      for (std::size_t c = 0; c < alphabet_size; ++c) {
+        auto next_key = std::make_pair(-1, 0);
+        if (position == -1 or position == index + search_length) {
+          next_key = states[s];
+        } else if (position >= index) {
+          if ((unsigned char)search[position - index] == c) {
+            next_key = std::make_pair(position + 1, 0);
+          }
+        } else if (kmp_transitions[kmp_state][c] != search_length) { // state i of a single pattern is its prefix of length i
+          next_key = (position + 1 == index) ? std::make_pair(index, 0) : std::make_pair(position + 1, kmp_transitions[kmp_state][c]);
+        }
+        next_states[c] = get_state(next_key);
+      }
+      transitions.push_back(next_states);
+      statuses.push_back((position == index + search_length) ? '+' : '-');
+    }
+
+    auto index_of_auto = new StringAutomaton(MakeDfaFromTable(transitions, statuses, num_of_bdd_variables_), num_of_bdd_variables_);
+    restricted_auto = this->Intersect(index_of_auto);
+    delete index_of_auto; index_of_auto = nullptr;
+    DVLOG(VLOG_LEVEL) << restricted_auto->id_ << " = [" << this->id_ << "]->restrictIndexOfTo(" << index << ", " << search_auto->id_ << ")";
+    return restricted_auto;
+  }
+
   index_auto = IntAutomaton::makeInt(index);
   restricted_auto = this->RestrictIndexOfTo(index_auto, search_auto);
   delete index_auto; index_auto = nullptr;
@@ -2849,6 +3298,31 @@ StringAutomaton_ptr StringAutomaton::RestrictAtIndexTo(int index,
 	CHECK_EQ(this->num_tracks_,1);
   StringAutomaton_ptr restricted_auto = nullptr;
   IntAutomaton_ptr index_auto = nullptr;
+  if (Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS and index >= 0 and sub_string_auto->IsAcceptingSingleString()
+          and not sub_string_auto->HasEmptyString()) {
+    // strings that have the sub string at index, or that have length index (charAt of the end is empty)
+    const std::string sub_string = sub_string_auto->GetAnAcceptingString();
+    const int accept_all_state = index + sub_string.size(), sink_state = accept_all_state + 1;
+    const unsigned long alphabet_size = 1UL << num_of_bdd_variables_;
+    std::vector<std::vector<int>> transitions (sink_state + 1, std::vector<int>(alphabet_size, sink_state));
+    std::string statuses (sink_state + 1, '-');
+    for (int s = 0; s < index; ++s) {
+      std::fill(transitions[s].begin(), transitions[s].end(), s + 1);
+    }
+    for (int s = index; s < accept_all_state; ++s) {
+      transitions[s][(unsigned char)sub_string[s - index]] = s + 1;
+    }
+    std::fill(transitions[accept_all_state].begin(), transitions[accept_all_state].end(), accept_all_state);
+    statuses[index] = '+';
+    statuses[accept_all_state] = '+';
+
+    auto at_index_auto = new StringAutomaton(MakeDfaFromTable(transitions, statuses, num_of_bdd_variables_), num_of_bdd_variables_);
+    restricted_auto = this->Intersect(at_index_auto);
+    delete at_index_auto; at_index_auto = nullptr;
+    DVLOG(VLOG_LEVEL) << restricted_auto->id_ << " = [" << this->id_ << "]->restrictAtIndexTo(" << index << ", " << sub_string_auto->id_ << ")";
+    return restricted_auto;
+  }
+
   index_auto = IntAutomaton::makeInt(index);
   restricted_auto = this->RestrictAtIndexTo(index_auto, sub_string_auto);
   delete index_auto; index_auto = nullptr;
@@ -2900,28 +3374,9 @@ StringAutomaton_ptr StringAutomaton::RestrictAtIndexTo(
  */
 StringAutomaton_ptr StringAutomaton::PreToUpperCase(StringAutomaton_ptr rangeAuto) {
 	CHECK_EQ(this->num_tracks_,1);
-  DFA_ptr result_dfa = nullptr;
-  StringAutomaton_ptr result_auto = nullptr;
-
-  int var = this->num_of_bdd_variables_;
-	int nvar = var+1;
-
-	// dfa1 will have var+1 indices, with all valid transitions having extrabit=0
-	DFA_ptr dfa1 = Automaton::DFAExtendExtrabit(this->dfa_,var);
-	int *indices = Automaton::GetBddVariableIndices(nvar);
-
-  result_dfa = Automaton::dfaPreToUpperCase(dfa1,nvar,indices);
-	DFA_ptr temp_dfa = Automaton::DFAProjectAway(result_dfa,var);
-	dfaFree(result_dfa);
-
-
-  result_auto = new StringAutomaton(temp_dfa,var);
-
-  if (rangeAuto not_eq nullptr) {
-    StringAutomaton_ptr tmp_auto = result_auto;
-    result_auto = tmp_auto->Intersect(rangeAuto);
-    delete tmp_auto;
-  }
+  Transducer_ptr upper_case_transducer = Transducer::MakeToUpperCase();
+  StringAutomaton_ptr result_auto = this->PreTransduce(upper_case_transducer, rangeAuto);
+  delete upper_case_transducer;
 
   DVLOG(VLOG_LEVEL) << result_auto->id_ << " = [" << this->id_ << "]->preToUpperCase()";
 
@@ -2930,48 +3385,20 @@ StringAutomaton_ptr StringAutomaton::PreToUpperCase(StringAutomaton_ptr rangeAut
 
 StringAutomaton_ptr StringAutomaton::PreToLowerCase(StringAutomaton_ptr rangeAuto) {
 	CHECK_EQ(this->num_tracks_,1);
-  DFA_ptr result_dfa = nullptr;
-  StringAutomaton_ptr result_auto = nullptr;
-
-  int var = this->num_of_bdd_variables_;
-	int nvar = var+1;
-  DFA_ptr dfa1 = Automaton::DFAExtendExtrabit(this->dfa_,var);
-	int *indices = Automaton::GetBddVariableIndices(nvar);
-
-  result_dfa = dfaPreToLowerCase(dfa1,nvar,indices);
-
-
-	DFA_ptr temp_dfa = Automaton::DFAProjectAway(result_dfa,var);
-	dfaFree(result_dfa);
-
-  result_auto = new StringAutomaton(temp_dfa,var);
-
-  if (rangeAuto not_eq nullptr) {
-    StringAutomaton_ptr tmp_auto = result_auto;
-    result_auto = tmp_auto->Intersect(rangeAuto);
-    delete tmp_auto;
-  }
+  Transducer_ptr lower_case_transducer = Transducer::MakeToLowerCase();
+  StringAutomaton_ptr result_auto = this->PreTransduce(lower_case_transducer, rangeAuto);
+  delete lower_case_transducer;
 
   DVLOG(VLOG_LEVEL) << result_auto->id_ << " = [" << this->id_ << "]->preToLowerCase()";
 
   return result_auto;
 }
 
-// CHECK WITH BAKI
-// may be wrong
 StringAutomaton_ptr StringAutomaton::PreTrim(StringAutomaton_ptr rangeAuto) {
 	CHECK_EQ(this->num_tracks_,1);
-  StringAutomaton_ptr result_auto = nullptr, trim_auto = nullptr, temp_auto = nullptr;
-
-  std::string trim_regex = "' '*";
-  trim_auto = StringAutomaton::MakeRegexAuto(trim_regex);
-
-  result_auto = this->Concat(trim_auto);
-  temp_auto = trim_auto->Concat(result_auto);
-  delete result_auto;
-  result_auto = temp_auto->Intersect(rangeAuto);
-  delete trim_auto;
-  delete temp_auto;
+  Transducer_ptr trim_transducer = Transducer::MakeTrim();
+  StringAutomaton_ptr result_auto = this->PreTransduce(trim_transducer, rangeAuto);
+  delete trim_transducer;
 
   DVLOG(VLOG_LEVEL) << result_auto->id_ << " = [" << this->id_ << "]->preTrim()";
   return result_auto;
@@ -3006,6 +3433,17 @@ StringAutomaton_ptr StringAutomaton::PreReplace(StringAutomaton_ptr searchAuto,
   DFA_ptr result_dfa = nullptr, temp_dfa = nullptr;
   StringAutomaton_ptr result_auto = nullptr;
 
+  if (searchAuto->IsAcceptingSingleString()) {
+    std::string search_string = searchAuto->GetAnAcceptingString();
+    if (not search_string.empty()) {
+      Transducer_ptr replace_transducer = Transducer::MakeReplace(search_string, replaceString);
+      result_auto = this->PreTransduce(replace_transducer, rangeAuto);
+      delete replace_transducer;
+      DVLOG(VLOG_LEVEL) << result_auto->id_ << " = [" << this->id_ << "]->preReplace(" << searchAuto->id_ << ", " << replaceString << ")";
+      return result_auto;
+    }
+  }
+
   std::vector<char> replaceStringVector(replaceString.begin(), replaceString.end());
   replaceStringVector.push_back('\0');
 
@@ -3035,6 +3473,21 @@ StringAutomaton_ptr StringAutomaton::PreReplace(StringAutomaton_ptr searchAuto,
   return result_auto;
 }
 
+StringAutomaton_ptr StringAutomaton::PreTransduce(const Transducer_ptr transducer, StringAutomaton_ptr rangeAuto) {
+  CHECK_EQ(this->num_tracks_,1);
+  DFA_ptr result_dfa = transducer->PreImage(this->dfa_, num_of_bdd_variables_, GetBddVariableIndices(num_of_bdd_variables_));
+  StringAutomaton_ptr result_auto = new StringAutomaton(result_dfa, num_of_bdd_variables_);
+  if (rangeAuto not_eq nullptr) {
+    StringAutomaton_ptr tmp_auto = result_auto;
+    result_auto = tmp_auto->Intersect(rangeAuto);
+    delete tmp_auto;
+  }
+
+  DVLOG(VLOG_LEVEL) << result_auto->id_ << " = [" << this->id_ << "]->preTransduce()";
+
+  return result_auto;
+}
+
 StringAutomaton_ptr StringAutomaton::GetAutomatonForVariable(std::string var_name) {
 	if(formula_ == nullptr) {
 		LOG(FATAL) << "No String formula!";
@@ -3050,6 +3503,19 @@ StringAutomaton_ptr StringAutomaton::GetAutomatonForVariable(std::string var_nam
 	return result_auto;
 }
 
+std::map<std::string, StringAutomaton_ptr> StringAutomaton::GetAutomataForAllVariables() {
+	if(formula_ == nullptr) {
+		LOG(FATAL) << "No String formula!";
+	}
+
+	std::map<std::string, StringAutomaton_ptr> result_autos;
+	for(auto& el : formula_->GetVariableCoefficientMap()) {
+		result_autos[el.first] = GetAutomatonForVariable(el.first);
+	}
+	DVLOG(VLOG_LEVEL) << "[" << this->id_ << "]->GetAutomataForAllVariables()";
+	return result_autos;
+}
+
 // handle case where only 1 track, but make sure correct # of variables
 StringAutomaton_ptr StringAutomaton::GetKTrack(int k_track) {
   DFA_ptr res = this->dfa_, temp;
@@ -3205,7 +3671,7 @@ void StringAutomaton::SetSymbolicCounter() {
 	char* statuses = new char[original_dfa->ns+1];
 	std::vector<std::pair<std::vector<char>,int>> state_exeps;
 	std::vector<bool> lambda_states(original_dfa->ns,false);
-	dfaSetup(original_dfa->ns,len,mindices);
+	DFABuilder builder(original_dfa->ns,len,mindices);
 	for(int i = 0; i < original_dfa->ns; i++) {
 		statuses[i] = '-';
 		state_paths = pp = make_paths(original_dfa->bddm, original_dfa->q[i]);
@@ -3246,16 +3712,16 @@ void StringAutomaton::SetSymbolicCounter() {
 			pp = pp->next;
 		}
 		kill_paths(state_paths);
-		dfaAllocExceptions(state_exeps.size());
+		builder.AllocExceptions(state_exeps.size());
 		for(int k = 0; k < state_exeps.size(); k++) {
-			dfaStoreException(state_exeps[k].second, &state_exeps[k].first[0]);
+			builder.StoreException(state_exeps[k].second, &state_exeps[k].first[0]);
 		}
-		dfaStoreState(sink);
+		builder.StoreState(sink);
 		state_exeps.clear();
 	}
 	statuses[original_dfa->ns] = '\0';
-	temp_dfa = dfaBuild(statuses);
-	trimmed_dfa = dfaMinimize(temp_dfa);
+	temp_dfa = builder.Build(statuses);
+	trimmed_dfa = DFAMinimize(temp_dfa);
 	dfaFree(temp_dfa);
 	//delete[] mindices;
 	delete[] statuses;
@@ -3453,7 +3919,7 @@ std::map<std::string,std::vector<std::string>> StringAutomaton::GetModelsWithinB
       // therefor, if to_state is a final state, and the current_length is <= bound, then we record the previous track_characters
       // and don't new transitions!
       if(this->dfa_->f[to_state] == 1) {
-        if((count_bound_exact_ and length == bound) or (not count_bound_exact_ and length <= bound)) {
+        if((Option::Theory::COUNT_BOUND_EXACT and length == bound) or (not Option::Theory::COUNT_BOUND_EXACT and length <= bound)) {
           
           int max_x = 0;
           // each track can have differing number of x's
@@ -3775,8 +4241,12 @@ const StringAutomaton::TransitionVector& StringAutomaton::GenerateTransitionsFor
   bits_per_var--;
   // check table for precomputed value first
   std::pair<int,StringFormula::Type> key(bits_per_var,type);
-  if(TRANSITION_TABLE.find(key) != TRANSITION_TABLE.end()) {
-    return TRANSITION_TABLE[key];
+  {
+    std::lock_guard<std::mutex> lock(TRANSITION_TABLE_MUTEX);
+    auto it = TRANSITION_TABLE.find(key);
+    if (it != TRANSITION_TABLE.end()) {
+      return it->second;
+    }
   }
 
   // not previously computed; compute now and cache for later.
@@ -3848,10 +4318,9 @@ const StringAutomaton::TransitionVector& StringAutomaton::GenerateTransitionsFor
     next.pop();
   }
 
-  // cache the transitions for later
-  TRANSITION_TABLE[key] = good_trans;
-
-  return TRANSITION_TABLE[key];
+  // cache the transitions for later, entries are never removed so the reference stays valid
+  std::lock_guard<std::mutex> lock(TRANSITION_TABLE_MUTEX);
+  return TRANSITION_TABLE.insert(std::make_pair(key, good_trans)).first->second;
 }
 
 DFA_ptr StringAutomaton::MakeBinaryRelationDfa(StringFormula::Type type, int bits_per_var, int num_tracks, int left_track, int right_track) {
@@ -3952,34 +4421,33 @@ DFA_ptr StringAutomaton::MakeBinaryRelationDfa(StringFormula::Type type, int bit
   exeps.push_back(std::make_pair(str,left));
 
 
-  dfaSetup(4,len,mindices);
-  dfaAllocExceptions(exeps.size());
+  DFABuilder builder(4,len,mindices);
+  builder.AllocExceptions(exeps.size());
   for(int i = 0; i < exeps.size(); i++) {
-    dfaStoreException(exeps[i].second, &(exeps[i].first)[0]);
+    builder.StoreException(exeps[i].second, &(exeps[i].first)[0]);
   }
-  dfaStoreState(sink);
+  builder.StoreState(sink);
   exeps.clear();
 
-  dfaAllocExceptions(0);
-  dfaStoreState(left);
+  builder.AllocExceptions(0);
+  builder.StoreState(left);
 
-  dfaAllocExceptions(0);
-  dfaStoreState(right);
+  builder.AllocExceptions(0);
+  builder.StoreState(right);
 
   // sink
-  dfaAllocExceptions(0);
-  dfaStoreState(sink);
+  builder.AllocExceptions(0);
+  builder.StoreState(sink);
 
   // build it!
-  temp_dfa = dfaBuild(statuses);
-  result_dfa = dfaMinimize(temp_dfa);
-  dfaFree(temp_dfa);
+  temp_dfa = builder.Build(statuses);
+  result_dfa = DFAMinimizeIntermediate(temp_dfa);
 
   aligned_dfa = MakeBinaryAlignedDfa(left_track,right_track,num_tracks);
-  temp_dfa = dfaProduct(result_dfa,aligned_dfa,dfaAND);
+  temp_dfa = DFAProduct(result_dfa,aligned_dfa,dfaAND);
 
   dfaFree(result_dfa);
-  result_dfa = dfaMinimize(temp_dfa);
+  result_dfa = DFAMinimize(temp_dfa);
   dfaFree(temp_dfa);
   dfaFree(aligned_dfa);
 
@@ -3999,7 +4467,7 @@ DFA_ptr StringAutomaton::MakeBinaryAlignedDfa(int left_track, int right_track, i
   exep_dont_care[var-1] = '0';
   tv = GenerateTransitionsForRelation(StringFormula::Type::EQ,var);
 
-  dfaSetup(5,len,mindices);
+  DFABuilder builder(5,len,mindices);
 
   // ---- init state
   // if lambda/star goto lambda_star,
@@ -4011,87 +4479,87 @@ DFA_ptr StringAutomaton::MakeBinaryAlignedDfa(int left_track, int right_track, i
   std::vector<char> str(len,'X');
   str.push_back('\0');
 
-  dfaAllocExceptions(4);
+  builder.AllocExceptions(4);
   // x,x
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_dont_care[i];
     str[right_track+num_tracks*i] = exep_dont_care[i];
   }
-  dfaStoreException(init, &str[0]);
+  builder.StoreException(init, &str[0]);
 
   // x,lambda
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_dont_care[i];
     str[right_track+num_tracks*i] = exep_lambda[i];
   }
-  dfaStoreException(star_lambda, &str[0]);
+  builder.StoreException(star_lambda, &str[0]);
 
   // lambda,x
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_lambda[i];
     str[right_track+num_tracks*i] = exep_dont_care[i];
   }
-  dfaStoreException(lambda_star, &str[0]);
+  builder.StoreException(lambda_star, &str[0]);
 
   //lambda,lambda
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_lambda[i];
     str[right_track+num_tracks*i] = exep_lambda[i];
   }
-  dfaStoreException(lambda_lambda, &str[0]);
-  dfaStoreState(sink);
+  builder.StoreException(lambda_lambda, &str[0]);
+  builder.StoreState(sink);
 
   // ---- lambda_star state ----
 
-  dfaAllocExceptions(2);
+  builder.AllocExceptions(2);
   // lambda,x
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_lambda[i];
     str[right_track+num_tracks*i] = exep_dont_care[i];
   }
-  dfaStoreException(lambda_star, &str[0]);
+  builder.StoreException(lambda_star, &str[0]);
   //lambda,lambda
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_lambda[i];
     str[right_track+num_tracks*i] = exep_lambda[i];
   }
-  dfaStoreException(lambda_lambda, &str[0]);
-  dfaStoreState(sink);
+  builder.StoreException(lambda_lambda, &str[0]);
+  builder.StoreState(sink);
 
   // ---- lambda_lambda state ----
 
-  dfaAllocExceptions(1);
+  builder.AllocExceptions(1);
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_lambda[i];
     str[right_track+num_tracks*i] = exep_lambda[i];
   }
-  dfaStoreException(lambda_lambda, &str[0]);
-  dfaStoreState(sink);
+  builder.StoreException(lambda_lambda, &str[0]);
+  builder.StoreState(sink);
 
   // ---- star_lambda state ----
 
-  dfaAllocExceptions(2);
+  builder.AllocExceptions(2);
   // lambda,x
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_dont_care[i];
     str[right_track+num_tracks*i] = exep_lambda[i];
   }
-  dfaStoreException(star_lambda, &str[0]);
+  builder.StoreException(star_lambda, &str[0]);
   //lambda,lambda
   for(int i = 0; i < var; i++) {
     str[left_track+num_tracks*i] = exep_lambda[i];
     str[right_track+num_tracks*i] = exep_lambda[i];
   }
-  dfaStoreException(lambda_lambda, &str[0]);
-  dfaStoreState(sink);
+  builder.StoreException(lambda_lambda, &str[0]);
+  builder.StoreState(sink);
 
   // ---- sink state -----
 
-  dfaAllocExceptions(0);
-  dfaStoreState(sink);
+  builder.AllocExceptions(0);
+  builder.StoreState(sink);
 
-  temp_dfa = dfaBuild("--+--");
-  result_dfa = dfaMinimize(temp_dfa);
+  temp_dfa = builder.Build("--+--");
+  result_dfa = DFAMinimize(temp_dfa);
   dfaFree(temp_dfa);
 
   return result_dfa;
@@ -4110,15 +4578,15 @@ DFA_ptr StringAutomaton::MakeRelationalCharAtDfa(StringFormula_ptr formula, int
 	std::vector<char> exep_lambda(var,'1');
 	TransitionVector tv = GenerateTransitionsForRelation(formula->GetType(),VAR_PER_TRACK);
 
-	dfaSetup(ns,len,mindices);
+	DFABuilder builder(ns,len,mindices);
 	// till index state, dont care
 	for(int i = 0; i < index; i++) {
-		dfaAllocExceptions(0);
-		dfaStoreState(i+1);
+		builder.AllocExceptions(0);
+		builder.StoreState(i+1);
 		statuses[i] = '-';
 	}
 	// index state
-	dfaAllocExceptions(tv.size());
+	builder.AllocExceptions(tv.size());
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for(int k = 0; k < VAR_PER_TRACK; k++ ){
@@ -4126,9 +4594,9 @@ DFA_ptr StringAutomaton::MakeRelationalCharAtDfa(StringFormula_ptr formula, int
 			str[right_track+num_tracks*k] = tv[i].second[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(index+1,&str[0]);
+		builder.StoreException(index+1,&str[0]);
 	}
-	dfaStoreState(sink);
+	builder.StoreState(sink);
 	statuses[index] = '-';
 
 	int lambda_star = index+2;
@@ -4143,7 +4611,7 @@ DFA_ptr StringAutomaton::MakeRelationalCharAtDfa(StringFormula_ptr formula, int
 	//         -> star_lambda,
 	//         -> lambda_lambda
 
-	dfaAllocExceptions(tv.size()*2+1);
+	builder.AllocExceptions(tv.size()*2+1);
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str(len,'X');
 		for (int k = 0; k < var; k++) {
@@ -4151,13 +4619,13 @@ DFA_ptr StringAutomaton::MakeRelationalCharAtDfa(StringFormula_ptr formula, int
 			str[right_track+num_tracks*k] = tv[i].first[k];
 		}
 		str.push_back('\0');
-		dfaStoreException(lambda_star,&str[0]);
+		builder.StoreException(lambda_star,&str[0]);
 
 		for (int k = 0; k < var; k++) {
 			str[left_track+num_tracks*k] = tv[i].first[k];
 			str[right_track+num_tracks*k] = exep_lambda[k];
 		}
-		dfaStoreException(star_lambda,&str[0]);
+		builder.StoreException(star_lambda,&str[0]);
 	}
 
 	// if both are lambda, go to sink
@@ -4168,12 +4636,12 @@ DFA_ptr StringAutomaton::MakeRelationalCharAtDfa(StringFormula_ptr formula, int
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
 	str.push_back('\0');
-	dfaStoreException(lambda_lambda,&str[0]);
-	dfaStoreState(index+1);
+	builder.StoreException(lambda_lambda,&str[0]);
+	builder.StoreState(index+1);
 	statuses[index+1] = '-';
 
 	// lambda_star state
-	dfaAllocExceptions(tv.size()+1);
+	builder.AllocExceptions(tv.size()+1);
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str2(len,'X');
 		for (int k = 0; k < var; k++) {
@@ -4181,19 +4649,19 @@ DFA_ptr StringAutomaton::MakeRelationalCharAtDfa(StringFormula_ptr formula, int
 			str2[right_track+num_tracks*k] = tv[i].first[k];
 		}
 		str2.push_back('\0');
-		dfaStoreException(lambda_star,&str2[0]);
+		builder.StoreException(lambda_star,&str2[0]);
 	}
 
 	for(int k = 0; k < var; k++) {
 		str[left_track+num_tracks*k] = exep_lambda[k];
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
-	dfaStoreException(lambda_lambda,&str[0]);
-	dfaStoreState(sink);
+	builder.StoreException(lambda_lambda,&str[0]);
+	builder.StoreState(sink);
 	statuses[lambda_star] = '-';
 
 	// star_lambda state
-	dfaAllocExceptions(tv.size()+1);
+	builder.AllocExceptions(tv.size()+1);
 	for(int i = 0; i < tv.size(); i++) {
 		std::vector<char> str2(len,'X');
 		for (int k = 0; k < var; k++) {
@@ -4201,31 +4669,30 @@ DFA_ptr StringAutomaton::MakeRelationalCharAtDfa(StringFormula_ptr formula, int
 			str2[right_track+num_tracks*k] = exep_lambda[k];
 		}
 		str2.push_back('\0');
-		dfaStoreException(star_lambda,&str2[0]);
+		builder.StoreException(star_lambda,&str2[0]);
 	}
 	for(int k = 0; k < var; k++) {
 		str[left_track+num_tracks*k] = exep_lambda[k];
 		str[right_track+num_tracks*k] = exep_lambda[k];
 	}
-	dfaStoreException(lambda_lambda,&str[0]);
-	dfaStoreState(sink);
+	builder.StoreException(lambda_lambda,&str[0]);
+	builder.StoreState(sink);
 	statuses[star_lambda] = '-';
 
 	// lambda_lambda state
-	dfaAllocExceptions(1);
-	dfaStoreException(lambda_lambda,&str[0]);
-	dfaStoreState(sink);
+	builder.AllocExceptions(1);
+	builder.StoreException(lambda_lambda,&str[0]);
+	builder.StoreState(sink);
 	statuses[lambda_lambda] = '+';
 
 	// sink state
-	dfaAllocExceptions(0);
-	dfaStoreState(sink);
+	builder.AllocExceptions(0);
+	builder.StoreState(sink);
 	statuses[sink] = '-';
 	statuses[ns] = '\0';
 
-	DFA_ptr temp_dfa = dfaBuild(statuses);
-	DFA_ptr result_dfa = dfaMinimize(temp_dfa);
-	dfaFree(temp_dfa);
+	DFA_ptr temp_dfa = builder.Build(statuses);
+	DFA_ptr result_dfa = DFAMinimizeIntermediate(temp_dfa);
 
 	temp_dfa = MakeBinaryAlignedDfa(left_track,right_track,num_tracks);
 	result_dfa = DFAIntersect(result_dfa,temp_dfa);
@@ -4246,8 +4713,8 @@ StringAutomaton_ptr StringAutomaton::MakePrefixSuffix(int left_track, int prefix
 
   std::vector<char> exep_lambda(var,'1');
   tv = GenerateTransitionsForRelation(StringFormula::Type::EQ, var);
-  dfaSetup(4,len,mindices);
-  dfaAllocExceptions(2*tv.size() + 1); // 1 extra for lambda stuff below
+  DFABuilder builder(4,len,mindices);
+  builder.AllocExceptions(2*tv.size() + 1); // 1 extra for lambda stuff below
   for(int i = 0; i < tv.size(); i++) {
     std::vector<char> str(len,'X');
     for(int k = 0; k < var; k++) {
@@ -4256,7 +4723,7 @@ StringAutomaton_ptr StringAutomaton::MakePrefixSuffix(int left_track, int prefix
       str[suffix_track+num_tracks*k] = exep_lambda[k];
     }
     str.push_back('\0');
-    dfaStoreException(0,&str[0]);
+    builder.StoreException(0,&str[0]);
   }
 
   // if prefix is lambda, left  and suffix same
@@ -4268,7 +4735,7 @@ StringAutomaton_ptr StringAutomaton::MakePrefixSuffix(int left_track, int prefix
       str[suffix_track+num_tracks*k] = tv[i].first[k];
     }
     str.push_back('\0');
-    dfaStoreException(1,&str[0]);
+    builder.StoreException(1,&str[0]);
   }
 
   // if all 3 are lambda, go to next state
@@ -4280,11 +4747,11 @@ StringAutomaton_ptr StringAutomaton::MakePrefixSuffix(int left_track, int prefix
     str[suffix_track+num_tracks*k] = exep_lambda[k];
   }
   str.push_back('\0');
-  dfaStoreException(2,&str[0]);
-  dfaStoreState(3);
+  builder.StoreException(2,&str[0]);
+  builder.StoreState(3);
 
   // left = suffix, prefix lambda, loop back here
-  dfaAllocExceptions(tv.size() + 1);
+  builder.AllocExceptions(tv.size() + 1);
   for(int i = 0; i < tv.size(); i++) {
     std::vector<char> str(len,'X');
     for (int k = 0; k < var; k++) {
@@ -4293,7 +4760,7 @@ StringAutomaton_ptr StringAutomaton::MakePrefixSuffix(int left_track, int prefix
       str[suffix_track+num_tracks*k] = tv[i].first[k];
     }
     str.push_back('\0');
-    dfaStoreException(1,&str[0]);
+    builder.StoreException(1,&str[0]);
   }
 
   // if all 3 lambda, goto 2
@@ -4304,20 +4771,20 @@ StringAutomaton_ptr StringAutomaton::MakePrefixSuffix(int left_track, int prefix
     str[suffix_track+num_tracks*k] = exep_lambda[k];
   }
   str.push_back('\0');
-  dfaStoreException(2,&str[0]);
-  dfaStoreState(3);
+  builder.StoreException(2,&str[0]);
+  builder.StoreState(3);
 
   // lambda/lambda state, loop back on lambda
-  dfaAllocExceptions(1);
-  dfaStoreException(2,&str[0]);
-  dfaStoreState(3);
+  builder.AllocExceptions(1);
+  builder.StoreException(2,&str[0]);
+  builder.StoreState(3);
 
   // sink
-  dfaAllocExceptions(0);
-  dfaStoreState(3);
+  builder.AllocExceptions(0);
+  builder.StoreState(3);
 
-  temp_dfa = dfaBuild("--+-");
-  result_dfa = dfaMinimize(temp_dfa);
+  temp_dfa = builder.Build("--+-");
+  result_dfa = DFAMinimize(temp_dfa);
   dfaFree(temp_dfa);
   result_auto = new StringAutomaton(result_dfa,num_tracks,num_tracks*VAR_PER_TRACK);
 
@@ -4378,9 +4845,7 @@ DFA_ptr StringAutomaton::PrependLambda(DFA_ptr dfa, int var) {
     LOG(FATAL) << "mismatched incoming var";
   }
   DFA_ptr M = dfa, temp = nullptr, result = nullptr;
-  trace_descr tp;
-  paths state_paths, pp;
-  std::vector<std::pair<std::vector<char>,int>> state_exeps;
+  std::vector<std::pair<std::string,int>> state_exeps;
   int num_states = M->ns+1;
   int sink = Automaton::find_sink(M);
   bool has_sink = true;
@@ -4401,38 +4866,28 @@ DFA_ptr StringAutomaton::PrependLambda(DFA_ptr dfa, int var) {
   statuses = new char[num_states+1];
 
   // begin dfa building process
-  dfaSetup(num_states, len, mindices);
+  DFABuilder builder(num_states, len, mindices);
+
+  // lambda bit is '0' for the original transitions
+  TernaryException curr(len);
+  curr.SetBit(var, false);
+  auto add_shifted_exception = [&](const int to, const TernaryException& exception) {
+    if(to != sink-1) {
+      state_exeps.push_back(std::make_pair(exception.ToString(),to+1));
+    }
+  };
 
   // setup for initial state
-  state_paths = pp = make_paths(M->bddm, M->q[0]);
-  while(pp) {
-    if(pp->to != sink-1) {
-      std::vector<char> curr(len,'0');
-      for(unsigned j = 0; j < var; j++) {
-        for(tp = pp->trace; tp && (tp->index != mindices[j]); tp = tp->next);
-        if(tp) {
-          if(tp->value) curr[j] = '1';
-          else curr[j] = '0';
-        }
-        else
-          curr[j] = 'X';
-      }
-      curr.push_back('\0');
-      state_exeps.push_back(std::make_pair(curr,pp->to+1));
-    }
-    pp = pp->next;
-  }
-  kill_paths(state_paths);
+  DFAForEachPath(M, 0, curr, add_shifted_exception);
 
   // add lambda loop to self
-  std::vector<char> str(len,'1');
-  str.push_back('\0');
+  std::string str(len,'1');
   state_exeps.push_back(std::make_pair(str,0));
-  dfaAllocExceptions(state_exeps.size());
+  builder.AllocExceptions(state_exeps.size());
   for(unsigned k = 0; k < state_exeps.size(); ++k) {
-    dfaStoreException(state_exeps[k].second,&state_exeps[k].first[0]);
+    builder.StoreException(state_exeps[k].second,&state_exeps[k].first[0]);
   }
-  dfaStoreState(sink);
+  builder.StoreState(sink);
 
   state_exeps.clear();
   if(M->f[0] == 1) {
@@ -4443,32 +4898,13 @@ DFA_ptr StringAutomaton::PrependLambda(DFA_ptr dfa, int var) {
 
   // rest of states (shift 1)
   for(unsigned i = 0; i < M->ns; i++) {
-    state_paths = pp = make_paths(M->bddm, M->q[i]);
-
-    while(pp) {
-      if(pp->to != sink-1) {
-        std::vector<char> curr(len,'0');
-        for(unsigned j = 0; j < var; j++) {
-          for(tp = pp->trace; tp && (tp->index != mindices[j]); tp = tp->next);
-          if(tp) {
-            if(tp->value) curr[j] = '1';
-            else curr[j] = '0';
-          }
-          else
-            curr[j] = 'X';
-        }
-        curr.push_back('\0');
-        state_exeps.push_back(std::make_pair(curr,pp->to+1));
-      }
-      pp = pp->next;
-    }
-    kill_paths(state_paths);
+    DFAForEachPath(M, i, curr, add_shifted_exception);
 
-    dfaAllocExceptions(state_exeps.size());
+    builder.AllocExceptions(state_exeps.size());
     for(unsigned k = 0; k < state_exeps.size(); ++k) {
-      dfaStoreException(state_exeps[k].second,&state_exeps[k].first[0]);
+      builder.StoreException(state_exeps[k].second,&state_exeps[k].first[0]);
     }
-    dfaStoreState(sink);
+    builder.StoreState(sink);
     state_exeps.clear();
 
     if(M->f[i] == 1) {
@@ -4481,14 +4917,14 @@ DFA_ptr StringAutomaton::PrependLambda(DFA_ptr dfa, int var) {
   }
 
   if(!has_sink) {
-    dfaAllocExceptions(0);
-    dfaStoreState(sink);
+    builder.AllocExceptions(0);
+    builder.StoreState(sink);
     statuses[sink] = '-';
   }
 
   statuses[num_states] = '\0';
-  temp = dfaBuild(statuses);
-  result = dfaMinimize(temp);
+  temp = builder.Build(statuses);
+  result = DFAMinimize(temp);
   dfaFree(temp);
 
   delete[] statuses;
@@ -4576,7 +5012,7 @@ DFA_ptr StringAutomaton::TrimLambdaPrefix(DFA_ptr dfa, int var, bool project_bit
     }
   }
 
-  dfaSetup(num_states,len,indices);
+  DFABuilder builder(num_states,len,indices);
   // setup new "initial" state first
   for(int i = 0; i < reachable.size(); i++) {
     state_paths = pp = make_paths(dfa->bddm, dfa->q[reachable[i]]);
@@ -4610,11 +5046,11 @@ DFA_ptr StringAutomaton::TrimLambdaPrefix(DFA_ptr dfa, int var, bool project_bit
     kill_paths(state_paths);
   }
 
-  dfaAllocExceptions(state_exeps.size());
+  builder.AllocExceptions(state_exeps.size());
   for(int i = 0; i < state_exeps.size(); i++) {
-    dfaStoreException(state_exeps[i].second,&state_exeps[i].first[0]);
+    builder.StoreException(state_exeps[i].second,&state_exeps[i].first[0]);
   }
-  dfaStoreState(sink+1);
+  builder.StoreState(sink+1);
   state_exeps.clear();
 
   // continue with rest of states
@@ -4650,11 +5086,11 @@ DFA_ptr StringAutomaton::TrimLambdaPrefix(DFA_ptr dfa, int var, bool project_bit
     }
     kill_paths(state_paths);
 
-    dfaAllocExceptions(state_exeps.size());
+    builder.AllocExceptions(state_exeps.size());
     for(int j = 0; j < state_exeps.size(); j++) {
-      dfaStoreException(state_exeps[j].second, &state_exeps[j].first[0]);
+      builder.StoreException(state_exeps[j].second, &state_exeps[j].first[0]);
     }
-    dfaStoreState(sink+1);
+    builder.StoreState(sink+1);
     state_exeps.clear();
 
     if(dfa->f[i] == 1) {
@@ -4664,9 +5100,8 @@ DFA_ptr StringAutomaton::TrimLambdaPrefix(DFA_ptr dfa, int var, bool project_bit
 
   statuses[num_states] = '\0';
 
-  temp_dfa = dfaBuild(statuses);
-  result_dfa = dfaMinimize(temp_dfa);
-  dfaFree(temp_dfa);
+  temp_dfa = builder.Build(statuses);
+  result_dfa = DFAMinimizeIntermediate(temp_dfa);
   if(project_bit) {
     // project away the last bit as well
     num_bits++;
@@ -4674,11 +5109,11 @@ DFA_ptr StringAutomaton::TrimLambdaPrefix(DFA_ptr dfa, int var, bool project_bit
 
   for(int i = 0; i < num_bits; i++) {
     int bit = len-i-1;
-    temp_dfa = dfaProject(result_dfa,(unsigned)bit);
+    temp_dfa = DFAProject(result_dfa,(unsigned)bit);
     dfaFree(result_dfa);
-    result_dfa = dfaMinimize(temp_dfa);
-    dfaFree(temp_dfa);
+    result_dfa = DFAMinimizeIntermediate(temp_dfa);
   }
+  result_dfa = DFAMinimizeDeferred(result_dfa);
 
   delete[] statuses;
 
@@ -4701,7 +5136,7 @@ DFA_ptr StringAutomaton::TrimLambdaSuffix(DFA_ptr dfa, int var, bool project_bit
 
   std::vector<std::pair<std::vector<char>,int>> state_exeps;
   std::vector<char> lambda_vec(var,'1');
-  dfaSetup(dfa->ns, var, indices);
+  DFABuilder builder(dfa->ns, var, indices);
   for(int i = 0; i < dfa->ns; i++) {
     state_paths = pp = make_paths(dfa->bddm, dfa->q[i]);
     statuses[i] = '-';
@@ -4735,25 +5170,24 @@ DFA_ptr StringAutomaton::TrimLambdaSuffix(DFA_ptr dfa, int var, bool project_bit
     }
     kill_paths(state_paths);
 
-    dfaAllocExceptions(state_exeps.size());
+    builder.AllocExceptions(state_exeps.size());
     for (unsigned k = 0; k < state_exeps.size(); k++) {
-      dfaStoreException(state_exeps[k].second,&state_exeps[k].first[0]);
+      builder.StoreException(state_exeps[k].second,&state_exeps[k].first[0]);
     }
-    dfaStoreState(sink);
+    builder.StoreState(sink);
     state_exeps.clear();
   }
   statuses[dfa->ns] = '\0';
-  temp = dfaBuild(statuses);
-  result_dfa = dfaMinimize(temp);
-  dfaFree(temp);
+  temp = builder.Build(statuses);
+  result_dfa = DFAMinimizeIntermediate(temp);
 
   if(project_bit) {
     // project away extra bit
-    temp = dfaProject(result_dfa, var - 1);
+    temp = DFAProject(result_dfa, var - 1);
     dfaFree(result_dfa);
-    result_dfa = dfaMinimize(temp);
-    dfaFree(temp);
+    result_dfa = DFAMinimizeIntermediate(temp);
   }
+  result_dfa = DFAMinimizeDeferred(result_dfa);
 
   delete[] statuses;
 
@@ -4783,7 +5217,7 @@ DFA_ptr StringAutomaton::TrimPrefix(DFA_ptr subject_dfa, DFA_ptr trim_dfa, int v
 
   // 3rd track has lambda prefix, so get it (automatically removes lambda prefix/suffix)
   result_string_auto = intersect_multi->GetKTrack(2);
-  result_dfa = dfaCopy(result_string_auto->getDFA());
+  result_dfa = DFACopy(result_string_auto->getDFA());
   delete intersect_multi;
   delete result_string_auto;
 
@@ -4815,7 +5249,7 @@ DFA_ptr StringAutomaton::TrimSuffix(DFA_ptr subject_dfa, DFA_ptr trim_dfa, int v
   delete trim_multi;
 
   result_string_auto = intersect_multi->GetKTrack(1);
-  result_dfa = dfaCopy(result_string_auto->getDFA());
+  result_dfa = DFACopy(result_string_auto->getDFA());
   delete intersect_multi;
   delete result_string_auto;
 
@@ -4845,7 +5279,7 @@ DFA_ptr StringAutomaton::concat(DFA_ptr prefix_dfa, DFA_ptr suffix_dfa, int var)
   delete temp_multi;
   delete suffix_multi;
 	result_string_auto = intersect_multi->GetKTrack(0);
-	result_dfa = dfaCopy(result_string_auto->getDFA());
+	result_dfa = DFACopy(result_string_auto->getDFA());
 
   delete intersect_multi;
   delete result_string_auto;
@@ -4922,6 +5356,74 @@ StringAutomaton_ptr StringAutomaton::IndexOfHelper(StringAutomaton_ptr search_au
 	return index_of_auto;
 }
 
+StringAutomaton_ptr StringAutomaton::IndexOfHelper(const std::string& search) {
+  CHECK(not search.empty());
+  std::vector<bool> is_live;
+  auto transitions = GetTransitionTable(is_live);
+  std::vector<std::vector<int>> matched_patterns;
+  auto kmp_transitions = MakeAhoCorasickTable({search}, num_of_bdd_variables_, matched_patterns);
+  const std::size_t alphabet_size = kmp_transitions[0].size();
+  const int search_length = search.size(); // state i of a single pattern is its prefix of length i
+
+  // a match can start after kmp state j only if reading the search string from j does not complete an earlier match
+  std::vector<bool> can_start_match (search_length, true);
+  for (int j = 0; j < search_length; ++j) {
+    int kmp_state = j;
+    for (int i = 0; i + 1 < search_length and can_start_match[j]; ++i) {
+      kmp_state = kmp_transitions[kmp_state][(unsigned char)search[i]];
+      can_start_match[j] = (kmp_state != search_length);
+    }
+  }
+
+  // pairs of state of this automaton and kmp state, (-1, 0) is the sink
+  std::map<std::pair<int, int>, int> state_ids;
+  std::vector<std::pair<int, int>> states;
+  auto get_state = [&](const std::pair<int, int>& key) {
+    auto it = state_ids.find(key);
+    if (it != state_ids.end()) {
+      return it->second;
+    }
+    int id = states.size();
+    state_ids[key] = id;
+    states.push_back(key);
+    return id;
+  };
+
+  std::vector<std::vector<int>> index_of_transitions;
+  std::string statuses;
+  get_state(is_live[this->dfa_->s] ? std::make_pair(this->dfa_->s, 0) : std::make_pair(-1, 0));
+  for (std::size_t s = 0; s < states.size(); ++s) {
+    const int state = states[s].first, kmp_state = states[s].second;
+    std::vector<int> next_states (alphabet_size, -1);
+    bool is_final = false;
+    if (state == -1) {
+      std::fill(next_states.begin(), next_states.end(), s);
+    } else {
+      for (std::size_t c = 0; c < alphabet_size; ++c) {
+        const int next_state = transitions[state][c], next_kmp_state = kmp_transitions[kmp_state][c];
+        if (is_live[next_state] and next_kmp_state != search_length) {
+          next_states[c] = get_state(std::make_pair(next_state, next_kmp_state));
+        } else {
+          next_states[c] = get_state(std::make_pair(-1, 0));
+        }
+      }
+      if (can_start_match[kmp_state]) {
+        int match_state = state;
+        for (auto ch : search) {
+          match_state = transitions[match_state][(unsigned char)ch];
+        }
+        is_final = is_live[match_state];
+      }
+    }
+    index_of_transitions.push_back(next_states);
+    statuses.push_back(is_final ? '+' : '-');
+  }
+
+  auto index_of_auto = new StringAutomaton(MakeDfaFromTable(index_of_transitions, statuses, num_of_bdd_variables_), num_of_bdd_variables_);
+  DVLOG(VLOG_LEVEL) << index_of_auto->id_ << " = [" << this->id_ << "]->indexOfHelper(" << search << ")";
+  return index_of_auto;
+}
+
 /**
  * @param search automaton is an automaton that does not accept empty string
  * @this is an automaton that is known to be contains search automaton
@@ -5036,7 +5538,7 @@ StringAutomaton_ptr StringAutomaton::GetDuplicateStateAutomaton() {
 	char *statuses = new char[number_of_states + 1];
 	bool sink_state_allocated = false;
 
-	dfaSetup(number_of_states, number_of_variables, indices);
+	DFABuilder builder(number_of_states, number_of_variables, indices);
 	for (int s = 0; s < original_num_states; s++) {
 		if (s != sink_state) {
 			state_paths = pp = make_paths(this->dfa_->bddm, this->dfa_->q[s]);
@@ -5085,33 +5587,33 @@ StringAutomaton_ptr StringAutomaton::GetDuplicateStateAutomaton() {
 				duplicated_state_id++;
 			}
 			// do allocation for current states
-			dfaAllocExceptions(exceptions.size() + 1);
+			builder.AllocExceptions(exceptions.size() + 1);
 			for (auto entry : exceptions) {
-				dfaStoreException(entry.second, &*entry.first->begin());
+				builder.StoreException(entry.second, &*entry.first->begin());
 			}
-			dfaStoreException(duplicated_state_id, &*sharp1.begin()); // to duplicated state
-			dfaStoreState(sink_state);
+			builder.StoreException(duplicated_state_id, &*sharp1.begin()); // to duplicated state
+			builder.StoreState(sink_state);
 			// sink state id is between map_state_id and duplicate_state_id allocate sink state first;
 			if ((not sink_state_allocated) and (duplicated_state_id - 1) == sink_state ) {
-				dfaAllocExceptions(0);
-				dfaStoreState(sink_state);
+				builder.AllocExceptions(0);
+				builder.StoreState(sink_state);
 				statuses[sink_state] = '-';
 				sink_state_allocated = true;
 			}
 			// do allocation for duplicated states
-			dfaAllocExceptions(exceptions.size() + 1);
+			builder.AllocExceptions(exceptions.size() + 1);
 			for (auto it = exceptions.begin(); it != exceptions.end();) {
 				to_duplicate_state = it->second + 1;
 				if (to_duplicate_state == sink_state) {
 					to_duplicate_state++;
 				}
-				dfaStoreException(to_duplicate_state, &*it->first->begin());
+				builder.StoreException(to_duplicate_state, &*it->first->begin());
 				current_exception = it->first;
 				it = exceptions.erase(it);
 				delete current_exception;
 			}
-			dfaStoreException(mapped_state_id, &*sharp0.begin()); // to original state
-			dfaStoreState(sink_state);
+			builder.StoreException(mapped_state_id, &*sharp0.begin()); // to original state
+			builder.StoreState(sink_state);
 			// update final states
 			if (this->dfa_->f[s] == 1) {
 				statuses[mapped_state_id] = '+';
@@ -5128,15 +5630,15 @@ StringAutomaton_ptr StringAutomaton::GetDuplicateStateAutomaton() {
 			exceptions.clear();
 			current_exception = nullptr;
 		} else if (not sink_state_allocated) {
-			dfaAllocExceptions(0);
-			dfaStoreState(sink_state);
+			builder.AllocExceptions(0);
+			builder.StoreState(sink_state);
 			statuses[sink_state] = '-';
 			sink_state_allocated = true;
 		}
 	}
 
 	statuses[number_of_states] = '\0';
-	result_dfa = dfaBuild(statuses);
+	result_dfa = builder.Build(statuses);
 
 	duplicated_auto = new StringAutomaton(result_dfa, number_of_variables);
 	delete[] statuses;
@@ -5204,7 +5706,7 @@ StringAutomaton_ptr StringAutomaton::ToQueryAutomaton() {
 	sink_state += shift;
 	statuses = new char[number_of_states + 1];
 
-	dfaSetup(number_of_states, number_of_variables, indices);
+	DFABuilder builder(number_of_states, number_of_variables, indices);
 
 	// Construct not contains automaton part
 	for (int s = 0, new_state_id = 0; s < not_contains_auto->dfa_->ns; s++) {
@@ -5241,25 +5743,25 @@ StringAutomaton_ptr StringAutomaton::ToQueryAutomaton() {
 			}
 
 			if (not_contains_auto->dfa_->f[s] == 1) {
-				dfaAllocExceptions(exceptions.size() + 1);
+				builder.AllocExceptions(exceptions.size() + 1);
 				for (auto it = exceptions.begin(); it != exceptions.end();) {
-					dfaStoreException(it->second, &*it->first->begin());
+					builder.StoreException(it->second, &*it->first->begin());
 					current_exception = it->first;
 					it = exceptions.erase(it);
 					delete current_exception;
 				}
-				dfaStoreException(shift, &*sharp1.begin());
-				dfaStoreState(sink_state);
+				builder.StoreException(shift, &*sharp1.begin());
+				builder.StoreState(sink_state);
 				statuses[new_state_id] = '+';
 			} else {
-				dfaAllocExceptions(exceptions.size());
+				builder.AllocExceptions(exceptions.size());
 				for (auto it = exceptions.begin(); it != exceptions.end();) {
-					dfaStoreException(it->second, &*it->first->begin());
+					builder.StoreException(it->second, &*it->first->begin());
 					current_exception = it->first;
 					it = exceptions.erase(it);
 					delete current_exception;
 				}
-				dfaStoreState(sink_state);
+				builder.StoreState(sink_state);
 				statuses[new_state_id] = '-';
 			}
 
@@ -5302,40 +5804,40 @@ StringAutomaton_ptr StringAutomaton::ToQueryAutomaton() {
 			}
 
 			if (this->dfa_->f[s] == 1) {
-				dfaAllocExceptions(exceptions.size() + 1);
+				builder.AllocExceptions(exceptions.size() + 1);
 				for (auto it = exceptions.begin(); it != exceptions.end();) {
-					dfaStoreException(it->second, &*it->first->begin());
+					builder.StoreException(it->second, &*it->first->begin());
 					current_exception = it->first;
 					it = exceptions.erase(it);
 					delete current_exception;
 				}
-				dfaStoreException(0, &*sharp0.begin()); // add sharp0 to the initial state of not_contains auto
-				dfaStoreState(sink_state);
+				builder.StoreException(0, &*sharp0.begin()); // add sharp0 to the initial state of not_contains auto
+				builder.StoreState(sink_state);
 //        statuses[s + shift] = '0'; // TODO decide on don't care or reject
 				statuses[s + shift] = '-';
 			} else {
-				dfaAllocExceptions(exceptions.size());
+				builder.AllocExceptions(exceptions.size());
 				for (auto it = exceptions.begin(); it != exceptions.end();) {
-					dfaStoreException(it->second, &*it->first->begin());
+					builder.StoreException(it->second, &*it->first->begin());
 					current_exception = it->first;
 					it = exceptions.erase(it);
 					delete current_exception;
 				}
-				dfaStoreState(sink_state);
+				builder.StoreState(sink_state);
 				statuses[s + shift] = '-';
 			}
 			kill_paths(state_paths);
 			state_paths = pp = nullptr;
 			exceptions.clear();
 		} else {
-			dfaAllocExceptions(0);
-			dfaStoreState(sink_state);
+			builder.AllocExceptions(0);
+			builder.StoreState(sink_state);
 			statuses[sink_state] = '-';
 		}
 	}
 
 	statuses[number_of_states] = '\0';
-	result_dfa = dfaBuild(statuses);
+	result_dfa = builder.Build(statuses);
 	delete[] statuses;
 	//delete[] indices;
 
@@ -5447,7 +5949,7 @@ StringAutomaton_ptr StringAutomaton::RemoveReservedWords() {
 	int number_of_extra_bits_needed = number_of_variables - this->num_of_bdd_variables_;
 	std::vector<char>* current_exception = nullptr;
 
-	dfaSetup(number_of_states, number_of_variables, indices);
+	DFABuilder builder(number_of_states, number_of_variables, indices);
 	for (int s = 0; s < number_of_states; s++) {
 		if (merged_states_via_reserved_words.find(s) != merged_states_via_reserved_words.end()) {
 			statuses[s] = '-'; // initially
@@ -5496,30 +5998,30 @@ StringAutomaton_ptr StringAutomaton::RemoveReservedWords() {
 				extra_bits_value++;
 			}
 //       do allocation for merged states
-			dfaAllocExceptions(exceptions.size());
+			builder.AllocExceptions(exceptions.size());
 			for (auto it = exceptions.begin(); it != exceptions.end();) {
-				dfaStoreException(it->second, &*it->first->begin());
+				builder.StoreException(it->second, &*it->first->begin());
 				current_exception = it->first;
 				it = exceptions.erase(it);
 				delete current_exception;
 			}
 			current_exception = nullptr;
-			dfaStoreState(sink_state);
+			builder.StoreState(sink_state);
 			current_exception = nullptr;
 			extra_bits_value = 0;
 		} else {
 			// a state to remove
-			dfaAllocExceptions(0);
-			dfaStoreState(s);
+			builder.AllocExceptions(0);
+			builder.StoreState(s);
 			statuses[s] = '-';
 		}
 	}
 
 	statuses[number_of_states] = '\0';
-	result_dfa = dfaBuild(statuses);
+	result_dfa = builder.Build(statuses);
 	//delete[] indices;
 	delete[] statuses;
-	string_auto = new StringAutomaton(dfaMinimize(result_dfa), number_of_variables);
+	string_auto = new StringAutomaton(DFAMinimize(result_dfa), number_of_variables);
 	dfaFree(result_dfa); result_dfa = nullptr;
 
 	while (number_of_extra_bits_needed > 0) {
@@ -5532,6 +6034,201 @@ StringAutomaton_ptr StringAutomaton::RemoveReservedWords() {
 	return string_auto;
 }
 
+std::vector<std::vector<int>> StringAutomaton::MakeAhoCorasickTable(const std::vector<std::string>& patterns, const int number_of_bdd_variables, std::vector<std::vector<int>>& matched_patterns) {
+  const unsigned long alphabet_size = 1UL << number_of_bdd_variables;
+  std::vector<std::vector<int>> transitions (1, std::vector<int>(alphabet_size, -1));
+  matched_patterns.assign(1, std::vector<int>());
+  for (std::size_t p = 0; p < patterns.size(); ++p) {
+    int state = 0;
+    for (auto ch : patterns[p]) {
+      unsigned long c = (unsigned char) ch;
+      CHECK_LT(c, alphabet_size);
+      if (transitions[state][c] == -1) {
+        transitions[state][c] = transitions.size();
+        transitions.push_back(std::vector<int>(alphabet_size, -1));
+        matched_patterns.push_back(std::vector<int>());
+      }
+      state = transitions[state][c];
+    }
+    matched_patterns[state].push_back(p);
+  }
+
+  // breadth first, failure state of a state is always completed before the state itself
+  std::vector<int> failure (transitions.size(), 0);
+  std::queue<int> states;
+  for (unsigned long c = 0; c < alphabet_size; ++c) {
+    int next_state = transitions[0][c];
+    if (next_state == -1) {
+      transitions[0][c] = 0;
+    } else {
+      states.push(next_state);
+    }
+  }
+  while (not states.empty()) {
+    int state = states.front();
+    states.pop();
+    auto& failure_matches = matched_patterns[failure[state]];
+    matched_patterns[state].insert(matched_patterns[state].end(), failure_matches.begin(), failure_matches.end());
+    for (unsigned long c = 0; c < alphabet_size; ++c) {
+      int next_state = transitions[state][c];
+      if (next_state == -1) {
+        transitions[state][c] = transitions[failure[state]][c];
+      } else {
+        failure[next_state] = transitions[failure[state]][c];
+        states.push(next_state);
+      }
+    }
+  }
+  return transitions;
+}
+
+DFA_ptr StringAutomaton::MakeDfaFromTable(const std::vector<std::vector<int>>& transitions, std::string statuses, const int number_of_bdd_variables) {
+  const int number_of_states = transitions.size();
+  DFABuilder builder(number_of_states, number_of_bdd_variables, GetBddVariableIndices(number_of_bdd_variables));
+  for (int s = 0; s < number_of_states; ++s) {
+    std::map<int, RegexCompiler::CharSet> targets;
+    for (std::size_t c = 0; c < transitions[s].size(); ++c) {
+      targets[transitions[s][c]].set(c);
+    }
+    // the target reached with most characters becomes the default transition
+    auto default_target = targets.begin();
+    for (auto it = targets.begin(); it != targets.end(); ++it) {
+      if (it->second.count() > default_target->second.count()) {
+        default_target = it;
+      }
+    }
+
+    std::vector<std::pair<int, std::string>> exceptions;
+    for (auto it = targets.begin(); it != targets.end(); ++it) {
+      if (it == default_target) {
+        continue;
+      }
+      for (auto& path : RegexCompiler::GetExceptions(it->second, number_of_bdd_variables)) {
+        exceptions.push_back(std::make_pair(it->first, path));
+      }
+    }
+    builder.AllocExceptions(exceptions.size());
+    for (auto& exception : exceptions) {
+      builder.StoreException(exception.first, &exception.second[0]);
+    }
+    builder.StoreState(default_target->first);
+  }
+
+  DFA_ptr table_dfa = builder.Build(&statuses[0]);
+  DFA_ptr result_dfa = DFAMinimize(table_dfa);
+  dfaFree(table_dfa);
+  return result_dfa;
+}
+
+std::vector<std::vector<int>> StringAutomaton::GetTransitionTable(std::vector<bool>& is_live) {
+  auto transitions = Transducer::GetTransitionTable(this->dfa_, this->num_of_bdd_variables_, GetBddVariableIndices(this->num_of_bdd_variables_));
+  std::vector<std::vector<int>> predecessors (transitions.size());
+  for (std::size_t s = 0; s < transitions.size(); ++s) {
+    for (auto next_state : transitions[s]) {
+      if (predecessors[next_state].empty() or predecessors[next_state].back() != (int)s) {
+        predecessors[next_state].push_back(s);
+      }
+    }
+  }
+
+  is_live.assign(transitions.size(), false);
+  std::stack<int> state_work_list;
+  for (std::size_t s = 0; s < transitions.size(); ++s) {
+    if (IsAcceptingState(s)) {
+      is_live[s] = true;
+      state_work_list.push(s);
+    }
+  }
+  while (not state_work_list.empty()) {
+    int current_state = state_work_list.top(); state_work_list.pop();
+    for (auto previous_state : predecessors[current_state]) {
+      if (not is_live[previous_state]) {
+        is_live[previous_state] = true;
+        state_work_list.push(previous_state);
+      }
+    }
+  }
+  return transitions;
+}
+
+StringAutomaton_ptr StringAutomaton::SuffixesFromToDirect(const int min_walk, const int max_walk, const int length, const bool accept_empty_if_final) {
+  std::vector<bool> is_live;
+  auto transitions = GetTransitionTable(is_live);
+  const std::size_t alphabet_size = transitions[0].size();
+
+  // live states reachable from the initial state, sets of states after min_walk repeat periodically
+  std::set<int> start_states, current_states;
+  std::set<std::set<int>> visited;
+  if (is_live[this->dfa_->s]) {
+    current_states.insert(this->dfa_->s);
+  }
+  for (int walk = 0; walk <= max_walk and not current_states.empty(); ++walk) {
+    if (walk >= min_walk) {
+      if (not visited.insert(current_states).second) {
+        break;
+      }
+      start_states.insert(current_states.begin(), current_states.end());
+    }
+    std::set<int> next_states;
+    for (auto s : current_states) {
+      for (auto next_state : transitions[s]) {
+        if (is_live[next_state]) {
+          next_states.insert(next_state);
+        }
+      }
+    }
+    current_states = next_states;
+  }
+
+  // subset construction, depth is the number of characters read and stays 0 when length is not bounded
+  std::map<std::pair<std::set<int>, int>, int> state_ids;
+  std::vector<std::pair<std::set<int>, int>> states;
+  auto get_state = [&](const std::set<int>& subset, const int depth) {
+    auto key = std::make_pair(subset, subset.empty() ? 0 : depth);
+    auto it = state_ids.find(key);
+    if (it != state_ids.end()) {
+      return it->second;
+    }
+    int id = states.size();
+    state_ids[key] = id;
+    states.push_back(key);
+    return id;
+  };
+
+  std::vector<std::vector<int>> subset_transitions;
+  std::string statuses;
+  get_state(start_states, 0);
+  for (std::size_t s = 0; s < states.size(); ++s) {
+    const std::set<int> subset = states[s].first;
+    const int depth = states[s].second;
+    bool is_final = false;
+    for (auto q : subset) {
+      is_final = is_final or IsAcceptingState(q);
+    }
+    if (length < 0) {
+      statuses.push_back(is_final ? '+' : '-');
+    } else {
+      statuses.push_back((depth == length and not subset.empty()) or (depth == 0 and accept_empty_if_final and is_final) ? '+' : '-');
+    }
+
+    std::vector<int> next_states (alphabet_size, -1);
+    for (std::size_t c = 0; c < alphabet_size; ++c) {
+      std::set<int> next_subset;
+      if (depth != length) {
+        for (auto q : subset) {
+          if (is_live[transitions[q][c]]) {
+            next_subset.insert(transitions[q][c]);
+          }
+        }
+      }
+      next_states[c] = get_state(next_subset, (length < 0) ? 0 : depth + 1);
+    }
+    subset_transitions.push_back(next_states);
+  }
+
+  return new StringAutomaton(MakeDfaFromTable(subset_transitions, statuses, this->num_of_bdd_variables_), this->num_of_bdd_variables_);
+}
+
 void StringAutomaton::AddPrintLabel(std::ostream& out) {
 	out << " subgraph cluster_0 {\n";
 	out << "  style = invis;\n  center = true;\n  margin = 0;\n";
@@ -12,13 +12,20 @@
 #include <cstring>
 #include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <glog/logging.h>
 
 #include "../utils/RegularExpression.h"
@@ -27,7 +34,9 @@
 #include "Graph.h"
 #include "GraphNode.h"
 #include "IntAutomaton.h"
+#include "RegexCompiler.h"
 #include "StringFormula.h"
+#include "Transducer.h"
 
 namespace Vlab {
 namespace Theory {
@@ -38,6 +47,16 @@ using StringAutomaton_ptr = StringAutomaton*;
 class StringAutomaton: public Automaton {
 	using TransitionVector = std::vector<std::pair<std::string,std::string>>;
 	using TransitionTable = std::map<std::pair<int,StringFormula::Type>,TransitionVector>;
+
+	/**
+	 * A compiled regex dfa, either built in this process or lazily read from a mapped cache file
+	 */
+	struct RegexCacheEntry {
+	  DFA_ptr dfa;
+	  const char* data;
+	  std::size_t size;
+	};
+	using RegexCache = std::unordered_map<std::string, RegexCacheEntry>;
 public:
 	StringAutomaton(const DFA_ptr, const int number_of_bdd_variables);
 	StringAutomaton(const DFA_ptr, const int number_of_tracks, const int number_of_bdd_variables);
@@ -118,6 +137,67 @@ public:
    */
   static StringAutomaton_ptr MakeRegexAuto(Util::RegularExpression_ptr regular_expression, const int number_of_bdd_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
 
+  /**
+   * Generates a string automaton that accepts the strings containing at least one of the given patterns,
+   * built directly as an Aho-Corasick automaton (KMP automaton for a single pattern)
+   * @param patterns
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static StringAutomaton_ptr MakeContainsAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
+
+  /**
+   * Generates a string automaton that accepts the strings containing all of the given patterns,
+   * Aho-Corasick states are paired with the set of patterns seen so far
+   * @param patterns at most 64 patterns
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static StringAutomaton_ptr MakeContainsAllOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
+
+  /**
+   * Generates a string automaton that accepts the strings containing none of the given patterns
+   * @param patterns
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static StringAutomaton_ptr MakeNotContainsAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
+
+  /**
+   * Generates a string automaton that accepts the strings starting with one of the given patterns
+   * @param patterns
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static StringAutomaton_ptr MakeBeginsWithAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
+
+  /**
+   * Generates a string automaton that accepts the strings ending with one of the given patterns
+   * @param patterns
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static StringAutomaton_ptr MakeEndsWithAnyOf(const std::vector<std::string>& patterns, const int number_of_bdd_variables = StringAutomaton::DEFAULT_NUM_OF_VARIABLES);
+
+  /**
+   * Maps a regex cache file into memory, entries are decoded when they are first used
+   * @param file_name
+   * @return false if file cannot be mapped or is not a regex cache file
+   */
+  static bool LoadRegexCache(const std::string file_name);
+
+  /**
+   * Writes the compiled regex cache into a file if it has new entries
+   * @param file_name
+   * @return
+   */
+  static bool SaveRegexCache(const std::string file_name);
+
+  /**
+   * Frees cached regex automata and unmaps cache file
+   */
+  static void ClearRegexCache();
+
   /**
    * Generates a string automaton that accepts any string with the given length
    * @param length
@@ -233,6 +313,13 @@ public:
 
   StringAutomaton_ptr Replace(StringAutomaton_ptr search_auto, StringAutomaton_ptr replace_auto);
 
+  /**
+   * Generates the automaton for the outputs of the transducer on the strings of this automaton
+   * @param transducer
+   * @return
+   */
+  StringAutomaton_ptr Transduce(const Transducer_ptr transducer);
+
   StringAutomaton_ptr GetAnyStringNotContainsMe();
 
   UnaryAutomaton_ptr ToUnaryAutomaton();
@@ -264,7 +351,21 @@ public:
   StringAutomaton_ptr PreConcatRight(StringAutomaton_ptr left_auto);
   StringAutomaton_ptr PreReplace(StringAutomaton_ptr searchAuto, std::string replaceString, StringAutomaton_ptr rangeAuto = nullptr);
 
+  /**
+   * Generates the automaton for the inputs of the transducer that have an output in this automaton
+   * @param transducer
+   * @param rangeAuto
+   * @return
+   */
+  StringAutomaton_ptr PreTransduce(const Transducer_ptr transducer, StringAutomaton_ptr rangeAuto = nullptr);
+
   StringAutomaton_ptr GetAutomatonForVariable(std::string var_name);
+
+  /**
+   * Extracts the single track automaton of every variable in the formula
+   * @return variable name to automaton map, caller owns the automata
+   */
+  std::map<std::string, StringAutomaton_ptr> GetAutomataForAllVariables();
   StringAutomaton_ptr GetKTrack(int track);
   StringAutomaton_ptr ProjectAwayVariable(std::string var_name);
   StringAutomaton_ptr ProjectKTrack(int track);
@@ -308,17 +409,89 @@ protected:
   std::vector<int> GetAcceptingStates();
 
   StringAutomaton_ptr IndexOfHelper(StringAutomaton_ptr search_auto);
+
+  /**
+   * Generates the prefixes that are followed by the first occurrence of a constant search string,
+   * as a product of this automaton and the KMP automaton of the search string
+   * @param search non-empty search string
+   * @return
+   */
+  StringAutomaton_ptr IndexOfHelper(const std::string& search);
   StringAutomaton_ptr LastIndexOfHelper(StringAutomaton_ptr search_auto);
   StringAutomaton_ptr GetDuplicateStateAutomaton();
   StringAutomaton_ptr ToQueryAutomaton();
   StringAutomaton_ptr Search(StringAutomaton_ptr search_auto);
   StringAutomaton_ptr RemoveReservedWords();
+  /**
+   * Builds a dfa for min..max repetitions of this automaton's language.
+   * Copies of the operand are shared by tracking (completed copies, operand state) pairs
+   * during a single subset construction instead of unrolling and minimizing each copy.
+   * @param min
+   * @param max ignored if not bounded
+   * @param is_max_bounded false for min..infinity repetitions
+   * @return
+   */
+  DFA_ptr MakeRepeatDfa(unsigned min, unsigned max, bool is_max_bounded);
+
+  /**
+   * Aho-Corasick automaton of the given patterns, state 0 is the root of the pattern trie
+   * @param patterns
+   * @param number_of_bdd_variables
+   * @param matched_patterns set to the patterns that end at each state, including the ones found by failure links
+   * @return complete transition table
+   */
+  static std::vector<std::vector<int>> MakeAhoCorasickTable(const std::vector<std::string>& patterns, const int number_of_bdd_variables, std::vector<std::vector<int>>& matched_patterns);
+
+  /**
+   * Builds a minimized dfa from a complete transition table over the alphabet
+   * @param transitions
+   * @param statuses
+   * @param number_of_bdd_variables
+   * @return
+   */
+  static DFA_ptr MakeDfaFromTable(const std::vector<std::vector<int>>& transitions, std::string statuses, const int number_of_bdd_variables);
+
+  /**
+   * Complete transition table of this automaton
+   * @param is_live set to the states that can reach an accepting state
+   * @return
+   */
+  std::vector<std::vector<int>> GetTransitionTable(std::vector<bool>& is_live);
+
+  /**
+   * Generates the words read from the live states reachable with a walk between min_walk and max_walk,
+   * with a single subset construction over the transition table instead of extra bits and projections
+   * @param min_walk
+   * @param max_walk
+   * @param length if non-negative, accepts the words of that length that can be extended to an accepted suffix,
+   * otherwise accepts the suffixes
+   * @param accept_empty_if_final accepts the empty string if any of the states reached is accepting
+   * @return
+   */
+  StringAutomaton_ptr SuffixesFromToDirect(const int min_walk, const int max_walk, const int length, const bool accept_empty_if_final);
   virtual void AddPrintLabel(std::ostream& out);
 
 
   int num_tracks_;
   StringFormula_ptr formula_;
+
+  /**
+   * Cached unary dfa of the lengths accepted by this automaton (see ToUnaryAutomaton)
+   */
+  DFA_ptr length_dfa_ = nullptr;
   static TransitionTable TRANSITION_TABLE;
+  static std::mutex TRANSITION_TABLE_MUTEX;
+
+  /**
+   * Compiled regex automata keyed by syntax flags, number of bdd variables and regex string
+   */
+  static RegexCache REGEX_CACHE;
+  static bool REGEX_CACHE_IS_MODIFIED;
+  static std::mutex REGEX_CACHE_MUTEX;
+  static void* REGEX_CACHE_MAPPED_DATA;
+  static std::size_t REGEX_CACHE_MAPPED_SIZE;
+  static const std::string REGEX_CACHE_MAGIC;
+  static std::string GetRegexCacheKey(const std::string regex_string, const int number_of_bdd_variables);
   static const int VAR_PER_TRACK = 9;
   static const int DEFAULT_NUM_OF_VARIABLES = 8;
   static bool debug;
@@ -256,6 +256,7 @@ void StringFormula::MergeVariables(Formula_ptr other) {
       variable_coefficient_map_[el.first] = 0;
     }
   }
+  UpdateVariableIndices();
 }
 
 bool StringFormula::GetVarNamesIfEqualityOfTwoVars(std::string &v1, std::string &v2) {
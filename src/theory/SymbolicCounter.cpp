@@ -61,17 +61,22 @@ BigInteger SymbolicCounter::Count(const unsigned long bound) {
     power = (base << bound) - 1;
   }
 
+  // the cached vector is updated only when the count completes, a cancelled count leaves it as it was
+  Eigen::SparseVector<BigInteger> count_vector;
   if (power >= bound_) {
     power = power - bound_;
+    count_vector = initialization_vector_;
   } else {
-    initialization_vector_ = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
+    count_vector = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
   }
 
   while (power > 0) {
-    initialization_vector_ = transition_count_matrix_ * initialization_vector_;
+    Util::Cancellation::Check();
+    count_vector = transition_count_matrix_ * count_vector;
     --power;
   }
 
+  initialization_vector_ = count_vector;
   bound_ = bound;
   if (SymbolicCounter::Type::BINARYINT == type_) {
     ++bound_; // handle sign bit
@@ -127,25 +132,28 @@ int SymbolicCounter::GetMinBound(int num_models) {
 		power = (base << bound) - 1;
 	}
 
+	Eigen::SparseVector<BigInteger> count_vector;
 	if (power >= bound_) {
 		power = power - bound_;
+		count_vector = initialization_vector_;
 	} else {
-		initialization_vector_ = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
+		count_vector = transition_count_matrix_.innerVector(transition_count_matrix_.cols()-1);
 	}
 
 	int count = 0;
 	int min_bound = INT_MAX;
 	while (power > 0) {
-		auto before_vector(initialization_vector_);
-		initialization_vector_ = transition_count_matrix_ * initialization_vector_;
+		Util::Cancellation::Check();
+		auto before_vector(count_vector);
+		count_vector = transition_count_matrix_ * count_vector;
 		--power;
 		count++;
 		// if we have enough models, or the count vector doesn't change, return with
 		// the corresponding bound
-		if(initialization_vector_.coeff(0) >= num_models) {
+		if(count_vector.coeff(0) >= num_models) {
 			min_bound = count;
 			break;
-		} else if(before_vector.isApprox(initialization_vector_)) {
+		} else if(before_vector.isApprox(count_vector)) {
 			// -1 for incrementing count when not needed
 			count--;
 			min_bound = count;
@@ -153,6 +161,7 @@ int SymbolicCounter::GetMinBound(int num_models) {
 		}
 	}
 
+	initialization_vector_ = count_vector;
 	bound_ = min_bound;
 	if (SymbolicCounter::Type::BINARYINT == type_) {
 		++bound_; // handle sign bit
@@ -14,6 +14,7 @@
 
 #include <glog/logging.h>
 
+#include "../utils/Cancellation.h"
 #include "../utils/Serialize.h"
 
 namespace Vlab {
@@ -0,0 +1,94 @@
+/*
+ * TernaryException.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "TernaryException.h"
+
+namespace Vlab {
+namespace Theory {
+
+TernaryException::TernaryException()
+    : size_(0) {
+}
+
+TernaryException::TernaryException(const int size)
+    : size_(size),
+      care_((size + 63) / 64, 0),
+      value_((size + 63) / 64, 0) {
+}
+
+TernaryException::TernaryException(const std::string& exception)
+    : TernaryException(exception.size()) {
+  for (int i = 0; i < size_; ++i) {
+    Set(i, exception[i]);
+  }
+}
+
+char TernaryException::Get(const int index) const {
+  uint64_t bit = 1ULL << (index & 63);
+  if ((care_[index >> 6] & bit) == 0) {
+    return 'X';
+  }
+  return (value_[index >> 6] & bit) ? '1' : '0';
+}
+
+void TernaryException::Set(const int index, const char value) {
+  if (value == '0' or value == '1') {
+    SetBit(index, value == '1');
+  } else {
+    SetDontCare(index);
+  }
+}
+
+void TernaryException::PushBack(const char value) {
+  if ((size_ & 63) == 0) {
+    care_.push_back(0);
+    value_.push_back(0);
+  }
+  ++size_;
+  Set(size_ - 1, value);
+}
+
+std::string TernaryException::ToString() const {
+  std::string exception(size_, 'X');
+  for (int i = 0; i < size_; ++i) {
+    exception[i] = Get(i);
+  }
+  return exception;
+}
+
+std::size_t TernaryException::Hash() const {
+  std::size_t seed = size_;
+  for (std::size_t i = 0; i < care_.size(); ++i) {
+    seed ^= std::hash<uint64_t>()(care_[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<uint64_t>()(value_[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  }
+  return seed;
+}
+
+bool TernaryException::operator==(const TernaryException& other) const {
+  return size_ == other.size_ and care_ == other.care_ and value_ == other.value_;
+}
+
+bool TernaryException::operator!=(const TernaryException& other) const {
+  return not (*this == other);
+}
+
+bool TernaryException::operator<(const TernaryException& other) const {
+  if (size_ != other.size_) {
+    return size_ < other.size_;
+  }
+  if (care_ != other.care_) {
+    return care_ < other.care_;
+  }
+  return value_ < other.value_;
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
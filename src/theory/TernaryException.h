@@ -0,0 +1,95 @@
+/*
+ * TernaryException.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_TERNARYEXCEPTION_H_
+#define THEORY_TERNARYEXCEPTION_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Vlab {
+namespace Theory {
+
+/**
+ * A dfa exception (bdd path) over 0/1/X packed into two bit vectors.
+ * Bit i of care mask is set if variable i is fixed, bit i of value mask gives its value.
+ * Can be used as a key in ordered and hashed containers.
+ */
+class TernaryException {
+public:
+  TernaryException();
+  TernaryException(const int size);
+  TernaryException(const std::string& exception);
+
+  int size() const {
+    return size_;
+  }
+
+  /**
+   * @param index
+   * @return '0', '1' or 'X'
+   */
+  char Get(const int index) const;
+
+  /**
+   * @param index
+   * @param value '0', '1' or 'X'
+   */
+  void Set(const int index, const char value);
+
+  void SetBit(const int index, const bool value) {
+    care_[index >> 6] |= (1ULL << (index & 63));
+    if (value) {
+      value_[index >> 6] |= (1ULL << (index & 63));
+    } else {
+      value_[index >> 6] &= ~(1ULL << (index & 63));
+    }
+  }
+
+  void SetDontCare(const int index) {
+    care_[index >> 6] &= ~(1ULL << (index & 63));
+    value_[index >> 6] &= ~(1ULL << (index & 63));
+  }
+
+  /**
+   * Appends a variable at the end
+   * @param value '0', '1' or 'X'
+   */
+  void PushBack(const char value);
+
+  /**
+   * @return exception string as expected by dfaStoreException
+   */
+  std::string ToString() const;
+
+  std::size_t Hash() const;
+
+  bool operator==(const TernaryException& other) const;
+  bool operator!=(const TernaryException& other) const;
+  bool operator<(const TernaryException& other) const;
+
+  struct Hasher {
+    std::size_t operator()(const TernaryException& exception) const {
+      return exception.Hash();
+    }
+  };
+
+protected:
+  int size_;
+  std::vector<uint64_t> care_;
+  std::vector<uint64_t> value_;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_TERNARYEXCEPTION_H_ */
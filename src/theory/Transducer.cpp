@@ -0,0 +1,588 @@
+/*
+ * Transducer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "Transducer.h"
+
+#include <mona/bdd.h>
+
+namespace Vlab {
+namespace Theory {
+
+const int Transducer::VLOG_LEVEL = 15;
+
+Transducer::Transducer()
+    : initial_state_(0) {
+}
+
+Transducer::~Transducer() {
+}
+
+int Transducer::AddState(const bool is_final) {
+  is_final_.push_back(is_final);
+  transitions_.push_back(std::vector<Transition>());
+  return is_final_.size() - 1;
+}
+
+void Transducer::AddTransition(const int source, const int target, const CharSet& input, const std::vector<CharSet>& output) {
+  if (input.none()) {
+    return;
+  }
+  transitions_[source].push_back(Transition {target, true, input, nullptr, output});
+}
+
+void Transducer::AddEpsilonTransition(const int source, const int target, const std::vector<CharSet>& output) {
+  transitions_[source].push_back(Transition {target, false, CharSet(), nullptr, output});
+}
+
+void Transducer::AddRelationTransition(const int source, const int target, const CharSet& input, CharRelation_ptr relation) {
+  CHECK_EQ(256, relation->size());
+  if (input.none()) {
+    return;
+  }
+  transitions_[source].push_back(Transition {target, true, input, relation, std::vector<CharSet>()});
+}
+
+int Transducer::GetNumberOfStates() const {
+  return is_final_.size();
+}
+
+Transducer_ptr Transducer::Inverse() const {
+  Transducer split_transducer = Split();
+  Transducer_ptr inverse_transducer = new Transducer();
+  for (auto is_final : split_transducer.is_final_) {
+    inverse_transducer->AddState(is_final);
+  }
+  inverse_transducer->initial_state_ = split_transducer.initial_state_;
+
+  for (int s = 0; s < split_transducer.GetNumberOfStates(); ++s) {
+    for (auto& transition : split_transducer.transitions_[s]) {
+      if (transition.relation) {
+        auto inverse_relation = std::make_shared<CharRelation>(256);
+        CharSet input;
+        for (unsigned long c = 0; c < 256; ++c) {
+          if (not transition.input.test(c)) {
+            continue;
+          }
+          auto& outputs = (*transition.relation)[c];
+          for (unsigned long d = 0; d < 256; ++d) {
+            if (outputs.test(d)) {
+              (*inverse_relation)[d].set(c);
+              input.set(d);
+            }
+          }
+        }
+        inverse_transducer->AddRelationTransition(s, transition.target, input, inverse_relation);
+        continue;
+      }
+
+      std::vector<CharSet> output;
+      if (transition.has_input) {
+        output.push_back(transition.input);
+      }
+      if (transition.output.empty()) {
+        inverse_transducer->AddEpsilonTransition(s, transition.target, output);
+      } else {
+        inverse_transducer->AddTransition(s, transition.target, transition.output[0], output);
+      }
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << "transducer inverse: " << inverse_transducer->GetNumberOfStates() << " states";
+  return inverse_transducer;
+}
+
+Transducer_ptr Transducer::Compose(const Transducer_ptr other_transducer) const {
+  Transducer left = Split();
+  Transducer right = other_transducer->Split();
+  Transducer_ptr composed_transducer = new Transducer();
+
+  std::map<std::pair<int, int>, int> state_ids;
+  std::vector<std::pair<int, int>> states;
+  auto get_state = [&](const int left_state, const int right_state) {
+    auto key = std::make_pair(left_state, right_state);
+    auto it = state_ids.find(key);
+    if (it != state_ids.end()) {
+      return it->second;
+    }
+    int id = composed_transducer->AddState(left.is_final_[left_state] and right.is_final_[right_state]);
+    state_ids[key] = id;
+    states.push_back(key);
+    return id;
+  };
+
+  composed_transducer->initial_state_ = get_state(left.initial_state_, right.initial_state_);
+  for (std::size_t i = 0; i < states.size(); ++i) {
+    const int source = i;
+    const int left_state = states[i].first, right_state = states[i].second;
+
+    for (auto& left_transition : left.transitions_[left_state]) {
+      if (not left_transition.relation and left_transition.output.empty()) {
+        // left moves alone, nothing is passed to the right
+        int target = get_state(left_transition.target, right_state);
+        if (left_transition.has_input) {
+          composed_transducer->AddTransition(source, target, left_transition.input, std::vector<CharSet>());
+        } else {
+          composed_transducer->AddEpsilonTransition(source, target, std::vector<CharSet>());
+        }
+        continue;
+      }
+
+      for (auto& right_transition : right.transitions_[right_state]) {
+        if (not right_transition.has_input) {
+          continue;
+        }
+        int target = get_state(left_transition.target, right_transition.target);
+
+        if (left_transition.relation) {
+          auto relation = std::make_shared<CharRelation>(256);
+          CharSet input;
+          for (unsigned long c = 0; c < 256; ++c) {
+            if (not left_transition.input.test(c)) {
+              continue;
+            }
+            CharSet passed = (*left_transition.relation)[c] & right_transition.input;
+            if (passed.none()) {
+              continue;
+            }
+            if (right_transition.relation) {
+              (*relation)[c] = ApplyRelation(*right_transition.relation, passed);
+            } else if (not right_transition.output.empty()) {
+              (*relation)[c] = right_transition.output[0];
+            }
+            input.set(c);
+          }
+          if (right_transition.relation or not right_transition.output.empty()) {
+            composed_transducer->AddRelationTransition(source, target, input, relation);
+          } else {
+            composed_transducer->AddTransition(source, target, input, std::vector<CharSet>());
+          }
+          continue;
+        }
+
+        CharSet passed = left_transition.output[0] & right_transition.input;
+        if (passed.none()) {
+          continue;
+        }
+        std::vector<CharSet> output;
+        if (right_transition.relation) {
+          output.push_back(ApplyRelation(*right_transition.relation, passed));
+        } else if (not right_transition.output.empty()) {
+          output.push_back(right_transition.output[0]);
+        }
+        if (left_transition.has_input) {
+          composed_transducer->AddTransition(source, target, left_transition.input, output);
+        } else {
+          composed_transducer->AddEpsilonTransition(source, target, output);
+        }
+      }
+    }
+
+    for (auto& right_transition : right.transitions_[right_state]) {
+      if (not right_transition.has_input) {
+        // right moves alone, writes without reading from the left
+        int target = get_state(left_state, right_transition.target);
+        composed_transducer->AddEpsilonTransition(source, target, right_transition.output);
+      }
+    }
+  }
+
+  DVLOG(VLOG_LEVEL) << "transducer composition: " << composed_transducer->GetNumberOfStates() << " states";
+  return composed_transducer;
+}
+
+DFA_ptr Transducer::Image(const DFA_ptr dfa, const int number_of_bdd_variables, int* indices) const {
+  CHECK_LE(number_of_bdd_variables, 8);
+  const unsigned long alphabet_size = 1UL << number_of_bdd_variables;
+  CharSet alphabet;
+  for (unsigned long c = 0; c < alphabet_size; ++c) {
+    alphabet.set(c);
+  }
+  std::vector<std::vector<int>> dfa_transitions = GetTransitionTable(dfa, number_of_bdd_variables, indices);
+  Transducer split_transducer = Split();
+
+  // product of the transducer and the dfa, an nfa over the output characters
+  std::map<std::pair<int, int>, int> node_ids;
+  std::vector<std::pair<int, int>> nodes;
+  std::vector<std::vector<std::pair<CharSet, int>>> edges;
+  std::vector<std::vector<int>> epsilon_edges;
+  auto get_node = [&](const int transducer_state, const int dfa_state) {
+    auto key = std::make_pair(transducer_state, dfa_state);
+    auto it = node_ids.find(key);
+    if (it != node_ids.end()) {
+      return it->second;
+    }
+    int id = nodes.size();
+    node_ids[key] = id;
+    nodes.push_back(key);
+    edges.push_back(std::vector<std::pair<CharSet, int>>());
+    epsilon_edges.push_back(std::vector<int>());
+    return id;
+  };
+
+  get_node(split_transducer.initial_state_, dfa->s);
+  for (std::size_t n = 0; n < nodes.size(); ++n) {
+    const int transducer_state = nodes[n].first, dfa_state = nodes[n].second;
+    for (auto& transition : split_transducer.transitions_[transducer_state]) {
+      std::map<int, CharSet> dfa_targets;
+      if (transition.has_input) {
+        for (unsigned long c = 0; c < alphabet_size; ++c) {
+          if (transition.input.test(c)) {
+            dfa_targets[dfa_transitions[dfa_state][c]].set(c);
+          }
+        }
+      } else {
+        dfa_targets[dfa_state] = CharSet();
+      }
+
+      for (auto& dfa_target : dfa_targets) {
+        if (transition.relation) {
+          CharSet output = ApplyRelation(*transition.relation, dfa_target.second) & alphabet;
+          if (output.any()) {
+            int target = get_node(transition.target, dfa_target.first);
+            edges[n].push_back(std::make_pair(output, target));
+          }
+        } else if (transition.output.empty()) {
+          int target = get_node(transition.target, dfa_target.first);
+          epsilon_edges[n].push_back(target);
+        } else {
+          CharSet output = transition.output[0] & alphabet;
+          if (output.any()) {
+            int target = get_node(transition.target, dfa_target.first);
+            edges[n].push_back(std::make_pair(output, target));
+          }
+        }
+      }
+    }
+  }
+
+  auto close = [&](std::vector<int>& subset) {
+    std::vector<bool> is_member (nodes.size(), false);
+    for (auto node : subset) {
+      is_member[node] = true;
+    }
+    for (std::size_t i = 0; i < subset.size(); ++i) {
+      for (auto next_node : epsilon_edges[subset[i]]) {
+        if (not is_member[next_node]) {
+          is_member[next_node] = true;
+          subset.push_back(next_node);
+        }
+      }
+    }
+    std::sort(subset.begin(), subset.end());
+  };
+
+  std::map<std::vector<int>, int> subset_ids;
+  std::vector<std::vector<int>> subsets;
+  // transitions of each subset, target subset and the characters leading to it
+  std::vector<std::vector<std::pair<int, CharSet>>> transitions;
+  std::vector<int> initial_subset {0};
+  close(initial_subset);
+  subset_ids[initial_subset] = 0;
+  subsets.push_back(initial_subset);
+
+  for (std::size_t s = 0; s < subsets.size(); ++s) {
+    std::vector<std::vector<int>> next_nodes (alphabet_size);
+    for (auto node : subsets[s]) {
+      for (auto& edge : edges[node]) {
+        for (unsigned long c = 0; c < alphabet_size; ++c) {
+          if (edge.first.test(c)) {
+            next_nodes[c].push_back(edge.second);
+          }
+        }
+      }
+    }
+
+    std::map<std::vector<int>, int> closed_ids;
+    std::map<int, CharSet> targets;
+    for (unsigned long c = 0; c < alphabet_size; ++c) {
+      std::vector<int>& next_subset = next_nodes[c];
+      std::sort(next_subset.begin(), next_subset.end());
+      next_subset.erase(std::unique(next_subset.begin(), next_subset.end()), next_subset.end());
+      auto closed_it = closed_ids.find(next_subset);
+      if (closed_it == closed_ids.end()) {
+        std::vector<int> closed_subset = next_subset;
+        close(closed_subset);
+        int next_subset_id;
+        auto it = subset_ids.find(closed_subset);
+        if (it == subset_ids.end()) {
+          next_subset_id = subsets.size();
+          subset_ids[closed_subset] = next_subset_id;
+          subsets.push_back(closed_subset);
+        } else {
+          next_subset_id = it->second;
+        }
+        closed_it = closed_ids.insert(std::make_pair(next_subset, next_subset_id)).first;
+      }
+      targets[closed_it->second].set(c);
+    }
+    transitions.push_back(std::vector<std::pair<int, CharSet>>(targets.begin(), targets.end()));
+  }
+
+  const int number_of_states = subsets.size();
+  std::string statuses (number_of_states, '-');
+  DFABuilder builder(number_of_states, number_of_bdd_variables, indices);
+  for (int s = 0; s < number_of_states; ++s) {
+    for (auto node : subsets[s]) {
+      if (split_transducer.is_final_[nodes[node].first] and dfa->f[nodes[node].second] == 1) {
+        statuses[s] = '+';
+        break;
+      }
+    }
+
+    // the target reached with most characters becomes the default transition
+    std::size_t default_index = 0;
+    for (std::size_t i = 1; i < transitions[s].size(); ++i) {
+      if (transitions[s][i].second.count() > transitions[s][default_index].second.count()) {
+        default_index = i;
+      }
+    }
+
+    std::vector<std::pair<int, std::string>> exceptions;
+    for (std::size_t i = 0; i < transitions[s].size(); ++i) {
+      if (i == default_index) {
+        continue;
+      }
+      for (auto& path : RegexCompiler::GetExceptions(transitions[s][i].second, number_of_bdd_variables)) {
+        exceptions.push_back(std::make_pair(transitions[s][i].first, path));
+      }
+    }
+    builder.AllocExceptions(exceptions.size());
+    for (auto& exception : exceptions) {
+      builder.StoreException(exception.first, &exception.second[0]);
+    }
+    builder.StoreState(transitions[s][default_index].first);
+  }
+
+  DFA_ptr result_dfa = DFAMinimizeAndFree(builder.Build(&statuses[0]));
+  DVLOG(VLOG_LEVEL) << "transducer image: " << nodes.size() << " product states, " << number_of_states
+      << " subset states, " << result_dfa->ns << " minimized states";
+  return result_dfa;
+}
+
+DFA_ptr Transducer::PreImage(const DFA_ptr dfa, const int number_of_bdd_variables, int* indices) const {
+  Transducer_ptr inverse_transducer = Inverse();
+  DFA_ptr result_dfa = inverse_transducer->Image(dfa, number_of_bdd_variables, indices);
+  delete inverse_transducer;
+  return result_dfa;
+}
+
+Transducer_ptr Transducer::MakeIdentity() {
+  auto relation = std::make_shared<CharRelation>(256);
+  for (unsigned long c = 0; c < 256; ++c) {
+    (*relation)[c].set(c);
+  }
+  Transducer_ptr identity_transducer = new Transducer();
+  int state = identity_transducer->AddState(true);
+  identity_transducer->AddRelationTransition(state, state, ~CharSet(), relation);
+  return identity_transducer;
+}
+
+Transducer_ptr Transducer::MakeToUpperCase() {
+  auto relation = std::make_shared<CharRelation>(256);
+  for (unsigned long c = 0; c < 256; ++c) {
+    (*relation)[c].set((c >= 'a' and c <= 'z') ? c - 'a' + 'A' : c);
+  }
+  Transducer_ptr upper_case_transducer = new Transducer();
+  int state = upper_case_transducer->AddState(true);
+  upper_case_transducer->AddRelationTransition(state, state, ~CharSet(), relation);
+  return upper_case_transducer;
+}
+
+Transducer_ptr Transducer::MakeToLowerCase() {
+  auto relation = std::make_shared<CharRelation>(256);
+  for (unsigned long c = 0; c < 256; ++c) {
+    (*relation)[c].set((c >= 'A' and c <= 'Z') ? c - 'A' + 'a' : c);
+  }
+  Transducer_ptr lower_case_transducer = new Transducer();
+  int state = lower_case_transducer->AddState(true);
+  lower_case_transducer->AddRelationTransition(state, state, ~CharSet(), relation);
+  return lower_case_transducer;
+}
+
+/**
+ * Spaces seen after a non-space character are either written (more non-space characters follow)
+ * or dropped (trailing spaces), the transducer guesses and the wrong guess gets stuck.
+ */
+Transducer_ptr Transducer::MakeTrim() {
+  auto identity = std::make_shared<CharRelation>(256);
+  for (unsigned long c = 0; c < 256; ++c) {
+    (*identity)[c].set(c);
+  }
+  const CharSet space = MakeCharSet(' ');
+  const CharSet non_space = ~space;
+
+  Transducer_ptr trim_transducer = new Transducer();
+  int leading = trim_transducer->AddState(true);
+  int middle = trim_transducer->AddState(true);
+  int inner_spaces = trim_transducer->AddState(false);
+  int trailing = trim_transducer->AddState(true);
+
+  trim_transducer->AddTransition(leading, leading, space, std::vector<CharSet>());
+  trim_transducer->AddRelationTransition(leading, middle, non_space, identity);
+  trim_transducer->AddRelationTransition(middle, middle, non_space, identity);
+  trim_transducer->AddTransition(middle, inner_spaces, space, {space});
+  trim_transducer->AddTransition(middle, trailing, space, std::vector<CharSet>());
+  trim_transducer->AddTransition(inner_spaces, inner_spaces, space, {space});
+  trim_transducer->AddRelationTransition(inner_spaces, middle, non_space, identity);
+  trim_transducer->AddTransition(trailing, trailing, space, std::vector<CharSet>());
+  return trim_transducer;
+}
+
+/**
+ * State j buffers the pattern prefix of length j read so far (KMP automaton states). When a
+ * character breaks the match, the part of the buffer that cannot start a match anymore is written.
+ */
+Transducer_ptr Transducer::MakeReplace(const std::string pattern, const std::string replacement) {
+  CHECK(not pattern.empty()) << "replace pattern must be non-empty";
+  const int pattern_length = pattern.length();
+  std::vector<unsigned long> pattern_chars;
+  for (auto c : pattern) {
+    pattern_chars.push_back((unsigned char) c);
+  }
+
+  // kmp automaton, next_prefix[j][c] is the longest pattern prefix that is a suffix of pattern[0..j) + c
+  std::vector<std::vector<int>> next_prefix (pattern_length, std::vector<int>(256, 0));
+  next_prefix[0][pattern_chars[0]] = 1;
+  for (int j = 1, fallback = 0; j < pattern_length; ++j) {
+    next_prefix[j] = next_prefix[fallback];
+    next_prefix[j][pattern_chars[j]] = j + 1;
+    fallback = next_prefix[fallback][pattern_chars[j]];
+  }
+
+  auto identity = std::make_shared<CharRelation>(256);
+  for (unsigned long c = 0; c < 256; ++c) {
+    (*identity)[c].set(c);
+  }
+
+  Transducer_ptr replace_transducer = new Transducer();
+  for (int j = 0; j < pattern_length; ++j) {
+    replace_transducer->AddState(j == 0);
+  }
+  int flush_state = replace_transducer->AddState(true);
+
+  for (int j = 0; j < pattern_length; ++j) {
+    std::vector<CharSet> fallback_chars (j + 1);
+    for (unsigned long c = 0; c < 256; ++c) {
+      if (c != pattern_chars[j]) {
+        fallback_chars[next_prefix[j][c]].set(c);
+      }
+    }
+
+    if (j + 1 == pattern_length) {
+      replace_transducer->AddTransition(j, 0, MakeCharSet(pattern[j]), MakeOutput(replacement));
+    } else {
+      replace_transducer->AddTransition(j, j + 1, MakeCharSet(pattern[j]), std::vector<CharSet>());
+    }
+
+    for (int k = 1; k <= j; ++k) {
+      replace_transducer->AddTransition(j, k, fallback_chars[k], MakeOutput(pattern.substr(0, j + 1 - k)));
+    }
+
+    // the whole buffer and the character read are written
+    if (j == 0) {
+      replace_transducer->AddRelationTransition(j, 0, fallback_chars[0], identity);
+    } else if (fallback_chars[0].any()) {
+      int write_state = replace_transducer->AddState(false);
+      replace_transducer->AddEpsilonTransition(j, write_state, MakeOutput(pattern.substr(0, j)));
+      replace_transducer->AddRelationTransition(write_state, 0, fallback_chars[0], identity);
+    }
+
+    if (j > 0) {
+      replace_transducer->AddEpsilonTransition(j, flush_state, MakeOutput(pattern.substr(0, j)));
+    }
+  }
+
+  return replace_transducer;
+}
+
+Transducer::CharSet Transducer::MakeCharSet(const char c) {
+  CharSet chars;
+  chars.set((unsigned char) c);
+  return chars;
+}
+
+std::vector<Transducer::CharSet> Transducer::MakeOutput(const std::string str) {
+  std::vector<CharSet> output;
+  for (auto c : str) {
+    output.push_back(MakeCharSet(c));
+  }
+  return output;
+}
+
+Transducer Transducer::Split() const {
+  Transducer split_transducer;
+  split_transducer.initial_state_ = initial_state_;
+  split_transducer.is_final_ = is_final_;
+  split_transducer.transitions_.resize(is_final_.size());
+
+  for (std::size_t s = 0; s < transitions_.size(); ++s) {
+    for (auto& transition : transitions_[s]) {
+      if (transition.relation or transition.output.size() <= 1) {
+        split_transducer.transitions_[s].push_back(transition);
+        continue;
+      }
+      int source = s;
+      for (std::size_t i = 0; i < transition.output.size(); ++i) {
+        int target = (i + 1 == transition.output.size()) ? transition.target : split_transducer.AddState(false);
+        if (i == 0 and transition.has_input) {
+          split_transducer.AddTransition(source, target, transition.input, {transition.output[i]});
+        } else {
+          split_transducer.AddEpsilonTransition(source, target, {transition.output[i]});
+        }
+        source = target;
+      }
+    }
+  }
+  return split_transducer;
+}
+
+Transducer::CharSet Transducer::ApplyRelation(const CharRelation& relation, const CharSet& chars) {
+  CharSet result;
+  for (unsigned long c = 0; c < 256; ++c) {
+    if (chars.test(c)) {
+      result |= relation[c];
+    }
+  }
+  return result;
+}
+
+std::vector<std::vector<int>> Transducer::GetTransitionTable(const DFA_ptr dfa, const int number_of_bdd_variables, int* indices) {
+  const unsigned long alphabet_size = 1UL << number_of_bdd_variables;
+  // exceptions are most significant bit first, indices[i] reads bit (number_of_bdd_variables - 1 - i)
+  std::map<unsigned, int> shift_of_index;
+  for (int i = 0; i < number_of_bdd_variables; ++i) {
+    shift_of_index[indices[i]] = number_of_bdd_variables - 1 - i;
+  }
+
+  std::vector<std::vector<int>> transition_table (dfa->ns, std::vector<int>(alphabet_size, -1));
+  unsigned p, l, r, index; // BDD traversal variables
+  for (int s = 0; s < dfa->ns; ++s) {
+    for (unsigned long c = 0; c < alphabet_size; ++c) {
+      p = dfa->q[s];
+      LOAD_lri(&dfa->bddm->node_table[p], l, r, index);
+      while (index != BDD_LEAF_INDEX) {
+        p = ((c >> shift_of_index[index]) & 1) ? r : l;
+        LOAD_lri(&dfa->bddm->node_table[p], l, r, index);
+      }
+      transition_table[s][c] = l;
+    }
+  }
+  return transition_table;
+}
+
+DFA_ptr Transducer::DFAMinimizeAndFree(DFA_ptr dfa) {
+  MonaLock lock;
+  DFA_ptr minimized_dfa = dfaMinimize(dfa);
+  dfaFree(dfa);
+  return minimized_dfa;
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
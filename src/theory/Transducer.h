@@ -0,0 +1,151 @@
+/*
+ * Transducer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_TRANSDUCER_H_
+#define THEORY_TRANSDUCER_H_
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+#include <mona/dfa.h>
+
+#include "RegexCompiler.h"
+
+namespace Vlab {
+namespace Theory {
+
+class Transducer;
+using Transducer_ptr = Transducer*;
+
+/**
+ * Nondeterministic finite-state transducer over single-track strings.
+ * A transition either reads one character from a character set or reads nothing (epsilon), and
+ * either writes a sequence of character sets (any character of each set, a constant string is a
+ * sequence of singletons) or writes one character related to the character read (relation output).
+ * Images and pre-images of automata are computed with a single product and subset construction,
+ * and string functions can be chained with Compose() before they are applied.
+ */
+class Transducer {
+public:
+  using CharSet = RegexCompiler::CharSet;
+  /**
+   * relation[c] is the set of characters that can be written when c is read
+   */
+  using CharRelation = std::vector<CharSet>;
+  using CharRelation_ptr = std::shared_ptr<const CharRelation>;
+
+  struct Transition {
+    int target;
+    bool has_input;
+    CharSet input;
+    CharRelation_ptr relation;
+    std::vector<CharSet> output;
+  };
+
+  Transducer();
+  virtual ~Transducer();
+
+  int AddState(const bool is_final);
+  void AddTransition(const int source, const int target, const CharSet& input, const std::vector<CharSet>& output);
+  void AddEpsilonTransition(const int source, const int target, const std::vector<CharSet>& output);
+  void AddRelationTransition(const int source, const int target, const CharSet& input, CharRelation_ptr relation);
+
+  int GetNumberOfStates() const;
+
+  /**
+   * Generates the transducer that maps the outputs of this transducer back to its inputs
+   * @return
+   */
+  Transducer_ptr Inverse() const;
+
+  /**
+   * Generates the transducer that applies this transducer first and then the other one
+   * @param other_transducer
+   * @return
+   */
+  Transducer_ptr Compose(const Transducer_ptr other_transducer) const;
+
+  /**
+   * Generates a minimized dfa for the set of outputs of the strings accepted by the given dfa
+   * @param dfa
+   * @param number_of_bdd_variables
+   * @param indices bdd variable indices
+   * @return
+   */
+  DFA_ptr Image(const DFA_ptr dfa, const int number_of_bdd_variables, int* indices) const;
+
+  /**
+   * Generates a minimized dfa for the set of inputs that have an output accepted by the given dfa
+   * @param dfa
+   * @param number_of_bdd_variables
+   * @param indices bdd variable indices
+   * @return
+   */
+  DFA_ptr PreImage(const DFA_ptr dfa, const int number_of_bdd_variables, int* indices) const;
+
+  static Transducer_ptr MakeIdentity();
+  static Transducer_ptr MakeToUpperCase();
+  static Transducer_ptr MakeToLowerCase();
+
+  /**
+   * Removes leading and trailing space characters
+   * @return
+   */
+  static Transducer_ptr MakeTrim();
+
+  /**
+   * Replaces all leftmost non-overlapping occurrences of a non-empty constant pattern
+   * @param pattern
+   * @param replacement
+   * @return
+   */
+  static Transducer_ptr MakeReplace(const std::string pattern, const std::string replacement);
+
+  static CharSet MakeCharSet(const char c);
+  static std::vector<CharSet> MakeOutput(const std::string str);
+
+  /**
+   * Generates the complete transition table of a dfa, table[state][character] is the next state
+   * @param dfa
+   * @param number_of_bdd_variables
+   * @param indices bdd variable indices
+   * @return
+   */
+  static std::vector<std::vector<int>> GetTransitionTable(const DFA_ptr dfa, const int number_of_bdd_variables, int* indices);
+
+protected:
+  /**
+   * Generates an equivalent transducer where each transition writes at most one character set
+   * @return
+   */
+  Transducer Split() const;
+
+  static CharSet ApplyRelation(const CharRelation& relation, const CharSet& chars);
+
+  static DFA_ptr DFAMinimizeAndFree(DFA_ptr dfa);
+
+  int initial_state_;
+  std::vector<bool> is_final_;
+  std::vector<std::vector<Transition>> transitions_;
+
+private:
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_TRANSDUCER_H_ */
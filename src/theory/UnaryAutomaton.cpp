@@ -85,27 +85,27 @@ UnaryAutomaton_ptr UnaryAutomaton::MakeAutomaton(SemilinearSet_ptr semilinear_se
   }
   statuses.push_back('\0');
 
-  dfaSetup(number_of_states, number_of_variables, indices);
+  DFABuilder builder(number_of_states, number_of_variables, indices);
 
   for (int s = 0; s < number_of_states - 2; s++) {
 
-    dfaAllocExceptions(1);
-    dfaStoreException(s + 1, unary_exception);
-    dfaStoreState(sink_state);
+    builder.AllocExceptions(1);
+    builder.StoreException(s + 1, unary_exception);
+    builder.StoreState(sink_state);
   }
 
   // Handle last state
   if (has_only_constants) {
-    dfaAllocExceptions(0);
-    dfaStoreState(sink_state);
+    builder.AllocExceptions(0);
+    builder.StoreState(sink_state);
   } else {
-    dfaAllocExceptions(1);
-    dfaStoreException(cycle_head, unary_exception);
-    dfaStoreState(sink_state);
+    builder.AllocExceptions(1);
+    builder.StoreException(cycle_head, unary_exception);
+    builder.StoreState(sink_state);
   }
 
-  dfaAllocExceptions(0);
-  dfaStoreState(sink_state);
+  builder.AllocExceptions(0);
+  builder.StoreState(sink_state);
 
   for (auto c : semilinear_set->get_constants()) {
     statuses[c] = '+';
@@ -115,11 +115,11 @@ UnaryAutomaton_ptr UnaryAutomaton::MakeAutomaton(SemilinearSet_ptr semilinear_se
     statuses[cycle_head + r] = '+';
   }
 
-  unary_dfa = dfaBuild(&*statuses.begin());
+  unary_dfa = builder.Build(&*statuses.begin());
   //delete[] indices; indices = nullptr;
   if (not has_only_constants) {
     tmp_dfa = unary_dfa;
-    unary_dfa = dfaMinimize(tmp_dfa);
+    unary_dfa = DFAMinimize(tmp_dfa);
     dfaFree(tmp_dfa); tmp_dfa = nullptr;
   }
 
@@ -222,19 +222,19 @@ IntAutomaton_ptr UnaryAutomaton::toIntAutomaton(int number_of_variables, bool ad
     exception.push_back('\0');
   }
 
-  dfaSetup(number_of_states, number_of_variables, indices);
+  DFABuilder builder(number_of_states, number_of_variables, indices);
 
   for (int s = 0; s < this->dfa_->ns; s++) {
     if (s != sink_state || !has_sink) {
       to_state = getNextState(s, unary_exception);
-      dfaAllocExceptions(exceptions.size());
+      builder.AllocExceptions(exceptions.size());
       for (auto& exception : exceptions) {
-        dfaStoreException(to_state, &*exception.begin());
+        builder.StoreException(to_state, &*exception.begin());
       }
-      dfaStoreState(sink_state);
+      builder.StoreState(sink_state);
     } else {
-      dfaAllocExceptions(0);
-      dfaStoreState(sink_state);
+      builder.AllocExceptions(0);
+      builder.StoreState(sink_state);
     }
 
     if (IsAcceptingState(s)) {
@@ -246,8 +246,8 @@ IntAutomaton_ptr UnaryAutomaton::toIntAutomaton(int number_of_variables, bool ad
 
   statuses[number_of_states] = '\0';
 
-  DFA_ptr temp_dfa = dfaBuild(statuses);
-  int_dfa = dfaMinimize(temp_dfa);
+  DFA_ptr temp_dfa = builder.Build(statuses);
+  int_dfa = DFAMinimize(temp_dfa);
   dfaFree(temp_dfa);
 
   int_auto = new IntAutomaton(int_dfa, number_of_variables);
@@ -0,0 +1,167 @@
+/*
+ * VariableOrder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "VariableOrder.h"
+
+namespace Vlab {
+namespace Theory {
+
+const std::size_t VariableOrder::MAX_NUMBER_OF_VARIABLES = 64;
+const int VariableOrder::VLOG_LEVEL = 15;
+
+std::vector<std::string> VariableOrder::Find(const std::vector<ArithmeticFormula_ptr>& formulas,
+                                             const std::vector<std::string>& variables) {
+  const int n = variables.size();
+  if (n < 2 or variables.size() > MAX_NUMBER_OF_VARIABLES or formulas.empty()) {
+    return variables;
+  }
+
+  auto coefficients = GetCoefficients(formulas, variables);
+  std::vector<std::vector<int>> co_occurrences(n, std::vector<int>(n, 0));
+  std::vector<int> magnitudes(n, 0);
+  for (auto& formula_coefficients : coefficients) {
+    for (auto& el : formula_coefficients) {
+      magnitudes[el.first] += std::abs(el.second);
+      for (auto& other : formula_coefficients) {
+        if (el.first != other.first) {
+          ++co_occurrences[el.first][other.first];
+        }
+      }
+    }
+  }
+
+  // pick the variable that keeps the next prefix narrowest, prefer the ones that appear with the placed
+  // variables and then the ones with small coefficients
+  std::vector<int> order;
+  std::vector<bool> is_placed(n, false);
+  while (order.size() < variables.size()) {
+    int best = -1, best_shared = 0;
+    double best_width = 0;
+    for (int v = 0; v < n; ++v) {
+      if (is_placed[v]) {
+        continue;
+      }
+      order.push_back(v);
+      double width = EstimateBddWidth(coefficients, order);
+      order.pop_back();
+      int shared = 0;
+      for (int u : order) {
+        shared += co_occurrences[v][u];
+      }
+      if (best == -1 or width < best_width
+          or (width == best_width
+              and (shared > best_shared or (shared == best_shared and magnitudes[v] < magnitudes[best])))) {
+        best = v;
+        best_width = width;
+        best_shared = shared;
+      }
+    }
+    is_placed[best] = true;
+    order.push_back(best);
+  }
+
+  // improve with adjacent swaps while the estimate decreases
+  double width = EstimateBddWidth(coefficients, order);
+  bool is_improved = true;
+  for (int round = 0; round < n and is_improved; ++round) {
+    is_improved = false;
+    for (int i = 0; i + 1 < n; ++i) {
+      std::swap(order[i], order[i + 1]);
+      double swapped_width = EstimateBddWidth(coefficients, order);
+      if (swapped_width < width) {
+        width = swapped_width;
+        is_improved = true;
+      } else {
+        std::swap(order[i], order[i + 1]);
+      }
+    }
+  }
+
+  std::vector<int> current_order(n);
+  for (int i = 0; i < n; ++i) {
+    current_order[i] = i;
+  }
+  const double current_width = EstimateBddWidth(coefficients, current_order);
+  DVLOG(VLOG_LEVEL) << "estimated bdd width: " << current_width << " with the current order, " << width
+                    << " with the searched order";
+  if (not (width < current_width)) {
+    return variables;
+  }
+
+  std::vector<std::string> variable_order;
+  for (int v : order) {
+    variable_order.push_back(variables[v]);
+  }
+  return variable_order;
+}
+
+double VariableOrder::EstimateBddWidth(const std::vector<ArithmeticFormula_ptr>& formulas,
+                                       const std::vector<std::string>& order) {
+  std::vector<int> positions(order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    positions[i] = i;
+  }
+  return EstimateBddWidth(GetCoefficients(formulas, order), positions);
+}
+
+std::vector<VariableOrder::Coefficients> VariableOrder::GetCoefficients(
+    const std::vector<ArithmeticFormula_ptr>& formulas, const std::vector<std::string>& variables) {
+  std::map<std::string, int> positions;
+  for (std::size_t i = 0; i < variables.size(); ++i) {
+    positions[variables[i]] = i;
+  }
+  std::vector<Coefficients> coefficients;
+  for (auto formula : formulas) {
+    Coefficients formula_coefficients;
+    for (auto& el : formula->GetVariableCoefficientMap()) {
+      auto it = positions.find(el.first);
+      if (el.second != 0 and it != positions.end()) {
+        formula_coefficients[it->second] = el.second;
+      }
+    }
+    if (not formula_coefficients.empty()) {
+      coefficients.push_back(formula_coefficients);
+    }
+  }
+  return coefficients;
+}
+
+/**
+ * A formula that is not read yet does not split the bdd; a partially read one splits it by its partial sum, which
+ * has at most 2^k values for k read variables and at most one more than the sum of the read coefficient magnitudes;
+ * a fully read one splits it by the carry of the next state, about half of the sum of its coefficient magnitudes.
+ * Width of a prefix is the product of the splits of all formulas.
+ */
+double VariableOrder::EstimateBddWidth(const std::vector<Coefficients>& coefficients, const std::vector<int>& order) {
+  std::vector<int> read_counts(coefficients.size(), 0), read_sums(coefficients.size(), 0);
+  double total_width = 0;
+  for (int v : order) {
+    double width = 1;
+    for (std::size_t f = 0; f < coefficients.size(); ++f) {
+      auto it = coefficients[f].find(v);
+      if (it != coefficients[f].end()) {
+        ++read_counts[f];
+        read_sums[f] += std::abs(it->second);
+      }
+      if (read_counts[f] == 0) {
+        continue;
+      } else if (read_counts[f] == static_cast<int>(coefficients[f].size())) {
+        width *= read_sums[f] / 2 + 1;
+      } else {
+        width *= std::min(std::pow(2.0, read_counts[f]), read_sums[f] + 1.0);
+      }
+    }
+    total_width += width;
+  }
+  return total_width;
+}
+
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,77 @@
+/*
+ * VariableOrder.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_VARIABLEORDER_H_
+#define THEORY_VARIABLEORDER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "ArithmeticFormula.h"
+
+namespace Vlab {
+namespace Theory {
+
+/**
+ * Searches a bdd variable order for the automaton of a conjunction of linear formulas.
+ * The automaton reads one bit of every variable per transition and its states keep the carry of each formula,
+ * so within a transition the bdd distinguishes the partial sums of the formulas that are not fully read yet.
+ * The width of the bdd after a prefix of the order is estimated from the coefficients read so far; orders that
+ * keep co-occurring variables together and read small coefficients first are narrower.
+ */
+class VariableOrder {
+public:
+  /**
+   * Greedily builds an order that keeps the estimated width small, breaking ties by co-occurrence and coefficient
+   * magnitude, then improves it with adjacent swaps. Returns the given order if the search does not find a
+   * narrower one.
+   * @param formulas conjuncts, variables that are not in the given order are ignored
+   * @param variables all variables in their current order
+   * @return
+   */
+  static std::vector<std::string> Find(const std::vector<ArithmeticFormula_ptr>& formulas,
+                                       const std::vector<std::string>& variables);
+
+  /**
+   * Sums the estimated bdd width over all prefixes of the order
+   * @param formulas
+   * @param order
+   * @return
+   */
+  static double EstimateBddWidth(const std::vector<ArithmeticFormula_ptr>& formulas,
+                                 const std::vector<std::string>& order);
+
+private:
+  /**
+   * Non-zero coefficients of a formula indexed by variable position
+   */
+  using Coefficients = std::map<int, int>;
+
+  static std::vector<Coefficients> GetCoefficients(const std::vector<ArithmeticFormula_ptr>& formulas,
+                                                   const std::vector<std::string>& variables);
+  static double EstimateBddWidth(const std::vector<Coefficients>& coefficients, const std::vector<int>& order);
+
+  /**
+   * Groups with more variables keep their order, the search is cubic in the number of variables
+   */
+  static const std::size_t MAX_NUMBER_OF_VARIABLES;
+  static const int VLOG_LEVEL;
+};
+
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_VARIABLEORDER_H_ */
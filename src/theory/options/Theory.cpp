@@ -13,8 +13,15 @@
 namespace Vlab {
 namespace Option {
 
-std::string Theory::TMP_PATH     = ".";
-std::string Theory::SCRIPT_PATH  = ".";
+thread_local std::string Theory::TMP_PATH     = ".";
+thread_local std::string Theory::SCRIPT_PATH  = ".";
+thread_local std::string Theory::REGEX_CACHE_FILE = "";
+thread_local bool Theory::DEFER_MINIMIZATION = true;
+thread_local int Theory::DEFERRED_MINIMIZATION_LIMIT = 4096;
+thread_local bool Theory::USE_NATIVE_MINIMIZATION = false;
+thread_local bool Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = true;
+thread_local int Theory::INT_BIT_WIDTH = 0;
+thread_local bool Theory::COUNT_BOUND_EXACT = false;
 
 } /* namespace Option */
 } /* namespace Vlab */
@@ -16,10 +16,29 @@
 namespace Vlab {
 namespace Option {
 
+/**
+ * Options are thread local, a driver installs its own values on the thread it runs on (see Option::Options)
+ */
 class Theory {
 public:
-  static std::string TMP_PATH;
-  static std::string SCRIPT_PATH;
+  static thread_local std::string TMP_PATH;
+  static thread_local std::string SCRIPT_PATH;
+  static thread_local std::string REGEX_CACHE_FILE;
+  static thread_local bool DEFER_MINIMIZATION;
+  static thread_local int DEFERRED_MINIMIZATION_LIMIT;
+  static thread_local bool USE_NATIVE_MINIMIZATION;
+  /**
+   * Builds charAt, substring, indexOf and their restrictions directly when the arguments are constants
+   */
+  static thread_local bool USE_DIRECT_INDEX_CONSTRUCTIONS;
+  /**
+   * Width of fixed width integers, 0 means integers are unbounded
+   */
+  static thread_local int INT_BIT_WIDTH;
+  /**
+   * Counts the models of exactly the bound length instead of up to the bound
+   */
+  static thread_local bool COUNT_BOUND_EXACT;
 };
 
 } /* namespace Option */
@@ -0,0 +1,139 @@
+/*
+ * Cancellation.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "Cancellation.h"
+
+namespace Vlab {
+namespace Util {
+
+Cancelled::Cancelled(const Reason reason)
+    : std::runtime_error(Reason::TIMEOUT == reason ? "timeout" :
+                         Reason::MEMORY_LIMIT == reason ? "memory limit exceeded" : "abandoned"),
+      reason_ { reason } {
+}
+
+Cancelled::Reason Cancelled::reason() const {
+  return reason_;
+}
+
+thread_local Cancellation::Budget_ptr Cancellation::BUDGET = nullptr;
+thread_local unsigned Cancellation::CHECK_COUNT = 0;
+const unsigned Cancellation::CLOCK_INTERVAL = 16;
+
+Cancellation::Scope::Scope(const int timeout, const int memory_limit)
+    : previous_budget_ { BUDGET },
+      is_outermost_ { BUDGET == nullptr } {
+  if (is_outermost_) {
+    BUDGET = MakeBudget(timeout, memory_limit);
+    CHECK_COUNT = 0;
+  }
+}
+
+Cancellation::Scope::Scope(Budget_ptr budget)
+    : previous_budget_ { BUDGET },
+      is_outermost_ { BUDGET != budget } {
+  BUDGET = budget;
+  if (is_outermost_) {
+    CHECK_COUNT = 0;
+  }
+}
+
+Cancellation::Scope::~Scope() {
+  BUDGET = previous_budget_;
+}
+
+bool Cancellation::Scope::is_outermost() const {
+  return is_outermost_;
+}
+
+Cancellation::Budget_ptr Cancellation::MakeBudget(const int timeout, const int memory_limit) {
+  if (timeout <= 0 and memory_limit <= 0) {
+    return nullptr;
+  }
+  auto budget = std::make_shared<Budget>();
+  budget->has_deadline = timeout > 0;
+  budget->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+  budget->memory_limit = memory_limit > 0 ? static_cast<std::size_t>(memory_limit) << 20 : 0;
+  budget->charged_memory = 0;
+  budget->is_cancelled = false;
+  budget->reason = static_cast<int>(Cancelled::Reason::TIMEOUT);
+  return budget;
+}
+
+Cancellation::Budget_ptr Cancellation::MakeChildBudget(Budget_ptr parent) {
+  auto budget = std::make_shared<Budget>();
+  budget->has_deadline = false;
+  budget->memory_limit = 0;
+  budget->charged_memory = 0;
+  budget->is_cancelled = false;
+  budget->reason = static_cast<int>(Cancelled::Reason::ABANDONED);
+  budget->parent = parent;
+  return budget;
+}
+
+void Cancellation::Abandon(Budget_ptr budget) {
+  MarkCancelled(*budget, Cancelled::Reason::ABANDONED);
+}
+
+void Cancellation::Check() {
+  if (BUDGET == nullptr) {
+    return;
+  }
+  for (auto budget = BUDGET.get(); budget != nullptr; budget = budget->parent.get()) {
+    if (budget->is_cancelled.load(std::memory_order_relaxed)) {
+      throw Cancelled(static_cast<Cancelled::Reason>(budget->reason.load()));
+    }
+  }
+
+  if (CHECK_COUNT++ % CLOCK_INTERVAL != 0) {
+    return;
+  }
+  for (auto budget = BUDGET.get(); budget != nullptr; budget = budget->parent.get()) {
+    if (budget->has_deadline and std::chrono::steady_clock::now() > budget->deadline) {
+      Cancel(*budget, Cancelled::Reason::TIMEOUT);
+    }
+  }
+}
+
+void Cancellation::Charge(const std::size_t bytes) {
+  if (BUDGET == nullptr) {
+    return;
+  }
+  for (auto budget = BUDGET.get(); budget != nullptr; budget = budget->parent.get()) {
+    const std::size_t charged_memory = budget->charged_memory.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    if (budget->memory_limit > 0 and charged_memory > budget->memory_limit
+        and not budget->is_cancelled.load(std::memory_order_relaxed)) {
+      MarkCancelled(*budget, Cancelled::Reason::MEMORY_LIMIT);
+    }
+  }
+}
+
+void Cancellation::Refund(Budget_ptr budget, const std::size_t bytes) {
+  for (auto charged_budget = budget.get(); charged_budget != nullptr; charged_budget = charged_budget->parent.get()) {
+    charged_budget->charged_memory.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+}
+
+Cancellation::Budget_ptr Cancellation::GetBudget() {
+  return BUDGET;
+}
+
+void Cancellation::Cancel(Budget& budget, const Cancelled::Reason reason) {
+  MarkCancelled(budget, reason);
+  throw Cancelled(reason);
+}
+
+void Cancellation::MarkCancelled(Budget& budget, const Cancelled::Reason reason) {
+  budget.reason = static_cast<int>(reason);
+  budget.is_cancelled = true;
+}
+
+} /* namespace Util */
+} /* namespace Vlab */
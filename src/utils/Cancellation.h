@@ -0,0 +1,158 @@
+/*
+ * Cancellation.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_UTILS_CANCELLATION_H_
+#define SRC_UTILS_CANCELLATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace Vlab {
+namespace Util {
+
+/**
+ * Thrown by Cancellation::Check when the running query is out of its budget
+ */
+class Cancelled : public std::runtime_error {
+public:
+  enum class Reason : int {
+    TIMEOUT = 0,
+    MEMORY_LIMIT,
+    ABANDONED
+  };
+
+  Cancelled(const Reason reason);
+  Reason reason() const;
+
+private:
+  Reason reason_;
+};
+
+/**
+ * Time and memory budget of a query, enforced cooperatively: long running loops call Check, which throws
+ * Cancelled once the deadline has passed or the memory charged to the budget is above the limit.
+ * Memory is metered per budget: automata charge the bytes of their states and bdd nodes with Charge and
+ * return them with Refund when they are freed, the limit bounds the size of the automata a query keeps at
+ * the same time and other queries running at the same time do not count.
+ * Budgets are per thread; worker threads join the budget of the thread that starts them with a Scope, and once
+ * one thread runs out of the budget every thread of it is cancelled at its next check.
+ * A child budget shares the limits of its parent and can also be abandoned on its own, e.g. when another
+ * worker already computed the result it was started for.
+ */
+class Cancellation {
+public:
+  struct Budget {
+    bool has_deadline;
+    std::chrono::steady_clock::time_point deadline;
+    /**
+     * In bytes, 0 for no limit
+     */
+    std::size_t memory_limit;
+    std::atomic<std::size_t> charged_memory;
+    std::atomic<bool> is_cancelled;
+    std::atomic<int> reason;
+    /**
+     * Checks and charges also go to the parent, nullptr for a budget of a query
+     */
+    std::shared_ptr<Budget> parent;
+  };
+  using Budget_ptr = std::shared_ptr<Budget>;
+
+  /**
+   * Makes a budget current for the thread and restores the previous one when it goes out of scope
+   */
+  class Scope {
+  public:
+    /**
+     * Starts a budget unless the thread already runs in one; a budget is not started if both limits are 0
+     * @param timeout in milliseconds
+     * @param memory_limit in megabytes
+     */
+    Scope(const int timeout, const int memory_limit);
+
+    /**
+     * Joins the given budget, e.g. in a worker thread or in each call of a query that keeps its budget
+     * @param budget
+     */
+    Scope(Budget_ptr budget);
+    ~Scope();
+
+    /**
+     * @return true if the budget is not already current in an enclosing scope
+     */
+    bool is_outermost() const;
+
+  private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    Budget_ptr previous_budget_;
+    bool is_outermost_;
+  };
+
+  /**
+   * Starts a budget, its deadline runs from now
+   * @param timeout in milliseconds
+   * @param memory_limit in megabytes
+   * @return nullptr if both limits are 0
+   */
+  static Budget_ptr MakeBudget(const int timeout, const int memory_limit);
+
+  /**
+   * Starts a budget without limits of its own that is cancelled with its parent
+   * @param parent may be nullptr
+   */
+  static Budget_ptr MakeChildBudget(Budget_ptr parent);
+
+  /**
+   * Cancels the budget and its children at their next check, the parent is not cancelled
+   * @param budget
+   */
+  static void Abandon(Budget_ptr budget);
+
+  /**
+   * Throws Cancelled if the budget of the thread is exhausted, does nothing without a budget.
+   * The clock is read at the first check in a scope and then once every CLOCK_INTERVAL checks.
+   */
+  static void Check();
+
+  /**
+   * Charges memory to the budget of the thread, does nothing without a budget; the budget is cancelled at
+   * the next check once the charges exceed the limit, the caller is not interrupted
+   * @param bytes
+   */
+  static void Charge(const std::size_t bytes);
+
+  /**
+   * Returns memory charged to the budget, e.g. when the automaton that charged it is freed
+   * @param budget may be nullptr
+   * @param bytes
+   */
+  static void Refund(Budget_ptr budget, const std::size_t bytes);
+
+  static Budget_ptr GetBudget();
+
+private:
+  static void Cancel(Budget& budget, const Cancelled::Reason reason);
+  static void MarkCancelled(Budget& budget, const Cancelled::Reason reason);
+
+  static thread_local Budget_ptr BUDGET;
+  static thread_local unsigned CHECK_COUNT;
+  static const unsigned CLOCK_INTERVAL;
+};
+
+} /* namespace Util */
+} /* namespace Vlab */
+
+#endif /* SRC_UTILS_CANCELLATION_H_ */
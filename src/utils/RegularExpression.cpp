@@ -48,7 +48,7 @@ const int RegularExpression::AUTOMATON = 0x0010;
 const int RegularExpression::INTERVAL = 0x0020;
 const int RegularExpression::ALL = 0xffff;
 const int RegularExpression::NONE = 0x0000;
-int RegularExpression::DEFAULT = 0x000f;
+thread_local int RegularExpression::DEFAULT = 0x000f;
 
 RegularExpression::RegularExpression()
     : type_(Type::NONE),
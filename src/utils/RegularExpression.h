@@ -96,7 +96,7 @@ public:
    * Syntax flag, used as a default combinations of the flag
    * Enables all except AUTOMATON and INTERVAL
    */
-  static int DEFAULT;
+  static thread_local int DEFAULT;
 
   enum class Type : int {
     NONE = 0,
@@ -0,0 +1,148 @@
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ThreadPool.h"
+
+namespace Vlab {
+namespace Util {
+
+thread_local ThreadPool* ThreadPool::current_pool_ = nullptr;
+thread_local unsigned ThreadPool::current_worker_id_ = 0;
+
+ThreadPool::ThreadPool(const unsigned number_of_threads)
+    : number_of_queued_tasks_ { 0 },
+      is_stopped_ { false },
+      next_worker_ { 0 } {
+  const unsigned number_of_workers = (number_of_threads == 0) ? 1 : number_of_threads;
+  for (unsigned i = 0; i < number_of_workers; ++i) {
+    workers_.push_back(std::unique_ptr<Worker>(new Worker()));
+  }
+  for (unsigned i = 0; i < number_of_workers; ++i) {
+    threads_.push_back(std::thread(&ThreadPool::Run, this, i));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = true;
+  }
+  state_changed_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+unsigned ThreadPool::GetNumberOfThreads() const {
+  return threads_.size();
+}
+
+void ThreadPool::Submit(Task task) {
+  const unsigned worker_id = GetCurrentWorkerId();
+  {
+    std::lock_guard<std::mutex> lock(workers_[worker_id]->mutex);
+    workers_[worker_id]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++number_of_queued_tasks_;
+  }
+  state_changed_.notify_all();
+}
+
+void ThreadPool::RunAll(const std::vector<Task>& tasks) {
+  auto number_of_remaining_tasks = std::make_shared<std::atomic<std::size_t>>(tasks.size());
+  for (auto& task : tasks) {
+    Submit([this, task, number_of_remaining_tasks]() {
+      task();
+      if (--(*number_of_remaining_tasks) == 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        state_changed_.notify_all();
+      }
+    });
+  }
+
+  const unsigned worker_id = GetCurrentWorkerId();
+  while (*number_of_remaining_tasks > 0) {
+    if (RunQueuedTask(worker_id)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    state_changed_.wait(lock, [this, &number_of_remaining_tasks]() {
+      return *number_of_remaining_tasks == 0 or number_of_queued_tasks_ > 0;
+    });
+  }
+}
+
+void ThreadPool::Run(const unsigned worker_id) {
+  current_pool_ = this;
+  current_worker_id_ = worker_id;
+  while (true) {
+    if (RunQueuedTask(worker_id)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    state_changed_.wait(lock, [this]() {
+      return is_stopped_ or number_of_queued_tasks_ > 0;
+    });
+    if (is_stopped_ and number_of_queued_tasks_ <= 0) {
+      return;
+    }
+  }
+}
+
+bool ThreadPool::PopTask(const unsigned worker_id, Task& task) {
+  {
+    std::lock_guard<std::mutex> lock(workers_[worker_id]->mutex);
+    auto& own_tasks = workers_[worker_id]->tasks;
+    if (not own_tasks.empty()) {
+      task = std::move(own_tasks.back());
+      own_tasks.pop_back();
+      return true;
+    }
+  }
+
+  for (unsigned i = 1; i < workers_.size(); ++i) {
+    auto& victim = workers_[(worker_id + i) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim->mutex);
+    if (not victim->tasks.empty()) {
+      task = std::move(victim->tasks.front());
+      victim->tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::RunQueuedTask(const unsigned worker_id) {
+  Task task;
+  if (not PopTask(worker_id, task)) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --number_of_queued_tasks_;
+  }
+  task();
+  return true;
+}
+
+/**
+ * Threads that are not workers of this pool submit tasks round robin
+ */
+unsigned ThreadPool::GetCurrentWorkerId() {
+  if (current_pool_ == this) {
+    return current_worker_id_;
+  }
+  return next_worker_++ % workers_.size();
+}
+
+} /* namespace Util */
+} /* namespace Vlab */
@@ -0,0 +1,91 @@
+/*
+ * ThreadPool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SRC_UTILS_THREADPOOL_H_
+#define SRC_UTILS_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Vlab {
+namespace Util {
+
+/**
+ * Fixed size pool of worker threads with work stealing.
+ * Each worker has its own task deque, it runs its newest task first and steals the oldest task
+ * of another worker when its own deque is empty. Tasks submitted from a worker go to its own deque.
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  ThreadPool(const unsigned number_of_threads);
+  virtual ~ThreadPool();
+
+  unsigned GetNumberOfThreads() const;
+
+  /**
+   * Schedules a task to run on one of the workers
+   * @param task
+   */
+  void Submit(Task task);
+
+  /**
+   * Runs the tasks on the pool and returns when all of them are done.
+   * The calling thread runs queued tasks while it waits, so it can be called from a task.
+   * @param tasks
+   */
+  void RunAll(const std::vector<Task>& tasks);
+
+ protected:
+  struct Worker {
+    std::deque<Task> tasks;
+    std::mutex mutex;
+  };
+
+  void Run(const unsigned worker_id);
+
+  /**
+   * Pops a task from the worker's own deque or steals one from the others
+   * @param worker_id
+   * @param task
+   * @return false if there is no queued task
+   */
+  bool PopTask(const unsigned worker_id, Task& task);
+  bool RunQueuedTask(const unsigned worker_id);
+  unsigned GetCurrentWorkerId();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  /**
+   * Protects the number of queued tasks and the stop flag, waiting threads are notified when
+   * a task is queued or a batch of tasks is done
+   */
+  std::mutex mutex_;
+  std::condition_variable state_changed_;
+  int number_of_queued_tasks_;
+  bool is_stopped_;
+  std::atomic<unsigned> next_worker_;
+
+  static thread_local ThreadPool* current_pool_;
+  static thread_local unsigned current_worker_id_;
+};
+
+} /* namespace Util */
+} /* namespace Vlab */
+
+#endif /* SRC_UTILS_THREADPOOL_H_ */
@@ -126,6 +126,58 @@ JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable
   return (jboolean)result;
 }
 
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    isUnknown
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isUnknown
+  (JNIEnv *env, jobject obj) {
+
+  Vlab::Driver *abc_driver = getHandle<Vlab::Driver>(env, obj);
+  return (jboolean)abc_driver->is_unknown();
+}
+
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    push
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_push
+  (JNIEnv *env, jobject obj, jint levels) {
+
+  Vlab::Driver *abc_driver = getHandle<Vlab::Driver>(env, obj);
+  abc_driver->Push((unsigned long)levels);
+}
+
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    pop
+ * Signature: (I)Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_pop
+  (JNIEnv *env, jobject obj, jint levels) {
+
+  Vlab::Driver *abc_driver = getHandle<Vlab::Driver>(env, obj);
+  return (jboolean)abc_driver->Pop((unsigned long)levels);
+}
+
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    assertIncremental
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_assertIncremental
+  (JNIEnv *env, jobject obj, jstring constraint) {
+
+  Vlab::Driver *abc_driver = getHandle<Vlab::Driver>(env, obj);
+  const char* constraint_str = env->GetStringUTFChars(constraint, JNI_FALSE);
+  std::string constraint_string {constraint_str};
+  env->ReleaseStringUTFChars(constraint, constraint_str);
+  bool result = abc_driver->AssertIncremental(constraint_string);
+  return (jboolean)result;
+}
+
 /*
  * Class:     vlab_cs_ucsb_edu_DriverProxy
  * Method:    countVariable
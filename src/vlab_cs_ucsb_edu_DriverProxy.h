@@ -47,6 +47,38 @@ JNIEXPORT void JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_setOption__ILjava_lang_
 JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isSatisfiable
   (JNIEnv *, jobject, jstring);
 
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    isUnknown
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_isUnknown
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    push
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_push
+  (JNIEnv *, jobject, jint);
+
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    pop
+ * Signature: (I)Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_pop
+  (JNIEnv *, jobject, jint);
+
+/*
+ * Class:     vlab_cs_ucsb_edu_DriverProxy
+ * Method:    assertIncremental
+ * Signature: (Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_vlab_cs_ucsb_edu_DriverProxy_assertIncremental
+  (JNIEnv *, jobject, jstring);
+
 /*
  * Class:     vlab_cs_ucsb_edu_DriverProxy
  * Method:    countVariable
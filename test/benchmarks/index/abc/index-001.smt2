@@ -0,0 +1,9 @@
+(declare-fun url () String)
+(declare-fun c () String)
+
+(assert (str.in.re url (re.++ (str.to.re "http") (re.opt (str.to.re "s")) (str.to.re "://") (re.+ (re.range "a" "z")) (re.* (re.++ (str.to.re "/") (re.* (re.range "a" "z")))))))
+
+(assert (= c (str.at url 4)))
+(assert (= c "s"))
+
+(check-sat)
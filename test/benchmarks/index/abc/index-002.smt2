@@ -0,0 +1,10 @@
+(declare-fun cookie () String)
+(declare-fun lang () String)
+
+(assert (str.in.re cookie (re.++ (re.* (re.union (str.to.re "a") (str.to.re "b") (str.to.re "c") (str.to.re ";") (str.to.re "="))) (str.to.re "searchLang=") (re.* (re.range "a" "z")))))
+(assert (< (str.len cookie) 40))
+
+(assert (= lang (str.substr cookie 11 2)))
+(assert (= lang "nb"))
+
+(check-sat)
@@ -0,0 +1,9 @@
+(declare-fun email () String)
+(declare-fun i () Int)
+
+(assert (str.in.re email (re.++ (re.+ (re.union (re.range "a" "z") (re.range "0" "9") (str.to.re "."))) (str.to.re "@") (re.+ (re.range "a" "z")) (str.to.re ".") (re.union (str.to.re "com") (str.to.re "org") (str.to.re "edu")))))
+
+(assert (= i (str.indexof email "@" 0)))
+(assert (> i 8))
+
+(check-sat)
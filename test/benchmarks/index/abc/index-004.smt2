@@ -0,0 +1,12 @@
+(declare-fun path () String)
+(declare-fun dir () String)
+(declare-fun i () Int)
+
+(assert (str.in.re path (re.++ (str.to.re "/") (re.* (re.++ (re.+ (re.range "a" "z")) (str.to.re "/"))) (re.+ (re.range "a" "z")) (str.to.re ".") (re.union (str.to.re "txt") (str.to.re "log")))))
+
+(assert (= i (str.indexof path "/tmp/" 0)))
+(assert (= i 0))
+(assert (= dir (str.substr path 5 3)))
+(assert (not (= dir "abc")))
+
+(check-sat)
@@ -0,0 +1,15 @@
+(declare-fun s () String)
+(declare-fun a () String)
+(declare-fun b () String)
+(declare-fun c () String)
+
+(assert (str.in.re s (re.* (re.union (str.to.re "ab") (str.to.re "ba") (str.to.re "abc") (re.range "0" "9")))))
+(assert (> (str.len s) 12))
+
+(assert (= a (str.at s 3)))
+(assert (= b (str.at s 7)))
+(assert (= c (str.substr s 4 5)))
+(assert (= a b))
+(assert (str.contains c "ca"))
+
+(check-sat)
@@ -0,0 +1,33 @@
+#!/bin/bash
+#
+# Compares direct charAt/substring/indexOf constructions with the
+# suffix and prefix based ones on the benchmarks in this folder.
+#
+# usage: ./compare.sh <path to abc> [number of runs]
+#
+
+ABC=${1:-abc}
+RUNS=${2:-5}
+DIR=$(cd "$(dirname "$0")" && pwd)
+
+run() {
+  local mode=$1 file=$2
+  local start=$(date +%s%N)
+  local result=""
+  for ((r = 0; r < RUNS; r++)); do
+    result=$("$ABC" -i "$file" --"$mode"-direct-index-constructions 2>/dev/null | grep -m 1 -o "\(un\)\?sat")
+  done
+  local end=$(date +%s%N)
+  echo "$result $(( (end - start) / RUNS / 1000000 ))"
+}
+
+printf "%-16s %8s %12s %8s %12s\n" "benchmark" "direct" "direct(ms)" "generic" "generic(ms)"
+for file in "$DIR"/abc/*.smt2; do
+  read direct_result direct_time <<< "$(run enable "$file")"
+  read generic_result generic_time <<< "$(run disable "$file")"
+  printf "%-16s %8s %12s %8s %12s" "$(basename "$file")" "$direct_result" "$direct_time" "$generic_result" "$generic_time"
+  if [ "$direct_result" != "$generic_result" ]; then
+    printf "  MISMATCH"
+  fi
+  printf "\n"
+done
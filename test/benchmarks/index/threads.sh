@@ -0,0 +1,35 @@
+#!/bin/bash
+#
+# Compares the solving time of the benchmarks in this folder on one thread
+# with the time on a thread pool, components are then built concurrently
+# and contend only for the lock around the MONA BDD managers.
+#
+# usage: ./threads.sh <path to abc> [number of threads] [number of runs]
+#
+
+ABC=${1:-abc}
+THREADS=${2:-8}
+RUNS=${3:-5}
+DIR=$(cd "$(dirname "$0")" && pwd)
+
+run() {
+  local threads=$1 file=$2
+  local start=$(date +%s%N)
+  local result=""
+  for ((r = 0; r < RUNS; r++)); do
+    result=$("$ABC" -i "$file" --threads "$threads" 2>/dev/null | grep -m 1 -o "\(un\)\?sat")
+  done
+  local end=$(date +%s%N)
+  echo "$result $(( (end - start) / RUNS / 1000000 ))"
+}
+
+printf "%-16s %8s %12s %8s %12s\n" "benchmark" "1" "1(ms)" "$THREADS" "$THREADS(ms)"
+for file in "$DIR"/abc/*.smt2; do
+  read sequential_result sequential_time <<< "$(run 1 "$file")"
+  read parallel_result parallel_time <<< "$(run "$THREADS" "$file")"
+  printf "%-16s %8s %12s %8s %12s" "$(basename "$file")" "$sequential_result" "$sequential_time" "$parallel_result" "$parallel_time"
+  if [ "$sequential_result" != "$parallel_result" ]; then
+    printf "  MISMATCH"
+  fi
+  printf "\n"
+done
@@ -0,0 +1,168 @@
+/*
+ * ConcurrentSolvingTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ConcurrentSolvingTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+void ConcurrentSolvingTest::SetUp() {
+  const std::string benchmark_path = Vlab::Test::Path::TEST_PATH + "/benchmarks/index/abc/";
+  for (auto name : {"index-001", "index-002", "index-003", "index-004", "index-005"}) {
+    benchmarks_.push_back(Vlab::Test::FileHelper::getASCIIContents(benchmark_path + name + ".smt2"));
+  }
+  number_of_threads_ = 8;
+}
+
+void ConcurrentSolvingTest::TearDown() {
+  Option::Solver::NUM_OF_THREADS = 1;
+  Option::Solver::SAT_ONLY_MODE = false;
+}
+
+ConcurrentSolvingTest::Result ConcurrentSolvingTest::Solve(const std::string& constraint) {
+  Vlab::Driver driver;
+  std::istringstream input(constraint);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+
+  Result result {driver.is_sat(), ""};
+  if (result.is_sat) {
+    std::stringstream count;
+    count << driver.CountStrs(5);
+    result.count = count.str();
+  }
+  return result;
+}
+
+TEST_F(ConcurrentSolvingTest, DriversInParallelThreads) {
+  std::vector<Result> expected_results;
+  for (auto& benchmark : benchmarks_) {
+    expected_results.push_back(Solve(benchmark));
+  }
+
+  const int number_of_rounds = 4;
+  std::vector<std::vector<Result>> results(number_of_threads_);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < number_of_threads_; ++t) {
+    threads.push_back(std::thread([this, t, &results]() {
+      for (int round = 0; round < number_of_rounds; ++round) {
+        // threads start from different benchmarks so that different constructions overlap
+        for (std::size_t i = 0; i < benchmarks_.size(); ++i) {
+          results[t].push_back(Solve(benchmarks_[(i + t) % benchmarks_.size()]));
+        }
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int t = 0; t < number_of_threads_; ++t) {
+    ASSERT_EQ(number_of_rounds * benchmarks_.size(), results[t].size());
+    for (std::size_t i = 0; i < results[t].size(); ++i) {
+      auto& expected = expected_results[(i + t) % benchmarks_.size()];
+      EXPECT_EQ(expected.is_sat, results[t][i].is_sat) << "thread " << t << ", run " << i;
+      EXPECT_EQ(expected.count, results[t][i].count) << "thread " << t << ", run " << i;
+    }
+  }
+}
+
+TEST_F(ConcurrentSolvingTest, ComponentsOnThreadPool) {
+  for (auto& benchmark : benchmarks_) {
+    Option::Solver::NUM_OF_THREADS = 1;
+    auto expected = Solve(benchmark);
+    Option::Solver::NUM_OF_THREADS = number_of_threads_;
+    auto result = Solve(benchmark);
+    EXPECT_EQ(expected.is_sat, result.is_sat);
+    EXPECT_EQ(expected.count, result.count);
+  }
+}
+
+TEST_F(ConcurrentSolvingTest, ComponentsOnThreadPoolAreDeterministic) {
+  // independent components finish in any order on the pool, the joined result must not depend on it
+  const std::string constraint =
+      "(declare-fun a () String)\n"
+      "(declare-fun b () String)\n"
+      "(declare-fun c () String)\n"
+      "(declare-fun d () String)\n"
+      "(assert (in a /(ab)*/))\n"
+      "(assert (= (len b) 3))\n"
+      "(assert (str.contains c \"x\"))\n"
+      "(assert (not (= d \"\")))\n"
+      "(assert (str.prefixof \"a\" d))\n"
+      "(check-sat)\n";
+  Option::Solver::NUM_OF_THREADS = 1;
+  auto expected = Solve(constraint);
+  ASSERT_TRUE(expected.is_sat);
+
+  for (int number_of_threads : {2, 4, number_of_threads_}) {
+    Option::Solver::NUM_OF_THREADS = number_of_threads;
+    for (int run = 0; run < 4; ++run) {
+      auto result = Solve(constraint);
+      EXPECT_EQ(expected.is_sat, result.is_sat) << number_of_threads << " threads, run " << run;
+      EXPECT_EQ(expected.count, result.count) << number_of_threads << " threads, run " << run;
+    }
+  }
+}
+
+TEST_F(ConcurrentSolvingTest, DisjunctsOnThreadPoolCountTheirUnion) {
+  // solutions of the disjuncts overlap, each solution is counted once
+  const std::string constraint =
+      "(declare-fun x () String)\n"
+      "(assert (or (= x \"ab\") (= x \"cd\") (in x /a./) (in x /(ab)+/)))\n"
+      "(check-sat)\n";
+  const std::string union_constraint =
+      "(declare-fun x () String)\n"
+      "(assert (in x /ab|cd|a.|(ab)+/))\n"
+      "(check-sat)\n";
+  Option::Solver::NUM_OF_THREADS = 1;
+  auto expected = Solve(union_constraint);
+  ASSERT_TRUE(expected.is_sat);
+  EXPECT_EQ(expected.count, Solve(constraint).count);
+
+  Option::Solver::NUM_OF_THREADS = number_of_threads_;
+  for (int run = 0; run < 4; ++run) {
+    auto result = Solve(constraint);
+    EXPECT_TRUE(result.is_sat) << "run " << run;
+    EXPECT_EQ(expected.count, result.count) << "run " << run;
+  }
+}
+
+TEST_F(ConcurrentSolvingTest, SatOnlyDisjunctsStopAtFirstSatisfiable) {
+  // the second disjunct is satisfiable, the ones after it are abandoned and the last one would take long
+  const std::string constraint =
+      "(declare-fun x () String)\n"
+      "(declare-fun y () String)\n"
+      "(assert (or (and (= x \"a\") (= x \"b\"))\n"
+      "            (and (= x \"ab\") (= y \"c\"))\n"
+      "            (= y \"d\")\n"
+      "            (and (in x /(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)/)\n"
+      "                 (in x /(a|b)*b(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)/))))\n"
+      "(check-sat)\n";
+  Option::Solver::SAT_ONLY_MODE = true;
+  Option::Solver::NUM_OF_THREADS = 1;
+  auto expected = Solve(constraint);
+  ASSERT_TRUE(expected.is_sat);
+
+  Option::Solver::NUM_OF_THREADS = number_of_threads_;
+  for (int run = 0; run < 4; ++run) {
+    auto result = Solve(constraint);
+    EXPECT_TRUE(result.is_sat) << "run " << run;
+    EXPECT_EQ(expected.count, result.count) << "run " << run;
+  }
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
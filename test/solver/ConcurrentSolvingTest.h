@@ -0,0 +1,53 @@
+/*
+ * ConcurrentSolvingTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_CONCURRENTSOLVINGTEST_H_
+#define SOLVER_CONCURRENTSOLVINGTEST_H_
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+#include "solver/options/Solver.h"
+#include "helper/FileHelper.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+/**
+ * Solves the same benchmarks with many drivers in parallel threads and compares the results with
+ * the ones computed by a single driver.
+ */
+class ConcurrentSolvingTest : public ::testing::Test {
+protected:
+  struct Result {
+    bool is_sat;
+    std::string count;
+  };
+
+  virtual void SetUp();
+  virtual void TearDown();
+
+  static Result Solve(const std::string& constraint);
+
+  std::vector<std::string> benchmarks_;
+  int number_of_threads_;
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_CONCURRENTSOLVINGTEST_H_ */
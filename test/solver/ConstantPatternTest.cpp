@@ -0,0 +1,94 @@
+/*
+ * ConstantPatternTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ConstantPatternTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+static const unsigned long BOUND = 6;
+
+Theory::BigInteger ConstantPatternTest::Count(const std::string& assertions) {
+  Driver driver;
+  std::istringstream input("(declare-fun x () String)\n(assert (in x /[ab]*/))\n" + assertions);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+  if (not driver.is_sat()) {
+    return -1;
+  }
+  return driver.CountVariable("x", BOUND);
+}
+
+Theory::BigInteger ConstantPatternTest::Enumerate(std::function<bool(const std::string&)> is_model) {
+  Theory::BigInteger count = 0;
+  std::vector<std::string> values { "" };
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    if (is_model(values[i])) {
+      ++count;
+    }
+    if (values[i].size() < BOUND) {
+      values.push_back(values[i] + "a");
+      values.push_back(values[i] + "b");
+    }
+  }
+  return count == 0 ? -1 : count;
+}
+
+bool ConstantPatternTest::Contains(const std::string& value, const std::string& pattern) {
+  return value.find(pattern) != std::string::npos;
+}
+
+TEST_F(ConstantPatternTest, ContainsAll) {
+  EXPECT_EQ(Enumerate([](const std::string& x) {
+    return Contains(x, "ab") and Contains(x, "ba") and Contains(x, "aa");
+  }), Count("(assert (str.contains x \"ab\"))\n(assert (str.contains x \"ba\"))\n(assert (str.contains x \"aa\"))\n"));
+}
+
+TEST_F(ConstantPatternTest, ContainsAllInChunks) {
+  // more patterns than a single contains-all automaton takes
+  const std::vector<std::string> patterns { "a", "b", "ab", "ba", "aa", "bb", "aab", "abb", "bba" };
+  std::string assertions;
+  for (auto& pattern : patterns) {
+    assertions += "(assert (str.contains x \"" + pattern + "\"))\n";
+  }
+  EXPECT_EQ(Enumerate([&patterns](const std::string& x) {
+    for (auto& pattern : patterns) {
+      if (not Contains(x, pattern)) {
+        return false;
+      }
+    }
+    return true;
+  }), Count(assertions));
+}
+
+TEST_F(ConstantPatternTest, NegatedContains) {
+  EXPECT_EQ(Enumerate([](const std::string& x) {
+    return not Contains(x, "aa") and not Contains(x, "bbb");
+  }), Count("(assert (not (str.contains x \"aa\")))\n(assert (not (str.contains x \"bbb\")))\n"));
+}
+
+TEST_F(ConstantPatternTest, MixedContains) {
+  EXPECT_EQ(Enumerate([](const std::string& x) {
+    return Contains(x, "ab") and Contains(x, "ba") and not Contains(x, "aa") and not Contains(x, "bbb");
+  }), Count("(assert (str.contains x \"ab\"))\n(assert (not (str.contains x \"aa\")))\n"
+            "(assert (str.contains x \"ba\"))\n(assert (not (str.contains x \"bbb\")))\n"));
+
+  // a not contains pattern inside a contains pattern
+  EXPECT_EQ(-1, Count("(assert (str.contains x \"ab\"))\n(assert (not (str.contains x \"b\")))\n"
+                      "(assert (str.contains x \"ba\"))\n(assert (not (str.contains x \"bbb\")))\n"));
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
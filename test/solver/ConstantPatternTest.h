@@ -0,0 +1,51 @@
+/*
+ * ConstantPatternTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_CONSTANTPATTERNTEST_H_
+#define SOLVER_CONSTANTPATTERNTEST_H_
+
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+/**
+ * Checks merged contains and not contains constraints on constant patterns against enumerated strings
+ */
+class ConstantPatternTest : public ::testing::Test {
+protected:
+  /**
+   * Solves the assertions on x, which is restricted to [ab]*, and counts x
+   * @param assertions
+   * @return count, or -1 when the assertions are not satisfiable
+   */
+  static Theory::BigInteger Count(const std::string& assertions);
+
+  /**
+   * Counts the strings over [ab]* within the bound that satisfy is_model
+   */
+  static Theory::BigInteger Enumerate(std::function<bool(const std::string&)> is_model);
+
+  static bool Contains(const std::string& value, const std::string& pattern);
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_CONSTANTPATTERNTEST_H_ */
@@ -0,0 +1,110 @@
+/*
+ * ConstraintCostModelTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ConstraintCostModelTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+static const std::string DECLARATIONS = "(declare-fun x () String)\n(declare-fun y () String)\n(declare-fun z () String)\n";
+
+void ConstraintCostModelTest::TearDown() {
+  Option::Solver::ENABLE_TIMING_REFINEMENT = false;
+}
+
+std::vector<double> ConstraintCostModelTest::GetScores(const std::string& constraint,
+                                                      ConstraintCostModel::Timings_ptr timings,
+                                                      const std::vector<double>& milliseconds) {
+  Driver driver;
+  std::istringstream input(DECLARATIONS + constraint);
+  driver.Parse(&input);
+  driver.symbol_table_ = new SymbolTable();
+  Initializer initializer(driver.script_, driver.symbol_table_);
+  initializer.start();
+
+  std::vector<double> scores;
+  ConstraintCostModel cost_model(driver.script_, driver.symbol_table_, timings);
+  driver.symbol_table_->push_scope(driver.script_);
+  std::size_t index = 0;
+  for (auto command : *(driver.script_->command_list)) {
+    if (SMT::Command::Type::ASSERT == command->getType() and index < milliseconds.size()) {
+      cost_model.RecordTiming(dynamic_cast<SMT::Assert_ptr>(command)->term, milliseconds[index++]);
+    }
+  }
+  for (auto command : *(driver.script_->command_list)) {
+    if (SMT::Command::Type::ASSERT == command->getType()) {
+      scores.push_back(cost_model.GetScore(dynamic_cast<SMT::Assert_ptr>(command)->term));
+    }
+  }
+  driver.symbol_table_->pop_scope();
+  return scores;
+}
+
+TEST_F(ConstraintCostModelTest, RestrictiveConstraintsFirst) {
+  auto scores = GetScores("(assert (= x \"abc\"))\n(assert (contains x \"a\"))\n(assert (not (contains x \"ab\")))\n");
+  ASSERT_EQ(3, scores.size());
+  EXPECT_LT(scores[0], scores[1]);
+  EXPECT_LT(scores[1], scores[2]);
+}
+
+TEST_F(ConstraintCostModelTest, CheaperConstraintsFirst) {
+  auto scores = GetScores("(assert (in x /[a-z]{2,3}/))\n(assert (in x /[a-z]{20,30}/))\n(assert (= x (replace y \"a\" z)))\n");
+  ASSERT_EQ(3, scores.size());
+  EXPECT_LT(scores[0], scores[1]);
+  EXPECT_LT(scores[1], scores[2]);
+}
+
+TEST_F(ConstraintCostModelTest, TimingsAreKeptPerInstance) {
+  Option::Solver::ENABLE_TIMING_REFINEMENT = true;
+  const std::string constraint = "(assert (in x /[a-z]{2,3}/))\n(assert (= x (replace y \"a\" z)))\n";
+  auto scores = GetScores(constraint);
+  ASSERT_EQ(2, scores.size());
+
+  auto timings = std::make_shared<ConstraintCostModel::Timings>();
+  auto timed_scores = GetScores(constraint, timings, { 1000, 1 });
+  ASSERT_EQ(2, timed_scores.size());
+  EXPECT_GT(timed_scores[0], scores[0]);
+  EXPECT_LT(timed_scores[1], scores[1]);
+
+  // the timings stay with their owner, other models keep their own
+  auto other_scores = GetScores(constraint, std::make_shared<ConstraintCostModel::Timings>());
+  EXPECT_DOUBLE_EQ(scores[0], other_scores[0]);
+  EXPECT_DOUBLE_EQ(scores[1], other_scores[1]);
+  auto shared_scores = GetScores(constraint, timings);
+  EXPECT_DOUBLE_EQ(timed_scores[0], shared_scores[0]);
+  EXPECT_DOUBLE_EQ(timed_scores[1], shared_scores[1]);
+}
+
+TEST_F(ConstraintCostModelTest, TimingsAreIgnoredUnlessEnabled) {
+  const std::string constraint = "(assert (in x /[a-z]{2,3}/))\n(assert (= x (replace y \"a\" z)))\n";
+  auto scores = GetScores(constraint);
+  auto timings = std::make_shared<ConstraintCostModel::Timings>();
+  auto timed_scores = GetScores(constraint, timings, { 1000, 1 });
+  ASSERT_EQ(2, timed_scores.size());
+  EXPECT_DOUBLE_EQ(scores[0], timed_scores[0]);
+  EXPECT_DOUBLE_EQ(scores[1], timed_scores[1]);
+  EXPECT_TRUE(timings->by_type.empty());
+}
+
+TEST_F(ConstraintCostModelTest, RestrictReturnsLoweredBounds) {
+  ConstraintCostModel cost_model(nullptr, nullptr);
+  EXPECT_EQ(std::set<std::string>({"i", "x", "y"}), cost_model.Restrict({ 10, 1, 0.5, {"x", "y"}, {"i"} }));
+  // a larger estimate does not loosen the bounds
+  EXPECT_TRUE(cost_model.Restrict({ 20, 1, 0.5, {"x"}, {"i"} }).empty());
+  EXPECT_EQ(std::set<std::string>({"x", "y", "z"}), cost_model.Restrict({ 5, 1, 0.5, {"x", "y", "z"}, { } }));
+  EXPECT_EQ(std::set<std::string>({"i"}), cost_model.Restrict({ 5, 1, 0.5, {"z"}, {"i"} }));
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
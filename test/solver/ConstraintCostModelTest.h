@@ -0,0 +1,48 @@
+/*
+ * ConstraintCostModelTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_CONSTRAINTCOSTMODELTEST_H_
+#define SOLVER_CONSTRAINTCOSTMODELTEST_H_
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+#include "solver/ConstraintCostModel.h"
+#include "solver/options/Solver.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+class ConstraintCostModelTest : public ::testing::Test {
+protected:
+  virtual void TearDown();
+
+  /**
+   * Scores of the assertions of the constraint
+   * @param constraint
+   * @param timings of the cost model
+   * @param milliseconds recorded for each assertion before scoring
+   * @return
+   */
+  std::vector<double> GetScores(const std::string& constraint, ConstraintCostModel::Timings_ptr timings = nullptr,
+                                const std::vector<double>& milliseconds = { });
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_CONSTRAINTCOSTMODELTEST_H_ */
@@ -0,0 +1,113 @@
+/*
+ * IncrementalSolvingTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "IncrementalSolvingTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+static const unsigned long BOUND = 5;
+
+void IncrementalSolvingTest::SetUp() {
+  declarations_ = "(declare-fun x () String)\n(declare-fun y () String)\n(declare-fun z () String)\n";
+  driver_ = new Driver();
+  driver_->AssertIncremental(declarations_);
+}
+
+void IncrementalSolvingTest::TearDown() {
+  delete driver_;
+}
+
+Theory::BigInteger IncrementalSolvingTest::SolveAtOnce(const std::string& assertions, const std::string& var_name) {
+  Driver driver;
+  std::istringstream input(declarations_ + assertions);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+  if (not driver.is_sat()) {
+    return -1;
+  }
+  return driver.CountVariable(var_name, BOUND);
+}
+
+Theory::BigInteger IncrementalSolvingTest::CountIncremental(const std::string& var_name) {
+  if (not driver_->is_sat()) {
+    return -1;
+  }
+  return driver_->CountVariable(var_name, BOUND);
+}
+
+TEST_F(IncrementalSolvingTest, SingleVariableAssertions) {
+  const std::string first = "(assert (in x /[a-c]*/))\n";
+  const std::string second = "(assert (< (len x) 3))\n";
+  const std::string third = "(assert (str.prefixof \"b\" x))\n";
+
+  EXPECT_TRUE(driver_->AssertIncremental(first));
+  EXPECT_EQ(SolveAtOnce(first, "x"), CountIncremental("x"));
+
+  driver_->Push();
+  EXPECT_TRUE(driver_->AssertIncremental(second));
+  EXPECT_EQ(SolveAtOnce(first + second, "x"), CountIncremental("x"));
+
+  driver_->Push();
+  EXPECT_TRUE(driver_->AssertIncremental(third));
+  EXPECT_EQ(SolveAtOnce(first + second + third, "x"), CountIncremental("x"));
+
+  driver_->Pop();
+  EXPECT_EQ(SolveAtOnce(first + second, "x"), CountIncremental("x"));
+
+  driver_->Pop();
+  EXPECT_EQ(SolveAtOnce(first, "x"), CountIncremental("x"));
+}
+
+TEST_F(IncrementalSolvingTest, UnsatisfiableLevel) {
+  EXPECT_TRUE(driver_->AssertIncremental("(assert (in x /a+/))\n"));
+  EXPECT_FALSE(driver_->AssertIncremental("(push 1)\n(assert (in x /b+/))\n"));
+  EXPECT_FALSE(driver_->is_sat());
+  EXPECT_TRUE(driver_->AssertIncremental("(pop 1)\n"));
+  EXPECT_TRUE(driver_->is_sat());
+}
+
+TEST_F(IncrementalSolvingTest, RelatedVariables) {
+  const std::string first = "(assert (in y /a*/))\n";
+  const std::string second = "(assert (= x (str.++ y z)))\n";
+  const std::string third = "(assert (= z \"b\"))\n";
+
+  EXPECT_TRUE(driver_->AssertIncremental(first));
+  driver_->Push();
+  EXPECT_TRUE(driver_->AssertIncremental(second));
+  EXPECT_EQ(SolveAtOnce(first + second, "x"), CountIncremental("x"));
+  driver_->Push();
+  EXPECT_TRUE(driver_->AssertIncremental(third));
+  EXPECT_EQ(SolveAtOnce(first + second + third, "x"), CountIncremental("x"));
+  driver_->Pop(2);
+  EXPECT_EQ(SolveAtOnce(first, "y"), CountIncremental("y"));
+}
+
+TEST_F(IncrementalSolvingTest, PopTooManyLevels) {
+  EXPECT_TRUE(driver_->AssertIncremental("(assert (in x /a+/))\n"));
+  driver_->Push();
+  EXPECT_TRUE(driver_->AssertIncremental("(assert (< (len x) 3))\n"));
+  EXPECT_FALSE(driver_->Pop(2));
+  // the stack is left as it is
+  EXPECT_EQ(SolveAtOnce("(assert (in x /a+/))\n(assert (< (len x) 3))\n", "x"), CountIncremental("x"));
+  EXPECT_TRUE(driver_->AssertIncremental("(pop 5)\n"));
+  EXPECT_EQ(SolveAtOnce("(assert (in x /a+/))\n(assert (< (len x) 3))\n", "x"), CountIncremental("x"));
+  EXPECT_TRUE(driver_->Pop(1));
+  EXPECT_EQ(SolveAtOnce("(assert (in x /a+/))\n", "x"), CountIncremental("x"));
+  EXPECT_FALSE(driver_->Pop(1));
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
@@ -0,0 +1,50 @@
+/*
+ * IncrementalSolvingTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_INCREMENTALSOLVINGTEST_H_
+#define SOLVER_INCREMENTALSOLVINGTEST_H_
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+/**
+ * Compares incremental solving with solving all assertions at once
+ */
+class IncrementalSolvingTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Solves the declarations and the given assertions from scratch and counts the given variable
+   * @param assertions
+   * @param var_name
+   * @return count, or -1 when the assertions are not satisfiable
+   */
+  Theory::BigInteger SolveAtOnce(const std::string& assertions, const std::string& var_name);
+  Theory::BigInteger CountIncremental(const std::string& var_name);
+
+  std::string declarations_;
+  Driver* driver_;
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_INCREMENTALSOLVINGTEST_H_ */
@@ -0,0 +1,82 @@
+/*
+ * LengthAbstractionCheckerTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "LengthAbstractionCheckerTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+static const std::string DECLARATIONS = "(declare-fun x () String)\n(declare-fun y () String)\n(declare-fun i () Int)\n";
+
+bool LengthAbstractionCheckerTest::IsFeasible(const std::string& constraint) {
+  Driver driver;
+  std::istringstream input(DECLARATIONS + constraint);
+  driver.Parse(&input);
+  driver.symbol_table_ = new SymbolTable();
+  Initializer initializer(driver.script_, driver.symbol_table_);
+  initializer.start();
+  SyntacticProcessor syntactic_processor(driver.script_);
+  syntactic_processor.start();
+  SyntacticOptimizer syntactic_optimizer(driver.script_, driver.symbol_table_);
+  syntactic_optimizer.start();
+  LengthAbstractionChecker length_abstraction_checker(driver.script_, driver.symbol_table_);
+  length_abstraction_checker.start();
+  return length_abstraction_checker.is_feasible();
+}
+
+bool LengthAbstractionCheckerTest::IsSatisfiable(const std::string& constraint) {
+  Driver driver;
+  std::istringstream input(DECLARATIONS + constraint);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+  return driver.is_sat();
+}
+
+TEST_F(LengthAbstractionCheckerTest, InfeasibleLengths) {
+  EXPECT_FALSE(IsFeasible("(assert (> (len x) 10))\n(assert (= x (concat \"abc\" y)))\n(assert (< (len y) 3))\n"));
+  EXPECT_FALSE(IsFeasible("(assert (in x /[a-z]{5,8}/))\n(assert (< (len x) 4))\n"));
+  EXPECT_FALSE(IsFeasible("(assert (in x /(ab)+/))\n(assert (in y /c?/))\n(assert (= x y))\n"));
+  EXPECT_FALSE(IsFeasible("(assert (= (len x) (+ i 2)))\n(assert (< i (- 0 2)))\n"));
+  EXPECT_FALSE(IsFeasible("(assert (or (< (len x) 0) (and (in x /a{3}/) (> (len x) 3))))\n"));
+  EXPECT_FALSE(IsSatisfiable("(assert (> (len x) 10))\n(assert (= x (concat \"abc\" y)))\n(assert (< (len y) 3))\n"));
+}
+
+TEST_F(LengthAbstractionCheckerTest, InfeasibleLengthsCountNothing) {
+  Driver driver;
+  std::istringstream input(DECLARATIONS
+      + "(assert (> (len x) 10))\n(assert (= x (concat \"abc\" y)))\n(assert (< (len y) 3))\n(assert (< i 4))\n");
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+  EXPECT_FALSE(driver.is_sat());
+  EXPECT_EQ(0, driver.CountVariable("x", 15));
+  EXPECT_EQ(0, driver.CountVariable("i", 5));
+  EXPECT_EQ(0, driver.CountStrs(15));
+  EXPECT_EQ(0, driver.CountInts(5));
+  EXPECT_EQ(0, driver.Count(5, 15));
+  EXPECT_EQ(0, driver.GetModelCounter().Count(5, 15));
+}
+
+TEST_F(LengthAbstractionCheckerTest, FeasibleLengths) {
+  EXPECT_TRUE(IsFeasible("(assert (> (len x) 10))\n(assert (= x (concat \"abc\" y)))\n(assert (< (len y) 9))\n"));
+  EXPECT_TRUE(IsFeasible("(assert (in x /[a-z]*/))\n(assert (< (len x) 4))\n"));
+  EXPECT_TRUE(IsFeasible("(assert (or (< (len x) 0) (in x /a{3}/)))\n"));
+  // lengths agree, characters do not; it is left to the automata
+  EXPECT_TRUE(IsFeasible("(assert (in x /a+/))\n(assert (in x /b+/))\n"));
+  EXPECT_FALSE(IsSatisfiable("(assert (in x /a+/))\n(assert (in x /b+/))\n"));
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
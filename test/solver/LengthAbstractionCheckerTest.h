@@ -0,0 +1,47 @@
+/*
+ * LengthAbstractionCheckerTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_LENGTHABSTRACTIONCHECKERTEST_H_
+#define SOLVER_LENGTHABSTRACTIONCHECKERTEST_H_
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+#include "solver/LengthAbstractionChecker.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+class LengthAbstractionCheckerTest : public ::testing::Test {
+protected:
+  /**
+   * Runs the syntactic passes and the length abstraction checker
+   * @param constraint
+   * @return
+   */
+  bool IsFeasible(const std::string& constraint);
+
+  /**
+   * Solves the constraint with all solver passes
+   * @param constraint
+   * @return
+   */
+  bool IsSatisfiable(const std::string& constraint);
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_LENGTHABSTRACTIONCHECKERTEST_H_ */
@@ -0,0 +1,179 @@
+/*
+ * QueryBudgetTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "QueryBudgetTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+static const std::string CONSTRAINT = "(declare-fun x () String)\n(assert (in x /(ab|c)*d/))\n";
+
+void QueryBudgetTest::Solve(Driver& driver, const std::string& constraint) {
+  std::istringstream input(constraint);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+}
+
+Util::Cancellation::Budget_ptr QueryBudgetTest::MakeExpiredBudget() {
+  auto budget = Util::Cancellation::MakeBudget(1, 0);
+  budget->deadline = std::chrono::steady_clock::now() - std::chrono::milliseconds(1);
+  return budget;
+}
+
+TEST_F(QueryBudgetTest, CheckThrowsAfterDeadline) {
+  EXPECT_NO_THROW(Util::Cancellation::Check());
+  {
+    Util::Cancellation::Scope cancellation_scope(60000, 0);
+    EXPECT_NO_THROW(Util::Cancellation::Check());
+  }
+
+  Util::Cancellation::Scope cancellation_scope(MakeExpiredBudget());
+  EXPECT_TRUE(cancellation_scope.is_outermost());
+  try {
+    Util::Cancellation::Check();
+    FAIL() << "deadline is not enforced";
+  } catch (const Util::Cancelled& e) {
+    EXPECT_EQ(Util::Cancelled::Reason::TIMEOUT, e.reason());
+  }
+  // every later check of the budget fails
+  EXPECT_THROW(Util::Cancellation::Check(), Util::Cancelled);
+}
+
+TEST_F(QueryBudgetTest, CheckThrowsOverMemoryLimit) {
+  // charges without a budget are not metered
+  Util::Cancellation::Charge(std::size_t(1) << 30);
+  EXPECT_NO_THROW(Util::Cancellation::Check());
+
+  Util::Cancellation::Scope cancellation_scope(0, 1);
+  Util::Cancellation::Charge(std::size_t(1) << 19);
+  EXPECT_NO_THROW(Util::Cancellation::Check());
+  Util::Cancellation::Charge(std::size_t(1) << 20);
+  try {
+    Util::Cancellation::Check();
+    FAIL() << "memory limit is not enforced";
+  } catch (const Util::Cancelled& e) {
+    EXPECT_EQ(Util::Cancelled::Reason::MEMORY_LIMIT, e.reason());
+  }
+}
+
+TEST_F(QueryBudgetTest, QueriesAreMeteredSeparately) {
+  // the process takes more than a megabyte, only the automata of each query count
+  Driver driver, other_driver;
+  driver.set_option(Option::Name::MEMORY_LIMIT, 1);
+  other_driver.set_option(Option::Name::MEMORY_LIMIT, 1);
+  Solve(driver, CONSTRAINT);
+  Solve(other_driver, CONSTRAINT);
+  EXPECT_FALSE(driver.is_unknown());
+  EXPECT_FALSE(other_driver.is_unknown());
+  EXPECT_EQ(4, driver.CountStrs(3));
+  EXPECT_EQ(4, other_driver.CountStrs(3));
+}
+
+TEST_F(QueryBudgetTest, FreedAutomataAreRefunded) {
+  Util::Cancellation::Scope cancellation_scope(0, 1);
+  auto budget = Util::Cancellation::GetBudget();
+  auto regex_auto = Theory::StringAutomaton::MakeRegexAuto("(ab|c)*d");
+  auto copy_auto = regex_auto->clone();
+  EXPECT_LT(0, budget->charged_memory.load());
+  delete regex_auto;
+  EXPECT_LT(0, budget->charged_memory.load());
+  delete copy_auto;
+  EXPECT_EQ(0, budget->charged_memory.load());
+
+  // an automaton returns its charge to the budget it was charged to
+  auto other_auto = Theory::StringAutomaton::MakeRegexAuto("(ab|c)*d");
+  {
+    Util::Cancellation::Scope other_scope(Util::Cancellation::MakeBudget(0, 1));
+    delete other_auto;
+  }
+  EXPECT_EQ(0, budget->charged_memory.load());
+}
+
+TEST_F(QueryBudgetTest, CancelledCallIsUnknownUntilReset) {
+  Driver driver;
+  Solve(driver, CONSTRAINT);
+  EXPECT_TRUE(driver.is_sat());
+  EXPECT_FALSE(driver.is_unknown());
+
+  {
+    // the call runs in the budget of the caller
+    Util::Cancellation::Scope cancellation_scope(MakeExpiredBudget());
+    EXPECT_EQ(0, driver.CountStrs(3));
+  }
+  EXPECT_TRUE(driver.is_unknown());
+  EXPECT_FALSE(driver.is_sat());
+  EXPECT_TRUE(driver.getSatisfyingExamples().empty());
+  // later calls of the query do not run
+  EXPECT_EQ(0, driver.CountStrs(3));
+  EXPECT_TRUE(driver.is_unknown());
+
+  driver.reset();
+  Solve(driver, CONSTRAINT);
+  EXPECT_FALSE(driver.is_unknown());
+  EXPECT_TRUE(driver.is_sat());
+  EXPECT_EQ(4, driver.CountStrs(3));
+}
+
+TEST_F(QueryBudgetTest, CancelledSolveIsUnknownUntilReset) {
+  Driver driver;
+  {
+    Util::Cancellation::Scope cancellation_scope(MakeExpiredBudget());
+    Solve(driver, CONSTRAINT);
+  }
+  EXPECT_TRUE(driver.is_unknown());
+  EXPECT_FALSE(driver.is_sat());
+  EXPECT_EQ(0, driver.CountStrs(3));
+
+  driver.reset();
+  Solve(driver, CONSTRAINT);
+  EXPECT_FALSE(driver.is_unknown());
+  EXPECT_TRUE(driver.is_sat());
+  EXPECT_EQ(4, driver.CountStrs(3));
+}
+
+TEST_F(QueryBudgetTest, AbandonedChildBudgetDoesNotCancelParent) {
+  Util::Cancellation::Scope cancellation_scope(0, 1);
+  auto budget = Util::Cancellation::GetBudget();
+  auto child_budget = Util::Cancellation::MakeChildBudget(budget);
+  auto other_child_budget = Util::Cancellation::MakeChildBudget(budget);
+  {
+    Util::Cancellation::Scope child_scope(child_budget);
+    Util::Cancellation::Charge(std::size_t(1) << 19);
+    EXPECT_NO_THROW(Util::Cancellation::Check());
+    Util::Cancellation::Abandon(child_budget);
+    try {
+      Util::Cancellation::Check();
+      FAIL() << "abandoned budget is not cancelled";
+    } catch (const Util::Cancelled& e) {
+      EXPECT_EQ(Util::Cancelled::Reason::ABANDONED, e.reason());
+    }
+  }
+  EXPECT_NO_THROW(Util::Cancellation::Check());
+  EXPECT_EQ(std::size_t(1) << 19, budget->charged_memory.load());
+
+  // charges of a child count against the limit of the parent
+  Util::Cancellation::Scope other_child_scope(other_child_budget);
+  Util::Cancellation::Charge(std::size_t(1) << 20);
+  try {
+    Util::Cancellation::Check();
+    FAIL() << "memory limit of the parent is not enforced";
+  } catch (const Util::Cancelled& e) {
+    EXPECT_EQ(Util::Cancelled::Reason::MEMORY_LIMIT, e.reason());
+  }
+  EXPECT_TRUE(budget->is_cancelled.load());
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
@@ -0,0 +1,42 @@
+/*
+ * QueryBudgetTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_QUERYBUDGETTEST_H_
+#define SOLVER_QUERYBUDGETTEST_H_
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+#include "theory/StringAutomaton.h"
+#include "utils/Cancellation.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+class QueryBudgetTest : public ::testing::Test {
+protected:
+  void Solve(Driver& driver, const std::string& constraint);
+
+  /**
+   * Budget whose deadline has already passed, it cancels at the first check in its scope
+   */
+  static Util::Cancellation::Budget_ptr MakeExpiredBudget();
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_QUERYBUDGETTEST_H_ */
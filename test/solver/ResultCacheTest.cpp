@@ -0,0 +1,163 @@
+/*
+ * ResultCacheTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ResultCacheTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+static const unsigned long BOUND = 5;
+
+void ResultCacheTest::SetUp() {
+  ResultCache::Clear();
+}
+
+void ResultCacheTest::TearDown() {
+  ResultCache::Clear();
+  ResultCache::SetSize(ResultCache::DEFAULT_SIZE);
+}
+
+std::string ResultCacheTest::GetFingerprint(const std::string& constraint) {
+  Driver driver;
+  std::istringstream input(constraint);
+  driver.Parse(&input);
+  driver.symbol_table_ = new SymbolTable();
+  Initializer initializer(driver.script_, driver.symbol_table_);
+  initializer.start();
+  SyntacticProcessor syntactic_processor(driver.script_);
+  syntactic_processor.start();
+  SyntacticOptimizer syntactic_optimizer(driver.script_, driver.symbol_table_);
+  syntactic_optimizer.start();
+  ConstraintFingerprint constraint_fingerprint(driver.script_, driver.symbol_table_);
+  constraint_fingerprint.start();
+  return constraint_fingerprint.get_fingerprint();
+}
+
+TEST_F(ResultCacheTest, FingerprintIgnoresNamesAndOperandOrder) {
+  auto fingerprint = GetFingerprint(
+      "(declare-fun x () String)\n(declare-fun y () String)\n"
+      "(assert (= x (concat y \"a\")))\n(assert (in y /[a-c]*/))\n");
+  EXPECT_FALSE(fingerprint.empty());
+  EXPECT_EQ(fingerprint, GetFingerprint(
+      "(declare-fun b () String)\n(declare-fun a () String)\n"
+      "(assert (in a /[a-c]*/))\n(assert (= (concat a \"a\") b))\n"));
+  EXPECT_NE(fingerprint, GetFingerprint(
+      "(declare-fun x () String)\n(declare-fun y () String)\n"
+      "(assert (= x (concat y \"b\")))\n(assert (in y /[a-c]*/))\n"));
+  EXPECT_NE(fingerprint, GetFingerprint(
+      "(declare-fun x () String)\n(declare-fun y () String)\n"
+      "(assert (= y (concat x \"a\")))\n(assert (in y /[a-c]*/))\n"));
+}
+
+TEST_F(ResultCacheTest, RepeatedQueryUsesCachedResult) {
+  const std::string first = "(declare-fun x () String)\n(declare-fun y () String)\n"
+      "(assert (= x (concat y \"a\")))\n(assert (in y /[a-c]*/))\n";
+  const std::string second = "(declare-fun b () String)\n(declare-fun a () String)\n"
+      "(assert (in a /[a-c]*/))\n(assert (= (concat a \"a\") b))\n";
+
+  Theory::BigInteger count;
+  {
+    Driver driver;
+    driver.set_option(Option::Name::RESULT_CACHE_SIZE, 8);
+    std::istringstream input(first);
+    driver.Parse(&input);
+    driver.InitializeSolver();
+    driver.Solve();
+    EXPECT_TRUE(driver.is_sat());
+    count = driver.CountStrs(BOUND);
+  }
+
+  Driver driver;
+  driver.set_option(Option::Name::RESULT_CACHE_SIZE, 8);
+  std::istringstream input(second);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  ResultCache::Entry entry;
+  EXPECT_TRUE(ResultCache::Get(ResultCache::GetKey(GetFingerprint(second)), entry));
+  EXPECT_FALSE(entry.model_counter.empty());
+  driver.Solve();
+  EXPECT_TRUE(driver.is_sat());
+  EXPECT_EQ(count, driver.CountStrs(BOUND));
+  // variable values are computed on demand
+  EXPECT_FALSE(driver.getSatisfyingExamples().empty());
+  EXPECT_TRUE(driver.is_sat());
+}
+
+TEST_F(ResultCacheTest, KeyDependsOnResultOptions) {
+  // restores the options at the end
+  const Option::Options options;
+  Option::Options::Scope option_scope(options);
+  std::set<std::string> keys { ResultCache::GetKey("fingerprint") };
+  Option::Solver::ENABLE_IMPLICATIONS = not Option::Solver::ENABLE_IMPLICATIONS;
+  EXPECT_TRUE(keys.insert(ResultCache::GetKey("fingerprint")).second);
+  Option::Solver::ENABLE_LEN_IMPLICATIONS = not Option::Solver::ENABLE_LEN_IMPLICATIONS;
+  EXPECT_TRUE(keys.insert(ResultCache::GetKey("fingerprint")).second);
+  Option::Solver::ENABLE_EQUIVALENCE_CLASSES = not Option::Solver::ENABLE_EQUIVALENCE_CLASSES;
+  EXPECT_TRUE(keys.insert(ResultCache::GetKey("fingerprint")).second);
+  Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = not Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS;
+  EXPECT_TRUE(keys.insert(ResultCache::GetKey("fingerprint")).second);
+  // budgets do not change results
+  Option::Solver::TIMEOUT = Option::Solver::TIMEOUT + 1000;
+  EXPECT_FALSE(keys.insert(ResultCache::GetKey("fingerprint")).second);
+}
+
+TEST_F(ResultCacheTest, SizeIsSetOnConfiguration) {
+  ResultCache::SetSize(2);
+  ResultCache::Put("a", true);
+  ResultCache::Put("b", true);
+  ResultCache::Put("c", false);
+  ResultCache::Entry entry;
+  EXPECT_FALSE(ResultCache::Get("a", entry));
+  EXPECT_TRUE(ResultCache::Get("b", entry));
+
+  // the size option of the inserting thread does not matter
+  std::thread([]() {
+    Option::Solver::RESULT_CACHE_SIZE = 1;
+    ResultCache::Put("d", true);
+  }).join();
+  EXPECT_TRUE(ResultCache::Get("d", entry));
+  EXPECT_TRUE(ResultCache::Get("b", entry));
+  EXPECT_FALSE(ResultCache::Get("c", entry));
+
+  ResultCache::SetSize(1);
+  EXPECT_TRUE(ResultCache::Get("b", entry));
+  EXPECT_FALSE(ResultCache::Get("d", entry));
+}
+
+TEST_F(ResultCacheTest, EvictedResultIsNotCountedAsSatisfiable) {
+  const std::string constraint = "(declare-fun x () String)\n(assert (in x /a+/))\n(assert (in x /b+/))\n";
+  Driver driver;
+  driver.set_option(Option::Name::RESULT_CACHE_SIZE, 8);
+  std::istringstream input(constraint);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+  EXPECT_FALSE(driver.is_sat());
+
+  // another driver evicts the result before the query is counted
+  ResultCache::Clear();
+  driver.GetModelCounter();
+
+  Driver other_driver;
+  other_driver.set_option(Option::Name::RESULT_CACHE_SIZE, 8);
+  std::istringstream other_input(constraint);
+  other_driver.Parse(&other_input);
+  other_driver.InitializeSolver();
+  other_driver.Solve();
+  EXPECT_FALSE(other_driver.is_sat());
+  EXPECT_EQ(0, other_driver.CountVariable("x", BOUND));
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
@@ -0,0 +1,47 @@
+/*
+ * ResultCacheTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_RESULTCACHETEST_H_
+#define SOLVER_RESULTCACHETEST_H_
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+#include "solver/ConstraintFingerprint.h"
+#include "solver/ResultCache.h"
+#include "solver/options/Options.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+class ResultCacheTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Runs the passes that come before the fingerprint
+   * @param constraint
+   * @return
+   */
+  std::string GetFingerprint(const std::string& constraint);
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_RESULTCACHETEST_H_ */
@@ -0,0 +1,100 @@
+/*
+ * SymbolTableTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "SymbolTableTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+void SymbolTableTest::SetUp() {
+  // scopes are only used as keys, any two visitables will do
+  script_ = new SMT::Script(new SMT::CommandList());
+  disjunct_ = new SMT::Script(new SMT::CommandList());
+  symbol_table_ = new SymbolTable();
+  symbol_table_->add_variable(new SMT::Variable("x", SMT::Variable::Type::INT));
+  symbol_table_->add_variable(new SMT::Variable("y", SMT::Variable::Type::INT));
+  symbol_table_->push_scope(script_);
+  Value one(1);
+  symbol_table_->set_value("x", &one);
+  symbol_table_->set_value("y", &one);
+}
+
+void SymbolTableTest::TearDown() {
+  delete symbol_table_;
+  delete disjunct_;
+  delete script_;
+}
+
+int SymbolTableTest::GetIntConstant(SymbolTable_ptr symbol_table, SMT::Visitable_ptr scope,
+                                    const std::string& var_name) {
+  auto value = symbol_table->get_value_at_scope(scope, symbol_table->get_variable(var_name));
+  return value == nullptr ? -1 : value->getIntConstant();
+}
+
+TEST_F(SymbolTableTest, ForkCopiesOnlyForkedValues) {
+  auto x = symbol_table_->get_variable("x");
+  auto forked_table = symbol_table_->fork({x});
+  EXPECT_EQ(x, forked_table->get_variable("x"));
+  EXPECT_EQ(1, GetIntConstant(forked_table, script_, "x"));
+  EXPECT_EQ(-1, GetIntConstant(forked_table, script_, "y"));
+
+  Value two(2);
+  forked_table->set_value(x, &two);
+  EXPECT_EQ(2, GetIntConstant(forked_table, script_, "x"));
+  EXPECT_EQ(1, GetIntConstant(symbol_table_, script_, "x"));
+  delete forked_table;
+  EXPECT_EQ(1, GetIntConstant(symbol_table_, script_, "x"));
+}
+
+TEST_F(SymbolTableTest, JoinReplacesForkedValues) {
+  auto forked_table = symbol_table_->fork({symbol_table_->get_variable("x")});
+  Value two(2);
+  forked_table->set_value("x", &two);
+  symbol_table_->join(forked_table);
+  delete forked_table;
+
+  EXPECT_EQ(2, GetIntConstant(symbol_table_, script_, "x"));
+  EXPECT_EQ(1, GetIntConstant(symbol_table_, script_, "y"));
+}
+
+TEST_F(SymbolTableTest, JoinMovesGeneratedVariables) {
+  auto forked_table = symbol_table_->fork({symbol_table_->get_variable("x")});
+  auto z = new SMT::Variable("z", SMT::Variable::Type::INT);
+  forked_table->add_variable(z);
+  Value three(3);
+  forked_table->set_value(z, &three);
+  symbol_table_->join(forked_table);
+  delete forked_table;
+
+  EXPECT_EQ(z, symbol_table_->get_variable("z"));
+  EXPECT_EQ(3, GetIntConstant(symbol_table_, script_, "z"));
+}
+
+TEST_F(SymbolTableTest, JoinAtScopeKeepsOtherScopes) {
+  auto forked_table = symbol_table_->fork({symbol_table_->get_variable("x")});
+  Value two(2), three(3);
+  forked_table->set_value("x", &two);
+  forked_table->push_scope(disjunct_);
+  forked_table->set_value("x", &three);
+  forked_table->pop_scope();
+  symbol_table_->join(forked_table, disjunct_);
+  delete forked_table;
+
+  EXPECT_EQ(1, GetIntConstant(symbol_table_, script_, "x"));
+  EXPECT_EQ(3, GetIntConstant(symbol_table_, disjunct_, "x"));
+  EXPECT_EQ(1, GetIntConstant(symbol_table_, script_, "y"));
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
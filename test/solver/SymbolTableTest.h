@@ -0,0 +1,44 @@
+/*
+ * SymbolTableTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_SYMBOLTABLETEST_H_
+#define SOLVER_SYMBOLTABLETEST_H_
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "smt/ast.h"
+#include "solver/SymbolTable.h"
+#include "solver/Value.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+/**
+ * Checks that a forked table works on its own copies of the forked values and that joining it
+ * replaces only those values
+ */
+class SymbolTableTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  int GetIntConstant(SymbolTable_ptr symbol_table, SMT::Visitable_ptr scope, const std::string& var_name);
+
+  SymbolTable_ptr symbol_table_;
+  SMT::Script_ptr script_;
+  SMT::Script_ptr disjunct_;
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_SYMBOLTABLETEST_H_ */
@@ -0,0 +1,60 @@
+/*
+ * ValuePropagationTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "ValuePropagationTest.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+using namespace ::testing;
+
+static const std::string DECLARATIONS = "(declare-fun x () String)\n(declare-fun y () String)\n";
+static const unsigned long BOUND = 5;
+
+Theory::BigInteger ValuePropagationTest::Count(const std::string& constraint, const std::string& var_name) {
+  Driver driver;
+  driver.set_option(Option::Name::USE_SINGLETRACK_AUTO);
+  driver.set_option(Option::Name::DISABLE_EQUIVALENCE_CLASSES);
+  driver.set_option(Option::Name::DISABLE_DEPENDENCY_ANALYSIS);
+  driver.set_option(Option::Name::DISABLE_SORTING_HEURISTICS);
+  std::istringstream input(DECLARATIONS + constraint);
+  driver.Parse(&input);
+  driver.InitializeSolver();
+  driver.Solve();
+  if (not driver.is_sat()) {
+    return -1;
+  }
+  return driver.CountVariable(var_name, BOUND);
+}
+
+TEST_F(ValuePropagationTest, RequeuedConjunct) {
+  // the concatenation is solved again once y is refined
+  EXPECT_EQ(2, Count("(assert (= x (concat y \"a\")))\n(assert (in y /b|c/))\n", "x"));
+  EXPECT_EQ(-1, Count("(assert (= x (concat y \"a\")))\n(assert (in y /b|c/))\n(assert (= x \"da\"))\n", "x"));
+}
+
+TEST_F(ValuePropagationTest, LetPath) {
+  EXPECT_EQ(2, Count("(assert (let ((w (concat y \"a\"))) (= x w)))\n(assert (in y /b|c/))\n", "x"));
+  EXPECT_EQ(2, Count("(assert (in y /b|c/))\n(assert (let ((w (concat y \"a\"))) (= x w)))\n", "x"));
+}
+
+TEST_F(ValuePropagationTest, UnchangedValue) {
+  // the last conjunct does not refine x, y keeps the value of the first one
+  const std::string constraint = "(assert (in y /b|c/))\n(assert (= x (concat y \"a\")))\n(assert (in x /[bc]a/))\n";
+  EXPECT_EQ(2, Count(constraint, "x"));
+  EXPECT_EQ(2, Count(constraint, "y"));
+  // refining x refines y through the concatenation
+  EXPECT_EQ(1, Count("(assert (in y /b|c/))\n(assert (= x (concat y \"a\")))\n(assert (in x /ba/))\n", "y"));
+}
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
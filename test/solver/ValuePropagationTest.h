@@ -0,0 +1,44 @@
+/*
+ * ValuePropagationTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef SOLVER_VALUEPROPAGATIONTEST_H_
+#define SOLVER_VALUEPROPAGATIONTEST_H_
+
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Driver.h"
+
+namespace Vlab {
+namespace Solver {
+namespace Test {
+
+/**
+ * Checks that refined values reach the conjuncts solved before the refinement, and that propagation stops
+ * at unchanged values without losing a refinement
+ */
+class ValuePropagationTest : public ::testing::Test {
+protected:
+  /**
+   * Solves the constraint with single track automata in the given order, so values are refined by propagation
+   * @param constraint
+   * @param var_name
+   * @return count of the variable, or -1 when the constraint is not satisfiable
+   */
+  Theory::BigInteger Count(const std::string& constraint, const std::string& var_name);
+};
+
+} /* namespace Test */
+} /* namespace Solver */
+} /* namespace Vlab */
+
+#endif /* SOLVER_VALUEPROPAGATIONTEST_H_ */
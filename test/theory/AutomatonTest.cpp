@@ -0,0 +1,320 @@
+/*
+ * AutomatonTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "AutomatonTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class PublicAutomaton : public Automaton {
+ public:
+  using Automaton::DFAProjectAway;
+  using Automaton::DFAProjectAwayAll;
+  using Automaton::DFAProjectTo;
+  using Automaton::DFAIsEqual;
+  using Automaton::DFAMinimize;
+  using Automaton::DFAMinimizeNative;
+  using Automaton::DFAProduct;
+  using Automaton::DFAExportBinary;
+  using Automaton::DFAImportBinary;
+};
+
+using namespace ::testing;
+
+DFA_ptr AutomatonTest::ProjectAwayOneByOne(const DFA_ptr dfa, const std::vector<int>& indices) {
+  DFA_ptr result_dfa = PublicAutomaton::DFAProjectAway(dfa, indices[0]);
+  for (std::size_t i = 1; i < indices.size(); ++i) {
+    DFA_ptr projected_dfa = PublicAutomaton::DFAProjectAway(result_dfa, indices[i]);
+    dfaFree(result_dfa);
+    result_dfa = projected_dfa;
+  }
+  return result_dfa;
+}
+
+void AutomatonTest::ExpectSameAsOneByOne(const DFA_ptr dfa, const int number_of_bdd_variables,
+                                         const std::vector<int>& indices) {
+  DFA_ptr expected_dfa = ProjectAwayOneByOne(dfa, indices);
+  DFA_ptr result_dfa = PublicAutomaton::DFAProjectAwayAll(dfa, number_of_bdd_variables, indices);
+  EXPECT_TRUE(PublicAutomaton::DFAIsEqual(expected_dfa, result_dfa)) << "projecting " << PrintToString(indices);
+  // both are minimized
+  EXPECT_EQ(expected_dfa->ns, result_dfa->ns) << "projecting " << PrintToString(indices);
+  dfaFree(result_dfa);
+  dfaFree(expected_dfa);
+}
+
+std::vector<int> AutomatonTest::GetTrackIndices(const std::vector<int>& tracks, const int number_of_tracks,
+                                                const int number_of_bdd_variables) {
+  // bdd variables of the tracks are interleaved
+  std::vector<int> indices;
+  for (int track : tracks) {
+    for (int i = track; i < number_of_bdd_variables; i += number_of_tracks) {
+      indices.push_back(i);
+    }
+  }
+  return indices;
+}
+
+void AutomatonTest::ExpectSameAsMonaMinimization(const DFA_ptr dfa) {
+  DFA_ptr expected_dfa = dfaMinimize(dfa);
+  DFA_ptr result_dfa = PublicAutomaton::DFAMinimizeNative(dfa);
+  EXPECT_TRUE(PublicAutomaton::DFAIsEqual(expected_dfa, result_dfa));
+  EXPECT_EQ(expected_dfa->ns, result_dfa->ns);
+  dfaFree(result_dfa);
+  dfaFree(expected_dfa);
+}
+
+void AutomatonTest::ExpectBinaryRoundTrip(const DFA_ptr dfa, const int number_of_bdd_variables) {
+  std::stringstream out;
+  PublicAutomaton::DFAExportBinary(dfa, number_of_bdd_variables, out);
+  const std::string data = out.str();
+  DFA_ptr imported_dfa = PublicAutomaton::DFAImportBinary(data.data(), data.size(), number_of_bdd_variables);
+  ASSERT_NE(nullptr, imported_dfa);
+  EXPECT_TRUE(PublicAutomaton::DFAIsEqual(dfa, imported_dfa));
+  dfaFree(imported_dfa);
+
+  // a truncated entry is rejected instead of read past its end
+  EXPECT_EQ(nullptr, PublicAutomaton::DFAImportBinary(data.data(), data.size() / 2, number_of_bdd_variables));
+}
+
+std::vector<std::string> AutomatonTest::GetWords(const std::string& alphabet, const int max_length) {
+  std::vector<std::string> words {""};
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    if (words[i].size() < (std::size_t)max_length) {
+      for (char c : alphabet) {
+        words.push_back(words[i] + c);
+      }
+    }
+  }
+  return words;
+}
+
+StringAutomaton_ptr AutomatonTest::MakeAnyOf(const std::vector<std::string>& words) {
+  StringAutomaton_ptr result_auto = StringAutomaton::MakePhi();
+  for (auto& word : words) {
+    auto word_auto = StringAutomaton::MakeString(word);
+    auto union_auto = result_auto->Union(word_auto);
+    delete word_auto;
+    delete result_auto;
+    result_auto = union_auto;
+  }
+  return result_auto;
+}
+
+void AutomatonTest::ExpectConcatMatches(const std::string& left_regex, const std::string& right_regex) {
+  const std::vector<std::string> words = GetWords("abc", 5);
+  const std::regex concat_regex ("(?:" + left_regex + ")(?:" + right_regex + ")");
+  std::vector<std::string> expected_words;
+  for (auto& word : words) {
+    if (std::regex_match(word, concat_regex)) {
+      expected_words.push_back(word);
+    }
+  }
+
+  auto left_auto = StringAutomaton::MakeRegexAuto(left_regex);
+  auto right_auto = StringAutomaton::MakeRegexAuto(right_regex);
+  auto concat_auto = left_auto->Concat(right_auto);
+  auto words_auto = MakeAnyOf(words);
+  auto result_auto = concat_auto->Intersect(words_auto);
+  auto expected_auto = MakeAnyOf(expected_words);
+  EXPECT_TRUE(result_auto->IsEqual(expected_auto)) << left_regex << " . " << right_regex;
+  delete expected_auto;
+  delete result_auto;
+  delete words_auto;
+  delete concat_auto;
+  delete right_auto;
+  delete left_auto;
+}
+
+StringAutomaton_ptr AutomatonTest::MakeStringRelation(const StringFormula::Type type) {
+  // relation of x and y on three tracks, z is unconstrained
+  auto formula = new StringFormula();
+  formula->AddVariable("x", 1);
+  formula->AddVariable("y", 2);
+  formula->AddVariable("z", 0);
+  formula->SetType(type);
+  return StringAutomaton::MakeAutomaton(formula);
+}
+
+BinaryIntAutomaton_ptr AutomatonTest::MakeIntRelation(const ArithmeticFormula::Type type) {
+  // x - 3y + 2z + 1 (type) 0
+  auto formula = new ArithmeticFormula();
+  formula->AddVariable("x", 1);
+  formula->AddVariable("y", -3);
+  formula->AddVariable("z", 2);
+  formula->SetConstant(1);
+  formula->SetType(type);
+  return BinaryIntAutomaton::MakeAutomaton(formula, false);
+}
+
+TEST_F(AutomatonTest, ProjectAwayAllOfMultiTrack) {
+  const int number_of_tracks = 3;
+  for (auto type : {StringFormula::Type::EQ, StringFormula::Type::LT}) {
+    auto relation_auto = MakeStringRelation(type);
+    const int number_of_bdd_variables = relation_auto->get_number_of_bdd_variables();
+    for (auto tracks : std::vector<std::vector<int>> { {0}, {1}, {2}, {0, 2}, {1, 2} }) {
+      ExpectSameAsOneByOne(relation_auto->getDFA(), number_of_bdd_variables,
+                           GetTrackIndices(tracks, number_of_tracks, number_of_bdd_variables));
+    }
+    delete relation_auto;
+  }
+}
+
+TEST_F(AutomatonTest, ProjectAwayAllOfBinaryInt) {
+  for (auto type : {ArithmeticFormula::Type::EQ, ArithmeticFormula::Type::LT}) {
+    auto relation_auto = MakeIntRelation(type);
+    const int number_of_bdd_variables = relation_auto->get_number_of_bdd_variables();
+    for (auto indices : std::vector<std::vector<int>> { {0}, {1}, {2}, {0, 1}, {2, 0} }) {
+      ExpectSameAsOneByOne(relation_auto->getDFA(), number_of_bdd_variables, indices);
+    }
+    delete relation_auto;
+  }
+}
+
+TEST_F(AutomatonTest, ProjectToRemapsKeptVariable) {
+  auto relation_auto = MakeIntRelation(ArithmeticFormula::Type::EQ);
+  DFA_ptr expected_dfa = ProjectAwayOneByOne(relation_auto->getDFA(), {0, 1});
+  int indices_map[] = {1, 2, 0};
+  dfaReplaceIndices(expected_dfa, indices_map);
+  DFA_ptr result_dfa = PublicAutomaton::DFAProjectTo(relation_auto->getDFA(), 3, 2);
+  EXPECT_TRUE(PublicAutomaton::DFAIsEqual(expected_dfa, result_dfa));
+  dfaFree(result_dfa);
+  dfaFree(expected_dfa);
+  delete relation_auto;
+}
+
+TEST_F(AutomatonTest, NativeMinimizationOfProducts) {
+  // products are not minimized
+  const std::vector<std::pair<std::string, std::string>> regexes = {
+      {"(ab)*", "a*b*"}, {"[a-c]*c", "a(b|c)*"}, {".*abc.*", ".*cab.*"}
+  };
+  for (auto& regex_pair : regexes) {
+    auto left_auto = StringAutomaton::MakeRegexAuto(regex_pair.first);
+    auto right_auto = StringAutomaton::MakeRegexAuto(regex_pair.second);
+    for (auto product_type : {dfaAND, dfaOR, dfaIMPL}) {
+      DFA_ptr product_dfa = PublicAutomaton::DFAProduct(left_auto->getDFA(), right_auto->getDFA(), product_type);
+      ExpectSameAsMonaMinimization(product_dfa);
+      dfaFree(product_dfa);
+    }
+    delete right_auto;
+    delete left_auto;
+  }
+}
+
+TEST_F(AutomatonTest, NativeMinimizationOfRelations) {
+  auto equal_auto = MakeStringRelation(StringFormula::Type::EQ);
+  auto less_auto = MakeStringRelation(StringFormula::Type::LT);
+  DFA_ptr product_dfa = PublicAutomaton::DFAProduct(equal_auto->getDFA(), less_auto->getDFA(), dfaOR);
+  ExpectSameAsMonaMinimization(product_dfa);
+  dfaFree(product_dfa);
+  delete less_auto;
+  delete equal_auto;
+
+  auto int_equal_auto = MakeIntRelation(ArithmeticFormula::Type::EQ);
+  auto int_less_auto = MakeIntRelation(ArithmeticFormula::Type::LT);
+  product_dfa = PublicAutomaton::DFAProduct(int_equal_auto->getDFA(), int_less_auto->getDFA(), dfaOR);
+  ExpectSameAsMonaMinimization(product_dfa);
+  dfaFree(product_dfa);
+  delete int_less_auto;
+  delete int_equal_auto;
+}
+
+TEST_F(AutomatonTest, DeferredMinimizationEndsMinimized) {
+  // getting a track trims lambda prefix and suffix, both are chains of projections
+  const bool defer_minimization = Option::Theory::DEFER_MINIMIZATION;
+  Option::Theory::DEFER_MINIMIZATION = false;
+  auto relation_auto = MakeStringRelation(StringFormula::Type::LT);
+  auto expected_auto = relation_auto->GetAutomatonForVariable("y");
+
+  Option::Theory::DEFER_MINIMIZATION = true;
+  auto result_auto = relation_auto->GetAutomatonForVariable("y");
+  Option::Theory::DEFER_MINIMIZATION = defer_minimization;
+
+  EXPECT_TRUE(PublicAutomaton::DFAIsEqual(expected_auto->getDFA(), result_auto->getDFA()));
+  EXPECT_EQ(expected_auto->getDFA()->ns, result_auto->getDFA()->ns);
+  DFA_ptr minimized_dfa = PublicAutomaton::DFAMinimize(result_auto->getDFA());
+  EXPECT_EQ(minimized_dfa->ns, result_auto->getDFA()->ns);
+  dfaFree(minimized_dfa);
+  delete result_auto;
+  delete expected_auto;
+  delete relation_auto;
+}
+
+TEST_F(AutomatonTest, BinaryFormatRoundTrip) {
+  auto regex_auto = StringAutomaton::MakeRegexAuto("[a-z]+@(abc|def){1,3}");
+  ExpectBinaryRoundTrip(regex_auto->getDFA(), regex_auto->get_number_of_bdd_variables());
+  delete regex_auto;
+
+  auto relation_auto = MakeStringRelation(StringFormula::Type::LT);
+  ExpectBinaryRoundTrip(relation_auto->getDFA(), relation_auto->get_number_of_bdd_variables());
+  delete relation_auto;
+
+  auto int_relation_auto = MakeIntRelation(ArithmeticFormula::Type::EQ);
+  ExpectBinaryRoundTrip(int_relation_auto->getDFA(), int_relation_auto->get_number_of_bdd_variables());
+  delete int_relation_auto;
+}
+
+TEST_F(AutomatonTest, ConcatAcceptsConcatenatedWords) {
+  ExpectConcatMatches("a|bc", "c?|ab");
+  ExpectConcatMatches("(ab)*", "c+");
+  ExpectConcatMatches("a*b", "b*a");
+  ExpectConcatMatches("[a-c]{2,3}", "a|");
+  ExpectConcatMatches("", "(ab|c)*");
+  ExpectConcatMatches("(a|b)*c", "");
+}
+
+TEST_F(AutomatonTest, TrackKeepsLanguageOfSingleTrack) {
+  for (auto regex : {"(ab)*c+", "a|bcd", "[a-c]{2,3}", "(a|b)*c(a|b)*"}) {
+    auto single_track_auto = StringAutomaton::MakeRegexAuto(regex);
+    for (int number_of_tracks : {2, 3}) {
+      for (int track = 0; track < number_of_tracks; ++track) {
+        auto multi_track_auto = new StringAutomaton(single_track_auto->getDFA(), track, number_of_tracks,
+                                                    single_track_auto->get_number_of_bdd_variables());
+        auto track_auto = multi_track_auto->GetKTrack(track);
+        EXPECT_TRUE(track_auto->IsEqual(single_track_auto)) << regex << " on track " << track << " of "
+                                                            << number_of_tracks;
+        delete track_auto;
+        delete multi_track_auto;
+      }
+    }
+    delete single_track_auto;
+  }
+}
+
+TEST_F(AutomatonTest, ConcatOfRelationTrack) {
+  // y = x . "ab" keeps x on its own track
+  auto formula = new StringFormula();
+  formula->AddVariable("x", 1);
+  formula->AddVariable("y", 2);
+  formula->SetType(StringFormula::Type::EQ);
+  auto equality_auto = StringAutomaton::MakeAutomaton(formula);
+  auto x_auto = StringAutomaton::MakeRegexAuto("(a|c)*");
+  auto x_on_track_auto = new StringAutomaton(x_auto->getDFA(), equality_auto->GetFormula()->GetVariableIndex("x"),
+                                             2, x_auto->get_number_of_bdd_variables());
+  x_on_track_auto->SetFormula(equality_auto->GetFormula()->clone());
+  auto relation_auto = equality_auto->Intersect(x_on_track_auto);
+  auto y_auto = relation_auto->GetAutomatonForVariable("y");
+  auto suffix_auto = StringAutomaton::MakeString("ab");
+  auto result_auto = y_auto->Concat(suffix_auto);
+  auto expected_auto = StringAutomaton::MakeRegexAuto("(a|c)*ab");
+  EXPECT_TRUE(result_auto->IsEqual(expected_auto));
+  delete expected_auto;
+  delete result_auto;
+  delete suffix_auto;
+  delete y_auto;
+  delete relation_auto;
+  delete x_on_track_auto;
+  delete x_auto;
+  delete equality_auto;
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,88 @@
+/*
+ * AutomatonTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_AUTOMATONTEST_H_
+#define THEORY_AUTOMATONTEST_H_
+
+#include <regex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/ArithmeticFormula.h"
+#include "theory/Automaton.h"
+#include "theory/BinaryIntAutomaton.h"
+#include "theory/StringAutomaton.h"
+#include "theory/StringFormula.h"
+#include "theory/options/Theory.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+/**
+ * Compares the single pass projection and the native minimizer with the MONA operations they replace,
+ * checks that dfas survive the binary format of the regex cache and that the concat and track
+ * builders accept the expected languages
+ */
+class AutomatonTest : public ::testing::Test {
+protected:
+  /**
+   * Projects the bdd variables away one at a time
+   */
+  static DFA_ptr ProjectAwayOneByOne(const DFA_ptr dfa, const std::vector<int>& indices);
+
+  /**
+   * Expects DFAProjectAwayAll to accept the same language as projecting the indices away one at a time
+   */
+  static void ExpectSameAsOneByOne(const DFA_ptr dfa, const int number_of_bdd_variables,
+                                   const std::vector<int>& indices);
+
+  /**
+   * Bdd variables of the given tracks of a multi-track string automaton
+   */
+  static std::vector<int> GetTrackIndices(const std::vector<int>& tracks, const int number_of_tracks,
+                                          const int number_of_bdd_variables);
+
+  /**
+   * Expects the native minimizer to build the same minimal dfa as MONA
+   */
+  static void ExpectSameAsMonaMinimization(const DFA_ptr dfa);
+
+  /**
+   * Expects the dfa read back from its binary format to accept the same language
+   */
+  static void ExpectBinaryRoundTrip(const DFA_ptr dfa, const int number_of_bdd_variables);
+
+  /**
+   * All words over the alphabet up to the given length
+   */
+  static std::vector<std::string> GetWords(const std::string& alphabet, const int max_length);
+
+  static StringAutomaton_ptr MakeAnyOf(const std::vector<std::string>& words);
+
+  /**
+   * Expects the concatenation of the regexes to accept exactly the words std::regex matches
+   * among all words over 'abc' up to length 5
+   */
+  static void ExpectConcatMatches(const std::string& left_regex, const std::string& right_regex);
+
+  static StringAutomaton_ptr MakeStringRelation(const StringFormula::Type type);
+  static BinaryIntAutomaton_ptr MakeIntRelation(const ArithmeticFormula::Type type);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_AUTOMATONTEST_H_ */
@@ -18,10 +18,8 @@ class PublicBinaryIntAutomaton : public BinaryIntAutomaton {
  public:
   using BinaryIntAutomaton::BinaryIntAutomaton;
   using BinaryIntAutomaton::type_;
-  using BinaryIntAutomaton::is_count_matrix_cached_;
   using BinaryIntAutomaton::dfa_;
   using BinaryIntAutomaton::num_of_bdd_variables_;
-  using BinaryIntAutomaton::count_matrix_;
   using BinaryIntAutomaton::is_natural_number_;
   using BinaryIntAutomaton::formula_;
 
@@ -36,6 +34,79 @@ void BinaryIntAutomatonTest::SetUp() {
 void BinaryIntAutomatonTest::TearDown() {
 }
 
+BinaryIntAutomaton_ptr BinaryIntAutomatonTest::MakeAutomaton(const std::map<std::string, int>& coefficients,
+                                                             const int constant, const ArithmeticFormula::Type type,
+                                                             const bool is_natural_number) {
+  auto formula = new ArithmeticFormula();
+  for (auto& entry : coefficients) {
+    formula->AddVariable(entry.first, entry.second);
+  }
+  formula->SetConstant(constant);
+  formula->SetType(type);
+  return BinaryIntAutomaton::MakeAutomaton(formula, is_natural_number);
+}
+
+void BinaryIntAutomatonTest::ExpectMembers(SemilinearSet_ptr semilinear_set, std::function<bool(int)> is_member) {
+  for (int n = 0; n < 200; ++n) {
+    EXPECT_EQ(is_member(n), semilinear_set->has_value(n)) << n << " in " << *semilinear_set;
+  }
+}
+
+bool BinaryIntAutomatonTest::IsAccepted(BinaryIntAutomaton_ptr automaton, const std::vector<int>& values,
+                                        const int number_of_bits) {
+  DFA_ptr dfa = automaton->getDFA();
+  int state = dfa->s;
+  for (int bit = 0; bit < number_of_bits; ++bit) {
+    unsigned p = dfa->q[state], l, r, index;
+    LOAD_lri(&dfa->bddm->node_table[p], l, r, index);
+    while (index != BDD_LEAF_INDEX) {
+      p = ((values[index] >> bit) & 1) ? r : l;
+      LOAD_lri(&dfa->bddm->node_table[p], l, r, index);
+    }
+    state = l;
+  }
+  return dfa->f[state] == 1;
+}
+
+void BinaryIntAutomatonTest::ExpectSolutions(const std::vector<int>& coefficients, const int constant,
+                                             const ArithmeticFormula::Type type, const bool is_natural_number) {
+  auto relation_auto = MakeAutomaton({{"x", coefficients[0]}, {"y", coefficients[1]}}, constant, type,
+                                     is_natural_number);
+  // five bits hold the values, signed values are sign extended into the last bit
+  const int min = is_natural_number ? 0 : -8, max = is_natural_number ? 15 : 7;
+  for (int x = min; x <= max; ++x) {
+    for (int y = min; y <= max; ++y) {
+      const int sum = coefficients[0] * x + coefficients[1] * y + constant;
+      bool is_solution = false;
+      switch (type) {
+        case ArithmeticFormula::Type::EQ:
+          is_solution = (sum == 0);
+          break;
+        case ArithmeticFormula::Type::NOTEQ:
+          is_solution = (sum != 0);
+          break;
+        case ArithmeticFormula::Type::LT:
+          is_solution = (sum < 0);
+          break;
+        case ArithmeticFormula::Type::LE:
+          is_solution = (sum <= 0);
+          break;
+        case ArithmeticFormula::Type::GT:
+          is_solution = (sum > 0);
+          break;
+        case ArithmeticFormula::Type::GE:
+          is_solution = (sum >= 0);
+          break;
+        default:
+          FAIL() << "not a relation";
+      }
+      EXPECT_EQ(is_solution, IsAccepted(relation_auto, {x, y}, 5))
+          << coefficients[0] << "x + " << coefficients[1] << "y + " << constant << ", x = " << x << ", y = " << y;
+    }
+  }
+  delete relation_auto;
+}
+
 TEST_F(BinaryIntAutomatonTest, ConstructorWith1Args) {
   PublicBinaryIntAutomaton b_int_auto (false);
   EXPECT_EQ(Automaton::Type::BINARYINT, b_int_auto.type_);
@@ -54,11 +125,11 @@ TEST_F(BinaryIntAutomatonTest, ConstructorWith3Args) {
   EXPECT_EQ(5, b_int_auto_0.num_of_bdd_variables_);
 
   auto formula = new ArithmeticFormula();
-  formula->set_type(ArithmeticFormula::Type::EQ);
-  formula->set_constant(7);
-  formula->add_variable("x", 1);
-  formula->add_variable("y", 2);
-  formula->add_variable("z", 3);
+  formula->SetType(ArithmeticFormula::Type::EQ);
+  formula->SetConstant(7);
+  formula->AddVariable("x", 1);
+  formula->AddVariable("y", 2);
+  formula->AddVariable("z", 3);
   PublicBinaryIntAutomaton b_int_auto_1(nullptr, formula, true);
   EXPECT_EQ(Automaton::Type::BINARYINT, b_int_auto_1.type_);
   EXPECT_EQ(formula, b_int_auto_1.formula_);
@@ -70,16 +141,16 @@ TEST_F(BinaryIntAutomatonTest, ConstructorWith3Args) {
 
 TEST_F(BinaryIntAutomatonTest, CopyConstructor) {
   auto formula = new ArithmeticFormula();
-  formula->set_type(ArithmeticFormula::Type::EQ);
-  formula->set_constant(7);
-  formula->add_variable("x", 1);
-  formula->add_variable("y", 2);
-  formula->add_variable("z", 3);
+  formula->SetType(ArithmeticFormula::Type::EQ);
+  formula->SetConstant(7);
+  formula->AddVariable("x", 1);
+  formula->AddVariable("y", 2);
+  formula->AddVariable("z", 3);
 
   PublicBinaryIntAutomaton b_int_auto_0(nullptr, formula, true);
   PublicBinaryIntAutomaton b_int_auto_1(b_int_auto_0);
   EXPECT_EQ(Automaton::Type::BINARYINT, b_int_auto_1.type_);
-  EXPECT_THAT(b_int_auto_1.formula_->get_variable_coefficient_map(), ElementsAre(Pair("x", 1), Pair("y", 2), Pair("z", 3)));
+  EXPECT_THAT(b_int_auto_1.formula_->GetVariableCoefficientMap(), ElementsAre(Pair("x", 1), Pair("y", 2), Pair("z", 3)));
   EXPECT_EQ(nullptr, b_int_auto_1.dfa_);
   EXPECT_EQ(true, b_int_auto_1.is_natural_number_);
   EXPECT_EQ(3, b_int_auto_1.num_of_bdd_variables_);
@@ -87,11 +158,11 @@ TEST_F(BinaryIntAutomatonTest, CopyConstructor) {
 
 TEST_F(BinaryIntAutomatonTest, MakePhi) {
   auto formula = new ArithmeticFormula();
-  formula->set_type(ArithmeticFormula::Type::EQ);
-  formula->set_constant(7);
-  formula->add_variable("x", 1);
-  formula->add_variable("y", 2);
-  formula->add_variable("z", 3);
+  formula->SetType(ArithmeticFormula::Type::EQ);
+  formula->SetConstant(7);
+  formula->AddVariable("x", 1);
+  formula->AddVariable("y", 2);
+  formula->AddVariable("z", 3);
 
   auto result = BinaryIntAutomaton::MakePhi(formula, false);
   PublicBinaryIntAutomaton* presult = static_cast<PublicBinaryIntAutomaton*>(result);
@@ -102,6 +173,124 @@ TEST_F(BinaryIntAutomatonTest, MakePhi) {
   // TODO add an automaton check wrt a expectation
 }
 
+TEST_F(BinaryIntAutomatonTest, SymbolicRelationsAcceptTheirSolutions) {
+  // the carry automata are built over column sums, check them against the enumerated solutions
+  const std::vector<std::vector<int>> coefficient_sets = { {1, -1}, {2, 3}, {-3, -2}, {1, 0}, {-1, 4} };
+  const std::vector<ArithmeticFormula::Type> types = {
+      ArithmeticFormula::Type::EQ, ArithmeticFormula::Type::NOTEQ, ArithmeticFormula::Type::LT,
+      ArithmeticFormula::Type::LE, ArithmeticFormula::Type::GT, ArithmeticFormula::Type::GE
+  };
+  for (auto& coefficients : coefficient_sets) {
+    for (int constant : {0, 3, -5}) {
+      for (auto type : types) {
+        ExpectSolutions(coefficients, constant, type, false);
+        ExpectSolutions(coefficients, constant, type, true);
+      }
+    }
+  }
+}
+
+TEST_F(BinaryIntAutomatonTest, GetSemilinearSetOfLargeConstants) {
+  // constants beyond 15 bits used to be cut off
+  auto large_auto = MakeAutomaton({{"x", 1}}, -100000, ArithmeticFormula::Type::EQ, true);
+  auto other_auto = MakeAutomaton({{"x", 1}}, -40000, ArithmeticFormula::Type::EQ, true);
+  auto union_auto = large_auto->Union(other_auto);
+  auto semilinear_set = union_auto->GetSemilinearSet();
+  EXPECT_THAT(semilinear_set->get_constants(), ElementsAre(40000, 100000));
+  EXPECT_THAT(semilinear_set->get_periodic_constants(), IsEmpty());
+  EXPECT_TRUE(semilinear_set->has_value(100000));
+  EXPECT_FALSE(semilinear_set->has_value(100001));
+  delete semilinear_set;
+  delete union_auto;
+  delete other_auto;
+  delete large_auto;
+}
+
+TEST_F(BinaryIntAutomatonTest, GetSemilinearSetOfPeriodicValues) {
+  // x = 3y + 1
+  auto relation_auto = MakeAutomaton({{"x", 1}, {"y", -3}}, -1, ArithmeticFormula::Type::EQ, true);
+  auto x_auto = relation_auto->GetBinaryAutomatonFor("x");
+  auto semilinear_set = x_auto->GetSemilinearSet();
+  EXPECT_EQ(3, semilinear_set->get_period());
+  EXPECT_THAT(semilinear_set->get_constants(), IsEmpty());
+  ExpectMembers(semilinear_set, [](int n) { return n % 3 == 1; });
+  delete semilinear_set;
+  delete x_auto;
+  delete relation_auto;
+}
+
+TEST_F(BinaryIntAutomatonTest, GetSemilinearSetWithHeadAndPeriod) {
+  // {2} and x = 3y + 1 for x >= 5
+  auto relation_auto = MakeAutomaton({{"x", 1}, {"y", -3}}, -1, ArithmeticFormula::Type::EQ, true);
+  auto periodic_auto = relation_auto->GetBinaryAutomatonFor("x");
+  auto lower_bound_auto = MakeAutomaton({{"x", 1}}, -5, ArithmeticFormula::Type::GE, true);
+  auto bounded_auto = periodic_auto->Intersect(lower_bound_auto);
+  auto two_auto = MakeAutomaton({{"x", 1}}, -2, ArithmeticFormula::Type::EQ, true);
+  auto union_auto = bounded_auto->Union(two_auto);
+  auto semilinear_set = union_auto->GetSemilinearSet();
+  EXPECT_EQ(3, semilinear_set->get_period());
+  EXPECT_THAT(semilinear_set->get_constants(), ElementsAre(2));
+  ExpectMembers(semilinear_set, [](int n) { return n == 2 or (n >= 5 and n % 3 == 1); });
+  delete semilinear_set;
+  delete union_auto;
+  delete two_auto;
+  delete bounded_auto;
+  delete lower_bound_auto;
+  delete periodic_auto;
+  delete relation_auto;
+}
+
+TEST_F(BinaryIntAutomatonTest, GetSemilinearSetOfPositiveValues) {
+  // -3 <= x <= 4, negative values are removed before the extraction as the solver does
+  auto lower_bound_auto = MakeAutomaton({{"x", 1}}, 3, ArithmeticFormula::Type::GE, false);
+  auto upper_bound_auto = MakeAutomaton({{"x", 1}}, -4, ArithmeticFormula::Type::LE, false);
+  auto range_auto = lower_bound_auto->Intersect(upper_bound_auto);
+  auto positives_auto = range_auto->GetPositiveValuesFor("x");
+  auto semilinear_set = positives_auto->GetSemilinearSet();
+  EXPECT_THAT(semilinear_set->get_constants(), ElementsAre(0, 1, 2, 3, 4));
+  ExpectMembers(semilinear_set, [](int n) { return n <= 4; });
+  delete semilinear_set;
+  delete positives_auto;
+  delete range_auto;
+  delete upper_bound_auto;
+  delete lower_bound_auto;
+
+  // x < -1 has no positive values
+  auto negative_auto = MakeAutomaton({{"x", 1}}, 1, ArithmeticFormula::Type::LT, false);
+  positives_auto = negative_auto->GetPositiveValuesFor("x");
+  semilinear_set = positives_auto->GetSemilinearSet();
+  EXPECT_TRUE(semilinear_set->is_empty_set());
+  delete semilinear_set;
+  delete positives_auto;
+  delete negative_auto;
+}
+
+TEST_F(BinaryIntAutomatonTest, GetSemilinearSetOfEmptyAutomaton) {
+  auto formula = new ArithmeticFormula();
+  formula->AddVariable("x", 1);
+  auto phi_auto = BinaryIntAutomaton::MakePhi(formula, true);
+  auto semilinear_set = phi_auto->GetSemilinearSet();
+  EXPECT_TRUE(semilinear_set->is_empty_set());
+  delete semilinear_set;
+  delete phi_auto;
+}
+
+TEST_F(BinaryIntAutomatonTest, GetSemilinearSetOverApproximatesLargePeriods) {
+  // x = 2^32 * z has a period beyond int values
+  auto x_relation_auto = MakeAutomaton({{"x", 1}, {"y", -65536}, {"z", 0}}, 0, ArithmeticFormula::Type::EQ, true);
+  auto y_relation_auto = MakeAutomaton({{"x", 0}, {"y", 1}, {"z", -65536}}, 0, ArithmeticFormula::Type::EQ, true);
+  auto relation_auto = x_relation_auto->Intersect(y_relation_auto);
+  auto x_auto = relation_auto->GetBinaryAutomatonFor("x");
+  auto semilinear_set = x_auto->GetSemilinearSet();
+  EXPECT_EQ(1, semilinear_set->get_period());
+  ExpectMembers(semilinear_set, [](int n) { return true; });
+  delete semilinear_set;
+  delete x_auto;
+  delete relation_auto;
+  delete y_relation_auto;
+  delete x_relation_auto;
+}
+
 //TEST_F(BinaryIntAutomatonTest, Complement) {
 //  std::stringstream ss;
 //    std::string expected;
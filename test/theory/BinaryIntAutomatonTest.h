@@ -12,11 +12,18 @@
 #define THEORY_BINARYINTAUTOMATONTEST_H_
 
 
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "helper/FileHelper.h"
 //#include "theory/mock/MockBinaryIntAutomaton.h"
+#include "theory/ArithmeticFormula.h"
 #include "theory/BinaryIntAutomaton.h"
+#include "theory/SemilinearSet.h"
 
 namespace Vlab {
 namespace Theory {
@@ -27,6 +34,29 @@ protected:
   virtual void SetUp();
   virtual void TearDown();
 
+  /**
+   * Makes the automaton of sum(coefficient * variable) + constant (type) 0
+   */
+  static BinaryIntAutomaton_ptr MakeAutomaton(const std::map<std::string, int>& coefficients, const int constant,
+                                              const ArithmeticFormula::Type type, const bool is_natural_number);
+
+  /**
+   * Expects membership of the first values to agree with is_member
+   */
+  static void ExpectMembers(SemilinearSet_ptr semilinear_set, std::function<bool(int)> is_member);
+
+  /**
+   * Reads the values of the variables with the given number of bits, least significant bit first
+   * @return true if the automaton accepts the word
+   */
+  static bool IsAccepted(BinaryIntAutomaton_ptr automaton, const std::vector<int>& values, const int number_of_bits);
+
+  /**
+   * Expects the automaton of coefficients[0] * x + coefficients[1] * y + constant (type) 0 to accept exactly the
+   * pairs of small values that satisfy it
+   */
+  static void ExpectSolutions(const std::vector<int>& coefficients, const int constant,
+                              const ArithmeticFormula::Type type, const bool is_natural_number);
 };
 
 } /* namespace Test */
@@ -0,0 +1,107 @@
+/*
+ * FixedWidthIntegerTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "FixedWidthIntegerTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void FixedWidthIntegerTest::SetUp() {
+  int_bit_width_ = Option::Theory::INT_BIT_WIDTH;
+  // signed values are in [-8, 7], natural numbers in [0, 15]
+  Option::Theory::INT_BIT_WIDTH = 4;
+}
+
+void FixedWidthIntegerTest::TearDown() {
+  Option::Theory::INT_BIT_WIDTH = int_bit_width_;
+}
+
+std::unique_ptr<BinaryIntAutomaton> FixedWidthIntegerTest::MakeRelation(const ArithmeticFormula::Type type,
+                                                                        const int constant,
+                                                                        const bool is_natural_number) {
+  auto formula = new ArithmeticFormula();
+  formula->SetType(type);
+  formula->SetConstant(constant);
+  formula->AddVariable("x", 1);
+  return std::unique_ptr<BinaryIntAutomaton>(BinaryIntAutomaton::MakeAutomaton(formula, is_natural_number));
+}
+
+TEST_F(FixedWidthIntegerTest, SignedEqualityWrapsAround) {
+  auto seven = MakeRelation(ArithmeticFormula::Type::EQ, -7, false);
+  // x + 1 = -8 overflows to x = 7
+  auto wrapped = MakeRelation(ArithmeticFormula::Type::EQ, 9, false);
+  EXPECT_TRUE(seven->IsEqual(wrapped.get()));
+
+  auto not_seven = MakeRelation(ArithmeticFormula::Type::NOTEQ, 9, false);
+  std::unique_ptr<BinaryIntAutomaton> nothing(seven->Intersect(not_seven.get()));
+  EXPECT_TRUE(nothing->IsEmptyLanguage());
+}
+
+TEST_F(FixedWidthIntegerTest, SignedInequalityIsExactAtBoundary) {
+  auto seven = MakeRelation(ArithmeticFormula::Type::EQ, -7, false);
+  auto at_most_seven = MakeRelation(ArithmeticFormula::Type::LE, -7, false);
+  auto at_least_seven = MakeRelation(ArithmeticFormula::Type::GE, -7, false);
+  std::unique_ptr<BinaryIntAutomaton> exactly_seven(at_most_seven->Intersect(at_least_seven.get()));
+  EXPECT_TRUE(seven->IsEqual(exactly_seven.get()));
+
+  // x > 7 has no solution, it does not wrap to negative values
+  EXPECT_TRUE(MakeRelation(ArithmeticFormula::Type::GT, -7, false)->IsEmptyLanguage());
+  // x < 8 holds for every value
+  auto any_int = std::unique_ptr<BinaryIntAutomaton>(BinaryIntAutomaton::MakeAnyInt(seven->GetFormula()->clone(), false));
+  EXPECT_TRUE(MakeRelation(ArithmeticFormula::Type::LT, -8, false)->IsEqual(any_int.get()));
+  // x >= -8 holds for every value, x < -8 for none
+  EXPECT_TRUE(MakeRelation(ArithmeticFormula::Type::GE, 8, false)->IsEqual(any_int.get()));
+  EXPECT_TRUE(MakeRelation(ArithmeticFormula::Type::LT, 8, false)->IsEmptyLanguage());
+
+  // the wrapped equality agrees with the exact relations on its single solution
+  auto wrapped = MakeRelation(ArithmeticFormula::Type::EQ, 9, false);
+  std::unique_ptr<BinaryIntAutomaton> wrapped_at_most_seven(wrapped->Intersect(at_most_seven.get()));
+  EXPECT_TRUE(wrapped->IsEqual(wrapped_at_most_seven.get()));
+}
+
+TEST_F(FixedWidthIntegerTest, NaturalNumberSemilinearSet) {
+  // 12 needs all 4 bits as a natural number
+  SemilinearSet semilinear_set;
+  semilinear_set.add_constant(12);
+  auto formula = new ArithmeticFormula();
+  formula->AddVariable("x", 0);
+  std::unique_ptr<BinaryIntAutomaton> natural_auto(
+      BinaryIntAutomaton::MakeAutomaton(&semilinear_set, "x", formula, false));
+  EXPECT_TRUE(natural_auto->is_natural_number());
+  auto twelve = MakeRelation(ArithmeticFormula::Type::EQ, -12, true);
+  EXPECT_TRUE(natural_auto->IsEqual(twelve.get()));
+}
+
+TEST_F(FixedWidthIntegerTest, SignedSemilinearSet) {
+  SemilinearSet semilinear_set;
+  semilinear_set.add_constant(7);
+  auto formula = new ArithmeticFormula();
+  formula->AddVariable("x", 0);
+  std::unique_ptr<BinaryIntAutomaton> signed_auto(
+      BinaryIntAutomaton::MakeAutomaton(&semilinear_set, "x", formula, true));
+  EXPECT_FALSE(signed_auto->is_natural_number());
+  EXPECT_TRUE(signed_auto->IsEqual(MakeRelation(ArithmeticFormula::Type::EQ, -7, false).get()));
+
+  // 8 does not fit into a signed 4 bit integer
+  SemilinearSet too_large_set;
+  too_large_set.add_constant(8);
+  formula = new ArithmeticFormula();
+  formula->AddVariable("x", 0);
+  std::unique_ptr<BinaryIntAutomaton> too_large_auto(
+      BinaryIntAutomaton::MakeAutomaton(&too_large_set, "x", formula, true));
+  EXPECT_TRUE(too_large_auto->IsEmptyLanguage());
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
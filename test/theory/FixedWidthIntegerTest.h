@@ -0,0 +1,45 @@
+/*
+ * FixedWidthIntegerTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_FIXEDWIDTHINTEGERTEST_H_
+#define THEORY_FIXEDWIDTHINTEGERTEST_H_
+
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/ArithmeticFormula.h"
+#include "theory/BinaryIntAutomaton.h"
+#include "theory/SemilinearSet.h"
+#include "theory/options/Theory.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class FixedWidthIntegerTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Makes the automaton of x + constant ~ 0
+   */
+  static std::unique_ptr<BinaryIntAutomaton> MakeRelation(const ArithmeticFormula::Type type, const int constant,
+                                                          const bool is_natural_number);
+
+  int int_bit_width_;
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_FIXEDWIDTHINTEGERTEST_H_ */
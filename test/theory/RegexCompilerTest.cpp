@@ -0,0 +1,186 @@
+/*
+ * RegexCompilerTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "RegexCompilerTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void RegexCompilerTest::SetUp() {
+}
+
+void RegexCompilerTest::TearDown() {
+}
+
+StringAutomaton_ptr RegexCompilerTest::MakeRegexAuto(const std::string& regex_string) {
+  Util::RegularExpression regex (regex_string, 0x000e);
+  return StringAutomaton::MakeRegexAuto(&regex);
+}
+
+StringAutomaton_ptr RegexCompilerTest::MakeAnyOf(const std::vector<std::string>& words) {
+  StringAutomaton_ptr result_auto = StringAutomaton::MakePhi();
+  for (auto& word : words) {
+    auto word_auto = StringAutomaton::MakeString(word);
+    auto union_auto = result_auto->Union(word_auto);
+    delete word_auto;
+    delete result_auto;
+    result_auto = union_auto;
+  }
+  return result_auto;
+}
+
+void RegexCompilerTest::ExpectEqual(StringAutomaton_ptr result_auto, StringAutomaton_ptr expected_auto) {
+  EXPECT_TRUE(result_auto->IsEqual(expected_auto));
+  delete result_auto;
+  delete expected_auto;
+}
+
+TEST_F(RegexCompilerTest, GetExceptions) {
+  RegexCompiler::CharSet chars;
+  for (unsigned long c = 'a'; c <= 'z'; ++c) {
+    chars.set(c);
+  }
+  // 'a' = 01100001, 'z' = 01111010
+  EXPECT_THAT(RegexCompiler::GetExceptions(chars, 8),
+              ElementsAre("01100001", "0110001X", "011001XX", "01101XXX", "01110XXX", "0111100X", "01111010"));
+
+  chars.reset();
+  for (unsigned long c = 0; c < 256; ++c) {
+    chars.set(c);
+  }
+  EXPECT_THAT(RegexCompiler::GetExceptions(chars, 8), ElementsAre("XXXXXXXX"));
+
+  chars.reset();
+  EXPECT_THAT(RegexCompiler::GetExceptions(chars, 8), IsEmpty());
+}
+
+TEST_F(RegexCompilerTest, IsSupported) {
+  Util::RegularExpression regex_0 ("[a-z]+@(abc|def){1,3}", 0x000e);
+  EXPECT_TRUE(RegexCompiler::IsSupported(&regex_0, 8));
+  Util::RegularExpression regex_1 ("~(abc)", 0x000e);
+  EXPECT_FALSE(RegexCompiler::IsSupported(&regex_1, 8));
+}
+
+TEST_F(RegexCompilerTest, MakeRegexAuto) {
+  Util::RegularExpression regex ("(ab){1,2}c*", 0x000e);
+  auto regex_auto = StringAutomaton::MakeRegexAuto(&regex);
+
+  auto ab_auto = StringAutomaton::MakeString("ab");
+  auto abab_auto = StringAutomaton::MakeString("abab");
+  auto c_auto = StringAutomaton::MakeString("c");
+  auto c_star_auto = c_auto->KleeneClosure();
+  auto union_auto = ab_auto->Union(abab_auto);
+  auto expected_auto = union_auto->Concat(c_star_auto);
+
+  EXPECT_TRUE(regex_auto->IsEqual(expected_auto));
+
+  delete regex_auto;
+  delete ab_auto;
+  delete abab_auto;
+  delete c_auto;
+  delete c_star_auto;
+  delete union_auto;
+  delete expected_auto;
+}
+
+TEST_F(RegexCompilerTest, RepeatZeroTimes) {
+  ExpectEqual(MakeRegexAuto("(ab){0}"), StringAutomaton::MakeEmptyString());
+  ExpectEqual(MakeRegexAuto("x(ab){0}y"), StringAutomaton::MakeString("xy"));
+
+  auto ab_auto = StringAutomaton::MakeString("ab");
+  ExpectEqual(ab_auto->Repeat(0, 0), StringAutomaton::MakeEmptyString());
+  ExpectEqual(ab_auto->Repeat(3, 2), StringAutomaton::MakePhi());
+  delete ab_auto;
+}
+
+TEST_F(RegexCompilerTest, RepeatExactly) {
+  // copies of a multi character operand, a length range does not describe them
+  ExpectEqual(MakeRegexAuto("(ab|c){2}"), MakeAnyOf({"abab", "abc", "cab", "cc"}));
+
+  auto operand_auto = MakeAnyOf({"ab", "c"});
+  ExpectEqual(operand_auto->Repeat(2, 2), MakeAnyOf({"abab", "abc", "cab", "cc"}));
+  delete operand_auto;
+}
+
+TEST_F(RegexCompilerTest, RepeatUpToLargeMax) {
+  auto ab_star_auto = MakeRegexAuto("(ab)*");
+  auto range_auto = StringAutomaton::MakeAnyStringWithLengthInRange(4, 200);
+  ExpectEqual(MakeRegexAuto("(ab){2,100}"), ab_star_auto->Intersect(range_auto));
+
+  auto ab_auto = StringAutomaton::MakeString("ab");
+  ExpectEqual(ab_auto->Repeat(2, 100), ab_star_auto->Intersect(range_auto));
+  delete ab_auto;
+  delete range_auto;
+  delete ab_star_auto;
+
+  // unbounded repetition saturates the number of copies at min
+  auto operand_auto = MakeAnyOf({"ab", "c"});
+  auto prefix_auto = MakeRegexAuto("(ab|c)(ab|c)(ab|c)");
+  auto closure_auto = operand_auto->KleeneClosure();
+  ExpectEqual(operand_auto->Repeat(3), prefix_auto->Concat(closure_auto));
+  ExpectEqual(MakeRegexAuto("(ab|c){3,}"), prefix_auto->Concat(closure_auto));
+  delete closure_auto;
+  delete prefix_auto;
+  delete operand_auto;
+}
+
+TEST_F(RegexCompilerTest, RepeatNested) {
+  const std::vector<std::string> words = {"abcabc", "abcababc", "ababcabc", "ababcababc"};
+  ExpectEqual(MakeRegexAuto("((ab){1,2}c){2}"), MakeAnyOf(words));
+
+  auto ab_auto = StringAutomaton::MakeString("ab");
+  auto c_auto = StringAutomaton::MakeString("c");
+  auto inner_auto = ab_auto->Repeat(1, 2);
+  auto operand_auto = inner_auto->Concat(c_auto);
+  ExpectEqual(operand_auto->Repeat(2, 2), MakeAnyOf(words));
+  delete operand_auto;
+  delete inner_auto;
+  delete c_auto;
+  delete ab_auto;
+}
+
+TEST_F(RegexCompilerTest, RegexCacheRoundTrip) {
+  char file_name[] = "/tmp/abc_regex_cache_XXXXXX";
+  const int fd = mkstemp(file_name);
+  ASSERT_NE(-1, fd);
+  close(fd);
+
+  const std::vector<std::string> regexes = {"[a-z]+@(abc|def){1,3}", "(ab)*c?", ".*x.{2}", "((ab){1,2}c){2}"};
+  StringAutomaton::ClearRegexCache();
+  for (auto& regex : regexes) {
+    delete StringAutomaton::MakeRegexAuto(regex);
+  }
+  ASSERT_TRUE(StringAutomaton::SaveRegexCache(file_name));
+
+  // entries are decoded from the mapped file when they are first used
+  StringAutomaton::ClearRegexCache();
+  ASSERT_TRUE(StringAutomaton::LoadRegexCache(file_name));
+  for (auto& regex : regexes) {
+    auto cached_auto = StringAutomaton::MakeRegexAuto(regex);
+    Util::RegularExpression regular_expression (regex);
+    auto compiled_auto = StringAutomaton::MakeRegexAuto(&regular_expression);
+    EXPECT_TRUE(cached_auto->IsEqual(compiled_auto)) << regex;
+    delete compiled_auto;
+    delete cached_auto;
+  }
+  StringAutomaton::ClearRegexCache();
+
+  std::ofstream(file_name) << "not a regex cache";
+  EXPECT_FALSE(StringAutomaton::LoadRegexCache(file_name));
+  StringAutomaton::ClearRegexCache();
+  std::remove(file_name);
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,53 @@
+/*
+ * RegexCompilerTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_REGEXCOMPILERTEST_H_
+#define THEORY_REGEXCOMPILERTEST_H_
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/RegexCompiler.h"
+#include "theory/StringAutomaton.h"
+#include "utils/RegularExpression.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class RegexCompilerTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  static StringAutomaton_ptr MakeRegexAuto(const std::string& regex_string);
+
+  /**
+   * Union of the words as strings
+   */
+  static StringAutomaton_ptr MakeAnyOf(const std::vector<std::string>& words);
+
+  /**
+   * Expects both automata to accept the same language, deletes both
+   */
+  static void ExpectEqual(StringAutomaton_ptr result_auto, StringAutomaton_ptr expected_auto);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_REGEXCOMPILERTEST_H_ */
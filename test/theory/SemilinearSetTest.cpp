@@ -0,0 +1,149 @@
+/*
+ * SemilinearSetTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "SemilinearSetTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+std::unique_ptr<SemilinearSet> SemilinearSetTest::MakeProgression(const int offset, const int period) {
+  return Own(SemilinearSet::MakeSemilinearSet(offset, period, [offset, period](int n) {
+    return n >= offset and (n - offset) % period == 0;
+  }));
+}
+
+std::unique_ptr<SemilinearSet> SemilinearSetTest::Own(SemilinearSet_ptr semilinear_set) {
+  return std::unique_ptr<SemilinearSet>(semilinear_set);
+}
+
+void SemilinearSetTest::ExpectMembers(SemilinearSet& semilinear_set, std::function<bool(int)> is_member) {
+  for (int n = 0; n < 100; ++n) {
+    EXPECT_EQ(is_member(n), semilinear_set.has_value(n)) << n << " in " << semilinear_set;
+  }
+}
+
+TEST_F(SemilinearSetTest, MakeSemilinearSetNormalizes) {
+  auto odds = Own(SemilinearSet::MakeSemilinearSet(10, 8, [](int n) { return n % 2 == 1; }));
+  EXPECT_EQ(0, odds->get_cycle_head());
+  EXPECT_EQ(2, odds->get_period());
+  EXPECT_THAT(odds->get_periodic_constants(), ElementsAre(1));
+  EXPECT_THAT(odds->get_constants(), IsEmpty());
+
+  auto some = Own(SemilinearSet::MakeSemilinearSet(5, 1, [](int n) { return n == 1 or n == 3; }));
+  EXPECT_TRUE(some->has_only_constants());
+  EXPECT_THAT(some->get_constants(), ElementsAre(1, 3));
+
+  auto nothing = Own(SemilinearSet::MakeSemilinearSet(3, 4, [](int n) { return false; }));
+  EXPECT_TRUE(nothing->is_empty_set());
+}
+
+TEST_F(SemilinearSetTest, Union) {
+  auto evens = MakeProgression(0, 2);
+  auto three = Own(SemilinearSet::MakeSemilinearSet(4, 1, [](int n) { return n == 3; }));
+  auto result = Own(evens->Union(three.get()));
+  ExpectMembers(*result, [](int n) { return n % 2 == 0 or n == 3; });
+
+  auto empty = Own(new SemilinearSet());
+  result = Own(evens->Union(empty.get()));
+  ExpectMembers(*result, [](int n) { return n % 2 == 0; });
+}
+
+TEST_F(SemilinearSetTest, Intersect) {
+  auto evens = MakeProgression(0, 2), threes = MakeProgression(0, 3);
+  auto result = Own(evens->Intersect(threes.get()));
+  EXPECT_EQ(6, result->get_period());
+  ExpectMembers(*result, [](int n) { return n % 6 == 0; });
+
+  auto odds = MakeProgression(1, 2);
+  result = Own(evens->Intersect(odds.get()));
+  EXPECT_TRUE(result->is_empty_set());
+}
+
+TEST_F(SemilinearSetTest, Complement) {
+  auto evens = MakeProgression(0, 2);
+  auto result = Own(evens->Complement());
+  ExpectMembers(*result, [](int n) { return n % 2 == 1; });
+
+  auto empty = Own(new SemilinearSet());
+  result = Own(empty->Complement());
+  ExpectMembers(*result, [](int n) { return true; });
+}
+
+TEST_F(SemilinearSetTest, Plus) {
+  auto one = Own(SemilinearSet::MakeSemilinearSet(2, 1, [](int n) { return n == 1; }));
+  auto threes = MakeProgression(0, 3);
+  auto result = Own(one->Plus(threes.get()));
+  ExpectMembers(*result, [](int n) { return n % 3 == 1; });
+
+  auto fours = MakeProgression(0, 4);
+  result = Own(threes->Plus(fours.get()));
+  // 3a + 4b covers every number except 1, 2 and 5
+  ExpectMembers(*result, [](int n) { return n != 1 and n != 2 and n != 5; });
+
+  auto empty = Own(new SemilinearSet());
+  result = Own(threes->Plus(empty.get()));
+  EXPECT_TRUE(result->is_empty_set());
+}
+
+TEST_F(SemilinearSetTest, Times) {
+  auto odds = MakeProgression(1, 2);
+  auto result = Own(odds->Times(3));
+  ExpectMembers(*result, [](int n) { return n % 6 == 3; });
+
+  result = Own(odds->Times(0));
+  EXPECT_THAT(result->get_constants(), ElementsAre(0));
+
+  auto empty = Own(new SemilinearSet());
+  result = Own(empty->Times(3));
+  EXPECT_TRUE(result->is_empty_set());
+}
+
+TEST_F(SemilinearSetTest, OverflowIsOverApproximated) {
+  const int max_value = std::numeric_limits<int>::max();
+  auto odds = MakeProgression(1, 2);
+  auto result = Own(odds->Times(max_value / 2));
+  ExpectMembers(*result, [](int n) { return true; });
+
+  // lcm of the periods is beyond int values
+  auto left = MakeProgression(0, 65521), right = MakeProgression(0, 65519);
+  result = Own(left->Union(right.get()));
+  ExpectMembers(*result, [](int n) { return true; });
+  result = Own(left->Plus(right.get()));
+  ExpectMembers(*result, [](int n) { return true; });
+  result = Own(left->Intersect(right.get()));
+  ExpectMembers(*result, [](int n) { return n % 65521 == 0; });
+}
+
+TEST_F(SemilinearSetTest, LargeResultsAreOverApproximated) {
+  // lcm of the periods fits into int values but is beyond the work bound
+  auto left = MakeProgression(0, 211), right = MakeProgression(0, 223);
+  auto result = Own(left->Union(right.get()));
+  ExpectMembers(*result, [](int n) { return true; });
+  result = Own(left->Plus(right.get()));
+  ExpectMembers(*result, [](int n) { return true; });
+  result = Own(left->Intersect(right.get()));
+  ExpectMembers(*result, [](int n) { return n % 211 == 0; });
+
+  auto large = Own(SemilinearSet::MakeSemilinearSet(5001, 1, [](int n) { return n == 5000; }));
+  auto zero = Own(SemilinearSet::MakeSemilinearSet(1, 1, [](int n) { return n == 0; }));
+  result = Own(large->Plus(zero.get()));
+  ExpectMembers(*result, [](int n) { return true; });
+  result = Own(large->Complement());
+  ExpectMembers(*result, [](int n) { return true; });
+  result = Own(large->Times(2));
+  ExpectMembers(*result, [](int n) { return true; });
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,44 @@
+/*
+ * SemilinearSetTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_SEMILINEARSETTEST_H_
+#define THEORY_SEMILINEARSETTEST_H_
+
+#include <functional>
+#include <limits>
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/SemilinearSet.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class SemilinearSetTest : public ::testing::Test {
+protected:
+  /**
+   * Makes {offset + period * k}
+   */
+  static std::unique_ptr<SemilinearSet> MakeProgression(const int offset, const int period);
+  static std::unique_ptr<SemilinearSet> Own(SemilinearSet_ptr semilinear_set);
+
+  /**
+   * Expects membership of the first values to agree with is_member
+   */
+  static void ExpectMembers(SemilinearSet& semilinear_set, std::function<bool(int)> is_member);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_SEMILINEARSETTEST_H_ */
@@ -0,0 +1,203 @@
+/*
+ * StringAutomatonTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "StringAutomatonTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+// single patterns with and without self overlaps, patterns that are prefixes, suffixes or infixes of each other
+const std::vector<std::vector<std::string>> StringAutomatonTest::PATTERN_SETS = {
+  { "abab" },
+  { "aaa" },
+  { "ab", "ba" },
+  { "aa", "aab" },
+  { "a", "bca" },
+  { "he", "she", "his", "hers" }
+};
+
+// subject regexes; a star, a finite set with overlapping occurrences, a single string
+const std::vector<std::string> StringAutomatonTest::SUBJECTS = { "(ab|c)*a?", "baaab|aaa|b", "abc" };
+
+void StringAutomatonTest::SetUp() {
+  use_direct_index_constructions_ = Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS;
+}
+
+void StringAutomatonTest::TearDown() {
+  Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = use_direct_index_constructions_;
+}
+
+void StringAutomatonTest::ExpectSameAsGeneric(std::function<Automaton_ptr()> construction) {
+  Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = true;
+  std::unique_ptr<Automaton> direct(construction());
+  Option::Theory::USE_DIRECT_INDEX_CONSTRUCTIONS = false;
+  std::unique_ptr<Automaton> generic(construction());
+  EXPECT_TRUE(direct->IsEqual(generic.get()));
+}
+
+StringAutomatonTest::Automaton_uptr StringAutomatonTest::Own(StringAutomaton_ptr automaton) {
+  return Automaton_uptr(automaton);
+}
+
+StringAutomatonTest::Automaton_uptr StringAutomatonTest::MakeAnyOf(const std::vector<std::string>& patterns) {
+  auto any_of = Own(StringAutomaton::MakeString(patterns[0]));
+  for (std::size_t i = 1; i < patterns.size(); ++i) {
+    auto pattern = Own(StringAutomaton::MakeString(patterns[i]));
+    any_of = Own(any_of->Union(pattern.get()));
+  }
+  return any_of;
+}
+
+StringAutomatonTest::Automaton_uptr StringAutomatonTest::MakeContains(const std::vector<std::string>& patterns) {
+  auto any_string = Own(StringAutomaton::MakeAnyString());
+  auto any_of = MakeAnyOf(patterns);
+  auto prefix = Own(any_string->Concat(any_of.get()));
+  return Own(prefix->Concat(any_string.get()));
+}
+
+TEST_F(StringAutomatonTest, MakeContainsAnyOf) {
+  for (auto& patterns : PATTERN_SETS) {
+    auto expected = MakeContains(patterns);
+    auto result = Own(StringAutomaton::MakeContainsAnyOf(patterns));
+    EXPECT_TRUE(result->IsEqual(expected.get())) << patterns[0];
+  }
+}
+
+TEST_F(StringAutomatonTest, MakeContainsAllOf) {
+  for (auto& patterns : PATTERN_SETS) {
+    auto expected = MakeContains({ patterns[0] });
+    for (std::size_t i = 1; i < patterns.size(); ++i) {
+      auto contains = MakeContains({ patterns[i] });
+      expected = Own(expected->Intersect(contains.get()));
+    }
+    auto result = Own(StringAutomaton::MakeContainsAllOf(patterns));
+    EXPECT_TRUE(result->IsEqual(expected.get())) << patterns[0];
+  }
+}
+
+TEST_F(StringAutomatonTest, MakeNotContainsAnyOf) {
+  for (auto& patterns : PATTERN_SETS) {
+    auto contains = MakeContains(patterns);
+    auto expected = Own(contains->Complement());
+    auto result = Own(StringAutomaton::MakeNotContainsAnyOf(patterns));
+    EXPECT_TRUE(result->IsEqual(expected.get())) << patterns[0];
+  }
+}
+
+TEST_F(StringAutomatonTest, MakeBeginsWithAnyOf) {
+  auto any_string = Own(StringAutomaton::MakeAnyString());
+  for (auto& patterns : PATTERN_SETS) {
+    auto any_of = MakeAnyOf(patterns);
+    auto expected = Own(any_of->Concat(any_string.get()));
+    auto result = Own(StringAutomaton::MakeBeginsWithAnyOf(patterns));
+    EXPECT_TRUE(result->IsEqual(expected.get())) << patterns[0];
+  }
+}
+
+TEST_F(StringAutomatonTest, MakeEndsWithAnyOf) {
+  auto any_string = Own(StringAutomaton::MakeAnyString());
+  for (auto& patterns : PATTERN_SETS) {
+    auto any_of = MakeAnyOf(patterns);
+    auto expected = Own(any_string->Concat(any_of.get()));
+    auto result = Own(StringAutomaton::MakeEndsWithAnyOf(patterns));
+    EXPECT_TRUE(result->IsEqual(expected.get())) << patterns[0];
+  }
+}
+
+TEST_F(StringAutomatonTest, CharAt) {
+  for (auto& subject : SUBJECTS) {
+    auto subject_auto = Own(StringAutomaton::MakeRegexAuto(subject));
+    for (int index = 0; index < 5; ++index) {
+      SCOPED_TRACE(subject + " at " + std::to_string(index));
+      ExpectSameAsGeneric([&subject_auto, index]() { return subject_auto->CharAt(index); });
+    }
+  }
+}
+
+TEST_F(StringAutomatonTest, SubString) {
+  // (2, 3) of "abc" is a substring of length 1 at the end of the string, (3, 4) starts at the end
+  const std::vector<std::pair<int, int>> ranges = { {0, 1}, {1, 3}, {2, 3}, {3, 4}, {0, 5} };
+  for (auto& subject : SUBJECTS) {
+    auto subject_auto = Own(StringAutomaton::MakeRegexAuto(subject));
+    for (auto& range : ranges) {
+      SCOPED_TRACE(subject + " from " + std::to_string(range.first) + " to " + std::to_string(range.second));
+      ExpectSameAsGeneric([&subject_auto, &range]() { return subject_auto->SubString(range.first, range.second); });
+    }
+    for (int start = 0; start < 4; ++start) {
+      SCOPED_TRACE(subject + " from " + std::to_string(start));
+      ExpectSameAsGeneric([&subject_auto, start]() { return subject_auto->SubString(start); });
+    }
+  }
+}
+
+TEST_F(StringAutomatonTest, SuffixesFromTo) {
+  const std::vector<std::pair<int, int>> ranges = { {0, 0}, {0, 2}, {1, 3}, {3, 5} };
+  for (auto& subject : SUBJECTS) {
+    auto subject_auto = Own(StringAutomaton::MakeRegexAuto(subject));
+    for (auto& range : ranges) {
+      SCOPED_TRACE(subject + " from " + std::to_string(range.first) + " to " + std::to_string(range.second));
+      ExpectSameAsGeneric([&subject_auto, &range]() {
+        return subject_auto->SuffixesFromTo(range.first, range.second);
+      });
+    }
+  }
+}
+
+TEST_F(StringAutomatonTest, IndexOf) {
+  // "aa" overlaps itself, "baaab" has occurrences at 1 and 2
+  const std::vector<std::string> searches = { "a", "aa", "ab", "d" };
+  for (auto& subject : SUBJECTS) {
+    auto subject_auto = Own(StringAutomaton::MakeRegexAuto(subject));
+    for (auto& search : searches) {
+      SCOPED_TRACE(subject + " index of " + search);
+      auto search_auto = Own(StringAutomaton::MakeString(search));
+      ExpectSameAsGeneric([&subject_auto, &search_auto]() { return subject_auto->IndexOf(search_auto.get()); });
+    }
+  }
+}
+
+TEST_F(StringAutomatonTest, RestrictIndexOfTo) {
+  const std::vector<std::string> searches = { "a", "aa", "ab" };
+  for (auto& subject : SUBJECTS) {
+    auto subject_auto = Own(StringAutomaton::MakeRegexAuto(subject));
+    for (auto& search : searches) {
+      auto search_auto = Own(StringAutomaton::MakeString(search));
+      for (int index = 0; index < 4; ++index) {
+        SCOPED_TRACE(subject + " index of " + search + " is " + std::to_string(index));
+        ExpectSameAsGeneric([&subject_auto, &search_auto, index]() {
+          return subject_auto->RestrictIndexOfTo(index, search_auto.get());
+        });
+      }
+    }
+  }
+}
+
+TEST_F(StringAutomatonTest, RestrictAtIndexTo) {
+  const std::vector<std::string> sub_strings = { "a", "aa", "ab" };
+  for (auto& subject : SUBJECTS) {
+    auto subject_auto = Own(StringAutomaton::MakeRegexAuto(subject));
+    for (auto& sub_string : sub_strings) {
+      auto sub_string_auto = Own(StringAutomaton::MakeString(sub_string));
+      for (int index = 0; index < 4; ++index) {
+        SCOPED_TRACE(subject + " has " + sub_string + " at " + std::to_string(index));
+        ExpectSameAsGeneric([&subject_auto, &sub_string_auto, index]() {
+          return subject_auto->RestrictAtIndexTo(index, sub_string_auto.get());
+        });
+      }
+    }
+  }
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
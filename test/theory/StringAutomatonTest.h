@@ -0,0 +1,62 @@
+/*
+ * StringAutomatonTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_STRINGAUTOMATONTEST_H_
+#define THEORY_STRINGAUTOMATONTEST_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/StringAutomaton.h"
+#include "theory/options/Theory.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+/**
+ * Compares the automata built directly with the ones composed from basic operations
+ */
+class StringAutomatonTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  using Automaton_uptr = std::unique_ptr<StringAutomaton>;
+
+  static Automaton_uptr Own(StringAutomaton_ptr automaton);
+
+  /**
+   * Union of the patterns as strings
+   */
+  static Automaton_uptr MakeAnyOf(const std::vector<std::string>& patterns);
+  static Automaton_uptr MakeContains(const std::vector<std::string>& patterns);
+
+  /**
+   * Expects the direct index construction to accept the same language as the generic one
+   * @param construction builds the automaton under the current options
+   */
+  static void ExpectSameAsGeneric(std::function<Automaton_ptr()> construction);
+
+  static const std::vector<std::vector<std::string>> PATTERN_SETS;
+  static const std::vector<std::string> SUBJECTS;
+
+  bool use_direct_index_constructions_;
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_STRINGAUTOMATONTEST_H_ */
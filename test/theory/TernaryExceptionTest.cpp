@@ -0,0 +1,77 @@
+/*
+ * TernaryExceptionTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "TernaryExceptionTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+std::string TernaryExceptionTest::MakeLongException(const int seed) {
+  const std::string values = "01X";
+  std::string exception(130, 'X');
+  for (std::size_t i = 0; i < exception.size(); ++i) {
+    exception[i] = values[(i * 7 + seed) % 3];
+  }
+  return exception;
+}
+
+TEST_F(TernaryExceptionTest, ToStringOfParsedException) {
+  for (auto exception : {std::string(""), std::string("X"), std::string("01X10"), MakeLongException(0),
+                         MakeLongException(1)}) {
+    EXPECT_EQ(exception, TernaryException(exception).ToString());
+  }
+}
+
+TEST_F(TernaryExceptionTest, SetAndPushBack) {
+  const std::string expected = MakeLongException(2);
+  TernaryException exception;
+  for (char value : expected) {
+    exception.PushBack(value);
+  }
+  EXPECT_EQ(130, exception.size());
+  EXPECT_EQ(expected, exception.ToString());
+  EXPECT_EQ(TernaryException(expected), exception);
+
+  // a value set after a don't care does not leave stale bits behind
+  TernaryException updated(expected);
+  updated.SetBit(64, true);
+  updated.SetDontCare(64);
+  updated.Set(129, '0');
+  updated.Set(129, expected[129]);
+  EXPECT_EQ(TernaryException(expected), updated);
+  EXPECT_EQ('X', updated.Get(64));
+}
+
+TEST_F(TernaryExceptionTest, DistinctExceptionsAreDistinctKeys) {
+  // same characters except for '0' and 'X', and same prefix of different sizes
+  const std::vector<std::string> exceptions {"0X1", "XX1", "0X10", "0X1X", MakeLongException(0),
+                                             MakeLongException(1), MakeLongException(2)};
+  std::set<TernaryException> ordered;
+  std::unordered_set<TernaryException, TernaryException::Hasher> hashed;
+  for (auto& exception : exceptions) {
+    ordered.insert(TernaryException(exception));
+    hashed.insert(TernaryException(exception));
+  }
+  EXPECT_EQ(exceptions.size(), ordered.size());
+  EXPECT_EQ(exceptions.size(), hashed.size());
+
+  for (auto& exception : exceptions) {
+    EXPECT_EQ(1, ordered.count(TernaryException(exception)));
+    EXPECT_EQ(1, hashed.count(TernaryException(exception)));
+    EXPECT_FALSE(TernaryException(exception) != TernaryException(exception));
+  }
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
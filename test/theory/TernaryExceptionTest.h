@@ -0,0 +1,39 @@
+/*
+ * TernaryExceptionTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_TERNARYEXCEPTIONTEST_H_
+#define THEORY_TERNARYEXCEPTIONTEST_H_
+
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/TernaryException.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class TernaryExceptionTest : public ::testing::Test {
+protected:
+  /**
+   * Exception over 130 variables, spanning three words of the packed masks
+   */
+  static std::string MakeLongException(const int seed);
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_TERNARYEXCEPTIONTEST_H_ */
@@ -0,0 +1,82 @@
+/*
+ * TransducerTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "TransducerTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void TransducerTest::SetUp() {
+}
+
+void TransducerTest::TearDown() {
+}
+
+TEST_F(TransducerTest, Replace) {
+  auto subject_auto = StringAutomaton::MakeString("abaab");
+  auto search_auto = StringAutomaton::MakeString("ab");
+  auto replace_auto = StringAutomaton::MakeString("c");
+  auto result_auto = subject_auto->Replace(search_auto, replace_auto);
+  auto expected_auto = StringAutomaton::MakeString("cac");
+  EXPECT_TRUE(result_auto->IsEqual(expected_auto));
+
+  // pre image of "cac" also contains the strings that already have c in place of ab
+  auto pre_auto = expected_auto->PreReplace(search_auto, "c");
+  auto pre_subject_auto = StringAutomaton::MakeString("caab");
+  auto intersect_auto_1 = pre_auto->Intersect(subject_auto);
+  auto intersect_auto_2 = pre_auto->Intersect(pre_subject_auto);
+  EXPECT_FALSE(intersect_auto_1->IsEmptyLanguage());
+  EXPECT_FALSE(intersect_auto_2->IsEmptyLanguage());
+
+  delete subject_auto;
+  delete search_auto;
+  delete replace_auto;
+  delete result_auto;
+  delete expected_auto;
+  delete pre_auto;
+  delete pre_subject_auto;
+  delete intersect_auto_1;
+  delete intersect_auto_2;
+}
+
+TEST_F(TransducerTest, Compose) {
+  auto replace_transducer = Transducer::MakeReplace("-", " ");
+  auto upper_case_transducer = Transducer::MakeToUpperCase();
+  auto trim_transducer = Transducer::MakeTrim();
+  auto tmp_transducer = replace_transducer->Compose(upper_case_transducer);
+  auto sanitizer_transducer = tmp_transducer->Compose(trim_transducer);
+
+  auto subject_auto = StringAutomaton::MakeString("-ab-c-");
+  auto result_auto = subject_auto->Transduce(sanitizer_transducer);
+  auto expected_auto = StringAutomaton::MakeString("AB C");
+  EXPECT_TRUE(result_auto->IsEqual(expected_auto));
+
+  auto pre_auto = expected_auto->PreTransduce(sanitizer_transducer);
+  auto intersect_auto = pre_auto->Intersect(subject_auto);
+  EXPECT_FALSE(intersect_auto->IsEmptyLanguage());
+
+  delete replace_transducer;
+  delete upper_case_transducer;
+  delete trim_transducer;
+  delete tmp_transducer;
+  delete sanitizer_transducer;
+  delete subject_auto;
+  delete result_auto;
+  delete expected_auto;
+  delete pre_auto;
+  delete intersect_auto;
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
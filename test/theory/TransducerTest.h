@@ -0,0 +1,34 @@
+/*
+ * TransducerTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_TRANSDUCERTEST_H_
+#define THEORY_TRANSDUCERTEST_H_
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/Transducer.h"
+#include "theory/StringAutomaton.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class TransducerTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_TRANSDUCERTEST_H_ */
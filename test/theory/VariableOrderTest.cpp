@@ -0,0 +1,122 @@
+/*
+ * VariableOrderTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#include "VariableOrderTest.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+using namespace ::testing;
+
+void VariableOrderTest::SetUp() {
+}
+
+void VariableOrderTest::TearDown() {
+  for (auto formula : formulas_) {
+    delete formula;
+  }
+  formulas_.clear();
+}
+
+ArithmeticFormula_ptr VariableOrderTest::MakeEquality(const std::vector<int>& coefficients, const int constant) {
+  auto formula = new ArithmeticFormula();
+  formula->SetType(ArithmeticFormula::Type::EQ);
+  formula->SetConstant(constant);
+  formula->AddVariable("a", coefficients[0]);
+  formula->AddVariable("b", coefficients[1]);
+  formula->AddVariable("y", coefficients[2]);
+  formula->AddVariable("z", coefficients[3]);
+  return formula;
+}
+
+BinaryIntAutomaton_ptr VariableOrderTest::MakeConjunction(const std::vector<ArithmeticFormula_ptr>& formulas,
+                                                          const std::vector<std::string>& variable_order) {
+  BinaryIntAutomaton_ptr conjunction = nullptr;
+  for (auto formula : formulas) {
+    auto ordered_formula = formula->clone();
+    ordered_formula->SetVariableOrder(variable_order);
+    auto formula_auto = BinaryIntAutomaton::MakeAutomaton(ordered_formula, false);
+    if (conjunction == nullptr) {
+      conjunction = formula_auto;
+    } else {
+      auto tmp_auto = conjunction;
+      conjunction = tmp_auto->Intersect(formula_auto);
+      delete tmp_auto;
+      delete formula_auto;
+    }
+  }
+  return conjunction;
+}
+
+TEST_F(VariableOrderTest, FormulaVariableOrder) {
+  auto formula = MakeEquality({1, 2, 3, 4}, 0);
+  formulas_.push_back(formula);
+  EXPECT_THAT(formula->GetVariableOrder(), ElementsAre("a", "b", "y", "z"));
+  EXPECT_EQ(2, formula->GetVariableIndex("y"));
+
+  formula->SetVariableOrder({"z", "unknown", "a"});
+  EXPECT_THAT(formula->GetVariableOrder(), ElementsAre("z", "a", "b", "y"));
+  EXPECT_THAT(formula->GetCoefficients(), ElementsAre(4, 1, 2, 3));
+  EXPECT_EQ(0, formula->GetVariableIndex("z"));
+  EXPECT_EQ(3, formula->GetVariableIndex("y"));
+  EXPECT_EQ("a", formula->GetVariableAtIndex(1));
+
+  // clones and operations keep the order
+  auto clone = formula->clone();
+  formulas_.push_back(clone);
+  clone->RemoveVariable("a");
+  EXPECT_THAT(clone->GetVariableOrder(), ElementsAre("z", "b", "y"));
+  EXPECT_EQ(2, clone->GetVariableIndex("y"));
+}
+
+TEST_F(VariableOrderTest, KeepsCoOccurringVariablesTogether) {
+  // a + z = 0 and b + y = 0, name order reads a and b before completing either formula
+  formulas_.push_back(MakeEquality({1, 0, 0, 1}, 0));
+  formulas_.push_back(MakeEquality({0, 1, 1, 0}, 0));
+  std::vector<std::string> variables {"a", "b", "y", "z"};
+
+  auto variable_order = VariableOrder::Find(formulas_, variables);
+  EXPECT_THAT(variable_order, ElementsAre("a", "z", "b", "y"));
+  EXPECT_LT(VariableOrder::EstimateBddWidth(formulas_, variable_order),
+            VariableOrder::EstimateBddWidth(formulas_, variables));
+}
+
+TEST_F(VariableOrderTest, ReadsSmallCoefficientsFirst) {
+  // 8a + y + z = 0
+  formulas_.push_back(MakeEquality({8, 0, 1, 1}, 0));
+  auto variable_order = VariableOrder::Find(formulas_, {"a", "y", "z"});
+  EXPECT_THAT(variable_order, ElementsAre("y", "z", "a"));
+}
+
+TEST_F(VariableOrderTest, KeepsOrderWithoutImprovement) {
+  formulas_.push_back(MakeEquality({1, 0, 0, -1}, 0));
+  EXPECT_THAT(VariableOrder::Find(formulas_, {"a", "z"}), ElementsAre("a", "z"));
+  EXPECT_THAT(VariableOrder::Find(std::vector<ArithmeticFormula_ptr>(), {"a", "b"}), ElementsAre("a", "b"));
+}
+
+TEST_F(VariableOrderTest, SearchedOrderShrinksAutomaton) {
+  formulas_.push_back(MakeEquality({1, 0, 0, 1}, 0));
+  formulas_.push_back(MakeEquality({0, 1, 1, 0}, 0));
+  std::vector<std::string> variables {"a", "b", "y", "z"};
+
+  auto name_order_auto = MakeConjunction(formulas_, variables);
+  auto searched_order_auto = MakeConjunction(formulas_, VariableOrder::Find(formulas_, variables));
+  // same solutions, fewer bdd nodes per transition
+  EXPECT_EQ(name_order_auto->Count(8), searched_order_auto->Count(8));
+  EXPECT_EQ(name_order_auto->GetNumberOfStates(), searched_order_auto->GetNumberOfStates());
+  EXPECT_LT(searched_order_auto->GetNumberOfBddNodes(), name_order_auto->GetNumberOfBddNodes());
+  delete name_order_auto;
+  delete searched_order_auto;
+}
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
@@ -0,0 +1,50 @@
+/*
+ * VariableOrderTest.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *   Copyright: Copyright 2015 The ABC Authors. All rights reserved.
+ *              Use of this source code is governed license that can
+ *              be found in the COPYING file.
+ */
+
+#ifndef THEORY_VARIABLEORDERTEST_H_
+#define THEORY_VARIABLEORDERTEST_H_
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "theory/ArithmeticFormula.h"
+#include "theory/BinaryIntAutomaton.h"
+#include "theory/VariableOrder.h"
+
+namespace Vlab {
+namespace Theory {
+namespace Test {
+
+class VariableOrderTest : public ::testing::Test {
+protected:
+  virtual void SetUp();
+  virtual void TearDown();
+
+  /**
+   * Makes an equality formula over a, b, y and z with the given coefficients
+   */
+  static ArithmeticFormula_ptr MakeEquality(const std::vector<int>& coefficients, const int constant);
+
+  /**
+   * Makes the automaton of the conjunction of the formulas with the given variable order
+   */
+  static BinaryIntAutomaton_ptr MakeConjunction(const std::vector<ArithmeticFormula_ptr>& formulas,
+                                                const std::vector<std::string>& variable_order);
+
+  std::vector<ArithmeticFormula_ptr> formulas_;
+};
+
+} /* namespace Test */
+} /* namespace Theory */
+} /* namespace Vlab */
+
+#endif /* THEORY_VARIABLEORDERTEST_H_ */